@@ -0,0 +1,358 @@
+// Copyright (c) 2012-2019 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef __ELASTOS_SDK_BENCHMARKHELPER_H__
+#define __ELASTOS_SDK_BENCHMARKHELPER_H__
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <string>
+#include <vector>
+
+// Define BENCHMARK_CONFIG_MAIN in exactly one source file of a benchmark, before including this header, to replace
+// the global operator new and count every allocation of the process, including those made inside the sdk, and the
+// heap they still hold.
+
+namespace Elastos {
+	namespace ElaWallet {
+		namespace Benchmark {
+
+			struct Allocations {
+				uint64_t count;
+				uint64_t bytes;
+			};
+
+			extern std::atomic<uint64_t> allocCount;
+			extern std::atomic<uint64_t> allocBytes;
+			extern std::atomic<int64_t> liveBytes;
+
+			inline Allocations GetAllocations() {
+				Allocations a;
+				a.count = allocCount.load();
+				a.bytes = allocBytes.load();
+				return a;
+			}
+
+			// heap held by operator new allocations not deleted yet, in usable bytes of the allocator
+			inline int64_t LiveBytes() {
+				return liveBytes.load();
+			}
+
+			class Timer {
+			public:
+				Timer() : _start(std::chrono::steady_clock::now()) {}
+
+				void Reset() { _start = std::chrono::steady_clock::now(); }
+
+				// seconds since construction or the last Reset()
+				double Elapsed() const {
+					return std::chrono::duration<double>(std::chrono::steady_clock::now() - _start).count();
+				}
+
+			private:
+				std::chrono::steady_clock::time_point _start;
+			};
+
+			// Allocation counts and wall time of a measured section, as json
+			class Measure {
+			public:
+				Measure() : _alloc(GetAllocations()) {}
+
+				nlohmann::json ToJson() const {
+					Allocations a = GetAllocations();
+					nlohmann::json j;
+					j["Seconds"] = _timer.Elapsed();
+					j["Allocations"] = a.count - _alloc.count;
+					j["AllocatedBytes"] = a.bytes - _alloc.bytes;
+					return j;
+				}
+
+				double Elapsed() const { return _timer.Elapsed(); }
+
+			private:
+				Timer _timer;
+				Allocations _alloc;
+			};
+
+			// Latency samples in seconds, summarized as percentiles
+			class Samples {
+			public:
+				void Add(double seconds) { _samples.push_back(seconds); }
+
+				void Merge(const Samples &other) {
+					_samples.insert(_samples.end(), other._samples.begin(), other._samples.end());
+				}
+
+				size_t Size() const { return _samples.size(); }
+
+				// nearest rank, p in [0, 100]
+				double Percentile(double p) const {
+					if (_samples.empty())
+						return 0;
+
+					std::vector<double> sorted(_samples);
+					size_t rank = (size_t) (p / 100 * (sorted.size() - 1) + 0.5);
+					std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.end());
+					return sorted[rank];
+				}
+
+				nlohmann::json ToJson() const {
+					nlohmann::json j;
+					double sum = 0;
+					for (size_t i = 0; i < _samples.size(); ++i)
+						sum += _samples[i];
+
+					j["Count"] = _samples.size();
+					j["Mean"] = _samples.empty() ? 0 : sum / _samples.size();
+					j["P50"] = Percentile(50);
+					j["P90"] = Percentile(90);
+					j["P99"] = Percentile(99);
+					j["Max"] = Percentile(100);
+					return j;
+				}
+
+			private:
+				std::vector<double> _samples;
+			};
+
+			// keep the compiler from dropping a result nobody reads
+			template<class T>
+			inline void Keep(const T &value) {
+#if defined(__GNUC__) || defined(__clang__)
+				asm volatile("" : : "r"(&value) : "memory");
+#else
+				static const void *volatile sink;
+				sink = &value;
+#endif
+			}
+
+			// Microbenchmarks: every case runs in batches sized to take about minTime / repeats each, a batch is one
+			// sample of the time per operation. Cases whose name does not contain filter are skipped.
+			class Suite {
+			public:
+				Suite(double minTime = 0.5, size_t repeats = 5, const std::string &filter = "") :
+					_minTime(minTime), _repeats(repeats ? repeats : 1), _filter(filter) {}
+
+				void Add(const std::string &name, const std::function<void()> &op) {
+					if (name.find(_filter) != std::string::npos)
+						_cases.push_back(std::make_pair(name, op));
+				}
+
+				nlohmann::json Run() const {
+					nlohmann::json j;
+					for (size_t i = 0; i < _cases.size(); ++i)
+						j[_cases[i].first] = RunCase(_cases[i].second);
+					return j;
+				}
+
+			private:
+				nlohmann::json RunCase(const std::function<void()> &op) const {
+					double batchTime = _minTime / _repeats;
+					uint64_t iterations = 1;
+
+					op();
+					for (;;) {
+						Timer timer;
+						for (uint64_t n = 0; n < iterations; ++n)
+							op();
+						double elapsed = timer.Elapsed();
+						if (elapsed >= batchTime || iterations >= (1ull << 40))
+							break;
+						iterations *= elapsed > 0 && batchTime / elapsed < 16 ? 2 : 16;
+					}
+
+					Samples nanoseconds;
+					Allocations before = GetAllocations();
+					for (size_t r = 0; r < _repeats; ++r) {
+						Timer timer;
+						for (uint64_t n = 0; n < iterations; ++n)
+							op();
+						nanoseconds.Add(timer.Elapsed() * 1e9 / iterations);
+					}
+					Allocations after = GetAllocations();
+
+					uint64_t ops = iterations * _repeats;
+					nlohmann::json j;
+					j["Iterations"] = ops;
+					j["NsPerOp"] = nanoseconds.ToJson();
+					j["AllocationsPerOp"] = (double) (after.count - before.count) / ops;
+					j["AllocatedBytesPerOp"] = (double) (after.bytes - before.bytes) / ops;
+					return j;
+				}
+
+			private:
+				double _minTime;
+				size_t _repeats;
+				std::string _filter;
+				std::vector<std::pair<std::string, std::function<void()> > > _cases;
+			};
+
+		}
+	}
+}
+
+#ifdef BENCHMARK_CONFIG_MAIN
+
+#ifdef __APPLE__
+#include <malloc/malloc.h>
+#else
+#include <malloc.h>
+#endif
+
+namespace Elastos {
+	namespace ElaWallet {
+		namespace Benchmark {
+			std::atomic<uint64_t> allocCount(0);
+			std::atomic<uint64_t> allocBytes(0);
+			std::atomic<int64_t> liveBytes(0);
+		}
+	}
+}
+
+namespace Elastos {
+	namespace ElaWallet {
+		namespace Benchmark {
+			inline std::size_t UsableSize(void *p) {
+#ifdef __APPLE__
+				return p ? malloc_size(p) : 0;
+#else
+				return p ? malloc_usable_size(p) : 0;
+#endif
+			}
+
+			inline void *CountedAlloc(std::size_t size) {
+				void *p = std::malloc(size == 0 ? 1 : size);
+				allocCount++;
+				allocBytes += size;
+				liveBytes += UsableSize(p);
+				return p;
+			}
+
+			inline void CountedFree(void *p) {
+				liveBytes -= UsableSize(p);
+				std::free(p);
+			}
+		}
+	}
+}
+
+// every replaceable form is defined, so no new or delete of the process mixes this malloc with the library's heap
+
+void *operator new(std::size_t size) {
+	void *p = Elastos::ElaWallet::Benchmark::CountedAlloc(size);
+	if (p == nullptr)
+		throw std::bad_alloc();
+	return p;
+}
+
+void *operator new[](std::size_t size) {
+	return operator new(size);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+	return Elastos::ElaWallet::Benchmark::CountedAlloc(size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+	return Elastos::ElaWallet::Benchmark::CountedAlloc(size);
+}
+
+void operator delete(void *p) noexcept {
+	Elastos::ElaWallet::Benchmark::CountedFree(p);
+}
+
+void operator delete[](void *p) noexcept {
+	Elastos::ElaWallet::Benchmark::CountedFree(p);
+}
+
+void operator delete(void *p, const std::nothrow_t &) noexcept {
+	Elastos::ElaWallet::Benchmark::CountedFree(p);
+}
+
+void operator delete[](void *p, const std::nothrow_t &) noexcept {
+	Elastos::ElaWallet::Benchmark::CountedFree(p);
+}
+
+#ifdef __cpp_sized_deallocation
+void operator delete(void *p, std::size_t) noexcept {
+	Elastos::ElaWallet::Benchmark::CountedFree(p);
+}
+
+void operator delete[](void *p, std::size_t) noexcept {
+	Elastos::ElaWallet::Benchmark::CountedFree(p);
+}
+#endif
+
+#ifdef __cpp_aligned_new
+namespace Elastos {
+	namespace ElaWallet {
+		namespace Benchmark {
+			inline void *CountedAlignedAlloc(std::size_t size, std::align_val_t align) {
+				std::size_t alignment = static_cast<std::size_t>(align);
+				void *p = nullptr;
+
+				allocCount++;
+				allocBytes += size;
+				if (posix_memalign(&p, alignment < sizeof(void *) ? sizeof(void *) : alignment, size == 0 ? 1 : size))
+					return nullptr;
+				liveBytes += UsableSize(p);
+				return p;
+			}
+		}
+	}
+}
+
+void *operator new(std::size_t size, std::align_val_t align) {
+	void *p = Elastos::ElaWallet::Benchmark::CountedAlignedAlloc(size, align);
+	if (p == nullptr)
+		throw std::bad_alloc();
+	return p;
+}
+
+void *operator new[](std::size_t size, std::align_val_t align) {
+	return operator new(size, align);
+}
+
+void *operator new(std::size_t size, std::align_val_t align, const std::nothrow_t &) noexcept {
+	return Elastos::ElaWallet::Benchmark::CountedAlignedAlloc(size, align);
+}
+
+void *operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t &) noexcept {
+	return Elastos::ElaWallet::Benchmark::CountedAlignedAlloc(size, align);
+}
+
+void operator delete(void *p, std::align_val_t) noexcept {
+	Elastos::ElaWallet::Benchmark::CountedFree(p);
+}
+
+void operator delete[](void *p, std::align_val_t) noexcept {
+	Elastos::ElaWallet::Benchmark::CountedFree(p);
+}
+
+void operator delete(void *p, std::align_val_t, const std::nothrow_t &) noexcept {
+	Elastos::ElaWallet::Benchmark::CountedFree(p);
+}
+
+void operator delete[](void *p, std::align_val_t, const std::nothrow_t &) noexcept {
+	Elastos::ElaWallet::Benchmark::CountedFree(p);
+}
+
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept {
+	Elastos::ElaWallet::Benchmark::CountedFree(p);
+}
+
+void operator delete[](void *p, std::size_t, std::align_val_t) noexcept {
+	Elastos::ElaWallet::Benchmark::CountedFree(p);
+}
+#endif
+
+#endif
+
+#endif //__ELASTOS_SDK_BENCHMARKHELPER_H__
@@ -0,0 +1,139 @@
+// Copyright (c) 2012-2019 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// Wallet database fixture generator.
+//
+//   GeneratorBench <db file> [--blocks n] [--tx-per-block n] [--wallet-tx-per-block n] [--wallet-spend-per-block n]
+//                  [--mempool n] [--seed n] [--batch blocks]
+//
+// Mines a synthetic chain for the wallet of the benchmark mnemonic and writes what that wallet would have saved after
+// syncing it: block headers, wallet transactions, unspent outputs, used addresses and pending transactions. Blocks
+// are written in batches while they are mined and their transactions dropped afterwards, so a million wallet
+// transactions fit in memory. Prints the time spent mining and writing, and the genesis checkpoint a PrvNet config
+// needs to open the database, as json.
+//
+// A wallet imported from the same mnemonic into a PrvNet manager picks the file up as <data path>/<wallet id>/ELA.db.
+
+#define BENCHMARK_CONFIG_MAIN
+
+#include "BenchmarkHelper.h"
+#include "SyntheticChain.h"
+#include "SyntheticWallet.h"
+
+#include <Common/Log.h>
+#include <Database/DatabaseManager.h>
+
+#include <boost/bind.hpp>
+#include <boost/filesystem.hpp>
+
+#include <iostream>
+
+using namespace Elastos::ElaWallet;
+
+static const std::string __mnemonic = "abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon about";
+
+class BlockWriter {
+public:
+	BlockWriter(DatabaseManager *database, size_t batch) : _database(database), _batch(batch), _failed(false) {}
+
+	void OnBlock(const SyntheticChain::BlockPtr &block) {
+		_pending.push_back(block);
+		if (_pending.size() >= _batch)
+			Flush();
+	}
+
+	void Flush() {
+		Benchmark::Timer timer;
+		if (!_pending.empty() && !SyntheticChain::StoreBlocks(*_database, _pending))
+			_failed = true;
+		_pending.clear();
+		_storeTime.Add(timer.Elapsed());
+	}
+
+	bool Failed() const { return _failed; }
+
+	const Benchmark::Samples &StoreTime() const { return _storeTime; }
+
+private:
+	DatabaseManager *_database;
+	size_t _batch;
+	bool _failed;
+	std::vector<SyntheticChain::BlockPtr> _pending;
+	Benchmark::Samples _storeTime;
+};
+
+static bool ParseOptions(int argc, char *argv[], SyntheticChain::Options &options, size_t &batch) {
+	for (int i = 2; i < argc; i += 2) {
+		if (i + 1 >= argc)
+			return false;
+
+		std::string name = argv[i];
+		uint32_t value = (uint32_t) std::strtoul(argv[i + 1], nullptr, 10);
+		if (name == "--blocks") options.blocks = value;
+		else if (name == "--tx-per-block") options.txPerBlock = value;
+		else if (name == "--wallet-tx-per-block") options.walletTxPerBlock = value;
+		else if (name == "--wallet-spend-per-block") options.walletSpendPerBlock = value;
+		else if (name == "--mempool") options.mempoolTxs = value;
+		else if (name == "--seed") options.seed = value;
+		else if (name == "--batch" && value > 0) batch = value;
+		else return false;
+	}
+	return true;
+}
+
+int main(int argc, char *argv[]) {
+	SyntheticChain::Options options;
+	size_t batch = 1000;
+
+	options.keepTransactions = false;
+	if (argc < 2 || !ParseOptions(argc, argv, options, batch)) {
+		std::cerr << "usage: " << argv[0] << " <db file> [--blocks n] [--tx-per-block n] [--wallet-tx-per-block n]"
+				  << std::endl << "       [--wallet-spend-per-block n] [--mempool n] [--seed n] [--batch blocks]"
+				  << std::endl;
+		return 1;
+	}
+
+	boost::filesystem::path path(argv[1]);
+	if (boost::filesystem::exists(path)) {
+		std::cerr << path.string() << " already exists" << std::endl;
+		return 1;
+	}
+
+	Log::registerMultiLogger();
+	Log::setLevel(spdlog::level::warn);
+
+	try {
+		Benchmark::Measure total;
+		DatabaseManager database(path);
+		SyntheticWallet wallet(__mnemonic);
+		SyntheticChain chain(options, &wallet);
+		BlockWriter writer(&database, batch);
+
+		writer.OnBlock(chain.Genesis());
+		chain.Generate(boost::bind(&BlockWriter::OnBlock, &writer, _1));
+		writer.Flush();
+
+		Benchmark::Timer walletTimer;
+		bool ok = !writer.Failed() && chain.StoreWallet(database);
+		double walletSeconds = walletTimer.Elapsed();
+
+		nlohmann::json result = total.ToJson();
+		double seconds = result["Seconds"];
+		result["Stored"] = ok;
+		result["Database"] = path.string();
+		result["Checkpoint"] = chain.Checkpoint();
+		result["Blocks"] = chain.Height();
+		result["Transactions"] = chain.TransactionCount();
+		result["WalletTransactions"] = chain.WalletTransactionCount();
+		result["WalletUTXOs"] = chain.WalletUTXOCount();
+		result["TxPerSecond"] = seconds > 0 ? chain.TransactionCount() / seconds : 0;
+		result["BatchStoreSeconds"] = writer.StoreTime().ToJson();
+		result["WalletStoreSeconds"] = walletSeconds;
+		std::cout << result.dump(4) << std::endl;
+		return ok ? 0 : 1;
+	} catch (const std::exception &e) {
+		std::cerr << e.what() << std::endl;
+		return 1;
+	}
+}
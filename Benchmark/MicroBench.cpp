@@ -0,0 +1,394 @@
+// Copyright (c) 2012-2019 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// Microbenchmarks of the sdk hot paths.
+//
+//   MicroBench [--filter substring] [--min-time seconds] [--repeats n]
+//
+// Prints nanoseconds per operation (percentiles over the repeats) and allocations per operation of every case as json,
+// keyed by case name so runs can be compared over time. Inputs come from a SyntheticChain with a fixed seed. Coin
+// selection runs over 1k, 10k, 100k and 1M candidate utxos. MerkleBlock/ReceiveBatch parses a merkleblock and its
+// matched txs in place, ReceiveBatchCopied copies each payload first as the messages did before. PayoutOutputs is the
+// heap one output keeps of a parsed 1000 output tx.
+
+#define BENCHMARK_CONFIG_MAIN
+
+#include "BenchmarkHelper.h"
+#include "SyntheticChain.h"
+#include "SyntheticWallet.h"
+
+#include <Common/Log.h>
+#include <Common/BigInt.h>
+#include <Common/hash.h>
+#include <Database/DatabaseManager.h>
+#include <Plugin/Registry.h>
+#include <Wallet/CoinSelector.h>
+#include <Wallet/UTXO.h>
+#include <WalletCore/AES.h>
+#include <WalletCore/Base58.h>
+#include <WalletCore/BIP39.h>
+#include <WalletCore/BloomFilter.h>
+#include <WalletCore/HDKeychain.h>
+#include <WalletCore/Key.h>
+
+#include <boost/filesystem.hpp>
+
+#include <iostream>
+
+using namespace Elastos::ElaWallet;
+
+static const std::string __mnemonic = "abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon about";
+
+static void AddTransactionCases(Benchmark::Suite &suite, const SyntheticChain &chain) {
+	// the first wallet tx of a block above 1 spends a coin of the wallet, so it is signed
+	TransactionPtr tx = chain.Tip()->walletTxns.front();
+	ByteStream stream;
+	tx->Serialize(stream);
+	bytes_t raw = stream.GetBytes();
+
+	suite.Add("Transaction/Serialize", [tx]() {
+		ByteStream s;
+		tx->Serialize(s);
+		Benchmark::Keep(s);
+	});
+
+	suite.Add("Transaction/Deserialize", [raw]() {
+		Transaction t;
+		ByteStream s(raw);
+		Benchmark::Keep(t.Deserialize(s));
+	});
+
+	suite.Add("Transaction/GetHash", [tx]() {
+		tx->ResetHash();
+		Benchmark::Keep(tx->GetHash());
+	});
+
+	suite.Add("Transaction/IsSigned", [tx]() {
+		Benchmark::Keep(tx->IsSigned());
+	});
+}
+
+// the parsing a peer does for a merkleblock and its matched txs
+static bool ParseBatch(const std::vector<bytes_t> &batch, bool copy) {
+	MerkleBlock block;
+	ByteStream blockStream = copy ? ByteStream(batch[0]) : ByteStream::View(batch[0].data(), batch[0].size());
+	bool r = block.Deserialize(blockStream, MERKLEBLOCK_VERSION_1);
+	std::vector<uint256> txHashes;
+	block.MerkleBlockTxHashes(txHashes);
+
+	for (size_t i = 1; i < batch.size(); ++i) {
+		Transaction tx;
+		ByteStream stream = copy ? ByteStream(batch[i]) : ByteStream::View(batch[i].data(), batch[i].size());
+		r = tx.Deserialize(stream) && r;
+		Benchmark::Keep(tx.GetHash());
+	}
+
+	return r && txHashes.size() == batch.size() - 1;
+}
+
+static void AddMerkleBlockCases(Benchmark::Suite &suite, const SyntheticChain &chain, const SyntheticWallet &wallet) {
+	BloomFilter filter(BLOOM_DEFAULT_FALSEPOSITIVE_RATE, 100, 0, BLOOM_UPDATE_ALL);
+	const std::vector<Address> &addresses = wallet.GetAddresses();
+	for (size_t i = 0; i < addresses.size(); ++i)
+		filter.InsertData(addresses[i].ProgramHash().bytes());
+
+	std::vector<TransactionPtr> matched;
+	MerkleBlockPtr block = SyntheticChain::FilterBlock(*chain.Tip(), filter, matched);
+	uint32_t now = (uint32_t) time(nullptr);
+
+	suite.Add("MerkleBlock/IsValid", [block, now]() {
+		Benchmark::Keep(block->IsValid(now));
+	});
+
+	suite.Add("MerkleBlock/MerkleBlockTxHashes", [block]() {
+		std::vector<uint256> txHashes;
+		Benchmark::Keep(block->MerkleBlockTxHashes(txHashes));
+	});
+
+	std::vector<bytes_t> batch(1);
+	ByteStream stream;
+	block->Serialize(stream, MERKLEBLOCK_VERSION_1);
+	batch[0] = stream.GetBytes();
+	for (size_t i = 0; i < matched.size(); ++i) {
+		stream.Reset();
+		matched[i]->Serialize(stream);
+		batch.push_back(stream.GetBytes());
+	}
+
+	suite.Add("MerkleBlock/ReceiveBatch", [batch]() {
+		Benchmark::Keep(ParseBatch(batch, false));
+	});
+
+	suite.Add("MerkleBlock/ReceiveBatchCopied", [batch]() {
+		Benchmark::Keep(ParseBatch(batch, true));
+	});
+}
+
+static void AddBloomFilterCases(Benchmark::Suite &suite) {
+	BloomFilterPtr filter(new BloomFilter(BLOOM_DEFAULT_FALSEPOSITIVE_RATE, 10000, 0, BLOOM_UPDATE_ALL));
+	std::vector<bytes_t> elements;
+	for (uint16_t i = 0; i < 10000; ++i) {
+		bytes_t outpoint = uint256(sha256_2(bytes_t(&i, sizeof(i)))).bytes();
+		outpoint.append(i);
+		elements.push_back(outpoint);
+		filter->InsertData(outpoint);
+	}
+
+	size_t next = 0;
+	suite.Add("BloomFilter/InsertData", [filter, elements, next]() mutable {
+		filter->InsertData(elements[next++ % elements.size()]);
+	});
+
+	bytes_t miss(34, 0xee);
+	suite.Add("BloomFilter/ContainsData/Hit", [filter, elements]() {
+		Benchmark::Keep(filter->ContainsData(elements[5000]));
+	});
+
+	suite.Add("BloomFilter/ContainsData/Miss", [filter, miss]() {
+		Benchmark::Keep(filter->ContainsData(miss));
+	});
+}
+
+static void AddCryptoCases(Benchmark::Suite &suite, const SyntheticWallet &wallet) {
+	uint512 seed = BIP39::DeriveSeed(__mnemonic, "");
+	HDSeed hdseed(seed.bytes());
+	HDKeychain root(hdseed.getExtendedKey(true));
+	HDKeychain account = root.getChild("44'/0'/0'");
+	HDKeychain external = account.getPublic().getChild(0);
+
+	suite.Add("HDKeychain/getChild/Hardened", [account]() {
+		Benchmark::Keep(account.getChild(0x80000000 | 7));
+	});
+
+	suite.Add("HDKeychain/getChild/Public", [external]() {
+		Benchmark::Keep(external.getChild(7));
+	});
+
+	Key key(account.getChild(0).getChild(0));
+	uint256 digest(sha256_2(bytes_t("microbench")));
+	bytes_t signature = key.Sign(digest);
+
+	suite.Add("Key/Sign", [key, digest]() {
+		Benchmark::Keep(key.Sign(digest));
+	});
+
+	suite.Add("Key/Verify", [key, digest, signature]() {
+		Benchmark::Keep(key.Verify(digest, signature));
+	});
+
+	bytes_t payload = wallet.GetAddresses()[0].ProgramHash().bytes();
+	std::string encoded = Base58::CheckEncode(payload);
+
+	suite.Add("Base58/CheckEncode", [payload]() {
+		Benchmark::Keep(Base58::CheckEncode(payload));
+	});
+
+	suite.Add("Base58/CheckDecode", [encoded]() {
+		bytes_t decoded;
+		Benchmark::Keep(Base58::CheckDecode(encoded, decoded));
+	});
+
+	std::string ciphertext = AES::EncryptCCM(bytes_t(seed.begin(), seed.size()), "microbench");
+	suite.Add("AES/DecryptCCM", [ciphertext]() {
+		Benchmark::Keep(AES::DecryptCCM(ciphertext, "microbench"));
+	});
+
+	BigInt a(std::string("1b1ae4d6e2ef500000")), b(uint64_t(175799086));
+	suite.Add("BigInt/Add", [a, b]() {
+		Benchmark::Keep(a + b);
+	});
+
+	suite.Add("BigInt/Multiply", [a, b]() {
+		Benchmark::Keep(a * b);
+	});
+
+	suite.Add("BigInt/Compare", [a, b]() {
+		Benchmark::Keep(b < a);
+	});
+}
+
+static void AddCoinSelectionCases(Benchmark::Suite &suite, const SyntheticWallet &wallet) {
+	// amounts repeat over a pool of outputs so the million utxo case stays within memory
+	std::mt19937 random(0);
+	OutputArray outputs;
+	for (size_t i = 0; i < 10000; ++i)
+		outputs.push_back(OutputPtr(new TransactionOutput(BigInt(uint64_t(10000 + random() % 100000000)),
+														  wallet.GetAddresses()[i % wallet.GetAddresses().size()])));
+
+	CoinSelector::Params params;
+	params.amount = uint64_t(2000000000);
+	params.feePerKB = 10000;
+	params.baseSize = 200;
+	params.inputSize = 140;
+	params.maxSize = 1000 * 1000;
+	params.changeCost = (200 * params.feePerKB + 999) / 1000;
+
+	std::vector<CoinSelectorPtr> selectors;
+	selectors.push_back(CoinSelectorPtr(new LargestFirstCoinSelector()));
+	selectors.push_back(CoinSelectorPtr(new BranchAndBoundCoinSelector()));
+	selectors.push_back(CoinSelectorPtr(new MinInputCoinSelector()));
+
+	const uint32_t scales[] = {1000, 10000, 100000, 1000000};
+	for (size_t s = 0; s < sizeof(scales) / sizeof(scales[0]); ++s) {
+		boost::shared_ptr<UTXOArray> candidates(new UTXOArray());
+		candidates->reserve(scales[s]);
+		for (uint32_t i = 0; i < scales[s]; ++i)
+			candidates->push_back(UTXOPtr(new UTXO(uint256(sha256_2(bytes_t(&i, sizeof(i)))), uint16_t(i), 0, 0,
+												   outputs[i % outputs.size()])));
+		std::sort(candidates->begin(), candidates->end(), UTXOAmountCompare());
+
+		for (size_t i = 0; i < selectors.size(); ++i) {
+			CoinSelectorPtr selector = selectors[i];
+			suite.Add("CoinSelector/" + selector->Name() + "/" + std::to_string(scales[s]),
+					  [selector, candidates, params]() {
+				CoinSelector::Result result;
+				Benchmark::Keep(selector->Select(*candidates, params, result));
+			});
+		}
+	}
+}
+
+static void AddDatabaseCases(Benchmark::Suite &suite, const SyntheticChain &chain,
+							 const DatabaseManagerPtr &database) {
+	TransactionPtr tx = chain.Tip()->walletTxns.front();
+	database->PutNormalTxn(tx);
+
+	uint64_t next = 0;
+	suite.Add("DatabaseManager/PutNormalTxn", [database, tx, next]() mutable {
+		TransactionPtr t(new Transaction(*tx));
+		uint256 hash;
+		next++;
+		memcpy(hash.begin(), &next, sizeof(next));
+		t->SetHash(hash);
+		Benchmark::Keep(database->PutNormalTxn(t));
+	});
+
+	// a tx from the wire to the database, under a new hash each time so every store is an insert
+	ByteStream stream;
+	tx->Serialize(stream);
+	bytes_t raw = stream.GetBytes();
+	suite.Add("Transaction/ParseHashStore", [database, raw, next]() mutable {
+		TransactionPtr t(new Transaction());
+		ByteStream s(raw);
+		t->Deserialize(s);
+		Benchmark::Keep(t->GetHash());
+
+		uint256 hash;
+		next++;
+		memcpy(hash.begin() + sizeof(next), &next, sizeof(next));
+		t->SetHash(hash);
+		Benchmark::Keep(database->PutNormalTxn(t));
+	});
+
+	uint256 hash = tx->GetHash();
+	suite.Add("DatabaseManager/GetNormalTxn", [database, hash]() {
+		Benchmark::Keep(database->GetNormalTxn(hash, CHAINID_MAINCHAIN));
+	});
+
+	std::vector<MerkleBlockPtr> headers(1, chain.Tip()->header);
+	suite.Add("DatabaseManager/PutMerkleBlocks", [database, headers]() {
+		Benchmark::Keep(database->PutMerkleBlocks(false, headers));
+	});
+
+	uint64_t utxo = 0;
+	suite.Add("DatabaseManager/UTXOUpdate", [database, utxo]() mutable {
+		std::vector<UTXOEntity> added(1, UTXOEntity(std::to_string(utxo++), 0));
+		Benchmark::Keep(database->UTXOUpdate(added, {}, false));
+	});
+}
+
+// Heap of a parsed payout tx, and what is left of it while a wallet utxo keeps one of its outputs
+static nlohmann::json MeasurePayoutOutputs(const SyntheticWallet &wallet, size_t outputCount) {
+	const std::vector<Address> &addresses = wallet.GetAddresses();
+	Transaction payout;
+	for (size_t i = 0; i < outputCount; ++i)
+		payout.AddOutput(OutputPtr(new TransactionOutput(BigInt(uint64_t(10000 + i)),
+														 addresses[i % addresses.size()])));
+
+	ByteStream stream;
+	payout.Serialize(stream);
+	bytes_t raw = stream.GetBytes();
+
+	{
+		// parsed once first so the address pool entries are not counted
+		Transaction warm;
+		ByteStream s(raw);
+		warm.Deserialize(s);
+	}
+
+	nlohmann::json j;
+	int64_t before = Benchmark::LiveBytes();
+	OutputPtr kept;
+	{
+		TransactionPtr tx(new Transaction());
+		ByteStream s(raw);
+		tx->Deserialize(s);
+		kept = tx->GetOutputs().front();
+		j["TxBytes"] = Benchmark::LiveBytes() - before;
+	}
+	j["Outputs"] = outputCount;
+	j["RetainedBytes"] = Benchmark::LiveBytes() - before;
+	return j;
+}
+
+int main(int argc, char *argv[]) {
+	std::string filter;
+	double minTime = 0.5;
+	size_t repeats = 5;
+
+	for (int i = 1; i < argc; i += 2) {
+		std::string name = argv[i];
+		if (i + 1 >= argc || (name != "--filter" && name != "--min-time" && name != "--repeats")) {
+			std::cerr << "usage: " << argv[0] << " [--filter substring] [--min-time seconds] [--repeats n]"
+					  << std::endl;
+			return 1;
+		}
+
+		if (name == "--filter") filter = argv[i + 1];
+		else if (name == "--min-time") minTime = std::strtod(argv[i + 1], nullptr);
+		else repeats = std::strtoul(argv[i + 1], nullptr, 10);
+	}
+
+	boost::filesystem::path dbPath = boost::filesystem::temp_directory_path() /
+									 boost::filesystem::unique_path("MicroBench-%%%%-%%%%.db");
+
+	Log::registerMultiLogger();
+	Log::setLevel(spdlog::level::warn);
+
+	int ret = 0;
+	try {
+		SyntheticChain::Options options;
+		options.blocks = 3;
+		options.txPerBlock = 100;
+		options.walletTxPerBlock = 4;
+		options.walletSpendPerBlock = 1;
+
+		SyntheticWallet wallet(__mnemonic);
+		SyntheticChain chain(options, &wallet);
+		chain.Generate();
+
+		DatabaseManagerPtr database(new DatabaseManager(dbPath));
+		Benchmark::Suite suite(minTime, repeats, filter);
+
+		AddTransactionCases(suite, chain);
+		AddMerkleBlockCases(suite, chain, wallet);
+		AddBloomFilterCases(suite);
+		AddCryptoCases(suite, wallet);
+		AddCoinSelectionCases(suite, wallet);
+		AddDatabaseCases(suite, chain, database);
+
+		nlohmann::json result;
+		result["MinTime"] = minTime;
+		result["Repeats"] = repeats;
+		result["Cases"] = suite.Run();
+		result["PayoutOutputs"] = MeasurePayoutOutputs(wallet, 1000);
+		std::cout << result.dump(4) << std::endl;
+	} catch (const std::exception &e) {
+		std::cerr << e.what() << std::endl;
+		ret = 1;
+	}
+
+	boost::filesystem::remove(dbPath);
+	return ret;
+}
@@ -0,0 +1,216 @@
+// Copyright (c) 2012-2019 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// Offline sync benchmark.
+//
+//   ReplayBench capture <file> [blocks]           sync mainnet from scratch and record what the peers sent
+//   ReplayBench replay <file> [blocks] [realtime]  feed the download peer of a capture back, at full speed unless
+//                                                  realtime is given, and print blocks/sec, allocations and db writes
+//
+// Merkle blocks are filtered by the bloom filter of the wallet that synced, so both modes use the same mnemonic and a
+// capture is only meaningful when replayed against the wallet that made it.
+
+#define BENCHMARK_CONFIG_MAIN
+
+#include "BenchmarkHelper.h"
+
+#include <Common/Log.h>
+#include <Implement/SubWallet.h>
+#include <SpvService/SpvService.h>
+#include <P2P/PeerCapture.h>
+#include <Plugin/Registry.h>
+
+#include <MasterWalletManager.h>
+#include <IMasterWallet.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/thread.hpp>
+
+#include <iostream>
+
+using namespace Elastos::ElaWallet;
+
+static const std::string __mnemonic = "abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon about";
+static const std::string __payPassword = "benchmark";
+
+class BenchMasterWalletManager : public MasterWalletManager {
+public:
+	BenchMasterWalletManager(const std::string &rootPath) :
+		MasterWalletManager(rootPath) {
+		// the benchmark decides when and how the peer manager gets its messages
+		_p2pEnable = false;
+	}
+};
+
+class SyncCounter : public PeerManager::Listener, public Wallet::Listener {
+public:
+	SyncCounter() : saveCalls(0), blocks(0), txAdded(0), txUpdated(0), stopped(false) {}
+
+	virtual void syncStarted() {}
+
+	virtual void syncProgress(uint32_t progress, time_t lastBlockTime, uint32_t bytesPerSecond, const std::string &downloadPeer) {}
+
+	virtual void syncStopped(const std::string &error) { stopped = true; }
+
+	virtual void txStatusUpdate() {}
+
+	virtual void saveBlocks(bool replace, const std::vector<MerkleBlockPtr> &blocks) {
+		saveCalls++;
+		this->blocks += blocks.size();
+	}
+
+	virtual void savePeers(bool replace, const std::vector<PeerInfo> &peers) {}
+
+	virtual void saveBlackPeer(const PeerInfo &peer) {}
+
+	virtual bool networkIsReachable() { return true; }
+
+	virtual void txPublished(const std::string &hash, const nlohmann::json &result) {}
+
+	virtual void connectStatusChanged(const std::string &status) {}
+
+	virtual void onBalanceChanged(const uint256 &asset, const BigInt &balance) {}
+
+	virtual void onTxAdded(const TransactionPtr &tx) { txAdded++; }
+
+	virtual void onTxUpdated(const std::vector<TransactionPtr> &txns) { txUpdated += txns.size(); }
+
+	virtual void onTxDeleted(const TransactionPtr &tx, bool notifyUser, bool recommendRescan) {}
+
+	virtual void onAssetRegistered(const AssetPtr &asset, uint64_t amount, const uint168 &controller) {}
+
+	// listeners run on the executor of SpvService, wait for it to catch up with the peer manager
+	void WaitIdle() const {
+		uint64_t last;
+		do {
+			last = blocks + txAdded + txUpdated;
+			boost::this_thread::sleep_for(boost::chrono::milliseconds(200));
+		} while (last != blocks + txAdded + txUpdated);
+	}
+
+	nlohmann::json ToJson() const {
+		nlohmann::json j;
+		j["SaveBlocksCalls"] = saveCalls.load();
+		j["BlocksWritten"] = blocks.load();
+		j["TxAdded"] = txAdded.load();
+		j["TxUpdated"] = txUpdated.load();
+		return j;
+	}
+
+public:
+	std::atomic<uint64_t> saveCalls, blocks, txAdded, txUpdated;
+	std::atomic<bool> stopped;
+};
+
+static SubWallet *OpenWallet(MasterWalletManager *manager, SyncCounter *counter) {
+	IMasterWallet *masterWallet = manager->ImportWalletWithMnemonic("ReplayBench", __mnemonic, "", __payPassword,
+																	 false);
+	SubWallet *subWallet = dynamic_cast<SubWallet *>(masterWallet->CreateSubWallet(CHAINID_MAINCHAIN));
+
+	subWallet->GetWalletManager()->RegisterPeerManagerListener(counter);
+	subWallet->GetWalletManager()->RegisterWalletListener(counter);
+	return subWallet;
+}
+
+static int Capture(const std::string &rootPath, const std::string &file, size_t maxBlocks) {
+	SyncCounter counter;
+	BenchMasterWalletManager manager(rootPath);
+	SubWallet *subWallet = OpenWallet(&manager, &counter);
+	const PeerManagerPtr &peerManager = subWallet->GetWalletManager()->GetPeerManager();
+
+	PeerCapturePtr capture(new PeerCapture());
+	if (!capture->Create(file, peerManager->GetMagicNumber())) {
+		std::cerr << "can not create " << file << std::endl;
+		return 1;
+	}
+
+	uint32_t startHeight = peerManager->GetLastBlockHeight();
+	Benchmark::Measure measure;
+
+	peerManager->SetCapture(capture);
+	subWallet->GetWalletManager()->SyncStart();
+
+	while (!counter.stopped && (maxBlocks == 0 || peerManager->GetLastBlockHeight() - startHeight < maxBlocks))
+		boost::this_thread::sleep_for(boost::chrono::seconds(1));
+
+	subWallet->GetWalletManager()->SyncStop();
+	peerManager->SetCapture(nullptr);
+	capture->Close();
+
+	nlohmann::json result = measure.ToJson();
+	result["Mode"] = "capture";
+	result["Blocks"] = peerManager->GetLastBlockHeight() - startHeight;
+	result["Frames"] = capture->FramesRecorded();
+	std::cout << result.dump(4) << std::endl;
+	return 0;
+}
+
+static int Replay(const std::string &rootPath, const std::string &file, size_t maxBlocks, bool realtime) {
+	SyncCounter counter;
+	BenchMasterWalletManager manager(rootPath);
+	SubWallet *subWallet = OpenWallet(&manager, &counter);
+	const PeerManagerPtr &peerManager = subWallet->GetWalletManager()->GetPeerManager();
+
+	PeerCapturePtr capture(new PeerCapture());
+	if (!capture->Open(file)) {
+		std::cerr << "can not open " << file << std::endl;
+		return 1;
+	}
+
+	uint32_t startHeight = peerManager->GetLastBlockHeight();
+	Benchmark::Measure measure;
+
+	int error = peerManager->Replay(capture, maxBlocks, realtime);
+	double seconds = measure.Elapsed();
+	uint32_t blocks = peerManager->GetLastBlockHeight() - startHeight;
+
+	nlohmann::json result = measure.ToJson();
+	counter.WaitIdle();
+	subWallet->GetWalletManager()->SyncStop();
+	capture->Close();
+
+	result["Mode"] = "replay";
+	result["Error"] = error;
+	result["Seconds"] = seconds;
+	result["Blocks"] = blocks;
+	result["BlocksPerSecond"] = seconds > 0 ? blocks / seconds : 0;
+	result["DatabaseWrites"] = counter.ToJson();
+	result["Network"] = peerManager->GetNetworkStats();
+	std::cout << result.dump(4) << std::endl;
+	return error == 0 ? 0 : 1;
+}
+
+int main(int argc, char *argv[]) {
+	if (argc < 3 || (std::string(argv[1]) != "capture" && std::string(argv[1]) != "replay")) {
+		std::cerr << "usage: " << argv[0] << " capture <file> [blocks]" << std::endl
+				  << "       " << argv[0] << " replay <file> [blocks] [realtime]" << std::endl;
+		return 1;
+	}
+
+	std::string mode = argv[1], file = argv[2];
+	size_t maxBlocks = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 0;
+	bool realtime = argc > 4 && std::string(argv[4]) == "realtime";
+
+	// every run starts from an empty wallet database
+	boost::filesystem::path rootPath = boost::filesystem::temp_directory_path() /
+									   boost::filesystem::unique_path("ReplayBench-%%%%-%%%%");
+	boost::filesystem::create_directories(rootPath);
+
+	Log::registerMultiLogger(rootPath.string());
+	Log::setLevel(spdlog::level::warn);
+
+	int ret;
+	try {
+		if (mode == "capture")
+			ret = Capture(rootPath.string(), file, maxBlocks);
+		else
+			ret = Replay(rootPath.string(), file, maxBlocks, realtime);
+	} catch (const std::exception &e) {
+		std::cerr << e.what() << std::endl;
+		ret = 1;
+	}
+
+	boost::filesystem::remove_all(rootPath);
+	return ret;
+}
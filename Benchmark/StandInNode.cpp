@@ -0,0 +1,437 @@
+// Copyright (c) 2012-2019 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "StandInNode.h"
+
+#include <Common/hash.h>
+#include <Common/Log.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <string.h>
+
+#define NODE_PROTOCOL_VERSION   70013
+#define NODE_SERVICES           5 // SERVICES_NODE_NETWORK | SERVICES_NODE_BLOOM
+#define NODE_HEADER_LENGTH      24
+#define NODE_MAX_MESSAGE_LENGTH 0x02000000
+#define NODE_MAX_GETBLOCKS      500
+
+#define NODE_INV_TX             1
+#define NODE_INV_BLOCK          2
+#define NODE_INV_FILTERED_BLOCK 3
+
+namespace Elastos {
+	namespace ElaWallet {
+
+		static double Now() {
+			return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
+
+		static bool ReadAll(int socket, void *buf, size_t len) {
+			uint8_t *p = (uint8_t *) buf;
+			while (len > 0) {
+				ssize_t n = recv(socket, p, len, 0);
+				if (n <= 0)
+					return false;
+				p += n;
+				len -= n;
+			}
+			return true;
+		}
+
+		static bool WriteAll(int socket, const void *buf, size_t len) {
+			const uint8_t *p = (const uint8_t *) buf;
+			while (len > 0) {
+				ssize_t n = send(socket, p, len, MSG_NOSIGNAL);
+				if (n <= 0)
+					return false;
+				p += n;
+				len -= n;
+			}
+			return true;
+		}
+
+		StandInNode::StandInNode(SyntheticChain *chain, uint32_t magicNumber) :
+			_chain(chain),
+			_magicNumber(magicNumber),
+			_listenSocket(-1),
+			_running(false),
+			_mempoolRequests(0) {
+		}
+
+		StandInNode::~StandInNode() {
+			Stop();
+		}
+
+		uint16_t StandInNode::Start(uint16_t port) {
+			struct sockaddr_in addr;
+			socklen_t addrLen = sizeof(addr);
+			int on = 1;
+
+			_listenSocket = socket(AF_INET, SOCK_STREAM, 0);
+			if (_listenSocket < 0)
+				return 0;
+
+			setsockopt(_listenSocket, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+			memset(&addr, 0, sizeof(addr));
+			addr.sin_family = AF_INET;
+			addr.sin_port = htons(port);
+			addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+			if (bind(_listenSocket, (struct sockaddr *) &addr, sizeof(addr)) != 0 ||
+				listen(_listenSocket, 8) != 0 ||
+				getsockname(_listenSocket, (struct sockaddr *) &addr, &addrLen) != 0) {
+				Log::error("stand-in node: can not listen on port {}: {}", port, strerror(errno));
+				close(_listenSocket);
+				_listenSocket = -1;
+				return 0;
+			}
+
+			_running = true;
+			_threads.create_thread(boost::bind(&StandInNode::AcceptThread, this));
+			return ntohs(addr.sin_port);
+		}
+
+		void StandInNode::Stop() {
+			if (!_running)
+				return;
+
+			_running = false;
+			shutdown(_listenSocket, SHUT_RDWR);
+			close(_listenSocket);
+			_listenSocket = -1;
+
+			{
+				boost::mutex::scoped_lock scopedLock(_lock);
+				for (std::set<ConnectionPtr>::iterator it = _connections.begin(); it != _connections.end(); ++it)
+					shutdown((*it)->socket, SHUT_RDWR);
+			}
+
+			_threads.join_all();
+		}
+
+		void StandInNode::Announce(const std::vector<SyntheticChain::BlockPtr> &blocks) {
+			std::vector<uint256> hashes;
+			std::vector<ConnectionPtr> connections;
+
+			for (size_t i = 0; i < blocks.size(); ++i)
+				hashes.push_back(blocks[i]->header->GetHash());
+
+			{
+				boost::mutex::scoped_lock scopedLock(_lock);
+				for (std::set<ConnectionPtr>::iterator it = _connections.begin(); it != _connections.end(); ++it)
+					if ((*it)->verack)
+						connections.push_back(*it);
+			}
+
+			for (size_t i = 0; i < connections.size(); ++i)
+				SendInventory(connections[i], NODE_INV_BLOCK, hashes);
+		}
+
+		size_t StandInNode::ConnectionCount() const {
+			boost::mutex::scoped_lock scopedLock(_lock);
+			return _connections.size();
+		}
+
+		size_t StandInNode::MempoolRequests() const {
+			boost::mutex::scoped_lock scopedLock(_lock);
+			return _mempoolRequests;
+		}
+
+		nlohmann::json StandInNode::GetStats() const {
+			boost::mutex::scoped_lock scopedLock(_lock);
+			nlohmann::json j;
+
+			for (std::map<std::string, MessageStats>::const_iterator it = _stats.begin(); it != _stats.end(); ++it) {
+				nlohmann::json s;
+				s["Count"] = it->second.count;
+				s["Bytes"] = it->second.bytes;
+				s["PeerLatency"] = it->second.peerLatency.ToJson();
+				s["ServiceTime"] = it->second.serviceTime.ToJson();
+				j[it->first] = s;
+			}
+
+			return j;
+		}
+
+		void StandInNode::AcceptThread() {
+			while (_running) {
+				int socket = accept(_listenSocket, nullptr, nullptr);
+				if (socket < 0)
+					break;
+
+				int on = 1;
+				setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+
+				ConnectionPtr conn(new Connection());
+				conn->socket = socket;
+				conn->verack = false;
+				conn->lastSend = 0;
+				// matches nothing until the peer loads its own filter
+				conn->filter = BloomFilterPtr(new BloomFilter(BLOOM_DEFAULT_FALSEPOSITIVE_RATE, 1, 0, BLOOM_UPDATE_ALL));
+
+				boost::mutex::scoped_lock scopedLock(_lock);
+				if (!_running) {
+					close(socket);
+					break;
+				}
+				_connections.insert(conn);
+				_threads.create_thread(boost::bind(&StandInNode::ConnectionThread, this, conn));
+			}
+		}
+
+		void StandInNode::ConnectionThread(const ConnectionPtr &conn) {
+			std::string type;
+			bytes_t payload;
+			bool ok = true;
+
+			while (ok && _running && ReadMessage(conn, type, payload)) {
+				double received = Now(), lastSend;
+				{
+					boost::mutex::scoped_lock sendLock(conn->sendLock);
+					lastSend = conn->lastSend;
+				}
+
+				if (type == "version") ok = OnVersion(conn, payload);
+				else if (type == "verack") conn->verack = true;
+				else if (type == "filterload") ok = OnFilterLoad(conn, payload);
+				else if (type == "getblocks") ok = OnGetBlocks(conn, payload);
+				else if (type == "getdata") ok = OnGetData(conn, payload);
+				else if (type == "mempool") ok = OnMempool(conn, payload);
+				else if (type == "ping") ok = OnPing(conn, payload);
+				// getaddr, pong, tx, notfound and the rest need no answer from a node with a fixed chain
+
+				boost::mutex::scoped_lock scopedLock(_lock);
+				MessageStats &stats = _stats[type];
+				stats.count++;
+				stats.bytes += NODE_HEADER_LENGTH + payload.size();
+				if (lastSend > 0)
+					stats.peerLatency.Add(received - lastSend);
+				stats.serviceTime.Add(Now() - received);
+			}
+
+			if (ok && _running)
+				Log::warn("stand-in node: peer disconnected");
+
+			boost::mutex::scoped_lock scopedLock(_lock);
+			close(conn->socket);
+			_connections.erase(conn);
+		}
+
+		bool StandInNode::ReadMessage(const ConnectionPtr &conn, std::string &type, bytes_t &payload) {
+			uint8_t header[NODE_HEADER_LENGTH];
+			if (!ReadAll(conn->socket, header, sizeof(header)))
+				return false;
+
+			ByteStream stream(header, sizeof(header));
+			uint32_t magic = 0, length = 0, checksum = 0;
+			char command[13] = {0};
+
+			stream.ReadUint32(magic);
+			stream.ReadBytes(command, 12);
+			stream.ReadUint32(length);
+			stream.ReadUint32(checksum);
+
+			if (magic != _magicNumber || length > NODE_MAX_MESSAGE_LENGTH) {
+				Log::error("stand-in node: bad message header, magic {:x} length {}", magic, length);
+				return false;
+			}
+
+			payload.resize(length);
+			if (length > 0 && !ReadAll(conn->socket, &payload[0], length))
+				return false;
+
+			uint32_t expected;
+			bytes_t hash = sha256_2(payload);
+			memcpy(&expected, hash.data(), sizeof(expected));
+			if (checksum != expected) {
+				Log::error("stand-in node: bad checksum of {}", command);
+				return false;
+			}
+
+			type = command;
+			return true;
+		}
+
+		bool StandInNode::SendMessage(const ConnectionPtr &conn, const std::string &type, const bytes_t &payload) {
+			ByteStream stream;
+			char command[12] = {0};
+			bytes_t hash = sha256_2(payload);
+
+			strncpy(command, type.c_str(), sizeof(command));
+			stream.WriteUint32(_magicNumber);
+			stream.WriteBytes(command, sizeof(command));
+			stream.WriteUint32((uint32_t) payload.size());
+			stream.WriteBytes(hash.data(), 4);
+			stream.WriteBytes(payload);
+
+			const bytes_t &msg = stream.GetBytes();
+			boost::mutex::scoped_lock sendLock(conn->sendLock);
+			if (!WriteAll(conn->socket, msg.data(), msg.size()))
+				return false;
+
+			conn->lastSend = Now();
+			return true;
+		}
+
+		bool StandInNode::OnVersion(const ConnectionPtr &conn, const bytes_t &payload) {
+			ByteStream stream;
+			stream.WriteUint32(NODE_PROTOCOL_VERSION);
+			stream.WriteUint64(NODE_SERVICES);
+			stream.WriteUint32((uint32_t) time(nullptr));
+			stream.WriteUint16(0);
+			stream.WriteUint64(((uint64_t) _chain->Height() << 32) | (uint64_t) conn->socket);
+			stream.WriteUint64(_chain->Height());
+			stream.WriteUint8(1);
+			stream.WriteVarString("/StandInNode/");
+
+			return SendMessage(conn, "version", stream.GetBytes()) && SendMessage(conn, "verack", bytes_t());
+		}
+
+		bool StandInNode::OnFilterLoad(const ConnectionPtr &conn, const bytes_t &payload) {
+			ByteStream stream(payload);
+			BloomFilterPtr filter(new BloomFilter(BLOOM_DEFAULT_FALSEPOSITIVE_RATE, 1, 0, BLOOM_UPDATE_ALL));
+
+			if (!filter->Deserialize(stream)) {
+				Log::error("stand-in node: malformed filterload");
+				return false;
+			}
+
+			conn->filter = filter;
+			return true;
+		}
+
+		bool StandInNode::OnGetBlocks(const ConnectionPtr &conn, const bytes_t &payload) {
+			ByteStream stream(payload);
+			std::vector<uint256> locators;
+			uint256 hashStop;
+			uint32_t count;
+
+			if (!stream.ReadUint32(count) || count > NODE_MAX_GETBLOCKS) {
+				Log::error("stand-in node: malformed getblocks");
+				return false;
+			}
+
+			locators.resize(count);
+			for (uint32_t i = 0; i < count; ++i) {
+				if (!stream.ReadBytes(locators[i])) {
+					Log::error("stand-in node: malformed getblocks");
+					return false;
+				}
+			}
+			stream.ReadBytes(hashStop);
+
+			std::vector<uint256> hashes;
+			uint32_t height = _chain->FindFork(locators);
+			while (hashes.size() < NODE_MAX_GETBLOCKS) {
+				SyntheticChain::BlockPtr block = _chain->GetBlock(++height);
+				if (block == nullptr)
+					break;
+
+				hashes.push_back(block->header->GetHash());
+				if (hashes.back() == hashStop)
+					break;
+			}
+
+			return hashes.empty() || SendInventory(conn, NODE_INV_BLOCK, hashes);
+		}
+
+		bool StandInNode::OnGetData(const ConnectionPtr &conn, const bytes_t &payload) {
+			ByteStream stream(payload), notFound;
+			uint32_t count, type, missing = 0;
+			uint256 hash;
+
+			if (!stream.ReadUint32(count)) {
+				Log::error("stand-in node: malformed getdata");
+				return false;
+			}
+
+			for (uint32_t i = 0; i < count; ++i) {
+				if (!stream.ReadUint32(type) || !stream.ReadBytes(hash)) {
+					Log::error("stand-in node: malformed getdata");
+					return false;
+				}
+
+				if (type == NODE_INV_BLOCK || type == NODE_INV_FILTERED_BLOCK) {
+					SyntheticChain::BlockPtr block = _chain->GetBlock(hash);
+					if (block != nullptr) {
+						std::vector<TransactionPtr> matched;
+						MerkleBlockPtr merkleBlock = SyntheticChain::FilterBlock(*block, *conn->filter, matched);
+
+						ByteStream msg;
+						merkleBlock->Serialize(msg, MERKLEBLOCK_VERSION_1);
+						if (!SendMessage(conn, "merkleblock", msg.GetBytes()))
+							return false;
+
+						for (size_t j = 0; j < matched.size(); ++j) {
+							ByteStream txMsg;
+							matched[j]->Serialize(txMsg);
+							if (!SendMessage(conn, "tx", txMsg.GetBytes()))
+								return false;
+						}
+						continue;
+					}
+				} else if (type == NODE_INV_TX) {
+					TransactionPtr tx = _chain->GetMempoolTx(hash);
+					if (tx != nullptr) {
+						ByteStream txMsg;
+						tx->Serialize(txMsg);
+						if (!SendMessage(conn, "tx", txMsg.GetBytes()))
+							return false;
+						continue;
+					}
+				}
+
+				notFound.WriteUint32(type);
+				notFound.WriteBytes(hash);
+				missing++;
+			}
+
+			if (missing == 0)
+				return true;
+
+			ByteStream msg;
+			msg.WriteUint32(missing);
+			msg.WriteBytes(notFound.GetBytes());
+			return SendMessage(conn, "notfound", msg.GetBytes());
+		}
+
+		bool StandInNode::OnMempool(const ConnectionPtr &conn, const bytes_t &payload) {
+			std::vector<TransactionPtr> txns = _chain->GetMempool();
+			std::vector<uint256> hashes;
+
+			{
+				boost::mutex::scoped_lock scopedLock(_lock);
+				_mempoolRequests++;
+			}
+
+			for (size_t i = 0; i < txns.size(); ++i)
+				if (SyntheticChain::FilterTransaction(txns[i], *conn->filter))
+					hashes.push_back(txns[i]->GetHash());
+
+			return hashes.empty() || SendInventory(conn, NODE_INV_TX, hashes);
+		}
+
+		bool StandInNode::OnPing(const ConnectionPtr &conn, const bytes_t &payload) {
+			ByteStream stream;
+			stream.WriteUint64(_chain->Height());
+			return SendMessage(conn, "pong", stream.GetBytes());
+		}
+
+		bool StandInNode::SendInventory(const ConnectionPtr &conn, uint32_t type, const std::vector<uint256> &hashes) {
+			ByteStream stream;
+			stream.WriteUint32((uint32_t) hashes.size());
+			for (size_t i = 0; i < hashes.size(); ++i) {
+				stream.WriteUint32(type);
+				stream.WriteBytes(hashes[i]);
+			}
+
+			return SendMessage(conn, "inv", stream.GetBytes());
+		}
+
+	}
+}
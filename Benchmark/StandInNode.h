@@ -0,0 +1,104 @@
+// Copyright (c) 2012-2019 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef __ELASTOS_SDK_STANDINNODE_H__
+#define __ELASTOS_SDK_STANDINNODE_H__
+
+#include "SyntheticChain.h"
+#include "BenchmarkHelper.h"
+
+#include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
+
+#include <map>
+#include <set>
+#include <string>
+
+namespace Elastos {
+	namespace ElaWallet {
+
+		// A local node that serves a SyntheticChain to spv peers over tcp. It answers version, getblocks, getdata
+		// (filtered blocks and mempool tx), filterload, mempool and ping the way an ELA full node does, and ignores
+		// everything else.
+		class StandInNode {
+		public:
+			StandInNode(SyntheticChain *chain, uint32_t magicNumber);
+
+			~StandInNode();
+
+			// listen on 127.0.0.1, port 0 picks a free one. returns the port, 0 on failure
+			uint16_t Start(uint16_t port = 0);
+
+			void Stop();
+
+			// inv blocks to every connected peer, for a new tip or the branch of a reorganization
+			void Announce(const std::vector<SyntheticChain::BlockPtr> &blocks);
+
+			size_t ConnectionCount() const;
+
+			size_t MempoolRequests() const;
+
+			// per inbound message type: count, bytes, how long the peer took to send it after our last message and
+			// how long we took to answer it
+			nlohmann::json GetStats() const;
+
+		private:
+			struct Connection {
+				int socket;
+				bool verack;
+				double lastSend;
+				BloomFilterPtr filter;
+				boost::mutex sendLock;
+			};
+
+			typedef boost::shared_ptr<Connection> ConnectionPtr;
+
+			struct MessageStats {
+				uint64_t count;
+				uint64_t bytes;
+				Benchmark::Samples peerLatency;
+				Benchmark::Samples serviceTime;
+
+				MessageStats() : count(0), bytes(0) {}
+			};
+
+			void AcceptThread();
+
+			void ConnectionThread(const ConnectionPtr &conn);
+
+			bool ReadMessage(const ConnectionPtr &conn, std::string &type, bytes_t &payload);
+
+			bool SendMessage(const ConnectionPtr &conn, const std::string &type, const bytes_t &payload);
+
+			bool OnVersion(const ConnectionPtr &conn, const bytes_t &payload);
+
+			bool OnFilterLoad(const ConnectionPtr &conn, const bytes_t &payload);
+
+			bool OnGetBlocks(const ConnectionPtr &conn, const bytes_t &payload);
+
+			bool OnGetData(const ConnectionPtr &conn, const bytes_t &payload);
+
+			bool OnMempool(const ConnectionPtr &conn, const bytes_t &payload);
+
+			bool OnPing(const ConnectionPtr &conn, const bytes_t &payload);
+
+			bool SendInventory(const ConnectionPtr &conn, uint32_t type, const std::vector<uint256> &hashes);
+
+		private:
+			SyntheticChain *_chain;
+			uint32_t _magicNumber;
+			int _listenSocket;
+			volatile bool _running;
+			size_t _mempoolRequests;
+
+			mutable boost::mutex _lock;
+			boost::thread_group _threads;
+			std::set<ConnectionPtr> _connections;
+			std::map<std::string, MessageStats> _stats;
+		};
+
+	}
+}
+
+#endif //__ELASTOS_SDK_STANDINNODE_H__
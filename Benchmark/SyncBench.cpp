@@ -0,0 +1,254 @@
+// Copyright (c) 2012-2019 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// End-to-end sync benchmark against a StandInNode on localhost.
+//
+//   SyncBench [--blocks n] [--tx-per-block n] [--wallet-tx-per-block n] [--wallet-spend-per-block n] [--mempool n]
+//             [--reorgs n] [--reorg-depth n] [--seed n] [--timeout seconds]
+//
+// A synthetic chain is mined for the wallet of the benchmark mnemonic, a full SpvService sync runs against it, then
+// every reorg mines a longer branch below the tip and announces it. Prints blocks/sec, tx/sec, allocations, the
+// latency percentiles the node saw per message type and the network stats of the peer manager as json.
+
+#define BENCHMARK_CONFIG_MAIN
+
+#include "BenchmarkHelper.h"
+#include "StandInNode.h"
+#include "SyntheticChain.h"
+#include "SyntheticWallet.h"
+
+#include <Common/Log.h>
+#include <Implement/SubWallet.h>
+#include <SpvService/SpvService.h>
+#include <Plugin/Registry.h>
+
+#include <MasterWalletManager.h>
+#include <IMasterWallet.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/thread.hpp>
+
+#include <iostream>
+
+using namespace Elastos::ElaWallet;
+
+static const std::string __mnemonic = "abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon about";
+static const std::string __payPassword = "benchmark";
+
+class BenchMasterWalletManager : public MasterWalletManager {
+public:
+	BenchMasterWalletManager(const std::string &rootPath, const nlohmann::json &config) :
+		MasterWalletManager(rootPath, "PrvNet", config) {
+		// the benchmark starts the sync once the chain is mined for the wallet
+		_p2pEnable = false;
+	}
+};
+
+class SyncCounter : public PeerManager::Listener, public Wallet::Listener {
+public:
+	SyncCounter() : blocks(0), txAdded(0), txUpdated(0), txDeleted(0), stopped(false) {}
+
+	virtual void syncStarted() {}
+
+	virtual void syncProgress(uint32_t progress, time_t lastBlockTime, uint32_t bytesPerSecond, const std::string &downloadPeer) {}
+
+	virtual void syncStopped(const std::string &error) {
+		this->error = error;
+		stopped = true;
+	}
+
+	virtual void txStatusUpdate() {}
+
+	virtual void saveBlocks(bool replace, const std::vector<MerkleBlockPtr> &blocks) { this->blocks += blocks.size(); }
+
+	virtual void savePeers(bool replace, const std::vector<PeerInfo> &peers) {}
+
+	virtual void saveBlackPeer(const PeerInfo &peer) {}
+
+	virtual bool networkIsReachable() { return true; }
+
+	virtual void txPublished(const std::string &hash, const nlohmann::json &result) {}
+
+	virtual void connectStatusChanged(const std::string &status) {}
+
+	virtual void onBalanceChanged(const uint256 &asset, const BigInt &balance) {}
+
+	virtual void onTxAdded(const TransactionPtr &tx) { txAdded++; }
+
+	virtual void onTxUpdated(const std::vector<TransactionPtr> &txns) { txUpdated += txns.size(); }
+
+	virtual void onTxDeleted(const TransactionPtr &tx, bool notifyUser, bool recommendRescan) { txDeleted++; }
+
+	virtual void onAssetRegistered(const AssetPtr &asset, uint64_t amount, const uint168 &controller) {}
+
+	// listeners run on the executor of SpvService, wait for it to catch up with the peer manager
+	void WaitIdle() const {
+		uint64_t last;
+		do {
+			last = blocks + txAdded + txUpdated + txDeleted;
+			boost::this_thread::sleep_for(boost::chrono::milliseconds(200));
+		} while (last != blocks + txAdded + txUpdated + txDeleted);
+	}
+
+	nlohmann::json ToJson() const {
+		nlohmann::json j;
+		j["BlocksWritten"] = blocks.load();
+		j["TxAdded"] = txAdded.load();
+		j["TxUpdated"] = txUpdated.load();
+		j["TxDeleted"] = txDeleted.load();
+		return j;
+	}
+
+public:
+	std::atomic<uint64_t> blocks, txAdded, txUpdated, txDeleted;
+	std::atomic<bool> stopped;
+	std::string error;
+};
+
+struct BenchOptions {
+	SyntheticChain::Options chain;
+	uint32_t reorgs;
+	uint32_t reorgDepth;
+	uint32_t timeout;
+
+	BenchOptions() : reorgs(1), reorgDepth(6), timeout(600) {}
+};
+
+static bool WaitHeight(const PeerManagerPtr &peerManager, uint32_t height, const Benchmark::Measure &measure,
+					   uint32_t timeout) {
+	while (peerManager->GetLastBlockHeight() < height) {
+		if (measure.Elapsed() > timeout)
+			return false;
+		boost::this_thread::sleep_for(boost::chrono::milliseconds(10));
+	}
+	return true;
+}
+
+static int Run(const std::string &rootPath, const BenchOptions &options) {
+	Benchmark::Measure total;
+
+	Benchmark::Timer mineTimer;
+	SyntheticWallet wallet(__mnemonic);
+	SyntheticChain chain(options.chain, &wallet);
+	chain.Generate();
+	double mineSeconds = mineTimer.Elapsed();
+
+	uint32_t magicNumber = 0x5e1f0000 + options.chain.seed;
+	StandInNode node(&chain, magicNumber);
+	uint16_t port = node.Start();
+	if (port == 0) {
+		std::cerr << "can not start the stand-in node" << std::endl;
+		return 1;
+	}
+
+	nlohmann::json config;
+	config["ELA"]["ChainParameters"]["MagicNumber"] = magicNumber;
+	config["ELA"]["ChainParameters"]["StandardPort"] = port;
+	config["ELA"]["ChainParameters"]["DNSSeeds"] = nlohmann::json::array({"127.0.0.1"});
+	config["ELA"]["ChainParameters"]["CheckPoints"] = nlohmann::json::array({chain.Checkpoint()});
+
+	SyncCounter counter;
+	BenchMasterWalletManager manager(rootPath, config);
+	IMasterWallet *masterWallet = manager.ImportWalletWithMnemonic("SyncBench", __mnemonic, "", __payPassword, false);
+	SubWallet *subWallet = dynamic_cast<SubWallet *>(masterWallet->CreateSubWallet(CHAINID_MAINCHAIN));
+	const PeerManagerPtr &peerManager = subWallet->GetWalletManager()->GetPeerManager();
+
+	subWallet->GetWalletManager()->RegisterPeerManagerListener(&counter);
+	subWallet->GetWalletManager()->RegisterWalletListener(&counter);
+	subWallet->SetFixedPeer("127.0.0.1", port);
+
+	Benchmark::Measure sync;
+	subWallet->GetWalletManager()->SyncStart();
+	bool synced = WaitHeight(peerManager, chain.Height(), sync, options.timeout);
+	double syncSeconds = sync.Elapsed();
+	nlohmann::json syncResult = sync.ToJson();
+
+	Benchmark::Samples reorgLatency;
+	for (uint32_t i = 0; synced && i < options.reorgs; ++i) {
+		Benchmark::Timer reorg;
+		node.Announce(chain.Reorganize(options.reorgDepth));
+		synced = WaitHeight(peerManager, chain.Height(), sync, options.timeout);
+		reorgLatency.Add(reorg.Elapsed());
+	}
+
+	counter.WaitIdle();
+	subWallet->GetWalletManager()->SyncStop();
+	node.Stop();
+
+	uint32_t blocks = options.chain.blocks;
+	size_t txns = (size_t) blocks * options.chain.txPerBlock;
+	nlohmann::json result = total.ToJson();
+	result["Synced"] = synced;
+	result["Error"] = counter.error;
+	result["Options"] = {{"Blocks",              blocks},
+						 {"TxPerBlock",          options.chain.txPerBlock},
+						 {"WalletTxPerBlock",    options.chain.walletTxPerBlock},
+						 {"WalletSpendPerBlock", options.chain.walletSpendPerBlock},
+						 {"Mempool",             options.chain.mempoolTxs},
+						 {"Reorgs",              options.reorgs},
+						 {"ReorgDepth",          options.reorgDepth},
+						 {"Seed",                options.chain.seed}};
+	result["MineSeconds"] = mineSeconds;
+	result["Sync"] = syncResult;
+	result["Sync"]["Seconds"] = syncSeconds;
+	result["Sync"]["BlocksPerSecond"] = syncSeconds > 0 ? blocks / syncSeconds : 0;
+	result["Sync"]["TxPerSecond"] = syncSeconds > 0 ? txns / syncSeconds : 0;
+	result["Reorganize"] = reorgLatency.ToJson();
+	result["MempoolRequests"] = node.MempoolRequests();
+	result["DatabaseWrites"] = counter.ToJson();
+	result["Node"] = node.GetStats();
+	result["Network"] = peerManager->GetNetworkStats();
+	std::cout << result.dump(4) << std::endl;
+	return synced ? 0 : 1;
+}
+
+static bool ParseOptions(int argc, char *argv[], BenchOptions &options) {
+	for (int i = 1; i < argc; i += 2) {
+		if (i + 1 >= argc)
+			return false;
+
+		std::string name = argv[i];
+		uint32_t value = (uint32_t) std::strtoul(argv[i + 1], nullptr, 10);
+		if (name == "--blocks") options.chain.blocks = value;
+		else if (name == "--tx-per-block") options.chain.txPerBlock = value;
+		else if (name == "--wallet-tx-per-block") options.chain.walletTxPerBlock = value;
+		else if (name == "--wallet-spend-per-block") options.chain.walletSpendPerBlock = value;
+		else if (name == "--mempool") options.chain.mempoolTxs = value;
+		else if (name == "--reorgs") options.reorgs = value;
+		else if (name == "--reorg-depth") options.reorgDepth = value;
+		else if (name == "--seed") options.chain.seed = value;
+		else if (name == "--timeout") options.timeout = value;
+		else return false;
+	}
+	return true;
+}
+
+int main(int argc, char *argv[]) {
+	BenchOptions options;
+	if (!ParseOptions(argc, argv, options)) {
+		std::cerr << "usage: " << argv[0] << " [--blocks n] [--tx-per-block n] [--wallet-tx-per-block n]" << std::endl
+				  << "       [--wallet-spend-per-block n] [--mempool n] [--reorgs n] [--reorg-depth n] [--seed n]"
+				  << std::endl << "       [--timeout seconds]" << std::endl;
+		return 1;
+	}
+
+	// every run starts from an empty wallet database
+	boost::filesystem::path rootPath = boost::filesystem::temp_directory_path() /
+									   boost::filesystem::unique_path("SyncBench-%%%%-%%%%");
+	boost::filesystem::create_directories(rootPath);
+
+	Log::registerMultiLogger(rootPath.string());
+	Log::setLevel(spdlog::level::warn);
+
+	int ret;
+	try {
+		ret = Run(rootPath.string(), options);
+	} catch (const std::exception &e) {
+		std::cerr << e.what() << std::endl;
+		ret = 1;
+	}
+
+	boost::filesystem::remove_all(rootPath);
+	return ret;
+}
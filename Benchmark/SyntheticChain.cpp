@@ -0,0 +1,481 @@
+// Copyright (c) 2012-2019 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "SyntheticChain.h"
+
+#include <Common/hash.h>
+#include <Common/ErrorChecker.h>
+#include <Plugin/Transaction/Attribute.h>
+#include <Plugin/Transaction/Program.h>
+#include <Plugin/Transaction/TransactionInput.h>
+#include <Plugin/Transaction/TransactionOutput.h>
+#include <Plugin/Transaction/Payload/CoinBase.h>
+#include <Plugin/Transaction/Payload/TransferAsset.h>
+
+#include <string.h>
+
+namespace Elastos {
+	namespace ElaWallet {
+
+		static size_t TreeWidth(size_t txCount, int height) {
+			return (txCount + (1 << height) - 1) >> height;
+		}
+
+		static uint256 TreeHash(const std::vector<uint256> &txHashes, int height, size_t pos) {
+			if (height == 0)
+				return txHashes[pos];
+
+			uint256 left = TreeHash(txHashes, height - 1, pos * 2), right = left;
+			if (pos * 2 + 1 < TreeWidth(txHashes.size(), height - 1))
+				right = TreeHash(txHashes, height - 1, pos * 2 + 1);
+
+			bytes_t data(left.begin(), left.size());
+			data += bytes_t(right.begin(), right.size());
+			return uint256(sha256_2(data));
+		}
+
+		static int TreeHeight(size_t txCount) {
+			int height = 0;
+			while (TreeWidth(txCount, height) > 1)
+				height++;
+			return height;
+		}
+
+		// partial merkle tree as in BIP37, the layout MerkleBlockBase::MerkleBlockRootR() walks
+		static void TreeBuild(const std::vector<uint256> &txHashes, const std::vector<bool> &matches, int height,
+							  size_t pos, std::vector<bool> &bits, std::vector<uint256> &hashes) {
+			bool parentOfMatch = false;
+			for (size_t p = pos << height; p < ((pos + 1) << height) && p < txHashes.size(); p++)
+				parentOfMatch = parentOfMatch || matches[p];
+
+			bits.push_back(parentOfMatch);
+			if (height == 0 || !parentOfMatch) {
+				hashes.push_back(TreeHash(txHashes, height, pos));
+			} else {
+				TreeBuild(txHashes, matches, height - 1, pos * 2, bits, hashes);
+				if (pos * 2 + 1 < TreeWidth(txHashes.size(), height - 1))
+					TreeBuild(txHashes, matches, height - 1, pos * 2 + 1, bits, hashes);
+			}
+		}
+
+		SyntheticChain::Options::Options() :
+			blocks(2000),
+			txPerBlock(20),
+			walletTxPerBlock(1),
+			walletSpendPerBlock(0),
+			mempoolTxs(1),
+			seed(0),
+			keepTransactions(true) {
+		}
+
+		SyntheticChain::SyntheticChain(const Options &options, const SyntheticWallet *wallet) :
+			_options(options),
+			_wallet(wallet),
+			_random(options.seed),
+			_externalIndex(0),
+			_internalIndex(0),
+			_txCount(0),
+			_walletTxCount(0) {
+			ErrorChecker::CheckParam(options.txPerBlock == 0, Error::InvalidArgument, "txPerBlock should not be 0");
+			ErrorChecker::CheckParam(options.walletTxPerBlock + options.walletSpendPerBlock >= options.txPerBlock,
+									 Error::InvalidArgument, "wallet txns should leave room for the coinbase");
+
+			boost::mutex::scoped_lock scopedLock(_lock);
+			_best.push_back(MineInternal(nullptr, std::vector<TransactionPtr>(1, CreateCoinbase(0))));
+		}
+
+		const SyntheticChain::Options &SyntheticChain::GetOptions() const {
+			return _options;
+		}
+
+		nlohmann::json SyntheticChain::Checkpoint() const {
+			const MerkleBlockPtr &header = Genesis()->header;
+			nlohmann::json j = nlohmann::json::array();
+
+			j.push_back(header->GetHeight());
+			j.push_back(header->GetHash().GetHex());
+			j.push_back(header->GetTimestamp());
+			j.push_back(header->GetTarget());
+			return j;
+		}
+
+		void SyntheticChain::Generate(const BlockHandler &handler) {
+			for (uint32_t i = 0; i < _options.blocks; ++i) {
+				BlockPtr block = Mine(Tip());
+				if (handler)
+					handler(block);
+
+				if (!_options.keepTransactions) {
+					boost::mutex::scoped_lock scopedLock(_lock);
+					block->txns.clear();
+					block->walletTxns.clear();
+				}
+			}
+
+			boost::mutex::scoped_lock scopedLock(_lock);
+			for (uint32_t i = 0; i < _options.mempoolTxs && _wallet != nullptr; ++i) {
+				TransactionPtr tx = CreateTransfer(NextWalletAddress(false));
+				_mempool[tx->GetHash()] = tx;
+			}
+		}
+
+		SyntheticChain::BlockPtr SyntheticChain::Mine(const BlockPtr &prev) {
+			boost::mutex::scoped_lock scopedLock(_lock);
+			std::vector<TransactionPtr> walletTxns;
+			bool onTip = prev == _best.back();
+			BlockPtr block = MineInternal(prev, CreateTransactions(prev->header->GetHeight() + 1, onTip, walletTxns));
+			block->walletTxns = walletTxns;
+			_walletTxCount += walletTxns.size();
+
+			if (block->header->GetHeight() > _best.back()->header->GetHeight()) {
+				// walk back to the best chain, then replace everything above the fork
+				std::vector<BlockPtr> branch;
+				BlockPtr b = block;
+				while (b->header->GetHeight() >= _best.size() ||
+					   _best[b->header->GetHeight()]->header->GetHash() != b->header->GetHash()) {
+					branch.push_back(b);
+					b = _blocks[b->header->GetPrevBlockHash()];
+				}
+
+				_best.resize(b->header->GetHeight() + 1);
+				_best.insert(_best.end(), branch.rbegin(), branch.rend());
+			}
+
+			return block;
+		}
+
+		std::vector<SyntheticChain::BlockPtr> SyntheticChain::Reorganize(uint32_t depth) {
+			uint32_t height = Height();
+			ErrorChecker::CheckParam(depth == 0 || depth > height, Error::InvalidArgument, "invalid reorganize depth");
+
+			std::vector<BlockPtr> branch;
+			BlockPtr prev = GetBlock(height - depth);
+			for (uint32_t i = 0; i <= depth; ++i) {
+				prev = Mine(prev);
+				branch.push_back(prev);
+			}
+
+			return branch;
+		}
+
+		SyntheticChain::BlockPtr SyntheticChain::Genesis() const {
+			boost::mutex::scoped_lock scopedLock(_lock);
+			return _best.front();
+		}
+
+		SyntheticChain::BlockPtr SyntheticChain::Tip() const {
+			boost::mutex::scoped_lock scopedLock(_lock);
+			return _best.back();
+		}
+
+		uint32_t SyntheticChain::Height() const {
+			boost::mutex::scoped_lock scopedLock(_lock);
+			return _best.back()->header->GetHeight();
+		}
+
+		SyntheticChain::BlockPtr SyntheticChain::GetBlock(uint32_t height) const {
+			boost::mutex::scoped_lock scopedLock(_lock);
+			return height < _best.size() ? _best[height] : nullptr;
+		}
+
+		SyntheticChain::BlockPtr SyntheticChain::GetBlock(const uint256 &hash) const {
+			boost::mutex::scoped_lock scopedLock(_lock);
+			std::map<uint256, BlockPtr>::const_iterator it = _blocks.find(hash);
+			return it != _blocks.end() ? it->second : nullptr;
+		}
+
+		uint32_t SyntheticChain::FindFork(const std::vector<uint256> &locators) const {
+			boost::mutex::scoped_lock scopedLock(_lock);
+			for (size_t i = 0; i < locators.size(); ++i) {
+				std::map<uint256, BlockPtr>::const_iterator it = _blocks.find(locators[i]);
+				if (it == _blocks.end())
+					continue;
+
+				uint32_t height = it->second->header->GetHeight();
+				if (height < _best.size() && _best[height] == it->second)
+					return height;
+			}
+
+			return 0;
+		}
+
+		std::vector<TransactionPtr> SyntheticChain::GetMempool() const {
+			boost::mutex::scoped_lock scopedLock(_lock);
+			std::vector<TransactionPtr> txns;
+			for (std::map<uint256, TransactionPtr>::const_iterator it = _mempool.begin(); it != _mempool.end(); ++it)
+				txns.push_back(it->second);
+			return txns;
+		}
+
+		TransactionPtr SyntheticChain::GetMempoolTx(const uint256 &hash) const {
+			boost::mutex::scoped_lock scopedLock(_lock);
+			std::map<uint256, TransactionPtr>::const_iterator it = _mempool.find(hash);
+			return it != _mempool.end() ? it->second : nullptr;
+		}
+
+		size_t SyntheticChain::TransactionCount() const {
+			boost::mutex::scoped_lock scopedLock(_lock);
+			return _txCount;
+		}
+
+		size_t SyntheticChain::WalletTransactionCount() const {
+			boost::mutex::scoped_lock scopedLock(_lock);
+			return _walletTxCount;
+		}
+
+		size_t SyntheticChain::WalletUTXOCount() const {
+			boost::mutex::scoped_lock scopedLock(_lock);
+			return _walletUTXOs.size();
+		}
+
+		bool SyntheticChain::StoreBlocks(DatabaseManager &database, const std::vector<BlockPtr> &blocks) {
+			std::vector<MerkleBlockPtr> headers;
+			std::vector<TransactionPtr> txns;
+
+			headers.reserve(blocks.size());
+			for (size_t i = 0; i < blocks.size(); ++i) {
+				headers.push_back(blocks[i]->header);
+				txns.insert(txns.end(), blocks[i]->walletTxns.begin(), blocks[i]->walletTxns.end());
+			}
+
+			return database.PutMerkleBlocks(false, headers) && (txns.empty() || database.PutNormalTxns(txns));
+		}
+
+		bool SyntheticChain::StoreWallet(DatabaseManager &database) const {
+			boost::mutex::scoped_lock scopedLock(_lock);
+			std::vector<UTXOEntity> utxos;
+			std::vector<TransactionPtr> pending;
+
+			utxos.reserve(_walletUTXOs.size());
+			for (std::set<std::pair<uint256, uint16_t> >::const_iterator it = _walletUTXOs.begin();
+				 it != _walletUTXOs.end(); ++it)
+				utxos.push_back(UTXOEntity(it->first.GetHex(), it->second));
+
+			for (std::map<uint256, TransactionPtr>::const_iterator it = _mempool.begin(); it != _mempool.end(); ++it)
+				pending.push_back(it->second);
+
+			std::vector<std::string> usedAddresses(_usedAddresses.begin(), _usedAddresses.end());
+			return database.UTXOUpdate(utxos, {}, true) &&
+				   database.PutUsedAddresses(usedAddresses, true) &&
+				   (pending.empty() || database.PutPendingTxns(pending));
+		}
+
+		MerkleBlockPtr SyntheticChain::FilterBlock(const Block &block, BloomFilter &filter,
+												   std::vector<TransactionPtr> &matched) {
+			std::vector<uint256> txHashes;
+			std::vector<bool> matches, bits;
+			std::vector<uint256> hashes;
+
+			for (size_t i = 0; i < block.txns.size(); ++i) {
+				txHashes.push_back(block.txns[i]->GetHash());
+				matches.push_back(FilterTransaction(block.txns[i], filter));
+				if (matches.back())
+					matched.push_back(block.txns[i]);
+			}
+
+			TreeBuild(txHashes, matches, TreeHeight(txHashes.size()), 0, bits, hashes);
+
+			bytes_t flags((bits.size() + 7) / 8, 0);
+			for (size_t i = 0; i < bits.size(); ++i)
+				flags[i / 8] |= bits[i] << (i % 8);
+
+			MerkleBlock *merkleBlock = new MerkleBlock(*static_cast<const MerkleBlock *>(block.header.get()));
+			merkleBlock->SetTransactionCount((uint32_t) txHashes.size());
+			merkleBlock->SetHashes(hashes);
+			merkleBlock->SetFlags(flags);
+			return MerkleBlockPtr(merkleBlock);
+		}
+
+		bool SyntheticChain::FilterTransaction(const TransactionPtr &tx, BloomFilter &filter) {
+			bool match = filter.ContainsData(tx->GetHash().bytes());
+
+			// same element encoding as PeerManager::LoadBloomFilter()
+			const std::vector<OutputPtr> &outputs = tx->GetOutputs();
+			for (size_t i = 0; i < outputs.size(); ++i) {
+				if (filter.ContainsData(outputs[i]->Addr()->ProgramHash().bytes())) {
+					bytes_t outpoint = tx->GetHash().bytes();
+					outpoint.append((uint16_t) i);
+					filter.InsertData(outpoint);
+					match = true;
+				}
+			}
+
+			const std::vector<InputPtr> &inputs = tx->GetInputs();
+			for (size_t i = 0; i < inputs.size() && !match; ++i) {
+				bytes_t outpoint = inputs[i]->TxHash().bytes();
+				outpoint.append(inputs[i]->Index());
+				match = filter.ContainsData(outpoint);
+			}
+
+			return match;
+		}
+
+		SyntheticChain::BlockPtr SyntheticChain::MineInternal(const BlockPtr &prev,
+															   const std::vector<TransactionPtr> &txns) {
+			std::vector<uint256> txHashes;
+			for (size_t i = 0; i < txns.size(); ++i)
+				txHashes.push_back(txns[i]->GetHash());
+
+			uint32_t height = prev ? prev->header->GetHeight() + 1 : 0;
+			uint32_t timestamp = prev ? prev->header->GetTimestamp() + SYNTHETIC_CHAIN_BLOCK_SPACING :
+								 (uint32_t) time(nullptr) - (_options.blocks + 1) * SYNTHETIC_CHAIN_BLOCK_SPACING;
+
+			MerkleBlock *header = new MerkleBlock();
+			header->SetHeight(height);
+			header->SetPrevBlockHash(prev ? prev->header->GetHash() : uint256());
+			header->SetRootBlockHash(TreeHash(txHashes, TreeHeight(txHashes.size()), 0));
+			header->SetTimestamp(timestamp);
+			header->SetTarget(SYNTHETIC_CHAIN_TARGET);
+			header->SetNonce(height);
+
+			// the parent block commits to the block hash, so two blocks never share an aux pow
+			const uint256 &hash = header->GetHash();
+			BRMerkleBlock *parent = header->GetAuxPow().GetParBlockHeader();
+			memcpy(parent->merkleRoot.u8, hash.begin(), sizeof(parent->merkleRoot.u8));
+			parent->timestamp = timestamp;
+			parent->target = SYNTHETIC_CHAIN_TARGET;
+			parent->nonce = 0;
+
+			while (!header->IsValid(timestamp))
+				parent->nonce++;
+
+			BlockPtr block(new Block());
+			block->header = MerkleBlockPtr(header);
+			block->txns = txns;
+
+			for (size_t i = 0; i < txns.size(); ++i) {
+				txns[i]->SetBlockHeight(height);
+				txns[i]->SetTimestamp(timestamp);
+			}
+
+			_blocks[hash] = block;
+			_txCount += txns.size();
+			return block;
+		}
+
+		TransactionPtr SyntheticChain::CreateCoinbase(uint32_t height) {
+			bytes_t data;
+			data.append(height);
+			TransactionPtr tx(new Transaction(Transaction::coinBase, PayloadPtr(new CoinBase(data))));
+
+			tx->AddInput(InputPtr(new TransactionInput(uint256(), 0xFFFF)));
+			tx->AddOutput(OutputPtr(new TransactionOutput(BigInt(175799086), RandomAddress())));
+			tx->AddAttribute(AttributePtr(new Attribute(Attribute::Nonce, RandomHash().bytes())));
+			return tx;
+		}
+
+		TransactionPtr SyntheticChain::CreateTransfer(const Address &to) {
+			TransactionPtr tx(new Transaction(Transaction::transferAsset, PayloadPtr(new TransferAsset())));
+
+			tx->AddInput(InputPtr(new TransactionInput(RandomHash(), (uint16_t) (_random() % 4))));
+			tx->AddOutput(OutputPtr(new TransactionOutput(BigInt(100000 + _random() % 100000000), to)));
+			tx->AddOutput(OutputPtr(new TransactionOutput(BigInt(100000 + _random() % 100000000), RandomAddress())));
+			tx->AddAttribute(AttributePtr(new Attribute(Attribute::Nonce, RandomHash().bytes())));
+			return tx;
+		}
+
+		TransactionPtr SyntheticChain::CreateSpend(std::vector<Coin> &created) {
+			// coins too small to pay the fee and leave change stay unspent
+			while (!_spendable.empty()) {
+				size_t pick = _random() % _spendable.size();
+				Coin coin = _spendable[pick];
+				_spendable[pick] = _spendable.back();
+				_spendable.pop_back();
+
+				if (coin.amount < 4 * SYNTHETIC_CHAIN_FEE)
+					continue;
+
+				bytes_t code;
+				std::string path;
+				_wallet->GetCodeAndPath(coin.address, code, path);
+
+				uint64_t pay = coin.amount / 2;
+				TransactionPtr tx(new Transaction(Transaction::transferAsset, PayloadPtr(new TransferAsset())));
+				tx->AddInput(InputPtr(new TransactionInput(coin.hash, coin.index)));
+				tx->AddOutput(OutputPtr(new TransactionOutput(BigInt(pay), RandomAddress())));
+				tx->AddOutput(OutputPtr(new TransactionOutput(BigInt(coin.amount - pay - SYNTHETIC_CHAIN_FEE),
+															  NextWalletAddress(true))));
+				tx->AddAttribute(AttributePtr(new Attribute(Attribute::Nonce, RandomHash().bytes())));
+				tx->AddUniqueProgram(ProgramPtr(new Program(path, code, bytes_t())));
+				_wallet->Sign(tx);
+
+				_walletUTXOs.erase(std::make_pair(coin.hash, coin.index));
+				AddCoins(tx, created);
+				return tx;
+			}
+
+			return nullptr;
+		}
+
+		std::vector<TransactionPtr> SyntheticChain::CreateTransactions(uint32_t height, bool spend,
+																	   std::vector<TransactionPtr> &walletTxns) {
+			std::vector<TransactionPtr> txns;
+			std::vector<Coin> created;
+			txns.push_back(CreateCoinbase(height));
+
+			for (uint32_t i = 0; _wallet != nullptr && spend && i < _options.walletSpendPerBlock; ++i) {
+				TransactionPtr tx = CreateSpend(created);
+				if (tx == nullptr)
+					break;
+				txns.push_back(tx);
+				walletTxns.push_back(tx);
+			}
+
+			for (uint32_t i = 0; _wallet != nullptr && i < _options.walletTxPerBlock; ++i) {
+				TransactionPtr tx = CreateTransfer(NextWalletAddress(false));
+				if (spend)
+					AddCoins(tx, created);
+				txns.push_back(tx);
+				walletTxns.push_back(tx);
+			}
+
+			while (txns.size() < _options.txPerBlock)
+				txns.push_back(CreateTransfer(RandomAddress()));
+
+			// coins of this block can be spent from the next one on
+			_spendable.insert(_spendable.end(), created.begin(), created.end());
+			return txns;
+		}
+
+		void SyntheticChain::AddCoins(const TransactionPtr &tx, std::vector<Coin> &created) {
+			const std::vector<OutputPtr> &outputs = tx->GetOutputs();
+			for (uint16_t i = 0; i < outputs.size(); ++i) {
+				if (!_wallet->ContainsAddress(*outputs[i]->Addr()))
+					continue;
+
+				Coin coin;
+				coin.hash = tx->GetHash();
+				coin.index = i;
+				coin.amount = outputs[i]->Amount().getUint64();
+				coin.address = *outputs[i]->Addr();
+				created.push_back(coin);
+
+				_walletUTXOs.insert(std::make_pair(coin.hash, coin.index));
+				_usedAddresses.insert(coin.address.String());
+			}
+		}
+
+		Address SyntheticChain::NextWalletAddress(bool internal) {
+			const std::vector<Address> &addresses = _wallet->GetAddresses(internal);
+			size_t &index = internal ? _internalIndex : _externalIndex;
+			return addresses[index++ % addresses.size()];
+		}
+
+		uint256 SyntheticChain::RandomHash() {
+			uint256 hash;
+			for (size_t i = 0; i < hash.size(); i += sizeof(uint32_t)) {
+				uint32_t r = _random();
+				memcpy(hash.begin() + i, &r, sizeof(r));
+			}
+			return hash;
+		}
+
+		Address SyntheticChain::RandomAddress() {
+			bytes_t hash = RandomHash().bytes();
+			hash.resize(20);
+			return Address(uint168(PrefixStandard, hash));
+		}
+
+	}
+}
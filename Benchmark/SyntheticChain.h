@@ -0,0 +1,167 @@
+// Copyright (c) 2012-2019 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef __ELASTOS_SDK_SYNTHETICCHAIN_H__
+#define __ELASTOS_SDK_SYNTHETICCHAIN_H__
+
+#include "SyntheticWallet.h"
+
+#include <Database/DatabaseManager.h>
+#include <Plugin/Block/MerkleBlock.h>
+#include <Plugin/Transaction/Transaction.h>
+#include <WalletCore/Address.h>
+#include <WalletCore/BloomFilter.h>
+
+#include <nlohmann/json.hpp>
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <map>
+#include <random>
+#include <set>
+#include <vector>
+
+// easiest target that MerkleBlock::IsValid() accepts without overflowing its 256 bit target, ~512 hashes per block
+#define SYNTHETIC_CHAIN_TARGET 0x1f7fffff
+#define SYNTHETIC_CHAIN_BLOCK_SPACING 120
+#define SYNTHETIC_CHAIN_FEE           10000
+
+namespace Elastos {
+	namespace ElaWallet {
+
+		// A mainchain with real proof of work at a trivial target, deterministic for a given seed and wallet. It keeps
+		// every block it mined, so it can reorganize onto a new branch while peers still ask for the old one. The chain
+		// is either served by a StandInNode or stored straight into the database of the wallet.
+		class SyntheticChain {
+		public:
+			struct Options {
+				uint32_t blocks;              // blocks on top of the genesis block
+				uint32_t txPerBlock;          // transactions in every block, the coinbase included
+				uint32_t walletTxPerBlock;    // of those, how many pay an external address of the wallet
+				uint32_t walletSpendPerBlock; // and how many spend a confirmed coin of the wallet, change to internal
+				uint32_t mempoolTxs;          // unconfirmed wallet transactions answered to mempool requests
+				uint32_t seed;
+				bool keepTransactions;        // false drops the txns of a block once the handler of Generate() saw it
+
+				Options();
+			};
+
+			struct Block {
+				MerkleBlockPtr header; // hash, height and aux pow, without the partial merkle tree
+				std::vector<TransactionPtr> txns;
+				std::vector<TransactionPtr> walletTxns; // the txns that pay or spend the wallet
+			};
+
+			typedef boost::shared_ptr<Block> BlockPtr;
+
+			typedef boost::function<void(const BlockPtr &)> BlockHandler;
+
+		public:
+			// mines the genesis block, dated so that options.blocks blocks end about now. without a wallet no
+			// transaction pays anyone the benchmark knows
+			explicit SyntheticChain(const Options &options, const SyntheticWallet *wallet = nullptr);
+
+			const Options &GetOptions() const;
+
+			// [height, hash, timestamp, target] of the genesis block, for the CheckPoints of a chain config
+			nlohmann::json Checkpoint() const;
+
+			// append options.blocks blocks to the tip, handing each to handler as soon as it is mined, then add the
+			// mempool transactions
+			void Generate(const BlockHandler &handler = BlockHandler());
+
+			// mine a block on prev that pays the wallet, it becomes the tip if it is higher than the current one.
+			// the coins of the wallet only follow blocks mined on the tip, a branch never spends them
+			BlockPtr Mine(const BlockPtr &prev);
+
+			// mine a branch from depth blocks below the tip that is one block longer than the current chain, returns
+			// the blocks of the branch, the last one is the new tip
+			std::vector<BlockPtr> Reorganize(uint32_t depth);
+
+			BlockPtr Genesis() const;
+
+			BlockPtr Tip() const;
+
+			uint32_t Height() const;
+
+			// block at height on the best chain
+			BlockPtr GetBlock(uint32_t height) const;
+
+			// block of any branch
+			BlockPtr GetBlock(const uint256 &hash) const;
+
+			// height of the first locator on the best chain, 0 if none is
+			uint32_t FindFork(const std::vector<uint256> &locators) const;
+
+			std::vector<TransactionPtr> GetMempool() const;
+
+			TransactionPtr GetMempoolTx(const uint256 &hash) const;
+
+			size_t TransactionCount() const;
+
+			size_t WalletTransactionCount() const;
+
+			size_t WalletUTXOCount() const;
+
+			// headers and wallet transactions of blocks, as a wallet that synced them saves them
+			static bool StoreBlocks(DatabaseManager &database, const std::vector<BlockPtr> &blocks);
+
+			// unspent outputs and used addresses of the wallet, and the mempool as pending transactions
+			bool StoreWallet(DatabaseManager &database) const;
+
+			// merkleblock of block for the transactions that match filter, which also starts to match the outputs of
+			// matched transactions like a full node does with BLOOM_UPDATE_ALL
+			static MerkleBlockPtr FilterBlock(const Block &block, BloomFilter &filter,
+											  std::vector<TransactionPtr> &matched);
+
+			static bool FilterTransaction(const TransactionPtr &tx, BloomFilter &filter);
+
+		private:
+			struct Coin {
+				uint256 hash;
+				uint16_t index;
+				uint64_t amount;
+				Address address;
+			};
+
+			BlockPtr MineInternal(const BlockPtr &prev, const std::vector<TransactionPtr> &txns);
+
+			TransactionPtr CreateCoinbase(uint32_t height);
+
+			TransactionPtr CreateTransfer(const Address &to);
+
+			TransactionPtr CreateSpend(std::vector<Coin> &created);
+
+			std::vector<TransactionPtr> CreateTransactions(uint32_t height, bool spend,
+														   std::vector<TransactionPtr> &walletTxns);
+
+			void AddCoins(const TransactionPtr &tx, std::vector<Coin> &created);
+
+			Address NextWalletAddress(bool internal);
+
+			uint256 RandomHash();
+
+			Address RandomAddress();
+
+		private:
+			mutable boost::mutex _lock;
+			Options _options;
+			const SyntheticWallet *_wallet;
+			std::mt19937 _random;
+			size_t _externalIndex, _internalIndex, _txCount, _walletTxCount;
+
+			std::vector<Coin> _spendable;
+			std::set<std::pair<uint256, uint16_t> > _walletUTXOs;
+			std::set<std::string> _usedAddresses;
+
+			std::map<uint256, BlockPtr> _blocks;
+			std::vector<BlockPtr> _best;
+			std::map<uint256, TransactionPtr> _mempool;
+		};
+
+	}
+}
+
+#endif //__ELASTOS_SDK_SYNTHETICCHAIN_H__
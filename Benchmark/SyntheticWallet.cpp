@@ -0,0 +1,69 @@
+// Copyright (c) 2012-2019 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "SyntheticWallet.h"
+
+#include <Common/ErrorChecker.h>
+#include <WalletCore/BIP39.h>
+#include <Plugin/Transaction/Program.h>
+
+namespace Elastos {
+	namespace ElaWallet {
+
+		SyntheticWallet::SyntheticWallet(const std::string &mnemonic, uint32_t externalCount, uint32_t internalCount) {
+			uint512 seed = BIP39::DeriveSeed(mnemonic, "");
+			HDSeed hdseed(seed.bytes());
+			HDKeychain rootkey(hdseed.getExtendedKey(true));
+			HDKeychain account = rootkey.getChild("44'/0'/0'");
+
+			for (uint32_t chain = 0; chain < 2; ++chain) {
+				std::vector<Address> &addresses = chain == 0 ? _external : _internal;
+				uint32_t count = chain == 0 ? externalCount : internalCount;
+				HDKeychain keychain = account.getChild(chain);
+
+				for (uint32_t index = 0; index < count; ++index) {
+					HDKeychain child = keychain.getChild(index);
+					std::string path = "44'/0'/0'/" + std::to_string(chain) + "/" + std::to_string(index);
+
+					addresses.push_back(Address(PrefixStandard, child.pubkey()));
+					_paths[addresses.back().ProgramHash()] = path;
+					_keys[path] = Key(child);
+				}
+			}
+		}
+
+		const std::vector<Address> &SyntheticWallet::GetAddresses(bool internal) const {
+			return internal ? _internal : _external;
+		}
+
+		bool SyntheticWallet::ContainsAddress(const Address &address) const {
+			return _paths.find(address.ProgramHash()) != _paths.end();
+		}
+
+		bool SyntheticWallet::GetCodeAndPath(const Address &address, bytes_t &code, std::string &path) const {
+			std::map<uint168, std::string>::const_iterator it = _paths.find(address.ProgramHash());
+			if (it == _paths.end())
+				return false;
+
+			code = address.RedeemScript();
+			path = it->second;
+			return true;
+		}
+
+		void SyntheticWallet::Sign(const TransactionPtr &tx) const {
+			uint256 md = tx->GetShaData();
+
+			const std::vector<ProgramPtr> &programs = tx->GetPrograms();
+			for (size_t i = 0; i < programs.size(); ++i) {
+				std::map<std::string, Key>::const_iterator it = _keys.find(programs[i]->GetPath());
+				ErrorChecker::CheckLogic(it == _keys.end(), Error::PrivateKeyNotFound, "Private key not found");
+
+				ByteStream stream;
+				stream.WriteVarBytes(it->second.Sign(md));
+				programs[i]->SetParameter(stream.GetBytes());
+			}
+		}
+
+	}
+}
@@ -0,0 +1,47 @@
+// Copyright (c) 2012-2019 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef __ELASTOS_SDK_SYNTHETICWALLET_H__
+#define __ELASTOS_SDK_SYNTHETICWALLET_H__
+
+#include <Plugin/Transaction/Transaction.h>
+#include <WalletCore/Address.h>
+#include <WalletCore/HDKeychain.h>
+#include <WalletCore/Key.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Elastos {
+	namespace ElaWallet {
+
+		// Addresses and keys of a standard single sign wallet, derived from a mnemonic along the same 44'/0'/0' paths
+		// SubAccount uses. A chain can be generated for the wallet before any MasterWalletManager exists, and the
+		// spends of the wallet come out signed so that Wallet::RegisterTransaction() accepts them.
+		class SyntheticWallet {
+		public:
+			SyntheticWallet(const std::string &mnemonic, uint32_t externalCount = SEQUENCE_GAP_LIMIT_EXTERNAL,
+							uint32_t internalCount = SEQUENCE_GAP_LIMIT_INTERNAL);
+
+			const std::vector<Address> &GetAddresses(bool internal = false) const;
+
+			bool ContainsAddress(const Address &address) const;
+
+			// redeem script and derivation path of one of our addresses, like SubAccount::GetCodeAndPath()
+			bool GetCodeAndPath(const Address &address, bytes_t &code, std::string &path) const;
+
+			// sign every program of tx, each must carry the path of one of our addresses
+			void Sign(const TransactionPtr &tx) const;
+
+		private:
+			std::vector<Address> _external, _internal;
+			std::map<uint168, std::string> _paths;
+			std::map<std::string, Key> _keys;
+		};
+
+	}
+}
+
+#endif //__ELASTOS_SDK_SYNTHETICWALLET_H__
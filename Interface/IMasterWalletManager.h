@@ -209,6 +209,27 @@ namespace Elastos {
 			 */
 			virtual void FlushData() = 0;
 
+			/**
+			 * Get network statistics of all loaded wallets, for monitoring sync stalls and peer health.
+			 * @return Statistics in json format, keyed by master wallet ID and then by chain ID, for example:
+			 * {"WalletID":{"ELA":{"ConnectStatus":"Connected","ConnectedPeers":3,"LastBlockHeight":500000,
+			 * "EstimatedHeight":500000,"SyncProgress":1.0,"SecondsSinceLastBlock":42,"Reconnects":1,"ConnectFailures":0,
+			 * "BloomFalsePositiveRate":0.0005,"Orphans":{"Count":0,"Bytes":0,"Evictions":0},
+			 * "PublishQueue":{"Size":2,"PendingCallbacks":0},"Peers":[{"Host":"1.2.3.4","Port":20866,...}],
+			 * "Messages":{"Inbound":{"merkleblock":{"Count":10,"Bytes":3000,"LatencySum":0.01,"Buckets":[...]}},
+			 * "Outbound":{...}}}}}
+			 * Messages and each peer's Messages count messages per type. Buckets is a latency histogram in seconds with
+			 * upper bounds 0.001, 0.005, 0.01, 0.05, 0.1, 0.5, 1, 5, 10 and +Inf.
+			 */
+			virtual nlohmann::json GetNetworkStats() const = 0;
+
+			/**
+			 * Same statistics as GetNetworkStats() in plain text exposition format, one sample per line such as
+			 * spv_connected_peers{wallet="WalletID",chain="ELA"} 3
+			 * @return Statistics in text format.
+			 */
+			virtual std::string GetNetworkStatsText() const = 0;
+
 			/**
 			 *
 			 * @param level can be value of: "trace", "debug", "info", "warning", "error", "critical", "off"
@@ -166,6 +166,20 @@ namespace Elastos {
 				uint32_t count,
 				const std::string &address) const = 0;
 
+			/**
+			 * Get a page of UTXOs ordered by (height, hash, index) ascending. Cost is proportional to the page size,
+			 * not to the total number of UTXOs in wallet.
+			 * @param cursor opaque token returned as "NextCursor" by previous page. Empty for the first page.
+			 * @param count specify count of utxos we need.
+			 * @param address to filter the specify address's utxos. If empty, all utxo of all addresses wil be returned.
+			 * @return utxo page in json format. "NextCursor" is empty if there is no more utxo.
+			 * {"NextCursor":"...","UTXOs":[{"Amount":"100000","Hash":"...","Height":172300,"Index":0}]}
+			 */
+			virtual nlohmann::json GetUTXOsByCursor(
+				const std::string &cursor,
+				uint32_t count,
+				const std::string &address) const = 0;
+
 			/**
 			 * Create a transaction to combine as many UTXOs as possible until transaction size reaches the max size.
 			 * @param memo input memo attribute for describing.
@@ -174,6 +188,20 @@ namespace Elastos {
 			virtual nlohmann::json CreateConsolidateTransaction(
 					const std::string &memo) = 0;
 
+			/**
+			 * Create as many consolidate transactions as needed to combine all UTXOs. Each transaction spends a
+			 * different part of the UTXOs, so they can be signed by SignTransactions() and published by
+			 * PublishTransactions() together.
+			 * @param memo input memo attribute for describing.
+			 * @param maxTxCount max count of transactions to create, 0 means no limit.
+			 * @return If success return transactions in json format as below:
+			 * {"Transactions":[{...},{...}],"UTXOCount":9000,"Fee":30000}
+			 * each item of "Transactions" is the same as the result of CreateConsolidateTransaction().
+			 */
+			virtual nlohmann::json CreateConsolidateTransactions(
+					const std::string &memo,
+					uint32_t maxTxCount) = 0;
+
 			/**
 			 * Sign a transaction or append sign to a multi-sign transaction and return the content of transaction in json format.
 			 * @param tx transaction created by Create*Transaction().
@@ -184,6 +212,16 @@ namespace Elastos {
 					const nlohmann::json &tx,
 					const std::string &payPassword) const = 0;
 
+			/**
+			 * Sign a list of transactions. The root private key is decrypted only once for the whole list.
+			 * @param txs array of transactions created by Create*Transaction(s)().
+			 * @param payPassword use to decrypt the root private key temporarily. Pay password should between 8 and 128, otherwise will throw invalid argument exception.
+			 * @return If success return the array of signed transactions in json format, in the same order as txs.
+			 */
+			virtual nlohmann::json SignTransactions(
+					const nlohmann::json &txs,
+					const std::string &payPassword) const = 0;
+
 			/**
 			 * Get signers already signed specified transaction.
 			 * @param tx a signed transaction to find signed signers.
@@ -205,6 +243,16 @@ namespace Elastos {
 			virtual nlohmann::json PublishTransaction(
 					const nlohmann::json &tx) = 0;
 
+			/**
+			 * Publish a list of transactions to p2p network without waiting for each other. The whole list is announced
+			 * to each peer in one inventory message, parents before the transactions spending them. Results of the
+			 * transactions will be notified in batches by ISubWalletCallback::OnPublishProgress().
+			 * @param txs array of signed transactions.
+			 * @return Sent result in json format, for example: [{"TxHash":"...","Fee":10000},{"TxHash":"...","Fee":10000}]
+			 */
+			virtual nlohmann::json PublishTransactions(
+					const nlohmann::json &txs) = 0;
+
 			/**
 			 * Convert tx to raw transaction.
 			 * @param tx transaction json
@@ -225,6 +273,18 @@ namespace Elastos {
 					uint32_t count,
 					const std::string &txid) const = 0;
 
+			/**
+			 * Get a page of normal transactions ordered by (height, hash) descent (newest first). Pending transactions
+			 * come first. Cost is proportional to the page size, not to the total number of transactions in wallet.
+			 * @param cursor opaque token returned as "NextCursor" by previous page. Empty for the first page.
+			 * @param count specify count of transactions we need.
+			 * @return transaction page in json format. "NextCursor" is empty if there is no more transaction.
+			 * {"NextCursor":"...","Transactions":[{"Amount":"20000","ConfirmStatus":"6+","Direction":"Received","Height":172570,"Status":"Confirmed","Timestamp":1557910458,"TxHash":"ff454532e57837cbe04f56a7e43f4209b5eb61d5d2a43a016a769c60d21125b6","Type":6}]}
+			 */
+			virtual nlohmann::json GetTransactionsByCursor(
+					const std::string &cursor,
+					uint32_t count) const = 0;
+
 			/**
 			 * Get all coinbase transactions sorted by descent (newest first).
 			 * @param start specify start index of all transactions list.
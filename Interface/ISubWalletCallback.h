@@ -75,6 +75,23 @@ namespace Elastos {
 			 */
 			virtual void OnTxPublished(const std::string &hash, const nlohmann::json &result) = 0;
 
+			/**
+			 * Callback method fired with the results of transactions published by ISubWallet::PublishTransactions(),
+			 * which do not fire OnTxPublished(). Results are coalesced: one callback per 100 results, or for the
+			 * results that came in after a second had passed since the previous callback, and one for the last
+			 * result of the batch.
+			 * @param progress in json format as below:
+			 * {
+			 *     "Results": [{"TxHash":"...","Result":{"Code":0,"Reason":""}}],  # results since the previous callback,
+			 *                                                                   # Result same as of OnTxPublished()
+			 *     "Done": 3,                         # count of txs got result
+			 *     "Failed": 1,                       # count of txs got result with non-zero Code
+			 *     "Total": 10,                       # count of txs being published
+			 *     "FailedTxHashes": ["..."]          # only when Done reached Total, every tx of the batch that failed
+			 * }
+			 */
+			virtual void OnPublishProgress(const nlohmann::json &progress) = 0;
+
 			/**
 			 * Callback method fired when a new asset registered.
 			 * @param asset ID.
@@ -146,6 +146,10 @@ namespace Elastos {
 
 			virtual void FlushData();
 
+			virtual nlohmann::json GetNetworkStats() const;
+
+			virtual std::string GetNetworkStatsText() const;
+
 			virtual void SetLogLevel(const std::string &level);
 
 		protected:
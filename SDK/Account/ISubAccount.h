@@ -70,6 +70,8 @@ namespace Elastos {
 
 			virtual void SignTransaction(const TransactionPtr &tx, const std::string &payPasswd) const = 0;
 
+			virtual void SignTransactions(const std::vector<TransactionPtr> &txns, const std::string &payPasswd) const = 0;
+
 			virtual Key GetKeyWithDID(const AddressPtr &did, const std::string &payPasswd) const = 0;
 
 			virtual Key DeriveOwnerKey(const std::string &payPasswd) = 0;
@@ -176,6 +176,8 @@ namespace Elastos {
 
 			void SignTransaction(const TransactionPtr &tx, const std::string &payPasswd) const;
 
+			void SignTransactions(const std::vector<TransactionPtr> &txns, const std::string &payPasswd) const;
+
 			Key GetKeyWithDID(const AddressPtr &did, const std::string &payPasswd) const;
 
 			Key DeriveOwnerKey(const std::string &payPasswd);
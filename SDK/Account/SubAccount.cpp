@@ -215,19 +215,34 @@ namespace Elastos {
 		}
 
 		void SubAccount::SignTransaction(const TransactionPtr &tx, const std::string &payPasswd) const {
-			std::string addr;
+			ErrorChecker::CheckParam(_parent->Readonly(), Error::Sign, "Readonly wallet can not sign tx");
+
+			std::map<std::string, Key> keyCache;
+			SignTransaction(tx, _parent->RootKey(payPasswd), keyCache);
+		}
+
+		void SubAccount::SignTransactions(const std::vector<TransactionPtr> &txns, const std::string &payPasswd) const {
+			ErrorChecker::CheckParam(_parent->Readonly(), Error::Sign, "Readonly wallet can not sign tx");
+
+			// decrypt the seed once and derive each standard key once for the whole batch
+			HDKeychainPtr rootKey = _parent->RootKey(payPasswd);
+			std::map<std::string, Key> keyCache;
+			for (size_t i = 0; i < txns.size(); ++i)
+				SignTransaction(txns[i], rootKey, keyCache);
+		}
+
+		void SubAccount::SignTransaction(const TransactionPtr &tx, const HDKeychainPtr &rootKey,
+										 std::map<std::string, Key> &keyCache) const {
 			Key key;
 			bytes_t signature;
 			ByteStream stream;
 
-			ErrorChecker::CheckParam(_parent->Readonly(), Error::Sign, "Readonly wallet can not sign tx");
 			ErrorChecker::CheckParam(tx->IsSigned(), Error::AlreadySigned, "Transaction signed");
 			ErrorChecker::CheckParam(tx->GetPrograms().empty(), Error::InvalidTransaction,
 			                         "Invalid transaction program");
 
 			uint256 md = tx->GetShaData();
 
-			HDKeychainPtr rootKey = _parent->RootKey(payPasswd);
 			std::vector<bytes_t> publicKeys;
 			const std::vector<ProgramPtr> &programs = tx->GetPrograms();
 			for (size_t i = 0; i < programs.size(); ++i) {
@@ -239,7 +254,11 @@ namespace Elastos {
 
 				bool found = false;
 				if (type == SignTypeStandard) {
-					key = rootKey->getChild(programs[i]->GetPath());
+					std::map<std::string, Key>::iterator cached = keyCache.find(programs[i]->GetPath());
+					if (cached == keyCache.end())
+						cached = keyCache.insert(std::make_pair(programs[i]->GetPath(),
+																rootKey->getChild(programs[i]->GetPath()))).first;
+					key = cached->second;
 					for (size_t k = 0; !found && k < publicKeys.size(); ++k) {
 						if (publicKeys[k] == key.PubKey()) {
 							found = true;
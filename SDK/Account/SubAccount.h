@@ -28,6 +28,7 @@
 #include <Common/Lockable.h>
 
 #include <set>
+#include <map>
 
 namespace Elastos {
 	namespace ElaWallet {
@@ -76,6 +77,8 @@ namespace Elastos {
 
 			void SignTransaction(const TransactionPtr &tx, const std::string &payPasswd) const;
 
+			void SignTransactions(const std::vector<TransactionPtr> &txns, const std::string &payPasswd) const;
+
 			Key GetKeyWithDID(const AddressPtr &did, const std::string &payPasswd) const;
 
 			Key DeriveOwnerKey(const std::string &payPasswd);
@@ -89,6 +92,12 @@ namespace Elastos {
 			size_t ExternalChainIndex(const TransactionPtr &tx) const;
 
 			AccountPtr Parent() const;
+
+		private:
+			// keyCache holds standard keys by path, shared by all txs signed with the same rootKey
+			void SignTransaction(const TransactionPtr &tx, const HDKeychainPtr &rootKey,
+								 std::map<std::string, Key> &keyCache) const;
+
 		private:
 			uint32_t _coinIndex;
 			AddressArray _internalChain, _externalChain, _cid;
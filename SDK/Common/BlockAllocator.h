@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2019 Elastos Foundation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __ELASTOS_SDK_BLOCKALLOCATOR_H__
+#define __ELASTOS_SDK_BLOCKALLOCATOR_H__
+
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+
+#include <vector>
+
+namespace Elastos {
+	namespace ElaWallet {
+
+		/*
+		 * Hands out shared_ptr<T> that point into one contiguous block. Every pointer shares the
+		 * block's reference count (aliasing constructor), so the block is freed when the last element
+		 * is released. Once the reserved capacity is used up, New() falls back to make_shared.
+		 * Only for elements that die with their owner: one element kept elsewhere keeps the whole block.
+		 */
+		template<class T>
+		class BlockAllocator {
+		public:
+			explicit BlockAllocator(size_t capacity) : _block(boost::make_shared<std::vector<T> >()) {
+				_block->reserve(capacity);
+			}
+
+			template<class... Args>
+			boost::shared_ptr<T> New(Args &&... args) {
+				if (_block->size() == _block->capacity())
+					return boost::make_shared<T>(std::forward<Args>(args)...);
+
+				_block->emplace_back(std::forward<Args>(args)...);
+				return boost::shared_ptr<T>(_block, &_block->back());
+			}
+
+		private:
+			boost::shared_ptr<std::vector<T> > _block;
+		};
+
+	}
+}
+
+#endif //__ELASTOS_SDK_BLOCKALLOCATOR_H__
@@ -20,18 +20,20 @@
  * SOFTWARE.
  */
 #include "ByteStream.h"
+#include "ErrorChecker.h"
 
 namespace Elastos {
 	namespace ElaWallet {
-		ByteStream::ByteStream() : _rpos(0) {
+		ByteStream::ByteStream() : _rpos(0), _view(nullptr), _viewSize(0) {
 
 		}
 
-		ByteStream::ByteStream(const void *buf, size_t size) : _rpos(0), _buf((const unsigned char *) buf, size) {
+		ByteStream::ByteStream(const void *buf, size_t size) :
+			_rpos(0), _buf((const unsigned char *) buf, size), _view(nullptr), _viewSize(0) {
 
 		}
 
-		ByteStream::ByteStream(const bytes_t &buf) : _rpos(0), _buf(buf) {
+		ByteStream::ByteStream(const bytes_t &buf) : _rpos(0), _buf(buf), _view(nullptr), _viewSize(0) {
 
 		}
 
@@ -39,26 +41,52 @@ namespace Elastos {
 
 		}
 
+		ByteStream ByteStream::View(const void *buf, size_t size) {
+			ByteStream stream;
+			stream._view = (const uint8_t *) buf;
+			stream._viewSize = size;
+			return stream;
+		}
+
 		void ByteStream::Reset() {
 			_rpos = 0;
 			_buf.clear();
+			_view = nullptr;
+			_viewSize = 0;
 		}
 
 		void ByteStream::clear() {
-			_rpos = 0;
-			_buf.clear();
+			Reset();
+		}
+
+		void ByteStream::Reserve(size_t n) {
+			_buf.reserve(_buf.size() + n);
 		}
 
 		uint64_t ByteStream::size() const {
-			return _buf.size();
+			return _view ? _viewSize : _buf.size();
+		}
+
+		const uint8_t *ByteStream::Data() const {
+			return _view ? _view : _buf.data();
 		}
 
 		void ByteStream::Skip(size_t bytes) const {
-			if (_rpos + bytes <= _buf.size())
+			if (_rpos + bytes <= size())
 				_rpos += bytes;
 		}
 
+		size_t ByteStream::Position() const {
+			return _rpos;
+		}
+
+		void ByteStream::SetPosition(size_t pos) const {
+			if (pos <= size())
+				_rpos = pos;
+		}
+
 		const bytes_t &ByteStream::GetBytes() const {
+			ErrorChecker::CheckLogic(_view != nullptr, Error::InvalidArgument, "bytes of a byte stream view");
 			return _buf;
 		}
 
@@ -83,57 +111,57 @@ namespace Elastos {
 		}
 
 		bool ByteStream::ReadBytes(void *buf, size_t len) const {
-			if (_rpos + len > _buf.size())
+			if (_rpos + len > size())
 				return false;
 
-			memcpy(buf, &_buf[_rpos], len);
+			memcpy(buf, Data() + _rpos, len);
 			_rpos += len;
 
 			return true;
 		}
 
 		bool ByteStream::ReadBytes(bytes_t &bytes, size_t len) const {
-			if (_rpos + len > _buf.size())
+			if (_rpos + len > size())
 				return false;
 
-			bytes.assign(_buf.begin() + _rpos, _buf.begin() + _rpos + len);
+			bytes.assign(Data() + _rpos, Data() + _rpos + len);
 
 			_rpos += len;
 			return true;
 		}
 
 		bool ByteStream::ReadBytes(uint128 &u) const {
-			if (_rpos + u.size() > _buf.size())
+			if (_rpos + u.size() > size())
 				return false;
 
-			memcpy(u.begin(), &_buf[_rpos], u.size());
+			memcpy(u.begin(), Data() + _rpos, u.size());
 			_rpos += u.size();
 			return true;
 		}
 
 		bool ByteStream::ReadBytes(uint160 &u) const {
-			if (_rpos + u.size() > _buf.size())
+			if (_rpos + u.size() > size())
 				return false;
 
-			memcpy(u.begin(), &_buf[_rpos], u.size());
+			memcpy(u.begin(), Data() + _rpos, u.size());
 			_rpos += u.size();
 			return true;
 		}
 
 		bool ByteStream::ReadBytes(uint168 &u) const {
-			if (_rpos + u.size() > _buf.size())
+			if (_rpos + u.size() > size())
 				return false;
 
-			memcpy(u.begin(), &_buf[_rpos], u.size());
+			memcpy(u.begin(), Data() + _rpos, u.size());
 			_rpos += u.size();
 			return true;
 		}
 
 		bool ByteStream::ReadBytes(uint256 &u) const {
-			if (_rpos + u.size() > _buf.size())
+			if (_rpos + u.size() > size())
 				return false;
 
-			memcpy(u.begin(), &_buf[_rpos], u.size());
+			memcpy(u.begin(), Data() + _rpos, u.size());
 			_rpos += u.size();
 			return true;
 		}
@@ -148,30 +176,31 @@ namespace Elastos {
 		}
 
 		bool ByteStream::ReadVarUint(uint64_t &len) const {
-			if (_rpos + 1 > _buf.size())
+			const uint8_t *data = Data();
+			if (_rpos + 1 > size())
 				return false;
 
-			uint8_t h = _buf[_rpos++];
+			uint8_t h = data[_rpos++];
 
 			switch (h) {
 				case VAR_INT16_HEADER:
-					if (_rpos + 2 > _buf.size())
+					if (_rpos + 2 > size())
 						return false;
-					len = *(uint16_t *) &_buf[_rpos];
+					len = *(uint16_t *) &data[_rpos];
 					_rpos += 2;
 					break;
 
 				case VAR_INT32_HEADER:
-					if (_rpos + 4 > _buf.size())
+					if (_rpos + 4 > size())
 						return false;
-					len = *(uint32_t *) &_buf[_rpos];
+					len = *(uint32_t *) &data[_rpos];
 					_rpos += 4;
 					break;
 
 				case VAR_INT64_HEADER:
-					if (_rpos + 8 > _buf.size())
+					if (_rpos + 8 > size())
 						return false;
-					len = *(uint64_t *) &_buf[_rpos];
+					len = *(uint64_t *) &data[_rpos];
 					_rpos += 8;
 					break;
 
@@ -184,11 +213,12 @@ namespace Elastos {
 		}
 
 		bool ByteStream::ReadVarString(std::string &str) const {
-			bytes_t bytes;
-			if (!ReadVarBytes(bytes)) {
+			uint64_t length = 0;
+			if (!ReadVarUint(length) || _rpos + length > size())
 				return false;
-			}
-			str = std::string((const char *) bytes.data(), bytes.size());
+
+			str.assign((const char *) Data() + _rpos, length);
+			_rpos += length;
 
 			return true;
 		}
@@ -214,27 +244,28 @@ namespace Elastos {
 		}
 
 		void ByteStream::WriteBytes(const void *buf, size_t len) {
-			_buf += bytes_t(buf, len);
+			const uint8_t *p = (const uint8_t *) buf;
+			_buf.insert(_buf.end(), p, p + len);
 		}
 
 		void ByteStream::WriteBytes(const bytes_t &bytes) {
-			_buf += bytes;
+			_buf.insert(_buf.end(), bytes.begin(), bytes.end());
 		}
 
 		void ByteStream::WriteBytes(const uint128 &u) {
-			_buf += u.bytes();
+			_buf.insert(_buf.end(), u.begin(), u.end());
 		}
 
 		void ByteStream::WriteBytes(const uint160 &u) {
-			_buf += u.bytes();
+			_buf.insert(_buf.end(), u.begin(), u.end());
 		}
 
 		void ByteStream::WriteBytes(const uint168 &u) {
-			_buf += u.bytes();
+			_buf.insert(_buf.end(), u.begin(), u.end());
 		}
 
 		void ByteStream::WriteBytes(const uint256 &u) {
-			_buf += u.bytes();
+			_buf.insert(_buf.end(), u.begin(), u.end());
 		}
 
 		void ByteStream::WriteVarBytes(const void *bytes, size_t len) {
@@ -248,26 +279,32 @@ namespace Elastos {
 		}
 
 		size_t ByteStream::WriteVarUint(uint64_t len) {
-			size_t count;
-			if (len < VAR_INT16_HEADER) {
+			size_t count = VarUintSize(len);
+			if (count == 1) {
 				_buf.push_back((uint8_t) len);
-				count = 1;
-			} else if (len <= UINT16_MAX) {
+			} else if (count == 3) {
 				_buf.push_back(VAR_INT16_HEADER);
-				_buf += bytes_t((unsigned char *) &len, 2);
-				count = 2;
-			} else if (len <= UINT32_MAX) {
+				WriteBytes(&len, 2);
+			} else if (count == 5) {
 				_buf.push_back(VAR_INT32_HEADER);
-				_buf += bytes_t((unsigned char *) &len, 4);
-				count = 4;
+				WriteBytes(&len, 4);
 			} else {
 				_buf.push_back(VAR_INT64_HEADER);
-				_buf += bytes_t((unsigned char *) &len, 8);
-				count = 8;
+				WriteBytes(&len, 8);
 			}
 			return count;
 		}
 
+		size_t ByteStream::VarUintSize(uint64_t len) {
+			if (len < VAR_INT16_HEADER)
+				return 1;
+			else if (len <= UINT16_MAX)
+				return 3;
+			else if (len <= UINT32_MAX)
+				return 5;
+			return 9;
+		}
+
 		void ByteStream::WriteVarString(const std::string &str) {
 			WriteVarBytes(str.c_str(), str.length());
 		}
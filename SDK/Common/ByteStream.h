@@ -48,14 +48,29 @@ namespace Elastos {
 
 			~ByteStream();
 
+			// read-only stream over memory owned by the caller, nothing is copied. The memory must
+			// outlive the stream and must not be written through it.
+			static ByteStream View(const void *buf, size_t size);
+
 			void Reset();
 
 			void clear();
 
+			// make room for n more bytes to be written without reallocating
+			void Reserve(size_t n);
+
 			uint64_t size() const;
 
+			// bytes of the stream, valid until the next write
+			const uint8_t *Data() const;
+
 			void Skip(size_t bytes = 1) const;
 
+			size_t Position() const;
+
+			void SetPosition(size_t pos) const;
+
+			// bytes of a stream that owns them, a view throws; read a view through Data() and size()
 			const bytes_t &GetBytes() const;
 
 			bool ReadByte(uint8_t &val) const;
@@ -112,13 +127,18 @@ namespace Elastos {
 
 			void WriteVarBytes(const bytes_t &bytes);
 
+			// return the number of bytes written, same as VarUintSize(len)
 			size_t WriteVarUint(uint64_t len);
 
+			static size_t VarUintSize(uint64_t len);
+
 			void WriteVarString(const std::string &str);
 
 		private:
 			mutable size_t _rpos;
 			bytes_t _buf;
+			const uint8_t *_view;
+			size_t _viewSize;
 		};
 
 	}
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2019 Elastos Foundation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __ELASTOS_SDK_FLATSET_H__
+#define __ELASTOS_SDK_FLATSET_H__
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace Elastos {
+	namespace ElaWallet {
+
+		/*
+		 * Sorted vector with the subset of the std::set interface used in this code base. Elements
+		 * are contiguous, so lookups and full scans don't chase tree nodes. Inserting in order (or in
+		 * bulk through insert(first, last)) is amortized O(1) per element; inserting or erasing in
+		 * the middle moves the tail.
+		 */
+		template<class T, class Compare>
+		class FlatSet {
+		public:
+			typedef typename std::vector<T>::iterator iterator;
+			typedef typename std::vector<T>::const_iterator const_iterator;
+			typedef T value_type;
+
+			iterator begin() { return _data.begin(); }
+
+			iterator end() { return _data.end(); }
+
+			const_iterator begin() const { return _data.begin(); }
+
+			const_iterator end() const { return _data.end(); }
+
+			const_iterator cbegin() const { return _data.cbegin(); }
+
+			const_iterator cend() const { return _data.cend(); }
+
+			size_t size() const { return _data.size(); }
+
+			bool empty() const { return _data.empty(); }
+
+			void clear() { _data.clear(); }
+
+			void reserve(size_t n) { _data.reserve(n); }
+
+			std::pair<iterator, bool> insert(const T &value) {
+				if (_data.empty() || _comp(_data.back(), value)) {
+					_data.push_back(value);
+					return std::make_pair(_data.end() - 1, true);
+				}
+
+				iterator it = lower_bound(value);
+				if (it != _data.end() && !_comp(value, *it))
+					return std::make_pair(it, false);
+
+				return std::make_pair(_data.insert(it, value), true);
+			}
+
+			// bulk insert: one sort and merge instead of one shift per element, duplicates are dropped
+			template<class InputIt>
+			void insert(InputIt first, InputIt last) {
+				size_t n = _data.size();
+				_data.insert(_data.end(), first, last);
+				std::sort(_data.begin() + n, _data.end(), _comp);
+				std::inplace_merge(_data.begin(), _data.begin() + n, _data.end(), _comp);
+				_data.erase(std::unique(_data.begin(), _data.end(), [this](const T &a, const T &b) {
+					return !_comp(a, b) && !_comp(b, a);
+				}), _data.end());
+			}
+
+			iterator erase(iterator pos) {
+				return _data.erase(pos);
+			}
+
+			iterator erase(const_iterator pos) {
+				return _data.erase(_data.begin() + (pos - _data.cbegin()));
+			}
+
+			template<class K>
+			size_t erase(const K &key) {
+				iterator it = find(key);
+				if (it == _data.end())
+					return 0;
+
+				_data.erase(it);
+				return 1;
+			}
+
+			template<class K>
+			iterator lower_bound(const K &key) {
+				return std::lower_bound(_data.begin(), _data.end(), key, _comp);
+			}
+
+			template<class K>
+			const_iterator lower_bound(const K &key) const {
+				return std::lower_bound(_data.begin(), _data.end(), key, _comp);
+			}
+
+			template<class K>
+			iterator upper_bound(const K &key) {
+				return std::upper_bound(_data.begin(), _data.end(), key, _comp);
+			}
+
+			template<class K>
+			const_iterator upper_bound(const K &key) const {
+				return std::upper_bound(_data.begin(), _data.end(), key, _comp);
+			}
+
+			template<class K>
+			iterator find(const K &key) {
+				iterator it = lower_bound(key);
+				return (it != _data.end() && !_comp(key, *it)) ? it : _data.end();
+			}
+
+			template<class K>
+			const_iterator find(const K &key) const {
+				const_iterator it = lower_bound(key);
+				return (it != _data.end() && !_comp(key, *it)) ? it : _data.end();
+			}
+
+			template<class K>
+			size_t count(const K &key) const {
+				return find(key) != _data.end() ? 1 : 0;
+			}
+
+		private:
+			std::vector<T> _data;
+			Compare _comp;
+		};
+
+	}
+}
+
+#endif //__ELASTOS_SDK_FLATSET_H__
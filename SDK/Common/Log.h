@@ -24,8 +24,13 @@
 
 #include <CMakeConfig.h>
 #include <spdlog/spdlog.h>
+#include <spdlog/fmt/fmt.h>
+#ifdef SPV_ASYNC_LOG
+#include <spdlog/async.h>
+#endif
 #include <spdlog/sinks/stdout_sinks.h>
 #include <spdlog/sinks/rotating_file_sink.h>
+#include <nlohmann/json.hpp>
 #if defined(__ANDROID__)
 #include <spdlog/sinks/android_sink.h>
 #endif
@@ -41,10 +46,18 @@ namespace Elastos {
 
 #define SPV_FILE_NAME "spvsdk.log"
 #define GetFunName() (std::string("<<< ") + (__FUNCTION__) + " >>>")
+#define SPV_LOG_PATTERN "%m-%d %T.%e %P %t %^%L%$ %n %v"
+
+// entries the async argument logger buffers, the oldest is dropped when the writer falls behind
+#define SPV_LOG_QUEUE_SIZE 8192
+// longer arguments, usually history or utxo pages, keep their head only
+#define ARGUMENT_LOG_MAX_LENGTH 2048
 
 			static inline void registerMultiLogger(const std::string &path = ".") {
-				if (spdlog::get(SPV_DEFAULT_LOG) != nullptr)
+				if (spdlog::get(SPV_DEFAULT_LOG) != nullptr) {
+					registerArgLogger();
 					return ;
+				}
 
 #ifdef SPV_CONSOLE_LOG
 #if defined(__ANDROID__)
@@ -70,8 +83,10 @@ namespace Elastos {
 				auto logger = std::make_shared<spdlog::logger>(SPV_DEFAULT_LOG, sinks.begin(), sinks.end());
 				spdlog::register_logger(logger);
 
-				spdlog::get(SPV_DEFAULT_LOG)->set_pattern("%m-%d %T.%e %P %t %^%L%$ %n %v");
+				spdlog::get(SPV_DEFAULT_LOG)->set_pattern(SPV_LOG_PATTERN);
 				spdlog::get(SPV_DEFAULT_LOG)->flush_on(spdlog::level::debug);
+
+				registerArgLogger();
 			}
 
 			template<typename Arg1, typename... Args>
@@ -136,16 +151,127 @@ namespace Elastos {
 
 			static inline void setLevel(spdlog::level::level_enum level) {
 				spdlog::get(SPV_DEFAULT_LOG)->set_level(level);
+				if (argLogger() != nullptr)
+					argLogger()->set_level(level);
 			}
 
 			static inline void setPattern(const std::string &fmt) {
 				spdlog::get(SPV_DEFAULT_LOG)->set_pattern(fmt);
+				if (argLogger() != nullptr)
+					argLogger()->set_pattern(fmt);
 			}
 
 			static inline void flush() {
 				spdlog::get(SPV_DEFAULT_LOG)->flush();
+				if (argLogger() != nullptr)
+					argLogger()->flush();
+			}
+
+			// writes out the queued argument logs and stops the background writer, registerMultiLogger() starts a
+			// new one
+			static inline void shutdown() {
+#ifdef SPV_ASYNC_LOG
+				if (argThreadPool() == nullptr)
+					return;
+
+				argLogger() = spdlog::get(SPV_DEFAULT_LOG);
+				// the worker drains the queue before it joins
+				argThreadPool().reset();
+#endif
+			}
+
+			// checked by ArgInfo before its arguments are evaluated, so they cost nothing below info level
+			static inline bool argEnabled() {
+				const std::shared_ptr<spdlog::logger> &logger = argLogger();
+				return logger != nullptr && logger->should_log(spdlog::level::info);
 			}
 
+			template<typename... Args>
+			static inline void argInfo(const char *fmt, const Args &... args) {
+				argLogger()->info(fmt::format(fmt, argValue(args)...));
+			}
+
+		private:
+			// stops the json serializer once the argument log has enough of it
+			struct ArgumentFull {};
+
+			class ArgumentWriter : public nlohmann::detail::output_adapter_protocol<char> {
+			public:
+				explicit ArgumentWriter(std::string &out) : _out(out) {}
+
+				virtual void write_character(char c) {
+					if (_out.size() >= ARGUMENT_LOG_MAX_LENGTH)
+						throw ArgumentFull();
+					_out.push_back(c);
+				}
+
+				virtual void write_characters(const char *s, std::size_t length) {
+					size_t room = ARGUMENT_LOG_MAX_LENGTH - _out.size();
+					_out.append(s, std::min(length, room));
+					if (length > room)
+						throw ArgumentFull();
+				}
+
+			private:
+				std::string &_out;
+			};
+
+			template<typename T>
+			static inline const T &argValue(const T &value) {
+				return value;
+			}
+
+			static inline std::string argValue(const std::string &value) {
+				if (value.size() <= ARGUMENT_LOG_MAX_LENGTH)
+					return value;
+				return value.substr(0, ARGUMENT_LOG_MAX_LENGTH) + fmt::format("... ({} bytes)", value.size());
+			}
+
+			// serializes no further than what is logged, a whole history page is never dumped
+			static inline std::string argValue(const nlohmann::json &value) {
+				std::string out;
+				try {
+					nlohmann::detail::serializer<nlohmann::json> s(std::make_shared<ArgumentWriter>(out), ' ');
+					s.dump(value, false, false, 0);
+				} catch (const ArgumentFull &) {
+					out += "...";
+				}
+				return out;
+			}
+
+			// only argument logs go through the async logger, everything else, errors included, is written before the
+			// call returns
+			static inline void registerArgLogger() {
+				if (argLogger() != nullptr && argLogger() != spdlog::get(SPV_DEFAULT_LOG))
+					return;
+
+				std::shared_ptr<spdlog::logger> logger = spdlog::get(SPV_DEFAULT_LOG);
+#ifdef SPV_ASYNC_LOG
+				argThreadPool() = std::make_shared<spdlog::details::thread_pool>(SPV_LOG_QUEUE_SIZE, 1);
+				std::shared_ptr<spdlog::logger> async = std::make_shared<spdlog::async_logger>(
+					SPV_DEFAULT_LOG, logger->sinks().begin(), logger->sinks().end(), argThreadPool(),
+					spdlog::async_overflow_policy::overrun_oldest);
+				async->set_pattern(SPV_LOG_PATTERN);
+				async->set_level(logger->level());
+				async->flush_on(logger->flush_level());
+				logger = async;
+#endif
+				argLogger() = logger;
+			}
+
+			// the registry lookup of spdlog::get() takes a lock, api argument logging keeps its own reference
+			static inline std::shared_ptr<spdlog::logger> &argLogger() {
+				static std::shared_ptr<spdlog::logger> logger;
+				return logger;
+			}
+
+#ifdef SPV_ASYNC_LOG
+			static inline std::shared_ptr<spdlog::details::thread_pool> &argThreadPool() {
+				static std::shared_ptr<spdlog::details::thread_pool> pool;
+				return pool;
+			}
+#endif
+
 		};
 
 #define SPVLOG_DEBUG(...) SPDLOG_LOGGER_DEBUG(spdlog::get(SPV_DEFAULT_LOG), __VA_ARGS__)
@@ -154,12 +280,17 @@ namespace Elastos {
 #define SPVLOG_ERROR(...)  SPDLOG_LOGGER_ERROR(spdlog::get(SPV_DEFAULT_LOG), __VA_ARGS__)
 #define SPVLOG_CRITICAL(...)  SPDLOG_LOGGER_CRITICAL(spdlog::get(SPV_DEFAULT_LOG), __VA_ARGS__)
 
-#ifdef ARGUMENT_LOG_ENABLE
 #define __va_first(first, ...) first
 #define __va_rest(first, ...) __VA_ARGS__
-#define ArgInfo(...) SPVLOG_INFO(__va_first(__VA_ARGS__, NULL), __va_rest(__VA_ARGS__, NULL))
+
+#ifdef ARGUMENT_LOG_ENABLE
+#define ArgInfo(...) \
+	do { \
+		if (Elastos::ElaWallet::Log::argEnabled()) \
+			Elastos::ElaWallet::Log::argInfo(__VA_ARGS__); \
+	} while (0)
 #else
-#define ArgInfo(...)
+#define ArgInfo(...) do {} while (0)
 #endif
 
 	}
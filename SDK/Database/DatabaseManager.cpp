@@ -199,16 +199,41 @@ namespace Elastos {
 														 _utxoStore.GetTxHashColumnName());
 		}
 
+		std::vector<TransactionViewPtr> DatabaseManager::GetCoinbaseUTXOTxnViews(const std::string &chainID) const {
+			return _transactionCoinbase.GetTxnViewsBaseOnHash(chainID, _utxoStore.GetTableName(),
+													   _utxoStore.GetTxHashColumnName());
+		}
+
 		std::vector<TransactionPtr> DatabaseManager::GetCoinbaseUniqueTxns(const std::string &chainID,
 																		   const std::set<std::string> &hashes) const {
 			return _transactionCoinbase.GetUniqueTxns(chainID, hashes);
 		}
 
+		std::vector<TransactionViewPtr> DatabaseManager::GetCoinbaseUniqueTxnViews(const std::string &chainID,
+																			  const std::set<std::string> &hashes) const {
+			return _transactionCoinbase.GetUniqueTxnViews(chainID, hashes);
+		}
+
 		std::vector<TransactionPtr> DatabaseManager::GetCoinbaseTxns(const std::string &chainID, size_t offset,
 																	 size_t limit, bool asc) const {
 			return _transactionCoinbase.Gets(chainID, offset, limit, asc);
 		}
 
+		std::vector<TransactionViewPtr> DatabaseManager::GetCoinbaseTxnViews(const std::string &chainID, size_t offset,
+																			 size_t limit, bool asc) const {
+			return _transactionCoinbase.GetViews(chainID, offset, limit, asc);
+		}
+
+		std::vector<TransactionPtr> DatabaseManager::GetCoinbaseTxnsBefore(const std::string &chainID, uint64_t height,
+																		const std::string &hash, size_t limit) const {
+			return _transactionCoinbase.GetsBefore(chainID, height, hash, limit);
+		}
+
+		std::vector<TransactionViewPtr> DatabaseManager::GetCoinbaseTxnViewsBefore(const std::string &chainID, uint64_t height,
+																			  const std::string &hash, size_t limit) const {
+			return _transactionCoinbase.GetViewsBefore(chainID, height, hash, limit);
+		}
+
 		bool DatabaseManager::UpdateCoinbaseTxn(const std::vector<TransactionPtr> &txns) {
 			return _transactionCoinbase.Update(txns);
 		}
@@ -254,16 +279,41 @@ namespace Elastos {
 													   _utxoStore.GetTxHashColumnName());
 		}
 
+		std::vector<TransactionViewPtr> DatabaseManager::GetNormalUTXOTxnViews(const std::string &chainID) const {
+			return _transactionNormal.GetTxnViewsBaseOnHash(chainID, _utxoStore.GetTableName(),
+													   _utxoStore.GetTxHashColumnName());
+		}
+
 		std::vector<TransactionPtr> DatabaseManager::GetNormalUniqueTxns(const std::string &chainID,
 																		 const std::set<std::string> &hashes) const {
 			return _transactionNormal.GetUniqueTxns(chainID, hashes);
 		}
 
+		std::vector<TransactionViewPtr> DatabaseManager::GetNormalUniqueTxnViews(const std::string &chainID,
+																			  const std::set<std::string> &hashes) const {
+			return _transactionNormal.GetUniqueTxnViews(chainID, hashes);
+		}
+
 		std::vector<TransactionPtr> DatabaseManager::GetNormalTxns(const std::string &chainID, size_t offset,
 																   size_t limit, bool asc) const {
 			return _transactionNormal.Gets(chainID, offset, limit, asc);
 		}
 
+		std::vector<TransactionViewPtr> DatabaseManager::GetNormalTxnViews(const std::string &chainID, size_t offset,
+																		   size_t limit, bool asc) const {
+			return _transactionNormal.GetViews(chainID, offset, limit, asc);
+		}
+
+		std::vector<TransactionPtr> DatabaseManager::GetNormalTxnsBefore(const std::string &chainID, uint64_t height,
+																		const std::string &hash, size_t limit) const {
+			return _transactionNormal.GetsBefore(chainID, height, hash, limit);
+		}
+
+		std::vector<TransactionViewPtr> DatabaseManager::GetNormalTxnViewsBefore(const std::string &chainID, uint64_t height,
+																			  const std::string &hash, size_t limit) const {
+			return _transactionNormal.GetViewsBefore(chainID, height, hash, limit);
+		}
+
 		bool DatabaseManager::UpdateNormalTxn(const std::vector<TransactionPtr> &txns) {
 			return _transactionNormal.Update(txns);
 		}
@@ -313,6 +363,11 @@ namespace Elastos {
 			return _transactionPending.GetUniqueTxns(chainID, hashes);
 		}
 
+		std::vector<TransactionViewPtr> DatabaseManager::GetPendingUniqueTxnViews(const std::string &chainID,
+																				   const std::set<std::string> &hashes) const {
+			return _transactionPending.GetUniqueTxnViews(chainID, hashes);
+		}
+
 		bool DatabaseManager::ExistPendingTxnTable() const {
 			return _transactionPending.TableExist();
 		}
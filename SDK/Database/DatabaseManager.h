@@ -80,12 +80,26 @@ namespace Elastos {
 
 			std::vector<TransactionPtr> GetCoinbaseUTXOTxn(const std::string &chainID) const;
 
+			std::vector<TransactionViewPtr> GetCoinbaseUTXOTxnViews(const std::string &chainID) const;
+
 			std::vector<TransactionPtr> GetCoinbaseUniqueTxns(const std::string &chainID,
 															  const std::set<std::string> &hashes) const;
 
+			std::vector<TransactionViewPtr> GetCoinbaseUniqueTxnViews(const std::string &chainID,
+																	  const std::set<std::string> &hashes) const;
+
 			std::vector<TransactionPtr>
 			GetCoinbaseTxns(const std::string &chainID, size_t offset, size_t limit, bool asc = false) const;
 
+			std::vector<TransactionViewPtr>
+			GetCoinbaseTxnViews(const std::string &chainID, size_t offset, size_t limit, bool asc = false) const;
+
+			std::vector<TransactionPtr> GetCoinbaseTxnsBefore(const std::string &chainID, uint64_t height,
+														const std::string &hash, size_t limit) const;
+
+			std::vector<TransactionViewPtr> GetCoinbaseTxnViewsBefore(const std::string &chainID, uint64_t height,
+																  const std::string &hash, size_t limit) const;
+
 			bool UpdateCoinbaseTxn(const std::vector<TransactionPtr> &txns);
 
 			bool DeleteCoinbaseTxn(const uint256 &hash);
@@ -109,12 +123,26 @@ namespace Elastos {
 
 			std::vector<TransactionPtr> GetNormalUTXOTxn(const std::string &chainID) const;
 
+			std::vector<TransactionViewPtr> GetNormalUTXOTxnViews(const std::string &chainID) const;
+
 			std::vector<TransactionPtr> GetNormalUniqueTxns(const std::string &chainID,
 															const std::set<std::string> &hashes) const;
 
+			std::vector<TransactionViewPtr> GetNormalUniqueTxnViews(const std::string &chainID,
+																	  const std::set<std::string> &hashes) const;
+
 			std::vector<TransactionPtr>
 			GetNormalTxns(const std::string &chainID, size_t offset, size_t limit, bool asc = false) const;
 
+			std::vector<TransactionViewPtr>
+			GetNormalTxnViews(const std::string &chainID, size_t offset, size_t limit, bool asc = false) const;
+
+			std::vector<TransactionPtr> GetNormalTxnsBefore(const std::string &chainID, uint64_t height,
+														const std::string &hash, size_t limit) const;
+
+			std::vector<TransactionViewPtr> GetNormalTxnViewsBefore(const std::string &chainID, uint64_t height,
+																  const std::string &hash, size_t limit) const;
+
 			bool UpdateNormalTxn(const std::vector<TransactionPtr> &txns);
 
 			bool DeleteNormalTxn(const uint256 &hash);
@@ -141,6 +169,9 @@ namespace Elastos {
 			std::vector<TransactionPtr> GetPendingUniqueTxns(const std::string &chainID,
 															 const std::set<std::string> &hashes) const;
 
+			std::vector<TransactionViewPtr> GetPendingUniqueTxnViews(const std::string &chainID,
+																	 const std::set<std::string> &hashes) const;
+
 			bool ExistPendingTxnTable() const;
 
 			// Peer Address
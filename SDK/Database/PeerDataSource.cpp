@@ -39,6 +39,7 @@ namespace Elastos {
 
 		void PeerDataSource::InitializeTable() {
 			TableBase::InitializeTable(PEER_DATABASE_CREATE);
+			TableBase::InitializeTable("drop table if exists " + PEER_OLD_TABLE_NAME + ";");
 		}
 
 		bool PeerDataSource::PutPeer(const PeerEntity &peerEntity) {
@@ -64,8 +65,14 @@ namespace Elastos {
 		bool PeerDataSource::PutPeerInternal(const PeerEntity &peerEntity) {
 			std::string sql;
 
-			sql = "INSERT INTO " + PEER_TABLE_NAME + " (" + PEER_ADDRESS + "," + PEER_PORT + "," +
-				  PEER_TIMESTAMP + "," + PEER_ISO + ") VALUES (?, ?, ?, ?);";
+			// the address book keeps one row per address, a later put replaces its score in place
+			sql = "INSERT INTO " + PEER_TABLE_NAME + " (" + PEER_TIMESTAMP + "," + PEER_LAST_SUCCESS + "," +
+				  PEER_LATENCY + "," + PEER_FAILURES + "," + PEER_ADDRESS + "," + PEER_PORT + "," + PEER_ISO +
+				  ") VALUES (?, ?, ?, ?, ?, ?, '') ON CONFLICT(" + PEER_ADDRESS + "," + PEER_PORT + ") DO UPDATE SET " +
+				  PEER_TIMESTAMP + " = excluded." + PEER_TIMESTAMP + ", " +
+				  PEER_LAST_SUCCESS + " = excluded." + PEER_LAST_SUCCESS + ", " +
+				  PEER_LATENCY + " = excluded." + PEER_LATENCY + ", " +
+				  PEER_FAILURES + " = excluded." + PEER_FAILURES + ";";
 
 			sqlite3_stmt *stmt;
 			if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
@@ -73,10 +80,12 @@ namespace Elastos {
 				return false;
 			}
 
-			if (!_sqlite->BindBlob(stmt, 1, peerEntity.address.begin(), peerEntity.address.size(), nullptr) ||
-				!_sqlite->BindInt(stmt, 2, peerEntity.port) ||
-				!_sqlite->BindInt64(stmt, 3, peerEntity.timeStamp) ||
-				!_sqlite->BindText(stmt, 4, "", nullptr)) {
+			if (!_sqlite->BindInt64(stmt, 1, peerEntity.timeStamp) ||
+				!_sqlite->BindInt64(stmt, 2, peerEntity.lastSuccess) ||
+				!_sqlite->BindInt(stmt, 3, peerEntity.latency) ||
+				!_sqlite->BindInt(stmt, 4, peerEntity.failures) ||
+				!_sqlite->BindBlob(stmt, 5, peerEntity.address.begin(), peerEntity.address.size(), nullptr) ||
+				!_sqlite->BindInt(stmt, 6, peerEntity.port)) {
 				Log::error("bind args");
 			}
 
@@ -126,40 +135,6 @@ namespace Elastos {
 			return DeleteAll(PEER_TABLE_NAME);
 		}
 
-		bool PeerDataSource::Contain(const PeerEntity &entity) const {
-			bool contain = false;
-
-			std::string sql;
-
-			sql = "SELECT " +
-				  PEER_ADDRESS + "," +
-				  PEER_PORT +
-				  " FROM " + PEER_TABLE_NAME +
-				  " WHERE " + PEER_ADDRESS + " = ? AND " + PEER_PORT + " = ?;";
-
-			sqlite3_stmt *stmt;
-			if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
-				Log::error("prepare sql: {}" + sql);
-				return false;
-			}
-
-			if (!_sqlite->BindBlob(stmt, 1, entity.address.begin(), entity.address.size(), nullptr) ||
-				!_sqlite->BindInt(stmt, 2, entity.port)) {
-				Log::error("bind args");
-			}
-
-			if (SQLITE_ROW == _sqlite->Step(stmt)) {
-				contain = true;
-			}
-
-			if (!_sqlite->Finalize(stmt)) {
-				Log::error("Peer contain finalize");
-				return false;
-			}
-
-			return contain;
-		}
-
 		std::vector<PeerEntity> PeerDataSource::GetAllPeers() const {
 			std::vector<PeerEntity> peers;
 
@@ -167,7 +142,8 @@ namespace Elastos {
 			std::string sql;
 
 			sql = "SELECT " + PEER_COLUMN_ID + ", " + PEER_ADDRESS + ", " + PEER_PORT + ", " +
-				  PEER_TIMESTAMP + " FROM " + PEER_TABLE_NAME + ";";
+				  PEER_TIMESTAMP + ", " + PEER_LAST_SUCCESS + ", " + PEER_LATENCY + ", " + PEER_FAILURES +
+				  " FROM " + PEER_TABLE_NAME + ";";
 
 			sqlite3_stmt *stmt;
 			if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
@@ -192,6 +168,11 @@ namespace Elastos {
 				// timestamp
 				peer.timeStamp = _sqlite->ColumnInt64(stmt, 3);
 
+				// score
+				peer.lastSuccess = _sqlite->ColumnInt64(stmt, 4);
+				peer.latency = _sqlite->ColumnInt(stmt, 5);
+				peer.failures = _sqlite->ColumnInt(stmt, 6);
+
 				peers.push_back(peer);
 			}
 
@@ -35,7 +35,10 @@ namespace Elastos {
 			PeerEntity() :
 				id(0),
 				port(0),
-				timeStamp(0)
+				timeStamp(0),
+				lastSuccess(0),
+				latency(0),
+				failures(0)
 			{
 			}
 
@@ -43,7 +46,10 @@ namespace Elastos {
 				id(i),
 				address(addr),
 				port(p),
-				timeStamp(ts)
+				timeStamp(ts),
+				lastSuccess(0),
+				latency(0),
+				failures(0)
 			{
 			}
 
@@ -51,6 +57,9 @@ namespace Elastos {
 			uint128 address;
 			uint16_t port;
 			uint64_t timeStamp;
+			uint64_t lastSuccess;
+			uint32_t latency;
+			uint32_t failures;
 		};
 
 		class PeerDataSource : public TableBase {
@@ -75,27 +84,33 @@ namespace Elastos {
 			std::vector<PeerEntity> GetAllPeers() const;
 
 		private:
-			bool Contain(const PeerEntity &entity) const;
-
 			bool PutPeerInternal(const PeerEntity &peerEntity);
 
 		private:
 			/*
 			 * peer table
 			 */
-			const std::string PEER_TABLE_NAME = "peerTable";
+			const std::string PEER_OLD_TABLE_NAME = "peerTable";
+			const std::string PEER_TABLE_NAME = "peerAddressBook";
 			const std::string PEER_COLUMN_ID = "_id";
 			const std::string PEER_ADDRESS = "peerAddress";
 			const std::string PEER_PORT = "peerPort";
 			const std::string PEER_TIMESTAMP = "peerTimestamp";
 			const std::string PEER_ISO = "peerISO";
+			const std::string PEER_LAST_SUCCESS = "peerLastSuccess";
+			const std::string PEER_LATENCY = "peerLatency";
+			const std::string PEER_FAILURES = "peerFailures";
 
 			const std::string PEER_DATABASE_CREATE = "create table if not exists " + PEER_TABLE_NAME + " (" +
 				PEER_COLUMN_ID + " integer primary key autoincrement, " +
 				PEER_ADDRESS + " blob," +
 				PEER_PORT + " integer," +
 				PEER_TIMESTAMP + " integer," +
-				PEER_ISO + " text default 'ELA');";
+				PEER_ISO + " text default 'ELA'," +
+				PEER_LAST_SUCCESS + " integer default 0," +
+				PEER_LATENCY + " integer default 0," +
+				PEER_FAILURES + " integer default 0," +
+				"unique (" + PEER_ADDRESS + ", " + PEER_PORT + "));";
 		};
 
 	}
@@ -26,6 +26,7 @@
 #include <Common/uint256.h>
 #include <Plugin/Transaction/Transaction.h>
 #include <Plugin/Transaction/IDTransaction.h>
+#include <Plugin/Transaction/TransactionView.h>
 #include <Plugin/Registry.h>
 
 #include <string>
@@ -59,6 +60,8 @@ namespace Elastos {
 							 _assetID + " text not null, " +
 							 _iso + " text DEFAULT 'ELA');";
 			TableBase::InitializeTable(_tableCreation);
+			TableBase::InitializeTable("create index if not exists " + _tableName + "HeightHashIndex on " +
+									   _tableName + "(" + _blockHeight + ", " + _txHash + ");");
 		}
 
 		bool TransactionNormal::_Put(const TransactionPtr &tx) {
@@ -175,10 +178,24 @@ namespace Elastos {
 		std::vector<TransactionPtr> TransactionNormal::GetUniqueTxns(const std::string &chainID,
 																	 const std::set<std::string> &uniqueHash) const {
 			std::vector<TransactionPtr> txns;
+			SelectUnique(txns, chainID, uniqueHash);
+			return txns;
+		}
+
+		std::vector<TransactionViewPtr> TransactionNormal::GetUniqueTxnViews(const std::string &chainID,
+																			 const std::set<std::string> &uniqueHash) const {
+			std::vector<TransactionViewPtr> views;
+			SelectUnique(views, chainID, uniqueHash);
+			return views;
+		}
+
+		template <class T>
+		void TransactionNormal::SelectUnique(std::vector<T> &txns, const std::string &chainID,
+											 const std::set<std::string> &uniqueHash) const {
 			std::string sql;
 
 			if (uniqueHash.empty())
-				return txns;
+				return;
 
 			std::set<std::string>::iterator it = uniqueHash.cbegin();
 			size_t cnt, maxCnt = uniqueHash.size(), markCnt;
@@ -198,7 +215,7 @@ namespace Elastos {
 				sqlite3_stmt *stmt = NULL;
 				if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
 					Log::error("prepare sql: {}", sql);
-					return txns;
+					return;
 				}
 
 				for (size_t i = 0; i < markCnt; ++i, ++it) {
@@ -212,13 +229,12 @@ namespace Elastos {
 
 				if (!_sqlite->Finalize(stmt)) {
 					Log::error("Tx get all finalize");
-					return {};
+					txns.clear();
+					return;
 				}
 
 				cnt += markCnt;
 			}
-
-			return txns;
 		}
 
 		TransactionPtr TransactionNormal::Get(const uint256 &hash, const std::string &chainID) const {
@@ -288,6 +304,20 @@ namespace Elastos {
 		std::vector<TransactionPtr> TransactionNormal::Gets(const std::string &chainID, size_t offset,
 															size_t limit, bool asc) const {
 			std::vector<TransactionPtr> txns;
+			SelectPage(txns, chainID, offset, limit, asc);
+			return txns;
+		}
+
+		std::vector<TransactionViewPtr> TransactionNormal::GetViews(const std::string &chainID, size_t offset,
+																	size_t limit, bool asc) const {
+			std::vector<TransactionViewPtr> views;
+			SelectPage(views, chainID, offset, limit, asc);
+			return views;
+		}
+
+		template <class T>
+		void TransactionNormal::SelectPage(std::vector<T> &txns, const std::string &chainID, size_t offset,
+										   size_t limit, bool asc) const {
 			std::string sql, order;
 
 			if (asc) {
@@ -307,7 +337,7 @@ namespace Elastos {
 			sqlite3_stmt *stmt = NULL;
 			if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
 				Log::error("prepare sql: {}", sql);
-				return txns;
+				return;
 			}
 
 			if (!_sqlite->BindInt64(stmt, 1, limit) ||
@@ -319,16 +349,80 @@ namespace Elastos {
 
 			if (!_sqlite->Finalize(stmt)) {
 				Log::error("Tx get all finalize");
-				return {};
+				txns.clear();
 			}
+		}
 
+		std::vector<TransactionPtr> TransactionNormal::GetsBefore(const std::string &chainID, uint64_t height,
+																  const std::string &hash, size_t limit) const {
+			std::vector<TransactionPtr> txns;
+			SelectBefore(txns, chainID, height, hash, limit);
 			return txns;
 		}
 
+		std::vector<TransactionViewPtr> TransactionNormal::GetViewsBefore(const std::string &chainID, uint64_t height,
+																		  const std::string &hash, size_t limit) const {
+			std::vector<TransactionViewPtr> views;
+			SelectBefore(views, chainID, height, hash, limit);
+			return views;
+		}
+
+		template <class T>
+		void TransactionNormal::SelectBefore(std::vector<T> &txns, const std::string &chainID, uint64_t height,
+											 const std::string &hash, size_t limit) const {
+			std::string sql;
+
+			sql = "SELECT " +
+				  _txHash + "," +
+				  _buff + "," +
+				  _blockHeight + "," +
+				  _timestamp + "," +
+				  _iso +
+				  " FROM " + _tableName +
+				  " WHERE " + _blockHeight + " < ? OR (" + _blockHeight + " = ? AND " + _txHash + " < ?)" +
+				  " ORDER BY " + _blockHeight + " DESC, " + _txHash + " DESC LIMIT ?;";
+
+			sqlite3_stmt *stmt = NULL;
+			if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
+				Log::error("prepare sql: {}", sql);
+				return;
+			}
+
+			if (!_sqlite->BindInt64(stmt, 1, height) ||
+				!_sqlite->BindInt64(stmt, 2, height) ||
+				!_sqlite->BindText(stmt, 3, hash, nullptr) ||
+				!_sqlite->BindInt64(stmt, 4, limit)) {
+				Log::error("bind args");
+			}
+
+			GetSelectedTxns(txns, chainID, stmt);
+
+			if (!_sqlite->Finalize(stmt)) {
+				Log::error("Tx get before finalize");
+				txns.clear();
+			}
+		}
+
 		std::vector<TransactionPtr> TransactionNormal::GetTxnBaseOnHash(const std::string &chainID,
 																		const std::string &tableName,
 																		const std::string &txHashColumnName) const {
 			std::vector<TransactionPtr> txns;
+			SelectBaseOnHash(txns, chainID, tableName, txHashColumnName);
+			return txns;
+		}
+
+		std::vector<TransactionViewPtr> TransactionNormal::GetTxnViewsBaseOnHash(const std::string &chainID,
+																				 const std::string &tableName,
+																				 const std::string &txHashColumnName) const {
+			std::vector<TransactionViewPtr> views;
+			SelectBaseOnHash(views, chainID, tableName, txHashColumnName);
+			return views;
+		}
+
+		template <class T>
+		void TransactionNormal::SelectBaseOnHash(std::vector<T> &txns, const std::string &chainID,
+												 const std::string &tableName,
+												 const std::string &txHashColumnName) const {
 			std::string sql;
 
 			sql = "SELECT " + _txHash + "," + _buff + "," + _blockHeight + "," + _timestamp + "," + _iso +
@@ -339,7 +433,7 @@ namespace Elastos {
 			sqlite3_stmt *stmt = NULL;
 			if (!_sqlite->Prepare(sql, &stmt, nullptr)) {
 				Log::error("prepare sql: {}", sql);
-				return {};
+				return;
 			}
 
 			GetSelectedTxns(txns, chainID, stmt);
@@ -347,10 +441,8 @@ namespace Elastos {
 			int r = sqlite3_finalize(stmt);
 			if (SQLITE_OK != r) {
 				Log::error("Tx get txn({}) finalize: r = {}, extend code: {}", txns.size(), r, _sqlite->ExtendedEerrCode());
-				return {};
+				txns.clear();
 			}
-
-			return txns;
 		}
 
 		bool TransactionNormal::Update(const std::vector<TransactionPtr> &txns) {
@@ -410,15 +502,21 @@ namespace Elastos {
 			return txns.empty() ? nullptr : txns[0];
 		}
 
+		TransactionPtr TransactionNormal::CreateTxn(const std::string &chainID) const {
+			TransactionPtr tx;
+			if (chainID == CHAINID_MAINCHAIN) {
+				tx = TransactionPtr(new Transaction());
+			} else if (chainID == CHAINID_IDCHAIN || chainID == CHAINID_TOKENCHAIN) {
+				tx = TransactionPtr(new IDTransaction());
+			}
+
+			return tx;
+		}
+
 		void TransactionNormal::GetSelectedTxns(std::vector<TransactionPtr> &txns, const std::string &chainID,
 												sqlite3_stmt *stmt) const {
 			while (SQLITE_ROW == _sqlite->Step(stmt)) {
-				TransactionPtr tx;
-				if (chainID == CHAINID_MAINCHAIN) {
-					tx = TransactionPtr(new Transaction());
-				} else if (chainID == CHAINID_IDCHAIN || chainID == CHAINID_TOKENCHAIN) {
-					tx = TransactionPtr(new IDTransaction());
-				}
+				TransactionPtr tx = CreateTxn(chainID);
 
 				uint256 txHash(_sqlite->ColumnText(stmt, 0));
 
@@ -445,6 +543,33 @@ namespace Elastos {
 			}
 		}
 
+		void TransactionNormal::GetSelectedTxns(std::vector<TransactionViewPtr> &views, const std::string &chainID,
+												sqlite3_stmt *stmt) const {
+			while (SQLITE_ROW == _sqlite->Step(stmt)) {
+				TransactionViewPtr view(new TransactionView(CreateTxn(chainID)));
+
+				uint256 txHash(_sqlite->ColumnText(stmt, 0));
+
+				const uint8_t *pdata = (const uint8_t *) _sqlite->ColumnBlob(stmt, 1);
+				size_t len = (size_t) _sqlite->ColumnBytes(stmt, 1);
+
+				uint32_t blockHeight = (uint32_t) _sqlite->ColumnInt(stmt, 2);
+				uint32_t timeStamp = (uint32_t) _sqlite->ColumnInt(stmt, 3);
+				std::string iso = _sqlite->ColumnText(stmt, 4);
+
+				if (!view->Deserialize(pdata, len, iso == ISO)) {
+					Log::error("view of tx {} deserialize fail", txHash.GetHex());
+					continue;
+				}
+
+				view->SetHash(txHash);
+				view->SetBlockHeight(blockHeight);
+				view->SetTimestamp(timeStamp);
+
+				views.push_back(view);
+			}
+		}
+
 		bool TransactionNormal::ContainHash(const uint256 &hash) const {
 			bool contain = false;
 			std::string txHash = hash.GetHex();
@@ -32,8 +32,10 @@ namespace Elastos {
 	namespace ElaWallet {
 
 		class Transaction;
+		class TransactionView;
 
 		typedef boost::shared_ptr<Transaction> TransactionPtr;
+		typedef boost::shared_ptr<TransactionView> TransactionViewPtr;
 
 		class TransactionNormal : public TableBase {
 		public:
@@ -56,6 +58,9 @@ namespace Elastos {
 			std::vector<TransactionPtr> GetUniqueTxns(const std::string &chainID,
 													  const std::set<std::string> &uniqueHash) const;
 
+			std::vector<TransactionViewPtr> GetUniqueTxnViews(const std::string &chainID,
+															  const std::set<std::string> &uniqueHash) const;
+
 			TransactionPtr Get(const uint256 &hash, const std::string &chainID) const;
 
 			std::vector<TransactionPtr> GetAfter(const std::string &chainID, uint32_t height) const;
@@ -64,10 +69,24 @@ namespace Elastos {
 
 			std::vector<TransactionPtr> Gets(const std::string &chainID, size_t offset, size_t limit, bool asc = false) const;
 
+			std::vector<TransactionViewPtr> GetViews(const std::string &chainID, size_t offset, size_t limit,
+													 bool asc = false) const;
+
+			// keyset pagination: txns ordered by (height, hash) descending, strictly after the given key
+			std::vector<TransactionPtr> GetsBefore(const std::string &chainID, uint64_t height, const std::string &hash,
+												   size_t limit) const;
+
+			std::vector<TransactionViewPtr> GetViewsBefore(const std::string &chainID, uint64_t height,
+														   const std::string &hash, size_t limit) const;
+
 			std::vector<TransactionPtr> GetTxnBaseOnHash(const std::string &chainID,
 														 const std::string &tableName,
 														 const std::string &txHashColumnName) const;
 
+			std::vector<TransactionViewPtr> GetTxnViewsBaseOnHash(const std::string &chainID,
+																  const std::string &tableName,
+																  const std::string &txHashColumnName) const;
+
 			bool Update(const std::vector<TransactionPtr> &txns);
 
 			bool DeleteByHash(const uint256 &hash);
@@ -90,8 +109,28 @@ namespace Elastos {
 		private:
 			TransactionPtr SelectByHash(const uint256 &hash, const std::string &chainID) const;
 
+			TransactionPtr CreateTxn(const std::string &chainID) const;
+
 			void GetSelectedTxns(std::vector<TransactionPtr> &txns, const std::string &chainID, sqlite3_stmt *stmt) const;
 
+			void GetSelectedTxns(std::vector<TransactionViewPtr> &views, const std::string &chainID, sqlite3_stmt *stmt) const;
+
+			template <class T>
+			void SelectUnique(std::vector<T> &txns, const std::string &chainID,
+							  const std::set<std::string> &uniqueHash) const;
+
+			template <class T>
+			void SelectPage(std::vector<T> &txns, const std::string &chainID, size_t offset, size_t limit,
+							bool asc) const;
+
+			template <class T>
+			void SelectBefore(std::vector<T> &txns, const std::string &chainID, uint64_t height,
+							  const std::string &hash, size_t limit) const;
+
+			template <class T>
+			void SelectBaseOnHash(std::vector<T> &txns, const std::string &chainID, const std::string &tableName,
+								  const std::string &txHashColumnName) const;
+
 		protected:
 			std::string _tableName;
 			std::string _txHash;
@@ -60,7 +60,7 @@ const std::string CALLBACK_IS_NULL_PROMPT = "callback is null";
 			j["ID"] = GetTransferID(tx);
 			j["Fee"] = tx->getFee(unit);
 
-			ArgInfo("r => {}", j.dump());
+			ArgInfo("r => {}", j);
 
 			return j;
 		}
@@ -103,14 +103,14 @@ const std::string CALLBACK_IS_NULL_PROMPT = "callback is null";
 			j["ID"] = GetTransferID(tx);
 			j["Fee"] = tx->getFee(unit);
 
-			ArgInfo("r => {}", j.dump());
+			ArgInfo("r => {}", j);
 
 			return j;
 		}
 
 		void EthSidechainSubWallet::DeleteTransfer(const nlohmann::json &tx) {
 			ArgInfo("{} {}", _walletID, GetFunName());
-			ArgInfo("tx: {}", tx.dump());
+			ArgInfo("tx: {}", tx);
 
 			std::string tid;
 			EthereumTransferPtr transfer;
@@ -184,7 +184,7 @@ const std::string CALLBACK_IS_NULL_PROMPT = "callback is null";
 			j["MaxCount"] = maxCount;
 			j["Transactions"] = txList;
 
-			ArgInfo("r => {}", j.dump());
+			ArgInfo("r => {}", j);
 			return j;
 		}
 
@@ -238,12 +238,12 @@ const std::string CALLBACK_IS_NULL_PROMPT = "callback is null";
 		void EthSidechainSubWallet::getGasPrice(BREthereumWallet wid, int rid) {
 			nlohmann::json j;
 			j["rid"] = rid;
-			ArgInfo("{} {}", GetFunName(), j.dump(4));
+			ArgInfo("{} {}", GetFunName(), j);
 
 			boost::mutex::scoped_lock scoped_lock(lock);
 			if (_callback) {
 				nlohmann::json r = _callback->GasPrice(rid);
-				ArgInfo("r => {}", r.dump(4));
+				ArgInfo("r => {}", r);
 
 				if (!r.empty()) {
 					int id;
@@ -276,12 +276,12 @@ const std::string CALLBACK_IS_NULL_PROMPT = "callback is null";
 			j["data"] = data;
 			j["gasPrice"] = gasPrice;
 			j["rid"] = rid;
-			ArgInfo("{} {}", GetFunName(), j.dump(4));
+			ArgInfo("{} {}", GetFunName(), j);
 
 			boost::mutex::scoped_lock scoped_lock(lock);
 			if (_callback) {
 				nlohmann::json r = _callback->EstimateGas(from, to, amount, gasPrice, data, rid);
-				ArgInfo("r => {}", r.dump(4));
+				ArgInfo("r => {}", r);
 
 				if (!r.empty()) {
 					int id;
@@ -305,12 +305,12 @@ const std::string CALLBACK_IS_NULL_PROMPT = "callback is null";
 			nlohmann::json j;
 			j["address"] = address;
 			j["rid"] = rid;
-			ArgInfo("{} {}", GetFunName(), j.dump(4));
+			ArgInfo("{} {}", GetFunName(), j);
 
 			boost::mutex::scoped_lock scoped_lock(lock);
 			if (_callback) {
 				nlohmann::json r = _callback->GetBalance(address, rid);
-				ArgInfo("r => {}", r.dump(4));
+				ArgInfo("r => {}", r);
 
 				if (!r.empty()) {
 					int id;
@@ -334,12 +334,12 @@ const std::string CALLBACK_IS_NULL_PROMPT = "callback is null";
 			nlohmann::json j;
 			j["tx"] = tx;
 			j["rid"] = rid;
-			ArgInfo("{} {}", GetFunName(), j.dump(4));
+			ArgInfo("{} {}", GetFunName(), j);
 
 			boost::mutex::scoped_lock scoped_lock(lock);
 			if (_callback) {
 				nlohmann::json r = _callback->SubmitTransaction(tx, rid);
-				ArgInfo("r => {}", r.dump(4));
+				ArgInfo("r => {}", r);
 
 				if (!r.empty()) {
 					int id = rid;
@@ -368,12 +368,12 @@ const std::string CALLBACK_IS_NULL_PROMPT = "callback is null";
 			j["begBlockNumber"] = begBlockNumber;
 			j["endBlockNumber"] = endBlockNumber;
 			j["rid"] = rid;
-			ArgInfo("{} {}", GetFunName(), j.dump(4));
+			ArgInfo("{} {}", GetFunName(), j);
 
 			boost::mutex::scoped_lock scoped_lock(lock);
 			if (_callback) {
 				nlohmann::json r = _callback->GetTransactions(address, begBlockNumber, endBlockNumber, rid);
-				ArgInfo("r => {}", r.dump(4));
+				ArgInfo("r => {}", r);
 
 				if (!r.empty()) {
 					int id = rid;
@@ -431,12 +431,12 @@ const std::string CALLBACK_IS_NULL_PROMPT = "callback is null";
 			j["begBlockNumber"] = begBlockNumber;
 			j["endBlockNumber"] = endBlockNumber;
 			j["rid"] = rid;
-			ArgInfo("{} {}", GetFunName(), j.dump(4));
+			ArgInfo("{} {}", GetFunName(), j);
 
 			boost::mutex::scoped_lock scoped_lock(lock);
 			if (_callback) {
 				nlohmann::json r = _callback->GetLogs(contract, address, event, begBlockNumber, endBlockNumber, rid);
-				ArgInfo("r => {}", r.dump(4));
+				ArgInfo("r => {}", r);
 
 				if (!r.empty()) {
 					int id = rid;
@@ -483,14 +483,14 @@ const std::string CALLBACK_IS_NULL_PROMPT = "callback is null";
 			j["blockNumberStart"] = blockNumberStart;
 			j["blockNumberStop"] = blockNumberStop;
 			j["rid"] = rid;
-			ArgInfo("{} {}", GetFunName(), j.dump(4));
+			ArgInfo("{} {}", GetFunName(), j);
 
 			boost::mutex::scoped_lock scoped_lock(lock);
 			if (_callback) {
 				int id = rid;
 				std::set<uint64_t> numberSet;
 				nlohmann::json r = _callback->GetTransactions(address, blockNumberStart, blockNumberStop, rid);
-				ArgInfo("getTransactions => {}", r.dump(4));
+				ArgInfo("getTransactions => {}", r);
 
 				if (!r.empty()) {
 					std::string from, to, blockNumber;
@@ -535,7 +535,7 @@ const std::string CALLBACK_IS_NULL_PROMPT = "callback is null";
 				ArgInfo("address: {}", encodedAddress);
 				ArgInfo("event: {}", selector);
 				r = _callback->GetLogs("", encodedAddress, selector, blockNumberStart, blockNumberStop, rid);
-				ArgInfo("getLogs => {}", r.dump(4));
+				ArgInfo("getLogs => {}", r);
 
 				if (!r.empty()) {
 					std::string blockNumber;
@@ -583,12 +583,12 @@ const std::string CALLBACK_IS_NULL_PROMPT = "callback is null";
 		void EthSidechainSubWallet::getTokens(int rid) {
 			nlohmann::json j;
 			j["rid"] = rid;
-			ArgInfo("{} {}", GetFunName(), j.dump(4));
+			ArgInfo("{} {}", GetFunName(), j);
 
 			boost::mutex::scoped_lock scoped_lock(lock);
 			if (_callback) {
 				nlohmann::json r = _callback->GetTokens(rid);
-				ArgInfo("r => {}", r.dump(4));
+				ArgInfo("r => {}", r);
 
 				if (!r.empty()) {
 					int id = rid;
@@ -635,12 +635,12 @@ const std::string CALLBACK_IS_NULL_PROMPT = "callback is null";
 		void EthSidechainSubWallet::getBlockNumber(int rid) {
 			nlohmann::json j;
 			j["rid"] = rid;
-			ArgInfo("{} {}", GetFunName(), j.dump(4));
+			ArgInfo("{} {}", GetFunName(), j);
 
 			boost::mutex::scoped_lock scoped_lock(lock);
 			if (_callback) {
 				nlohmann::json r = _callback->GetBlockNumber(rid);
-				ArgInfo("r => {}", r.dump(4));
+				ArgInfo("r => {}", r);
 				int id = rid;
 
 				if (!r.empty()) {
@@ -661,12 +661,12 @@ const std::string CALLBACK_IS_NULL_PROMPT = "callback is null";
 			nlohmann::json j;
 			j["address"] = address;
 			j["rid"] = rid;
-			ArgInfo("{} {}", GetFunName(), j.dump(4));
+			ArgInfo("{} {}", GetFunName(), j);
 
 			boost::mutex::scoped_lock scoped_lock(lock);
 			if (_callback) {
 				nlohmann::json r = _callback->GetNonce(address, rid);
-				ArgInfo("r => {}", r.dump(4));
+				ArgInfo("r => {}", r);
 				int id = rid;
 
 				if (!r.empty()) {
@@ -685,7 +685,7 @@ const std::string CALLBACK_IS_NULL_PROMPT = "callback is null";
 
 		void EthSidechainSubWallet::handleEWMEvent(const BREthereumEWMEvent &event) {
 			nlohmann::json eJson = EthereumEWM::EWMEvent2Json(event);
-			ArgInfo("{} {}", GetFunName(), eJson.dump(4));
+			ArgInfo("{} {}", GetFunName(), eJson);
 
 			boost::mutex::scoped_lock scoped_lock(lock);
 			if (_callback != nullptr) {
@@ -697,7 +697,7 @@ const std::string CALLBACK_IS_NULL_PROMPT = "callback is null";
 
 		void EthSidechainSubWallet::handlePeerEvent(const BREthereumPeerEvent &event) {
 			nlohmann::json eJson = EthereumEWM::PeerEvent2Json(event);;
-			ArgInfo("{} {}", GetFunName(), eJson.dump(4));
+			ArgInfo("{} {}", GetFunName(), eJson);
 
 			boost::mutex::scoped_lock scoped_lock(lock);
 			if (_callback != nullptr) {
@@ -711,7 +711,7 @@ const std::string CALLBACK_IS_NULL_PROMPT = "callback is null";
 													  const BREthereumWalletEvent &event) {
 			nlohmann::json eJson = EthereumEWM::WalletEvent2Json(event);
 			eJson["WalletSymbol"] = wallet->getSymbol();
-			ArgInfo("{} {}", GetFunName(), eJson.dump(4));
+			ArgInfo("{} {}", GetFunName(), eJson);
 
 			boost::mutex::scoped_lock scoped_lock(lock);
 			if (_callback != nullptr) {
@@ -724,7 +724,7 @@ const std::string CALLBACK_IS_NULL_PROMPT = "callback is null";
 		void EthSidechainSubWallet::handleTokenEvent(const EthereumTokenPtr &token, const BREthereumTokenEvent &event) {
 			nlohmann::json eJson = EthereumEWM::TokenEvent2Json(event);
 			eJson["WalletSymbol"] = token->getSymbol();
-			ArgInfo("{} {}", GetFunName(), eJson.dump(4));
+			ArgInfo("{} {}", GetFunName(), eJson);
 
 			boost::mutex::scoped_lock scoped_lock(lock);
 			if (_callback != nullptr) {
@@ -786,7 +786,7 @@ const std::string CALLBACK_IS_NULL_PROMPT = "callback is null";
 				}
 			}
 
-			ArgInfo("{} {}", GetFunName(), eJson.dump(4));
+			ArgInfo("{} {}", GetFunName(), eJson);
 			boost::mutex::scoped_lock scoped_lock(lock);
 			if (_callback != nullptr) {
 				_callback->OnETHSCEventHandled(eJson);
@@ -814,7 +814,7 @@ const std::string CALLBACK_IS_NULL_PROMPT = "callback is null";
 			j["Info"] = jinfo;
 			j["ChainID"] = _info->GetChainID();
 
-			ArgInfo("r => {}", j.dump());
+			ArgInfo("r => {}", j);
 			return j;
 		}
 
@@ -825,7 +825,7 @@ const std::string CALLBACK_IS_NULL_PROMPT = "callback is null";
 			j["Info"] = "not ready";
 			j["Summary"] = nlohmann::json();
 
-			ArgInfo("r => {}", j.dump());
+			ArgInfo("r => {}", j);
 			return j;
 		}
 
@@ -872,7 +872,7 @@ const std::string CALLBACK_IS_NULL_PROMPT = "callback is null";
 			j["Addresses"] = addresses;
 			j["MaxCount"] = 1;
 
-			ArgInfo("r => {}", j.dump());
+			ArgInfo("r => {}", j);
 			return j;
 		}
 
@@ -887,7 +887,7 @@ const std::string CALLBACK_IS_NULL_PROMPT = "callback is null";
 			j["PublicKeys"] = pubkey;
 			j["MaxCount"] = 1;
 
-			ArgInfo("r => {}", j.dump());
+			ArgInfo("r => {}", j);
 			return j;
 		}
 
@@ -924,7 +924,7 @@ const std::string CALLBACK_IS_NULL_PROMPT = "callback is null";
 			j["ID"] = GetTransferID(tx);
 			j["Fee"] = tx->getFee(EthereumAmount::Unit::ETHER_ETHER);
 
-			ArgInfo("r => {}", j.dump());
+			ArgInfo("r => {}", j);
 
 			return j;
 		}
@@ -938,7 +938,21 @@ const std::string CALLBACK_IS_NULL_PROMPT = "callback is null";
 
 			nlohmann::json j;
 
-			ArgInfo("r => {}", j.dump());
+			ArgInfo("r => {}", j);
+
+			return j;
+		}
+
+		nlohmann::json EthSidechainSubWallet::GetUTXOsByCursor(const std::string &cursor, uint32_t count,
+															   const std::string &address) const {
+			ArgInfo("{} {}", _walletID, GetFunName());
+			ArgInfo("cursor: {}", cursor);
+			ArgInfo("cnt: {}", count);
+			ArgInfo("addr: {}", address);
+
+			nlohmann::json j;
+
+			ArgInfo("r => {}", j);
 
 			return j;
 		}
@@ -949,14 +963,25 @@ const std::string CALLBACK_IS_NULL_PROMPT = "callback is null";
 
 			nlohmann::json j;
 
-			ArgInfo("r => {}", j.dump());
+			ArgInfo("r => {}", j);
+			return j;
+		}
+
+		nlohmann::json EthSidechainSubWallet::CreateConsolidateTransactions(const std::string &memo, uint32_t maxTxCount) {
+			ArgInfo("{} {}", _walletID, GetFunName());
+			ArgInfo("memo: {}", memo);
+			ArgInfo("maxTxCount: {}", maxTxCount);
+
+			nlohmann::json j;
+
+			ArgInfo("r => {}", j);
 			return j;
 		}
 
 		nlohmann::json EthSidechainSubWallet::SignTransaction(const nlohmann::json &tx,
 															  const std::string &payPassword) const {
 			ArgInfo("{} {}", _walletID, GetFunName());
-			ArgInfo("tx: {}", tx.dump());
+			ArgInfo("tx: {}", tx);
 			ArgInfo("passwd: *");
 
 			std::string tid;
@@ -980,24 +1005,35 @@ const std::string CALLBACK_IS_NULL_PROMPT = "callback is null";
 			nlohmann::json j = tx;
 			j["Hash"] = transfer->getOriginationTransactionHash();
 
-			ArgInfo("r => {}", j.dump());
+			ArgInfo("r => {}", j);
+			return j;
+		}
+
+		nlohmann::json EthSidechainSubWallet::SignTransactions(const nlohmann::json &txs,
+															   const std::string &payPassword) const {
+			ErrorChecker::CheckParam(!txs.is_array(), Error::InvalidArgument, "txs should be json array");
+
+			nlohmann::json j = nlohmann::json::array();
+			for (nlohmann::json::const_iterator it = txs.cbegin(); it != txs.cend(); ++it)
+				j.push_back(SignTransaction(*it, payPassword));
+
 			return j;
 		}
 
 		nlohmann::json EthSidechainSubWallet::GetTransactionSignedInfo(const nlohmann::json &tx) const {
 			ArgInfo("{} {}", _walletID, GetFunName());
-			ArgInfo("tx: {}", tx.dump());
+			ArgInfo("tx: {}", tx);
 
 			nlohmann::json j;
 
-			ArgInfo("r => {}", j.dump());
+			ArgInfo("r => {}", j);
 
 			return j;
 		}
 
 		nlohmann::json EthSidechainSubWallet::PublishTransaction(const nlohmann::json &tx) {
 			ArgInfo("{} {}", _walletID, GetFunName());
-			ArgInfo("tx: {}", tx.dump());
+			ArgInfo("tx: {}", tx);
 
 			std::string tid;
 			EthereumTransferPtr transfer;
@@ -1017,13 +1053,23 @@ const std::string CALLBACK_IS_NULL_PROMPT = "callback is null";
 			nlohmann::json j = tx;
 			j["TxHash"] = transfer->getOriginationTransactionHash();
 
-			ArgInfo("r => {}", j.dump());
+			ArgInfo("r => {}", j);
+			return j;
+		}
+
+		nlohmann::json EthSidechainSubWallet::PublishTransactions(const nlohmann::json &txs) {
+			ErrorChecker::CheckParam(!txs.is_array(), Error::InvalidArgument, "txs should be json array");
+
+			nlohmann::json j = nlohmann::json::array();
+			for (nlohmann::json::const_iterator it = txs.cbegin(); it != txs.cend(); ++it)
+				j.push_back(PublishTransaction(*it));
+
 			return j;
 		}
 
 		std::string EthSidechainSubWallet::ConvertToRawTransaction(const nlohmann::json &tx) {
 			ArgInfo("{} {}", _walletID, GetFunName());
-			ArgInfo("tx: {}", tx.dump());
+			ArgInfo("tx: {}", tx);
 
 			ArgInfo("r => ");
 
@@ -1122,11 +1168,21 @@ const std::string CALLBACK_IS_NULL_PROMPT = "callback is null";
 			j["MaxCount"] = transfers.size();
 			j["Transactions"] = txList;
 
-			ArgInfo("r => {}", j.dump());
+			ArgInfo("r => {}", j);
 
 			return j;
 		}
 
+		nlohmann::json EthSidechainSubWallet::GetTransactionsByCursor(const std::string &cursor,
+																	  uint32_t count) const {
+			ArgInfo("{} {}", _walletID, GetFunName());
+			ArgInfo("cursor: {}, cnt: {}", cursor, count);
+
+			ErrorChecker::ThrowParamException(Error::UnsupportOperation, "use GetAllTransaction() instead");
+
+			return nlohmann::json();
+		}
+
 		nlohmann::json EthSidechainSubWallet::GetAllCoinBaseTransaction(uint32_t start, uint32_t count,
 																		const std::string &txID) const {
 			ArgInfo("{} {}", _walletID, GetFunName());
@@ -1141,7 +1197,7 @@ const std::string CALLBACK_IS_NULL_PROMPT = "callback is null";
 
 			nlohmann::json j;
 
-			ArgInfo("r => {}", j.dump());
+			ArgInfo("r => {}", j);
 			return j;
 		}
 
@@ -1151,7 +1207,7 @@ const std::string CALLBACK_IS_NULL_PROMPT = "callback is null";
 
 			j["BlockNumber"] = _client->_ewm->getBlockHeight();
 
-			ArgInfo("r => {}", j.dump());
+			ArgInfo("r => {}", j);
 			return j;
 		}
 
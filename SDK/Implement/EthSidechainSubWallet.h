@@ -165,19 +165,35 @@ namespace Elastos {
 				uint32_t count,
 				const std::string &address) const;
 
+			virtual nlohmann::json GetUTXOsByCursor(
+				const std::string &cursor,
+				uint32_t count,
+				const std::string &address) const;
+
 			virtual nlohmann::json CreateConsolidateTransaction(
 				const std::string &memo);
 
+			virtual nlohmann::json CreateConsolidateTransactions(
+				const std::string &memo,
+				uint32_t maxTxCount);
+
 			virtual nlohmann::json SignTransaction(
 				const nlohmann::json &tx,
 				const std::string &payPassword) const;
 
+			virtual nlohmann::json SignTransactions(
+				const nlohmann::json &txs,
+				const std::string &payPassword) const;
+
 			virtual nlohmann::json GetTransactionSignedInfo(
 				const nlohmann::json &tx) const;
 
 			virtual nlohmann::json PublishTransaction(
 				const nlohmann::json &tx);
 
+			virtual nlohmann::json PublishTransactions(
+				const nlohmann::json &txs);
+
 			virtual std::string ConvertToRawTransaction(const nlohmann::json &tx);
 
 			virtual nlohmann::json GetAllTransaction(
@@ -185,6 +201,10 @@ namespace Elastos {
 				uint32_t count,
 				const std::string &txid) const;
 
+			virtual nlohmann::json GetTransactionsByCursor(
+				const std::string &cursor,
+				uint32_t count) const;
+
 			virtual nlohmann::json GetAllCoinBaseTransaction(
 				uint32_t start,
 				uint32_t count,
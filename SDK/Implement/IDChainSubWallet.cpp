@@ -55,7 +55,7 @@ namespace Elastos {
 		IDChainSubWallet::CreateIDTransaction(const nlohmann::json &payloadJson, const std::string &memo, const std::string &fee) {
 			WalletPtr wallet = _walletManager->GetWallet();
 			ArgInfo("{} {}", wallet->GetWalletID(), GetFunName());
-			ArgInfo("payload: {}", payloadJson.dump());
+			ArgInfo("payload: {}", payloadJson);
 			ArgInfo("memo: {}", memo);
 			ArgInfo("fee: {}", fee);
 
@@ -105,7 +105,7 @@ namespace Elastos {
 			nlohmann::json result;
 			EncodeTx(result, tx);
 
-			ArgInfo("r => {}", result.dump());
+			ArgInfo("r => {}", result);
 
 			return result;
 		}
@@ -129,7 +129,7 @@ namespace Elastos {
 			j["DID"] = didJson;
 			j["MaxCount"] = maxCount;
 
-			ArgInfo("r => {}", j.dump());
+			ArgInfo("r => {}", j);
 			return j;
 		}
 
@@ -150,7 +150,7 @@ namespace Elastos {
 			j["CID"] = cidJosn;
 			j["MaxCount"] = maxCount;
 
-			ArgInfo("r => {}", j.dump());
+			ArgInfo("r => {}", j);
 
 			return j;
 		}
@@ -105,7 +105,7 @@ namespace Elastos {
 			nlohmann::json result;
 			EncodeTx(result, tx);
 
-			ArgInfo("r => {}", result.dump());
+			ArgInfo("r => {}", result);
 			return result;
 		}
 
@@ -169,7 +169,7 @@ namespace Elastos {
 
 			nlohmann::json payloadJson = pr.ToJson(0);
 
-			ArgInfo("r => {}", payloadJson.dump());
+			ArgInfo("r => {}", payloadJson);
 			return payloadJson;
 		}
 
@@ -196,7 +196,7 @@ namespace Elastos {
 			pc.SetSignature(_walletManager->GetWallet()->SignWithOwnerKey(pcUnsigned, payPasswd));
 
 			nlohmann::json payloadJson = pc.ToJson(0);
-			ArgInfo("r => {}", payloadJson.dump());
+			ArgInfo("r => {}", payloadJson);
 			return payloadJson;
 		}
 
@@ -209,7 +209,7 @@ namespace Elastos {
 
 			ArgInfo("{} {}", _walletManager->GetWallet()->GetWalletID(), GetFunName());
 			ArgInfo("fromAddr: {}", fromAddress);
-			ArgInfo("payload: {}", payloadJson.dump());
+			ArgInfo("payload: {}", payloadJson);
 			ArgInfo("amount: {}", amount);
 			ArgInfo("memo: {}", memo);
 
@@ -242,7 +242,7 @@ namespace Elastos {
 			nlohmann::json result;
 			EncodeTx(result, tx);
 
-			ArgInfo("r => {}", result.dump());
+			ArgInfo("r => {}", result);
 			return result;
 		}
 
@@ -254,7 +254,7 @@ namespace Elastos {
 			WalletPtr wallet = _walletManager->GetWallet();
 			ArgInfo("{} {}", wallet->GetWalletID(), GetFunName());
 			ArgInfo("fromAddr: {}", fromAddress);
-			ArgInfo("payload: {}", payloadJson.dump());
+			ArgInfo("payload: {}", payloadJson);
 			ArgInfo("memo: {}", memo);
 
 			PayloadPtr payload = PayloadPtr(new ProducerInfo());
@@ -280,7 +280,7 @@ namespace Elastos {
 			nlohmann::json result;
 			EncodeTx(result, tx);
 
-			ArgInfo("r => {}", result.dump());
+			ArgInfo("r => {}", result);
 			return result;
 		}
 
@@ -292,7 +292,7 @@ namespace Elastos {
 			WalletPtr wallet = _walletManager->GetWallet();
 			ArgInfo("{} {}", wallet->GetWalletID(), GetFunName());
 			ArgInfo("fromAddr: {}", fromAddress);
-			ArgInfo("payload: {}", payloadJson.dump());
+			ArgInfo("payload: {}", payloadJson);
 			ArgInfo("memo: {}", memo);
 
 			PayloadPtr payload = PayloadPtr(new CancelProducer());
@@ -318,7 +318,7 @@ namespace Elastos {
 			nlohmann::json result;
 			EncodeTx(result, tx);
 
-			ArgInfo("r => {}", result.dump());
+			ArgInfo("r => {}", result);
 			return result;
 		}
 
@@ -345,7 +345,7 @@ namespace Elastos {
 			nlohmann::json result;
 			EncodeTx(result, tx);
 
-			ArgInfo("r => {}", result.dump());
+			ArgInfo("r => {}", result);
 			return result;
 		}
 
@@ -429,7 +429,10 @@ namespace Elastos {
 				}
 			}
 
-			if (changed) pv->SetVoteContent(voteContent);
+			if (changed) {
+				pv->SetVoteContent(voteContent);
+				tx->ResetHash();
+			}
 		}
 
 		nlohmann::json MainchainSubWallet::CreateVoteProducerTransaction(
@@ -442,9 +445,9 @@ namespace Elastos {
 			ArgInfo("{} {}", _walletManager->GetWallet()->GetWalletID(), GetFunName());
 			ArgInfo("fromAddr: {}", fromAddress);
 			ArgInfo("stake: {}", stake);
-			ArgInfo("pubkeys: {}", publicKeys.dump());
+			ArgInfo("pubkeys: {}", publicKeys);
 			ArgInfo("memo: {}", memo);
-			ArgInfo("invalidCandidates: {}", invalidCandidates.dump());
+			ArgInfo("invalidCandidates: {}", invalidCandidates);
 
 			bool max = false;
 			BigInt bgStake;
@@ -485,7 +488,7 @@ namespace Elastos {
 			}
 			result["DropVotes"] = dropedTypes;
 
-			ArgInfo("r => {}", result.dump());
+			ArgInfo("r => {}", result);
 			return result;
 		}
 
@@ -538,7 +541,7 @@ namespace Elastos {
 			for (std::map<std::string, BigInt>::iterator it = votedList.begin(); it != votedList.end(); ++it)
 				j[(*it).first] = (*it).second.getDec();
 
-			ArgInfo("r => {}", j.dump());
+			ArgInfo("r => {}", j);
 
 			return j;
 		}
@@ -588,7 +591,7 @@ namespace Elastos {
 				}
 			}
 
-			ArgInfo("r => {}", j.dump());
+			ArgInfo("r => {}", j);
 			return j;
 		}
 
@@ -632,7 +635,7 @@ namespace Elastos {
 			nlohmann::json payloadJson = crInfo.ToJson(CRInfoDIDVersion);
 			payloadJson["Digest"] = digest.GetHex();
 
-			ArgInfo("r => {}", payloadJson.dump());
+			ArgInfo("r => {}", payloadJson);
 			return payloadJson;
 		}
 
@@ -653,7 +656,7 @@ namespace Elastos {
 			nlohmann::json payloadJson = unregisterCR.ToJson(0);
 			payloadJson["Digest"] = digest.GetHex();
 
-			ArgInfo("r => {}", payloadJson.dump());
+			ArgInfo("r => {}", payloadJson);
 			return payloadJson;
 		}
 
@@ -666,7 +669,7 @@ namespace Elastos {
 			WalletPtr wallet = _walletManager->GetWallet();
 			ArgInfo("{} {}", wallet->GetWalletID(), GetFunName());
 			ArgInfo("fromAddr: {}", fromAddress);
-			ArgInfo("payload: {}", payloadJSON.dump());
+			ArgInfo("payload: {}", payloadJSON);
 			ArgInfo("amount: {}", amount);
 			ArgInfo("memo: {}", memo);
 
@@ -705,7 +708,7 @@ namespace Elastos {
 			nlohmann::json result;
 			EncodeTx(result, tx);
 
-			ArgInfo("r => {}", result.dump());
+			ArgInfo("r => {}", result);
 			return result;
 		}
 
@@ -716,7 +719,7 @@ namespace Elastos {
 			WalletPtr wallet = _walletManager->GetWallet();
 			ArgInfo("{} {}", wallet->GetWalletID(), GetFunName());
 			ArgInfo("fromAddr: {}", fromAddress);
-			ArgInfo("payload: {}", payloadJSON.dump());
+			ArgInfo("payload: {}", payloadJSON);
 			ArgInfo("memo: {}", memo);
 
 			PayloadPtr payload = PayloadPtr(new CRInfo());
@@ -743,7 +746,7 @@ namespace Elastos {
 			nlohmann::json result;
 			EncodeTx(result, tx);
 
-			ArgInfo("r => {}", result.dump());
+			ArgInfo("r => {}", result);
 			return result;
 
 		}
@@ -755,7 +758,7 @@ namespace Elastos {
 			WalletPtr wallet = _walletManager->GetWallet();
 			ArgInfo("{} {}", wallet->GetWalletID(), GetFunName());
 			ArgInfo("fromAddr: {}", fromAddress);
-			ArgInfo("payload: {}", payloadJSON.dump());
+			ArgInfo("payload: {}", payloadJSON);
 			ArgInfo("memo: {}", memo);
 
 			ErrorChecker::CheckParam(payloadJSON.find("Signature") == payloadJSON.end() ||
@@ -785,7 +788,7 @@ namespace Elastos {
 			nlohmann::json result;
 			EncodeTx(result, tx);
 
-			ArgInfo("r => {}", result.dump());
+			ArgInfo("r => {}", result);
 			return result;
 		}
 
@@ -812,7 +815,7 @@ namespace Elastos {
 
 			nlohmann::json result;
 			EncodeTx(result, tx);
-			ArgInfo("r => {}", result.dump());
+			ArgInfo("r => {}", result);
 			return result;
 		}
 
@@ -823,9 +826,9 @@ namespace Elastos {
 				const nlohmann::json &invalidCandidates) {
 			ArgInfo("{} {}", _walletManager->GetWallet()->GetWalletID(), GetFunName());
 			ArgInfo("fromAddr: {}", fromAddress);
-			ArgInfo("votes: {}", votes.dump());
+			ArgInfo("votes: {}", votes);
 			ArgInfo("memo: {}", memo);
-			ArgInfo("invalidCandidates: {}", invalidCandidates.dump());
+			ArgInfo("invalidCandidates: {}", invalidCandidates);
 
 			ErrorChecker::CheckParam(!votes.is_object(), Error::Code::JsonFormatError, "votes is error json format");
 
@@ -866,7 +869,7 @@ namespace Elastos {
 			}
 			result["DropVotes"] = dropedTypes;
 
-			ArgInfo("r => {}", result.dump());
+			ArgInfo("r => {}", result);
 
 			return result;
 		}
@@ -911,7 +914,7 @@ namespace Elastos {
 			for (std::map<std::string, BigInt>::iterator it = votedList.begin(); it != votedList.end(); ++it)
 				j[(*it).first] = (*it).second.getDec();
 
-			ArgInfo("r => {}", j.dump());
+			ArgInfo("r => {}", j);
 
 			return j;
 		}
@@ -971,14 +974,14 @@ namespace Elastos {
 				}
 			}
 
-			ArgInfo("r => {}", j.dump());
+			ArgInfo("r => {}", j);
 			return j;
 		}
 
 		std::string MainchainSubWallet::CRCouncilMemberClaimNodeDigest(const nlohmann::json &payload) const {
 			WalletPtr wallet = _walletManager->GetWallet();
 			ArgInfo("{} {}", wallet->GetWalletID(), GetFunName());
-			ArgInfo("payload: {}", payload.dump());
+			ArgInfo("payload: {}", payload);
 
 
 			uint8_t version = CRCouncilMemberClaimNodeVersion;
@@ -1002,7 +1005,7 @@ namespace Elastos {
 		nlohmann::json MainchainSubWallet::CreateCRCouncilMemberClaimNodeTransaction(const nlohmann::json &payload, const std::string &memo) {
 			WalletPtr wallet = _walletManager->GetWallet();
 			ArgInfo("{} {}", wallet->GetWalletID(), GetFunName());
-			ArgInfo("payload: {}", payload.dump());
+			ArgInfo("payload: {}", payload);
 			ArgInfo("memo: {}", memo);
 
 			uint8_t version = CRCProposalDefaultVersion;
@@ -1031,7 +1034,7 @@ namespace Elastos {
 
 			nlohmann::json result;
 			EncodeTx(result, tx);
-			ArgInfo("r => {}", result.dump());
+			ArgInfo("r => {}", result);
 
 			return result;
 		}
@@ -1093,14 +1096,14 @@ namespace Elastos {
 
 			}
 
-			ArgInfo("r => {}", jinfo.dump());
+			ArgInfo("r => {}", jinfo);
 
 			return jinfo;
 		}
 
 		std::string MainchainSubWallet::ProposalOwnerDigest(const nlohmann::json &payload) const {
 			ArgInfo("{} {}", _walletManager->GetWallet()->GetWalletID(), GetFunName());
-			ArgInfo("payload: {}", payload.dump());
+			ArgInfo("payload: {}", payload);
 
 			CRCProposal proposal;
 			uint8_t version = CRCProposalDefaultVersion;
@@ -1126,7 +1129,7 @@ namespace Elastos {
 
 		std::string MainchainSubWallet::ProposalCRCouncilMemberDigest(const nlohmann::json &payload) const {
 			ArgInfo("{} {}", _walletManager->GetWallet()->GetWalletID(), GetFunName());
-			ArgInfo("payload: {}", payload.dump());
+			ArgInfo("payload: {}", payload);
 
 			CRCProposal proposal;
 			uint8_t version = CRCProposalDefaultVersion;
@@ -1152,7 +1155,7 @@ namespace Elastos {
 
 		std::string MainchainSubWallet::CalculateProposalHash(const nlohmann::json &payload) const {
 			ArgInfo("{} {}", _walletManager->GetWallet()->GetWalletID(), GetFunName());
-			ArgInfo("payload: {}", payload.dump());
+			ArgInfo("payload: {}", payload);
 
 			PayloadPtr p = PayloadPtr(new CRCProposal());
 			uint8_t version = CRCProposalDefaultVersion;
@@ -1183,7 +1186,7 @@ namespace Elastos {
 																	 const std::string &memo) {
 			WalletPtr wallet = _walletManager->GetWallet();
 			ArgInfo("{} {}", wallet->GetWalletID(), GetFunName());
-			ArgInfo("payload: {}", payload.dump());
+			ArgInfo("payload: {}", payload);
 			ArgInfo("memo: {}", memo);
 
 			PayloadPtr p = PayloadPtr(new CRCProposal());
@@ -1218,13 +1221,13 @@ namespace Elastos {
 			nlohmann::json result;
 			EncodeTx(result, tx);
 
-			ArgInfo("r => {}", result.dump());
+			ArgInfo("r => {}", result);
 			return result;
 		}
 
 		std::string MainchainSubWallet::ProposalReviewDigest(const nlohmann::json &payload) const {
 			ArgInfo("{} {}", _walletManager->GetWallet()->GetWalletID(), GetFunName());
-			ArgInfo("payload: {}", payload.dump());
+			ArgInfo("payload: {}", payload);
 
 			CRCProposalReview proposalReview;
 			uint8_t version = CRCProposalReviewDefaultVersion;
@@ -1253,7 +1256,7 @@ namespace Elastos {
 																		   const std::string &memo) {
 			WalletPtr wallet = _walletManager->GetWallet();
 			ArgInfo("{} {}", wallet->GetWalletID(), GetFunName());
-			ArgInfo("payload: {}", payload.dump());
+			ArgInfo("payload: {}", payload);
 			ArgInfo("memo: {}", memo);
 
 			PayloadPtr p = PayloadPtr(new CRCProposalReview());
@@ -1287,7 +1290,7 @@ namespace Elastos {
 			nlohmann::json result;
 			EncodeTx(result, tx);
 
-			ArgInfo("r => {}", result.dump());
+			ArgInfo("r => {}", result);
 			return result;
 		}
 
@@ -1297,9 +1300,9 @@ namespace Elastos {
 		                                                                    const nlohmann::json &invalidCandidates) {
 			ArgInfo("{} {}", _walletManager->GetWallet()->GetWalletID(), GetFunName());
 			ArgInfo("fromAddr: {}", fromAddress);
-			ArgInfo("votes: {}", votes.dump());
+			ArgInfo("votes: {}", votes);
 			ArgInfo("memo: {}", memo);
-			ArgInfo("invalidCandidates: {}", invalidCandidates.dump());
+			ArgInfo("invalidCandidates: {}", invalidCandidates);
 
 			ErrorChecker::CheckParam(!votes.is_object(), Error::Code::JsonFormatError, "votes is error json format");
 			BigInt bgStake = 0;
@@ -1333,7 +1336,7 @@ namespace Elastos {
 			}
 			result["DropVotes"] = dropedTypes;
 
-			ArgInfo("r => {}", result.dump());
+			ArgInfo("r => {}", result);
 
 			return result;
 		}
@@ -1344,9 +1347,9 @@ namespace Elastos {
 		                                                                   const nlohmann::json &invalidCandidates) {
 			ArgInfo("{} {}", _walletManager->GetWallet()->GetWalletID(), GetFunName());
 			ArgInfo("fromAddr: {}", fromAddress);
-			ArgInfo("votes: {}", votes.dump());
+			ArgInfo("votes: {}", votes);
 			ArgInfo("memo: {}", memo);
-			ArgInfo("invalidCandidates: {}", invalidCandidates.dump());
+			ArgInfo("invalidCandidates: {}", invalidCandidates);
 
 			ErrorChecker::CheckParam(!votes.is_object(), Error::Code::JsonFormatError, "votes is error json format");
 			BigInt bgStake = 0;
@@ -1383,14 +1386,14 @@ namespace Elastos {
 			}
 			result["DropVotes"] = droppedTypes;
 
-			ArgInfo("r => {}", result.dump());
+			ArgInfo("r => {}", result);
 
 			return result;
 		}
 
 		std::string MainchainSubWallet::ProposalTrackingOwnerDigest(const nlohmann::json &payload) const {
 			ArgInfo("{} {}", _walletManager->GetWallet()->GetWalletID(), GetFunName());
-			ArgInfo("payload: {}", payload.dump());
+			ArgInfo("payload: {}", payload);
 
 			uint8_t version = CRCProposalTrackingDefaultVersion;
 			CRCProposalTracking proposalTracking;
@@ -1415,7 +1418,7 @@ namespace Elastos {
 
 		std::string MainchainSubWallet::ProposalTrackingNewOwnerDigest(const nlohmann::json &payload) const {
 			ArgInfo("{} {}", _walletManager->GetWallet()->GetWalletID(), GetFunName());
-			ArgInfo("payload: {}", payload.dump());
+			ArgInfo("payload: {}", payload);
 
 			uint8_t version = CRCProposalTrackingDefaultVersion;
 			CRCProposalTracking proposalTracking;
@@ -1441,7 +1444,7 @@ namespace Elastos {
 
 		std::string MainchainSubWallet::ProposalTrackingSecretaryDigest(const nlohmann::json &payload) const {
 			ArgInfo("{} {}", _walletManager->GetWallet()->GetWalletID(), GetFunName());
-			ArgInfo("payload: {}", payload.dump());
+			ArgInfo("payload: {}", payload);
 
 			uint8_t version = CRCProposalTrackingDefaultVersion;
 			CRCProposalTracking proposalTracking;
@@ -1469,7 +1472,7 @@ namespace Elastos {
 		MainchainSubWallet::CreateProposalTrackingTransaction(const nlohmann::json &payload, const std::string &memo) {
 			WalletPtr wallet = _walletManager->GetWallet();
 			ArgInfo("{} {}", wallet->GetWalletID(), GetFunName());
-			ArgInfo("payload: {}", payload.dump());
+			ArgInfo("payload: {}", payload);
 			ArgInfo("memo: {}", memo);
 
 			uint8_t version = CRCProposalTrackingDefaultVersion;
@@ -1502,7 +1505,7 @@ namespace Elastos {
 
 			nlohmann::json result;
 			EncodeTx(result, tx);
-			ArgInfo("r => {}", result.dump());
+			ArgInfo("r => {}", result);
 
 			return result;
 		}
@@ -1510,7 +1513,7 @@ namespace Elastos {
 		std::string MainchainSubWallet::ProposalSecretaryGeneralElectionDigest(
 			const nlohmann::json &payload) const {
 			ArgInfo("{} {}", _walletManager->GetWallet()->GetWalletID(), GetFunName());
-			ArgInfo("payload: {}", payload.dump());
+			ArgInfo("payload: {}", payload);
 
 			uint8_t version = CRCProposalDefaultVersion;
 			CRCProposal proposal;
@@ -1539,7 +1542,7 @@ namespace Elastos {
 		std::string MainchainSubWallet::ProposalSecretaryGeneralElectionCRCouncilMemberDigest(
 			const nlohmann::json &payload) const {
 			ArgInfo("{} {}", _walletManager->GetWallet()->GetWalletID(), GetFunName());
-			ArgInfo("payload: {}", payload.dump());
+			ArgInfo("payload: {}", payload);
 
 			uint8_t version = CRCProposalDefaultVersion;
 			CRCProposal proposal;
@@ -1569,7 +1572,7 @@ namespace Elastos {
 			const nlohmann::json &payload, const std::string &memo) {
 			WalletPtr wallet = _walletManager->GetWallet();
 			ArgInfo("{} {}", wallet->GetWalletID(), GetFunName());
-			ArgInfo("payload: {}", payload.dump());
+			ArgInfo("payload: {}", payload);
 			ArgInfo("memo: {}", memo);
 
 			uint8_t version = CRCProposalDefaultVersion;
@@ -1604,7 +1607,7 @@ namespace Elastos {
 
 			nlohmann::json result;
 			EncodeTx(result, tx);
-			ArgInfo("r => {}", result.dump());
+			ArgInfo("r => {}", result);
 
 			return result;
 		}
@@ -1614,7 +1617,7 @@ namespace Elastos {
 		//////////////////////////////////////////////////
 		std::string MainchainSubWallet::ProposalChangeOwnerDigest(const nlohmann::json &payload) const {
 			ArgInfo("{} {}", _walletManager->GetWallet()->GetWalletID(), GetFunName());
-			ArgInfo("payload: {}", payload.dump());
+			ArgInfo("payload: {}", payload);
 
 			uint8_t version = CRCProposalDefaultVersion;
 			CRCProposal proposal;
@@ -1642,7 +1645,7 @@ namespace Elastos {
 
 		std::string MainchainSubWallet::ProposalChangeOwnerCRCouncilMemberDigest(const nlohmann::json &payload) const {
 			ArgInfo("{} {}", _walletManager->GetWallet()->GetWalletID(), GetFunName());
-			ArgInfo("payload: {}", payload.dump());
+			ArgInfo("payload: {}", payload);
 
 			uint8_t version = CRCProposalDefaultVersion;
 			CRCProposal proposal;
@@ -1672,7 +1675,7 @@ namespace Elastos {
 			const nlohmann::json &payload, const std::string &memo) {
 			WalletPtr wallet = _walletManager->GetWallet();
 			ArgInfo("{} {}", wallet->GetWalletID(), GetFunName());
-			ArgInfo("payload: {}", payload.dump());
+			ArgInfo("payload: {}", payload);
 			ArgInfo("memo: {}", memo);
 
 			uint8_t version = CRCProposalDefaultVersion;
@@ -1707,7 +1710,7 @@ namespace Elastos {
 
 			nlohmann::json result;
 			EncodeTx(result, tx);
-			ArgInfo("r => {}", result.dump());
+			ArgInfo("r => {}", result);
 
 			return result;
 		}
@@ -1717,7 +1720,7 @@ namespace Elastos {
 		//////////////////////////////////////////////////
 		std::string MainchainSubWallet::TerminateProposalOwnerDigest(const nlohmann::json &payload) const {
 			ArgInfo("{} {}", _walletManager->GetWallet()->GetWalletID(), GetFunName());
-			ArgInfo("payload: {}", payload.dump());
+			ArgInfo("payload: {}", payload);
 
 			uint8_t version = CRCProposalDefaultVersion;
 			CRCProposal proposal;
@@ -1745,7 +1748,7 @@ namespace Elastos {
 
 		std::string MainchainSubWallet::TerminateProposalCRCouncilMemberDigest(const nlohmann::json &payload) const {
 			ArgInfo("{} {}", _walletManager->GetWallet()->GetWalletID(), GetFunName());
-			ArgInfo("payload: {}", payload.dump());
+			ArgInfo("payload: {}", payload);
 
 			uint8_t version = CRCProposalDefaultVersion;
 			CRCProposal proposal;
@@ -1775,7 +1778,7 @@ namespace Elastos {
 			const nlohmann::json &payload, const std::string &memo) {
 			WalletPtr wallet = _walletManager->GetWallet();
 			ArgInfo("{} {}", wallet->GetWalletID(), GetFunName());
-			ArgInfo("payload: {}", payload.dump());
+			ArgInfo("payload: {}", payload);
 			ArgInfo("memo: {}", memo);
 
 			uint8_t version = CRCProposalDefaultVersion;
@@ -1810,14 +1813,14 @@ namespace Elastos {
 
 			nlohmann::json result;
 			EncodeTx(result, tx);
-			ArgInfo("r => {}", result.dump());
+			ArgInfo("r => {}", result);
 
 			return result;
 		}
 
 		std::string MainchainSubWallet::ProposalWithdrawDigest(const nlohmann::json &payload) const {
 			ArgInfo("{} {}", _walletManager->GetWallet()->GetWalletID(), GetFunName());
-			ArgInfo("payload: {}", payload.dump());
+			ArgInfo("payload: {}", payload);
 
 			uint8_t version = CRCProposalWithdrawVersion_01;
 			CRCProposalWithdraw proposalWithdraw;
@@ -1840,7 +1843,7 @@ namespace Elastos {
 																			 const std::string &memo) {
 			WalletPtr wallet = _walletManager->GetWallet();
 			ArgInfo("{} {}", wallet->GetWalletID(), GetFunName());
-			ArgInfo("payload: {}", payload.dump());
+			ArgInfo("payload: {}", payload);
 			ArgInfo("memo: {}", memo);
 
 			uint8_t version = CRCProposalWithdrawVersion_01;
@@ -1870,7 +1873,7 @@ namespace Elastos {
 
 			nlohmann::json result;
 			EncodeTx(result, tx);
-			ArgInfo("r => {}", result.dump());
+			ArgInfo("r => {}", result);
 
 			return result;
 		}
@@ -328,7 +328,7 @@ namespace Elastos {
 
 			nlohmann::json j = _account->GetPubKeyInfo();
 
-			ArgInfo("r => {}", j.dump());
+			ArgInfo("r => {}", j);
 			return j;
 		}
 
@@ -337,7 +337,7 @@ namespace Elastos {
 
 			nlohmann::json j = _account->ExportReadonlyWallet();
 
-			ArgInfo("r => {}", j.dump());
+			ArgInfo("r => {}", j);
 			return j;
 		}
 
@@ -568,7 +568,7 @@ namespace Elastos {
 
 			nlohmann::json info = _account->GetBasicInfo();
 
-			ArgInfo("r => {}", info.dump());
+			ArgInfo("r => {}", info);
 			return info;
 		}
 
@@ -576,6 +576,18 @@ namespace Elastos {
 			return _account->Equal(wallet._account);
 		}
 
+		nlohmann::json MasterWallet::GetNetworkStats() const {
+			nlohmann::json j = nlohmann::json::object();
+
+			for (WalletMap::const_iterator it = _createdWallets.cbegin(); it != _createdWallets.cend(); ++it) {
+				SubWallet *subWallet = dynamic_cast<SubWallet*>(it->second);
+				if (subWallet)
+					j[it->first] = subWallet->GetNetworkStats();
+			}
+
+			return j;
+		}
+
 		void MasterWallet::FlushData() {
 			for (WalletMap::const_iterator it = _createdWallets.cbegin(); it != _createdWallets.cend(); ++it) {
 				SubWallet *subWallet = dynamic_cast<SubWallet*>(it->second);
@@ -68,6 +68,9 @@ namespace Elastos {
 
 			void FlushData();
 
+			// network stats of every sub wallet, keyed by chain ID
+			nlohmann::json GetNetworkStats() const;
+
 		public: //override from IMasterWallet
 
 			static std::string GenerateMnemonic(const std::string &language, const std::string &rootPath,
@@ -33,6 +33,7 @@
 #include <MasterWalletManager.h>
 #include <CMakeConfig.h>
 #include <Common/Lockable.h>
+#include <P2P/NetworkStats.h>
 
 #include <boost/filesystem.hpp>
 
@@ -137,6 +138,8 @@ namespace Elastos {
 			_config = nullptr;
 			delete _lock;
 			_lock = nullptr;
+
+			Log::shutdown();
 		}
 
 		void MasterWalletManager::LoadMasterWalletID() {
@@ -240,7 +243,7 @@ namespace Elastos {
 																		time_t timestamp) {
 			ArgInfo("{}", GetFunName());
 			ArgInfo("masterWalletID: {}", masterWalletID);
-			ArgInfo("cosigners: {}", cosigners.dump());
+			ArgInfo("cosigners: {}", cosigners);
 			ArgInfo("m: {}", m);
 			ArgInfo("singleAddress: {}", singleAddress);
 			ArgInfo("compatible: {}", compatible);
@@ -297,7 +300,7 @@ namespace Elastos {
 			ArgInfo("masterWalletID: {}", masterWalletID);
 			ArgInfo("xprv: *");
 			ArgInfo("payPasswd: *");
-			ArgInfo("cosigners: {}", cosigners.dump());
+			ArgInfo("cosigners: {}", cosigners);
 			ArgInfo("m: {}", m);
 			ArgInfo("singleAddress: {}", singleAddress);
 			ArgInfo("compatible: {}", compatible);
@@ -360,7 +363,7 @@ namespace Elastos {
 			ArgInfo("mnemonic: *");
 			ArgInfo("passphrase: *, empty: {}", passphrase.empty());
 			ArgInfo("payPasswd: *");
-			ArgInfo("cosigners: {}", cosigners.dump());
+			ArgInfo("cosigners: {}", cosigners);
 			ArgInfo("m: {}", m);
 			ArgInfo("singleAddress: {}", singleAddress);
 			ArgInfo("compatible: {}", compatible);
@@ -526,7 +529,7 @@ namespace Elastos {
 			const nlohmann::json &walletJson) {
 			ArgInfo("{}", GetFunName());
 			ArgInfo("masterWalletID: {}", masterWalletID);
-			ArgInfo("walletJson: {}", walletJson.dump());
+			ArgInfo("walletJson: {}", walletJson);
 
 			boost::mutex::scoped_lock scoped_lock(_lock->GetLock());
 
@@ -567,6 +570,39 @@ namespace Elastos {
 						  });
 		}
 
+		nlohmann::json MasterWalletManager::GetNetworkStats() const {
+			ArgInfo("{}", GetFunName());
+
+			nlohmann::json j = nlohmann::json::object();
+
+			boost::mutex::scoped_lock scoped_lock(_lock->GetLock());
+			for (MasterWalletMap::const_iterator it = _masterWalletMap.cbegin(); it != _masterWalletMap.cend(); ++it) {
+				MasterWallet *masterWallet = dynamic_cast<MasterWallet *>(it->second);
+				if (masterWallet)
+					j[it->first] = masterWallet->GetNetworkStats();
+			}
+
+			ArgInfo("r => {} wallets", j.size());
+			return j;
+		}
+
+		std::string MasterWalletManager::GetNetworkStatsText() const {
+			ArgInfo("{}", GetFunName());
+
+			nlohmann::json stats = GetNetworkStats();
+			std::string text;
+
+			for (nlohmann::json::const_iterator w = stats.cbegin(); w != stats.cend(); ++w) {
+				for (nlohmann::json::const_iterator c = w.value().cbegin(); c != w.value().cend(); ++c) {
+					std::string labels = "wallet=\"" + w.key() + "\",chain=\"" + c.key() + "\"";
+					text += NetworkStats::ToText(c.value(), labels);
+				}
+			}
+
+			ArgInfo("r => {} bytes", text.size());
+			return text;
+		}
+
 		void MasterWalletManager::SetLogLevel(const std::string &level) {
 			ArgInfo("{}", GetFunName());
 			ArgInfo("level: {}", level);
@@ -0,0 +1,68 @@
+// Copyright (c) 2012-2019 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "PublishProgress.h"
+
+namespace Elastos {
+	namespace ElaWallet {
+
+		PublishProgress::PublishProgress() :
+			_results(nlohmann::json::array()),
+			_failedHashes(nlohmann::json::array()),
+			_done(0),
+			_failed(0),
+			_total(0),
+			_reportTime(0) {
+		}
+
+		void PublishProgress::Add(const std::string &txHash, time_t now) {
+			if (_pending.empty()) {
+				_results = nlohmann::json::array();
+				_failedHashes = nlohmann::json::array();
+				_done = _failed = _total = 0;
+				_reportTime = now;
+			}
+
+			if (_pending.insert(txHash).second)
+				_total++;
+		}
+
+		bool PublishProgress::Result(const std::string &txHash, const nlohmann::json &result, time_t now,
+									 nlohmann::json &report) {
+			report = nlohmann::json();
+			if (_pending.erase(txHash) == 0)
+				return false;
+
+			_done++;
+			if (result.contains("Code") && result["Code"] != 0) {
+				_failed++;
+				_failedHashes.push_back(txHash);
+			}
+
+			nlohmann::json item;
+			item["TxHash"] = txHash;
+			item["Result"] = result;
+			_results.push_back(item);
+
+			if (!_pending.empty() && _results.size() < PUBLISH_REPORT_COUNT && now - _reportTime < PUBLISH_REPORT_INTERVAL)
+				return true;
+
+			report["Results"] = _results;
+			report["Done"] = _done;
+			report["Failed"] = _failed;
+			report["Total"] = _total;
+			if (_pending.empty())
+				report["FailedTxHashes"] = _failedHashes;
+
+			_results = nlohmann::json::array();
+			_reportTime = now;
+			return true;
+		}
+
+		size_t PublishProgress::Pending() const {
+			return _pending.size();
+		}
+
+	}
+}
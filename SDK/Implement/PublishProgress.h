@@ -0,0 +1,46 @@
+// Copyright (c) 2012-2019 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef __ELASTOS_SDK_PUBLISHPROGRESS_H__
+#define __ELASTOS_SDK_PUBLISHPROGRESS_H__
+
+#include <nlohmann/json.hpp>
+
+#include <set>
+#include <string>
+#include <ctime>
+
+#define PUBLISH_REPORT_COUNT    100 // results of a batch per progress report
+#define PUBLISH_REPORT_INTERVAL 1   // seconds after which the results so far are reported, even if fewer
+
+namespace Elastos {
+	namespace ElaWallet {
+
+		// Results of the transactions passed to ISubWallet::PublishTransactions(), coalesced into progress reports.
+		// A report carries the results since the previous one. It is due every PUBLISH_REPORT_COUNT results, for
+		// the first result PUBLISH_REPORT_INTERVAL or more after the previous report, and for the last result of
+		// the batch, which also lists every failed transaction. Not thread safe.
+		class PublishProgress {
+		public:
+			PublishProgress();
+
+			// once every transaction of a batch got its result, the next Add() starts a new batch
+			void Add(const std::string &txHash, time_t now);
+
+			// false if txHash is not pending. Otherwise report is the progress report if one is due, null if not.
+			bool Result(const std::string &txHash, const nlohmann::json &result, time_t now, nlohmann::json &report);
+
+			size_t Pending() const;
+
+		private:
+			std::set<std::string> _pending;
+			nlohmann::json _results, _failedHashes;
+			size_t _done, _failed, _total;
+			time_t _reportTime;
+		};
+
+	}
+}
+
+#endif //__ELASTOS_SDK_PUBLISHPROGRESS_H__
@@ -82,7 +82,7 @@ namespace Elastos {
 			nlohmann::json result;
 			EncodeTx(result, tx);
 
-			ArgInfo("r => {}", result.dump());
+			ArgInfo("r => {}", result);
 			return result;
 		}
 
@@ -103,7 +103,7 @@ namespace Elastos {
 
 			nlohmann::json info = _walletManager->GetWallet()->GetBalanceInfo();
 
-			ArgInfo("r => {}", info.dump());
+			ArgInfo("r => {}", info);
 			return info;
 		}
 
@@ -144,7 +144,7 @@ namespace Elastos {
 			j["Addresses"] = addrString;
 			j["MaxCount"] = maxCount;
 
-			ArgInfo("r => {}", j.dump());
+			ArgInfo("r => {}", j);
 			return j;
 		}
 
@@ -165,7 +165,7 @@ namespace Elastos {
 			j["PublicKeys"] = pubKeyString;
 			j["MaxCount"] = maxCount;
 
-			ArgInfo("r => {}", j.dump());
+			ArgInfo("r => {}", j);
 			return j;
 		}
 
@@ -233,6 +233,25 @@ namespace Elastos {
 			return tx;
 		}
 
+		std::vector<TransactionPtr> SubWallet::CreateConsolidateTxns(const std::string &memo, const uint256 &asset,
+																	 size_t maxTxCount) const {
+			std::string m;
+
+			if (!memo.empty())
+				m = "type:text,msg:" + memo;
+
+			std::vector<TransactionPtr> txns = _walletManager->GetWallet()->ConsolidateInBatches(m, asset, maxTxCount);
+
+			for (size_t i = 0; i < txns.size(); ++i) {
+				if (_info->GetChainID() == "ELA")
+					txns[i]->SetVersion(Transaction::TxVersion::V09);
+
+				txns[i]->FixIndex();
+			}
+
+			return txns;
+		}
+
 		void SubWallet::EncodeTx(nlohmann::json &result, const TransactionPtr &tx) const {
 			ByteStream stream;
 			tx->Serialize(stream, true);
@@ -321,7 +340,7 @@ namespace Elastos {
 			nlohmann::json result;
 			EncodeTx(result, tx);
 
-			ArgInfo("r => {}", result.dump());
+			ArgInfo("r => {}", result);
 			return result;
 		}
 
@@ -329,7 +348,7 @@ namespace Elastos {
 												  const std::string &payPassword) const {
 
 			ArgInfo("{} {}", _walletManager->GetWallet()->GetWalletID(), GetFunName());
-			ArgInfo("tx: {}", tx.dump());
+			ArgInfo("tx: {}", tx);
 			ArgInfo("passwd: *");
 
 			TransactionPtr txn = DecodeTx(tx);
@@ -339,13 +358,37 @@ namespace Elastos {
 			nlohmann::json result;
 			EncodeTx(result, txn);
 
-			ArgInfo("r => {}", result.dump());
+			ArgInfo("r => {}", result);
+			return result;
+		}
+
+		nlohmann::json SubWallet::SignTransactions(const nlohmann::json &txs, const std::string &payPassword) const {
+			ArgInfo("{} {}", _walletManager->GetWallet()->GetWalletID(), GetFunName());
+			ArgInfo("txs: {}", txs.size());
+			ArgInfo("passwd: *");
+
+			ErrorChecker::CheckParam(!txs.is_array(), Error::InvalidArgument, "txs should be json array");
+
+			std::vector<TransactionPtr> txns;
+			for (nlohmann::json::const_iterator it = txs.cbegin(); it != txs.cend(); ++it)
+				txns.push_back(DecodeTx(*it));
+
+			_walletManager->GetWallet()->SignTransactions(txns, payPassword);
+
+			nlohmann::json result = nlohmann::json::array();
+			for (size_t i = 0; i < txns.size(); ++i) {
+				nlohmann::json item;
+				EncodeTx(item, txns[i]);
+				result.push_back(item);
+			}
+
+			ArgInfo("r => {} txs", result.size());
 			return result;
 		}
 
 		nlohmann::json SubWallet::PublishTransaction(const nlohmann::json &tx) {
 			ArgInfo("{} {}", _walletManager->GetWallet()->GetWalletID(), GetFunName());
-			ArgInfo("tx: {}", tx.dump());
+			ArgInfo("tx: {}", tx);
 
 			TransactionPtr txn = DecodeTx(tx);
 
@@ -355,13 +398,45 @@ namespace Elastos {
 			result["TxHash"] = txn->GetHash().GetHex();
 			result["Fee"] = txn->GetFee();
 
-			ArgInfo("r => {}", result.dump());
+			ArgInfo("r => {}", result);
+			return result;
+		}
+
+		nlohmann::json SubWallet::PublishTransactions(const nlohmann::json &txs) {
+			ArgInfo("{} {}", _walletManager->GetWallet()->GetWalletID(), GetFunName());
+			ArgInfo("txs: {}", txs.size());
+
+			ErrorChecker::CheckParam(!txs.is_array(), Error::InvalidArgument, "txs should be json array");
+
+			std::vector<TransactionPtr> txns;
+			for (nlohmann::json::const_iterator it = txs.cbegin(); it != txs.cend(); ++it)
+				txns.push_back(DecodeTx(*it));
+
+			// register the whole batch first, the result of a tx may come back before the next one is sent
+			{
+				boost::mutex::scoped_lock scoped_lock(lock);
+				time_t now = time(nullptr);
+				for (size_t i = 0; i < txns.size(); ++i)
+					_publishProgress.Add(txns[i]->GetHash().GetHex(), now);
+			}
+
+			publishTransactions(txns);
+
+			nlohmann::json result = nlohmann::json::array();
+			for (size_t i = 0; i < txns.size(); ++i) {
+				nlohmann::json item;
+				item["TxHash"] = txns[i]->GetHash().GetHex();
+				item["Fee"] = txns[i]->GetFee();
+				result.push_back(item);
+			}
+
+			ArgInfo("r => {}", result);
 			return result;
 		}
 
 		std::string SubWallet::ConvertToRawTransaction(const nlohmann::json &tx) {
 			ArgInfo("{} {}", _walletManager->GetWallet()->GetWalletID(), GetFunName());
-			ArgInfo("tx: {}", tx.dump());
+			ArgInfo("tx: {}", tx);
 
 			TransactionPtr txn = DecodeTx(tx);
 			ByteStream stream;
@@ -399,7 +474,45 @@ namespace Elastos {
 			j["MaxCount"] = maxCount;
 			j["UTXOs"] = jutxos;
 
-			ArgInfo("r => {}", j.dump());
+			ArgInfo("r => {}", j);
+			return j;
+		}
+
+		nlohmann::json SubWallet::GetUTXOsByCursor(const std::string &cursor, uint32_t count,
+												   const std::string &address) const {
+			ArgInfo("{} {}", _walletManager->GetWallet()->GetWalletID(), GetFunName());
+			ArgInfo("cursor: {}", cursor);
+			ArgInfo("count: {}", count);
+			ArgInfo("addr: {}", address);
+
+			UTXOPtr cursorUTXO;
+			if (!cursor.empty()) {
+				uint32_t height = 0;
+				uint256 hash;
+				uint16_t index = 0;
+				DecodeCursor(cursor, height, hash, index);
+				cursorUTXO = UTXOPtr(new UTXO(hash, index, 0, height));
+			}
+
+			UTXOArray UTXOs = _walletManager->GetWallet()->GetUTXOsAfter(cursorUTXO, count, address);
+
+			nlohmann::json j, jutxos = nlohmann::json::array();
+			for (const UTXOPtr &u : UTXOs) {
+				nlohmann::json item;
+				item["Hash"] = u->Hash().GetHex();
+				item["Index"] = u->Index();
+				item["Height"] = u->BlockHeight();
+				item["Amount"] = u->Output()->Amount().getDec();
+				jutxos.push_back(item);
+			}
+
+			j["UTXOs"] = jutxos;
+			if (count > 0 && UTXOs.size() == count)
+				j["NextCursor"] = EncodeCursor(UTXOs.back()->BlockHeight(), UTXOs.back()->Hash(), UTXOs.back()->Index());
+			else
+				j["NextCursor"] = "";
+
+			ArgInfo("r => {}", j);
 			return j;
 		}
 
@@ -412,10 +525,66 @@ namespace Elastos {
 			nlohmann::json result;
 			EncodeTx(result, tx);
 
-			ArgInfo("r => {}", result.dump());
+			ArgInfo("r => {}", result);
+			return result;
+		}
+
+		nlohmann::json SubWallet::CreateConsolidateTransactions(const std::string &memo, uint32_t maxTxCount) {
+			ArgInfo("{} {}", _walletManager->GetWallet()->GetWalletID(), GetFunName());
+			ArgInfo("memo: {}", memo);
+			ArgInfo("maxTxCount: {}", maxTxCount);
+
+			std::vector<TransactionPtr> txns = CreateConsolidateTxns(memo, Asset::GetELAAssetID(), maxTxCount);
+
+			nlohmann::json result, jtxs = nlohmann::json::array();
+			size_t utxoCount = 0;
+			uint64_t fee = 0;
+			for (size_t i = 0; i < txns.size(); ++i) {
+				nlohmann::json item;
+				EncodeTx(item, txns[i]);
+				jtxs.push_back(item);
+				utxoCount += txns[i]->GetInputs().size();
+				fee += txns[i]->GetFee();
+			}
+
+			result["Transactions"] = jtxs;
+			result["UTXOCount"] = utxoCount;
+			result["Fee"] = fee;
+
+			ArgInfo("r => {} txs, {} utxos, fee {}", txns.size(), utxoCount, fee);
 			return result;
 		}
 
+		std::map<std::string, std::string> SubWallet::GetGenesisAddresses() const {
+			std::map<std::string, std::string> genesisAddresses;
+
+			genesisAddresses[CHAINID_IDCHAIN] = _parent->GetChainConfig(CHAINID_IDCHAIN)->GenesisAddress();
+			genesisAddresses[CHAINID_ESC] = _parent->GetChainConfig(CHAINID_ESC)->GenesisAddress();
+			genesisAddresses[CHAINID_TOKENCHAIN] = _parent->GetChainConfig(CHAINID_TOKENCHAIN)->GenesisAddress();
+
+			return genesisAddresses;
+		}
+
+		std::string SubWallet::EncodeCursor(uint32_t height, const uint256 &hash, uint16_t index) const {
+			ByteStream stream;
+			stream.WriteUint32(height);
+			stream.WriteBytes(hash);
+			stream.WriteUint16(index);
+			return stream.GetBytes().getHex();
+		}
+
+		void SubWallet::DecodeCursor(const std::string &cursor, uint32_t &height, uint256 &hash,
+									 uint16_t &index) const {
+			bytes_t bytes;
+			bytes.setHex(cursor);
+			ByteStream stream(bytes);
+
+			ErrorChecker::CheckParam(bytes.size() != sizeof(height) + hash.size() + sizeof(index) ||
+									 !stream.ReadUint32(height) ||
+									 !stream.ReadBytes(hash) ||
+									 !stream.ReadUint16(index), Error::InvalidArgument, "invalid cursor");
+		}
+
 		nlohmann::json SubWallet::GetAllTransactionCommon(uint32_t start, uint32_t count, const std::string &txid,
 														  TxnType type) const {
 
@@ -424,11 +593,7 @@ namespace Elastos {
 			std::vector<nlohmann::json> jsonList;
 			const WalletPtr &wallet = _walletManager->GetWallet();
 			TransactionPtr txFound;
-			std::map<std::string, std::string> genesisAddresses;
-
-			genesisAddresses[CHAINID_IDCHAIN] = _parent->GetChainConfig(CHAINID_IDCHAIN)->GenesisAddress();
-			genesisAddresses[CHAINID_ESC] = _parent->GetChainConfig(CHAINID_ESC)->GenesisAddress();
-			genesisAddresses[CHAINID_TOKENCHAIN] = _parent->GetChainConfig(CHAINID_TOKENCHAIN)->GenesisAddress();
+			std::map<std::string, std::string> genesisAddresses = GetGenesisAddresses();
 
 			std::vector<TransactionPtr> txnPending = wallet->LoadTxn(TXN_PENDING);
 			for (std::vector<TransactionPtr>::iterator it = txnPending.begin(); it != txnPending.end();) {
@@ -459,16 +624,17 @@ namespace Elastos {
 			} else {
 				size_t realCnt, cur;
 				for (realCnt = 0, cur = start; cur < txnPending.size() && realCnt < count; ++realCnt, ++cur) {
-					confirms = txnPending[realCnt]->GetConfirms(wallet->LastBlockHeight());
-					jsonList.push_back(txnPending[realCnt]->GetSummary(wallet, genesisAddresses, confirms, false));
+					confirms = txnPending[cur]->GetConfirms(wallet->LastBlockHeight());
+					jsonList.push_back(txnPending[cur]->GetSummary(wallet, genesisAddresses, confirms, false));
 				}
+				// confirmed page is read as views: summaries never need payloads, attributes or programs
 				if (realCnt < count) {
 					size_t offset = cur - txnPending.size();
-					std::vector<TransactionPtr> txns = _walletManager->LoadTxnDesc(_info->GetChainID(), type,
-																				   offset, count - realCnt);
-					for (size_t i = 0; i < txns.size(); ++i) {
-						confirms = txns[i]->GetConfirms(wallet->LastBlockHeight());
-						jsonList.push_back(txns[i]->GetSummary(wallet, genesisAddresses, confirms, false));
+					std::vector<TransactionViewPtr> views = _walletManager->LoadTxnViewDesc(_info->GetChainID(), type,
+																							offset, count - realCnt);
+					for (size_t i = 0; i < views.size(); ++i) {
+						confirms = views[i]->GetConfirms(wallet->LastBlockHeight());
+						jsonList.push_back(views[i]->GetSummary(wallet, genesisAddresses, confirms));
 					}
 				}
 				j["Transactions"] = jsonList;
@@ -485,7 +651,76 @@ namespace Elastos {
 
 			nlohmann::json j = GetAllTransactionCommon(start, count, txid, TXN_NORMAL);
 
-			ArgInfo("r => {}", j.dump());
+			ArgInfo("r => {}", j);
+			return j;
+		}
+
+		nlohmann::json SubWallet::GetTransactionsByCursor(const std::string &cursor, uint32_t count) const {
+			ArgInfo("{} {}", _walletManager->GetWallet()->GetWalletID(), GetFunName());
+			ArgInfo("cursor: {}", cursor);
+			ArgInfo("count: {}", count);
+
+			const WalletPtr &wallet = _walletManager->GetWallet();
+			std::map<std::string, std::string> genesisAddresses = GetGenesisAddresses();
+			// first page starts above every possible height, pending txns (TX_UNCONFIRMED) included
+			uint32_t height = UINT32_MAX;
+			uint256 hash;
+			uint16_t index = 0;
+
+			if (!cursor.empty())
+				DecodeCursor(cursor, height, hash, index);
+
+			std::vector<TransactionPtr> txns = wallet->LoadTxn(TXN_PENDING);
+			for (std::vector<TransactionPtr>::iterator it = txns.begin(); it != txns.end();) {
+				uint32_t h = (*it)->GetBlockHeight();
+				if ((*it)->IsCoinBase() || h > height || (h == height && !((*it)->GetHash() < hash))) {
+					it = txns.erase(it);
+				} else {
+					++it;
+				}
+			}
+			std::sort(txns.begin(), txns.end(), [](const TransactionPtr &a, const TransactionPtr &b) {
+				return b->GetHash() < a->GetHash();
+			});
+			if (txns.size() > count)
+				txns.resize(count);
+
+			nlohmann::json j;
+			std::vector<nlohmann::json> jsonList;
+			for (const TransactionPtr &tx : txns) {
+				uint32_t confirms = tx->GetConfirms(wallet->LastBlockHeight());
+				jsonList.push_back(tx->GetSummary(wallet, genesisAddresses, confirms, false));
+			}
+
+			if (!txns.empty()) {
+				height = txns.back()->GetBlockHeight();
+				hash = txns.back()->GetHash();
+			}
+
+			// confirmed page is read as views: summaries never need payloads, attributes or programs
+			if (txns.size() < count) {
+				std::vector<TransactionViewPtr> confirmed = _walletManager->LoadTxnViewDescBefore(_info->GetChainID(),
+																								  TXN_NORMAL, height,
+																								  hash,
+																								  count - txns.size());
+				for (const TransactionViewPtr &view : confirmed) {
+					uint32_t confirms = view->GetConfirms(wallet->LastBlockHeight());
+					jsonList.push_back(view->GetSummary(wallet, genesisAddresses, confirms));
+				}
+
+				if (!confirmed.empty()) {
+					height = confirmed.back()->GetBlockHeight();
+					hash = confirmed.back()->GetHash();
+				}
+			}
+
+			j["Transactions"] = jsonList;
+			if (count > 0 && jsonList.size() == count)
+				j["NextCursor"] = EncodeCursor(height, hash);
+			else
+				j["NextCursor"] = "";
+
+			ArgInfo("r => {}", j);
 			return j;
 		}
 
@@ -498,7 +733,7 @@ namespace Elastos {
 
 			nlohmann::json j = GetAllTransactionCommon(start, count, txID, TXN_COINBASE);
 
-			ArgInfo("r => {}", j.dump());
+			ArgInfo("r => {}", j);
 			return j;
 		}
 
@@ -506,6 +741,10 @@ namespace Elastos {
 			_walletManager->PublishTransaction(tx);
 		}
 
+		void SubWallet::publishTransactions(const std::vector<TransactionPtr> &txns) {
+			_walletManager->PublishTransactions(txns);
+		}
+
 		void SubWallet::onBalanceChanged(const uint256 &assetID, const BigInt &balance) {
 			ArgInfo("{} {} Balance: {}", _walletManager->GetWallet()->GetWalletID(), GetFunName(), balance.getDec());
 			boost::mutex::scoped_lock scoped_lock(lock);
@@ -545,7 +784,7 @@ namespace Elastos {
 		}
 
 		void SubWallet::onAssetRegistered(const AssetPtr &asset, uint64_t amount, const uint168 &controller) {
-			ArgInfo("{} {} asset: {}, amount: {}",
+			ArgInfo("{} {} asset: {}, amount: {}, controller: {}",
 					_walletManager->GetWallet()->GetWalletID(), GetFunName(),
 					asset->GetName(), amount, controller.GetHex());
 
@@ -593,10 +832,18 @@ namespace Elastos {
 		}
 
 		void SubWallet::txPublished(const std::string &hash, const nlohmann::json &result) {
-			ArgInfo("{} {} hash: {} reason: {}", _walletManager->GetWallet()->GetWalletID(), GetFunName(), hash, result.dump());
+			ArgInfo("{} {} hash: {} reason: {}", _walletManager->GetWallet()->GetWalletID(), GetFunName(), hash, result);
 
 			boost::mutex::scoped_lock scoped_lock(lock);
 
+			// txs of PublishTransactions() are only reported in batches
+			nlohmann::json report;
+			if (_publishProgress.Result(hash, result, time(nullptr), report)) {
+				if (_callback && !report.is_null())
+					_callback->OnPublishProgress(report);
+				return;
+			}
+
 			if (_callback) {
 				_callback->OnTxPublished(hash, result);
 			} else {
@@ -644,6 +891,10 @@ namespace Elastos {
 			_walletManager->DatabaseFlush();
 		}
 
+		nlohmann::json SubWallet::GetNetworkStats() const {
+			return _walletManager->GetPeerManager()->GetNetworkStats();
+		}
+
 		time_t SubWallet::GetFirstTxnTimestamp() const {
 			return _walletManager->GetFirstTxnTimestamp();
 		}
@@ -680,19 +931,19 @@ namespace Elastos {
 			j["Info"] = _walletManager->GetWallet()->GetBasicInfo();
 			j["ChainID"] = _info->GetChainID();
 
-			ArgInfo("r => {}", j.dump());
+			ArgInfo("r => {}", j);
 			return j;
 		}
 
 		nlohmann::json SubWallet::GetTransactionSignedInfo(const nlohmann::json &encodedTx) const {
 			ArgInfo("{} {}", _walletManager->GetWallet()->GetWalletID(), GetFunName());
-			ArgInfo("tx: {}", encodedTx.dump());
+			ArgInfo("tx: {}", encodedTx);
 
 			TransactionPtr tx = DecodeTx(encodedTx);
 
 			nlohmann::json info = tx->GetSignedInfo();
 
-			ArgInfo("r => {}", info.dump());
+			ArgInfo("r => {}", info);
 
 			return info;
 		}
@@ -710,7 +961,7 @@ namespace Elastos {
 			else
 				info["Info"] = {};
 
-			ArgInfo("r => {}", info.dump());
+			ArgInfo("r => {}", info);
 			return info;
 		}
 
@@ -722,7 +973,7 @@ namespace Elastos {
 			j["Timestamp"] = _walletManager->GetPeerManager()->GetLastBlockTimestamp();
 			j["Hash"] = _walletManager->GetPeerManager()->GetLastBlockHash().GetHex();
 
-			ArgInfo("r => {}", j.dump());
+			ArgInfo("r => {}", j);
 
 			return j;
 		}
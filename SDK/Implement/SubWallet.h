@@ -22,6 +22,8 @@
 #ifndef __ELASTOS_SDK_SUBWALLET_H__
 #define __ELASTOS_SDK_SUBWALLET_H__
 
+#include "PublishProgress.h"
+
 #include <P2P/ChainParams.h>
 #include <SpvService/SpvService.h>
 #include <Account/SubAccount.h>
@@ -30,6 +32,7 @@
 #include <ISubWalletCallback.h>
 
 #include <map>
+#include <set>
 #include <boost/shared_ptr.hpp>
 #include <boost/filesystem/path.hpp>
 
@@ -68,6 +71,8 @@ namespace Elastos {
 
 			virtual void FlushData();
 
+			nlohmann::json GetNetworkStats() const;
+
 			time_t GetFirstTxnTimestamp() const;
 
 			virtual const std::string &GetInfoChainID() const;
@@ -101,19 +106,33 @@ namespace Elastos {
 
 			virtual nlohmann::json GetAllUTXOs(uint32_t start, uint32_t count, const std::string &address) const;
 
+			virtual nlohmann::json GetUTXOsByCursor(const std::string &cursor, uint32_t count,
+													const std::string &address) const;
+
 			virtual nlohmann::json CreateConsolidateTransaction(
 				const std::string &memo);
 
+			virtual nlohmann::json CreateConsolidateTransactions(
+				const std::string &memo,
+				uint32_t maxTxCount);
+
 			virtual nlohmann::json SignTransaction(
 				const nlohmann::json &tx,
 				const std::string &payPassword) const;
 
+			virtual nlohmann::json SignTransactions(
+				const nlohmann::json &txs,
+				const std::string &payPassword) const;
+
 			virtual nlohmann::json GetTransactionSignedInfo(
 				const nlohmann::json &rawTransaction) const;
 
 			virtual nlohmann::json PublishTransaction(
 				const nlohmann::json &tx);
 
+			virtual nlohmann::json PublishTransactions(
+				const nlohmann::json &txs);
+
 			virtual std::string ConvertToRawTransaction(const nlohmann::json &tx);
 
 			virtual nlohmann::json GetAllTransaction(
@@ -121,6 +140,10 @@ namespace Elastos {
 				uint32_t count,
 				const std::string &txid) const;
 
+			virtual nlohmann::json GetTransactionsByCursor(
+				const std::string &cursor,
+				uint32_t count) const;
+
 			virtual nlohmann::json GetAllCoinBaseTransaction(
 				uint32_t start,
 				uint32_t count,
@@ -189,13 +212,26 @@ namespace Elastos {
 				const std::string &memo,
 				const uint256 &asset) const;
 
+			std::vector<TransactionPtr> CreateConsolidateTxns(
+				const std::string &memo,
+				const uint256 &asset,
+				size_t maxTxCount) const;
+
 			nlohmann::json GetAllTransactionCommon(uint32_t start,
 												   uint32_t count,
 												   const std::string &txid,
 												   TxnType type) const;
 
+			std::map<std::string, std::string> GetGenesisAddresses() const;
+
+			std::string EncodeCursor(uint32_t height, const uint256 &hash, uint16_t index = 0) const;
+
+			void DecodeCursor(const std::string &cursor, uint32_t &height, uint256 &hash, uint16_t &index) const;
+
 			virtual void publishTransaction(const TransactionPtr &tx);
 
+			virtual void publishTransactions(const std::vector<TransactionPtr> &txns);
+
 			virtual void fireTransactionStatusChanged(const uint256 &txid, const std::string &status,
 													  const nlohmann::json &desc, uint32_t confirms);
 
@@ -211,6 +247,9 @@ namespace Elastos {
 			MasterWallet *_parent;
 			CoinInfoPtr _info;
 			ChainConfigPtr _config;
+
+			// results of PublishTransactions(), for OnPublishProgress()
+			PublishProgress _publishProgress;
 		};
 
 	}
@@ -96,7 +96,7 @@ namespace Elastos {
 			nlohmann::json result;
 			EncodeTx(result, tx);
 
-			ArgInfo("r => {}", result.dump());
+			ArgInfo("r => {}", result);
 			return result;
 		}
 
@@ -140,7 +140,7 @@ namespace Elastos {
 			nlohmann::json result;
 			EncodeTx(result, tx);
 
-			ArgInfo("r => {}", result.dump());
+			ArgInfo("r => {}", result);
 			return result;
 		}
 
@@ -155,7 +155,7 @@ namespace Elastos {
 			nlohmann::json result;
 			EncodeTx(result, tx);
 
-			ArgInfo("r => {}", result.dump());
+			ArgInfo("r => {}", result);
 			return result;
 		}
 
@@ -165,7 +165,7 @@ namespace Elastos {
 
 			nlohmann::json balanceInfo = _walletManager->GetWallet()->GetBalanceInfo();
 
-			ArgInfo("r => {}", balanceInfo.dump());
+			ArgInfo("r => {}", balanceInfo);
 			return  balanceInfo;
 		}
 
@@ -196,7 +196,7 @@ namespace Elastos {
 
 			nlohmann::json jsonData = _walletManager->GetWallet()->GetAllAssets();
 
-			ArgInfo("r => {}", jsonData.dump());
+			ArgInfo("r => {}", jsonData);
 
 			return jsonData;
 		}
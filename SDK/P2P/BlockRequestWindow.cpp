@@ -0,0 +1,111 @@
+// Copyright (c) 2012-2019 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "BlockRequestWindow.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace Elastos {
+	namespace ElaWallet {
+
+		BlockRequestWindow::BlockRequestWindow() :
+			_window(2),
+			_lastRate(0) {
+		}
+
+		bool BlockRequestWindow::Request(const std::vector<uint256> &blockHashes) {
+			if (_batches.size() >= _window || !_deferred.empty()) {
+				_deferred.push_back(blockHashes);
+				return false;
+			}
+
+			return true;
+		}
+
+		void BlockRequestWindow::BatchSent(const uint256 &lastHash, double now) {
+			Batch batch;
+
+			batch.lastHash = lastHash;
+			batch.bytes = 0;
+			batch.stalls = 0;
+			batch.requestTime = now;
+			batch.startTime = 0;
+			batch.progressTime = now;
+			_batches.push_back(batch);
+		}
+
+		bool BlockRequestWindow::Received(const uint256 &hash, size_t bytes, double now, double pingTime,
+										  std::vector<std::vector<uint256> > &released) {
+			if (_batches.empty())
+				return false;
+
+			Batch &batch = _batches.front();
+			if (batch.startTime == 0)
+				batch.startTime = now;
+			batch.bytes += bytes;
+			batch.stalls = 0;
+			batch.progressTime = now;
+
+			if (hash != batch.lastHash)
+				return false;
+
+			// Enough batches in flight to cover one round trip with data: while a batch streams
+			// for streamTime, the request for the next one must already be rtt old.
+			double streamTime = std::max(now - batch.startTime, 0.001);
+			double rtt = pingTime < DBL_MAX ? pingTime : batch.startTime - batch.requestTime;
+			size_t window = 1 + (size_t) std::ceil(std::max(rtt, 0.0) / streamTime);
+			_window = std::min(std::max(window, (size_t) 1), (size_t) MAX_SYNC_WINDOW);
+			_lastRate = batch.bytes / streamTime;
+			_batches.pop_front();
+
+			// batches are added by the getdata itself, count the ones released here against the window
+			while (!_deferred.empty() && _batches.size() + released.size() < _window) {
+				released.push_back(_deferred.front());
+				_deferred.pop_front();
+			}
+
+			return true;
+		}
+
+		BlockRequestWindow::Progress BlockRequestWindow::Check(double now) {
+			if (_batches.empty() || now - _batches.front().progressTime < STALL_TIMEOUT)
+				return Progressing;
+
+			Batch &batch = _batches.front();
+			batch.progressTime = now; // count each stall timeout once
+			if (++batch.stalls >= MAX_BATCH_STALLS)
+				return TimedOut;
+
+			return Stalled;
+		}
+
+		void BlockRequestWindow::Clear() {
+			_batches.clear();
+			_deferred.clear();
+		}
+
+		bool BlockRequestWindow::Waiting() const {
+			return !_batches.empty();
+		}
+
+		size_t BlockRequestWindow::Window() const {
+			return _window;
+		}
+
+		size_t BlockRequestWindow::Batches() const {
+			return _batches.size();
+		}
+
+		size_t BlockRequestWindow::Deferred() const {
+			return _deferred.size();
+		}
+
+		double BlockRequestWindow::LastRate() const {
+			return _lastRate;
+		}
+
+	}
+}
@@ -0,0 +1,79 @@
+// Copyright (c) 2012-2019 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef __ELASTOS_SDK_BLOCKREQUESTWINDOW_H__
+#define __ELASTOS_SDK_BLOCKREQUESTWINDOW_H__
+
+#include <Common/uint256.h>
+
+#include <deque>
+#include <vector>
+
+#define MAX_SYNC_WINDOW    4          // getdata batches of blocks outstanding at once
+#define STALL_TIMEOUT      15.0       // seconds a block request may go without progress before it counts as a stall
+#define MAX_BATCH_STALLS   4          // stalls in a row after which the oldest batch has timed out
+
+namespace Elastos {
+	namespace ElaWallet {
+
+		// Getdata batches of blocks outstanding on one peer. Inventories are requested while fewer batches than the
+		// window are in flight and deferred otherwise. Batches complete in request order; each completion resizes
+		// the window to cover a round trip and releases deferred inventories. Not thread safe.
+		class BlockRequestWindow {
+		public:
+			enum Progress {
+				Progressing,
+				Stalled,
+				TimedOut
+			};
+
+		public:
+			BlockRequestWindow();
+
+			// true if blockHashes should be requested now, false if it was deferred
+			bool Request(const std::vector<uint256> &blockHashes);
+
+			// a getdata went out, lastHash is the last block it asks for
+			void BatchSent(const uint256 &lastHash, double now);
+
+			// a block of the oldest batch arrived. Returns true if it completed the batch, released then holds the
+			// deferred inventories to request now. pingTime is DBL_MAX while unknown.
+			bool Received(const uint256 &hash, size_t bytes, double now, double pingTime,
+						  std::vector<std::vector<uint256> > &released);
+
+			// Stalled once per STALL_TIMEOUT the oldest batch goes without a block, TimedOut after
+			// MAX_BATCH_STALLS of them in a row.
+			Progress Check(double now);
+
+			void Clear();
+
+			bool Waiting() const;
+
+			size_t Window() const;
+
+			size_t Batches() const;
+
+			size_t Deferred() const;
+
+			// block bytes per second the last completed batch streamed at, 0 before one completed
+			double LastRate() const;
+
+		private:
+			struct Batch {
+				uint256 lastHash;
+				size_t bytes;
+				uint32_t stalls;
+				double requestTime, startTime, progressTime;
+			};
+
+			std::deque<Batch> _batches;
+			std::deque<std::vector<uint256> > _deferred;
+			size_t _window;
+			double _lastRate;
+		};
+
+	}
+}
+
+#endif //__ELASTOS_SDK_BLOCKREQUESTWINDOW_H__
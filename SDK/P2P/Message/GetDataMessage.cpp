@@ -17,7 +17,7 @@ namespace Elastos {
 		}
 
 		bool GetDataMessage::Accept(const bytes_t &msg) {
-			ByteStream stream(msg);
+			ByteStream stream = ByteStream::View(msg.data(), msg.size());
 			uint32_t count = 0;
 
 			if (!stream.ReadUint32(count)) {
@@ -108,8 +108,8 @@ namespace Elastos {
 					containBlocks = true;
 				}
 
-				if (containBlocks && blockCount > 1)
-					_peer->SetWaitingBlocks(true);
+				if (containBlocks)
+					_peer->AddBlockBatch(getDataParameter.blockHashes[count - txCount - 1]);
 				_peer->SetSentGetdata(true);
 				SendMessage(stream.GetBytes(), Type());
 			}
@@ -13,8 +13,7 @@
 #include <P2P/PeerManager.h>
 
 #include <float.h>
-
-#define MAX_BLOCKS_COUNT 500
+#include <algorithm>
 
 namespace Elastos {
 	namespace ElaWallet {
@@ -25,7 +24,7 @@ namespace Elastos {
 		}
 
 		bool InventoryMessage::Accept(const bytes_t &msg) {
-			ByteStream stream(msg);
+			ByteStream stream = ByteStream::View(msg.data(), msg.size());
 			uint32_t type;
 
 			uint32_t count;
@@ -73,11 +72,6 @@ namespace Elastos {
 				_peer->error("non-standard inv, {} is fewer block hash(es) than expected", blocks.size());
 				return false;
 			} else {
-				if (blocks.size() >= MAX_BLOCKS_COUNT && _peer->WaitingBlocks()) {
-					_peer->error("got inv message before previous getdata respond");
-					return false;
-				}
-
 				if (!_peer->SentFilter() && !_peer->SentGetblocks())
 					blocks.clear();
 				if (blocks.size() > 0) {
@@ -107,20 +101,13 @@ namespace Elastos {
 
 				_peer->info("got inv with {} tx {} block item(s)", txHashes.size(), blocks.size());
 				_peer->AddKnownTxHashes(txHashes);
-				if (txHashes.size() > 0 || blocks.size() > 0) {
-					GetDataParameter getDataParam(txHashes, blocks);
+				if (txHashes.size() > 0) {
+					GetDataParameter getDataParam(txHashes, {});
 					_peer->SendMessage(MSG_GETDATA, getDataParam);
 				}
 
-				// to improve chain download performance, if we received 500 block hashes, request the next 500 block hashes
-				if (blocks.size() >= MAX_BLOCKS_COUNT) {
-					GetBlocksParameter param;
-					param.locators.push_back(blocks.back());
-					param.locators.push_back(blocks.front());
-					param.hashStop = 0;
-
-					_peer->SendMessage(MSG_GETBLOCKS, param);
-				}
+				// blocks go through the peer's request window, a full inv also asks for the next 500 hashes
+				_peer->RequestBlocks(blocks);
 
 				if (transactions.size() > 0 && !_peer->GetMemPoolCallback().empty()) {
 					_peer->info("got initial mempool response");
@@ -143,17 +130,20 @@ namespace Elastos {
 			_peer->AddKnownTxHashes(invParam.txHashes);
 			txCount = _peer->KnownTxHashes().size() - knownCount;
 
-			if (txCount > 0) {
+			// receivers drop inv messages with more than MAX_GETDATA_HASHES items, so split big batches
+			for (size_t sent = 0; sent < txCount;) {
+				size_t count = std::min(txCount - sent, (size_t) MAX_GETDATA_HASHES);
 				ByteStream stream;
 
-				stream.WriteUint32(uint32_t(txCount));
-				for (size_t i = 0; i < txCount; i++) {
+				stream.WriteUint32(uint32_t(count));
+				for (size_t i = 0; i < count; i++) {
 					stream.WriteUint32(uint32_t(inv_tx));  // version
-					stream.WriteBytes(_peer->KnownTxHashes()[knownCount + i]);
+					stream.WriteBytes(_peer->KnownTxHashes()[knownCount + sent + i]);
 				}
 
-				_peer->info("sending inv tx count={} type={}", txCount, inv_tx);
+				_peer->info("sending inv tx count={} type={}", count, inv_tx);
 				SendMessage(stream.GetBytes(), Type());
+				sent += count;
 			}
 		}
 
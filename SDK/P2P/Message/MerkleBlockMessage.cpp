@@ -25,7 +25,7 @@ namespace Elastos {
 		bool MerkleBlockMessage::Accept(const bytes_t &msg) {
 			std::vector<uint256> txHashes;
 			int version;
-			ByteStream stream(msg);
+			ByteStream stream = ByteStream::View(msg.data(), msg.size());
 
 			PeerManager *manager = _peer->GetPeerManager();
 			MerkleBlockPtr block(Registry::Instance()->CreateMerkleBlock(manager->GetChainID()));
@@ -53,8 +53,9 @@ namespace Elastos {
 			} else if (!_peer->SentFilter() && !_peer->SentGetdata()) {
 				_peer->error("got merkleblock message before loading a filter");
 				return false;
+			} else if (_peer->BlockReceived(block->GetHash(), msg.size())) {
+				return true; // only requested to time the peer
 			} else {
-				_peer->SetWaitingBlocks(false);
 				block->MerkleBlockTxHashes(txHashes);
 
 				for (size_t i = txHashes.size(); i > 0; i--) { // reverse order for more efficient removal as tx arrive
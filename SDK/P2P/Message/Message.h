@@ -36,6 +36,7 @@
 #define MSG_FEEFILTER   "feefilter"// described in BIP133 https://github.com/bitcoin/bips/blob/master/bip-0133.mediawiki
 
 #define MAX_GETDATA_HASHES 50000
+#define MAX_BLOCKS_COUNT 500 // block hashes in a full inv answer to getblocks
 
 namespace Elastos {
 	namespace ElaWallet {
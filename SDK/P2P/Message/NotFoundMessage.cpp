@@ -19,7 +19,7 @@ namespace Elastos {
 		}
 
 		bool NotFoundMessage::Accept(const bytes_t &msg) {
-			ByteStream stream(msg);
+			ByteStream stream = ByteStream::View(msg.data(), msg.size());
 			uint32_t count = 0;
 
 			if (!stream.ReadUint32(count)) {
@@ -60,6 +60,8 @@ namespace Elastos {
 			}
 
 			_peer->RemoveKnownTxHashes(txHashes);
+			for (size_t i = 0; i < blockHashes.size(); ++i)
+				_peer->BlockReceived(blockHashes[i], 0);
 			FireNotfound(txHashes, blockHashes);
 
 			return true;
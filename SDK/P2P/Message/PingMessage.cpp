@@ -21,7 +21,7 @@ namespace Elastos {
 		}
 
 		bool PingMessage::Accept(const bytes_t &msg) {
-			ByteStream stream(msg);
+			ByteStream stream = ByteStream::View(msg.data(), msg.size());
 			uint64_t height;
 
 			if (!stream.ReadUint64(height)) {
@@ -15,7 +15,7 @@ namespace Elastos {
 		}
 
 		bool RejectMessage::Accept(const bytes_t &msg) {
-			ByteStream stream(msg);
+			ByteStream stream = ByteStream::View(msg.data(), msg.size());
 
 			std::string type;
 			if (!stream.ReadVarString(type)) {
@@ -22,7 +22,7 @@ namespace Elastos {
 		bool TransactionMessage::Accept(const bytes_t &msg) {
 			std::string chainID = _peer->GetPeerManager()->GetChainID();
 
-			ByteStream stream(msg);
+			ByteStream stream = ByteStream::View(msg.data(), msg.size());
 
 			TransactionPtr tx;
 			if (chainID == CHAINID_MAINCHAIN) {
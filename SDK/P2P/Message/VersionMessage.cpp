@@ -20,7 +20,7 @@ namespace Elastos {
 		}
 
 		bool VersionMessage::Accept(const bytes_t &msg) {
-			ByteStream stream(msg);
+			ByteStream stream = ByteStream::View(msg.data(), msg.size());
 
 			uint32_t version = 0;
 			if (!stream.ReadUint32(version)) {
@@ -0,0 +1,186 @@
+// Copyright (c) 2012-2019 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "NetworkStats.h"
+
+#include <sstream>
+
+namespace Elastos {
+	namespace ElaWallet {
+
+		const double NetworkStats::BucketBounds[NETWORK_STATS_BUCKETS - 1] = {
+			0.001, 0.005, 0.01, 0.05, 0.1, 0.5, 1, 5, 10
+		};
+
+		NetworkStats::Counter::Counter() :
+			count(0),
+			bytes(0),
+			latencySum(0) {
+			for (size_t i = 0; i < NETWORK_STATS_BUCKETS; ++i)
+				buckets[i] = 0;
+		}
+
+		void NetworkStats::Record(Direction direction, const std::string &type, size_t bytes, double latency) {
+			size_t bucket = 0;
+			while (bucket < NETWORK_STATS_BUCKETS - 1 && latency > BucketBounds[bucket])
+				bucket++;
+
+			boost::mutex::scoped_lock scopedLock(_lock);
+			Counter &counter = _counters[direction][type];
+			counter.count++;
+			counter.bytes += bytes;
+			counter.latencySum += latency;
+			counter.buckets[bucket]++;
+		}
+
+		void NetworkStats::Merge(const NetworkStats &other) {
+			CounterMap counters[2] = {other.GetCounters(Inbound), other.GetCounters(Outbound)};
+
+			boost::mutex::scoped_lock scopedLock(_lock);
+			for (size_t d = 0; d < 2; ++d) {
+				for (CounterMap::const_iterator it = counters[d].begin(); it != counters[d].end(); ++it) {
+					Counter &counter = _counters[d][it->first];
+					counter.count += it->second.count;
+					counter.bytes += it->second.bytes;
+					counter.latencySum += it->second.latencySum;
+					for (size_t i = 0; i < NETWORK_STATS_BUCKETS; ++i)
+						counter.buckets[i] += it->second.buckets[i];
+				}
+			}
+		}
+
+		NetworkStats::CounterMap NetworkStats::GetCounters(Direction direction) const {
+			boost::mutex::scoped_lock scopedLock(_lock);
+			return _counters[direction];
+		}
+
+		void NetworkStats::Clear() {
+			boost::mutex::scoped_lock scopedLock(_lock);
+			_counters[Inbound].clear();
+			_counters[Outbound].clear();
+		}
+
+		nlohmann::json NetworkStats::ToJson() const {
+			const char *names[2] = {"Inbound", "Outbound"};
+			nlohmann::json j;
+
+			boost::mutex::scoped_lock scopedLock(_lock);
+			for (size_t d = 0; d < 2; ++d) {
+				nlohmann::json types = nlohmann::json::object();
+				for (CounterMap::const_iterator it = _counters[d].begin(); it != _counters[d].end(); ++it) {
+					nlohmann::json item;
+					item["Count"] = it->second.count;
+					item["Bytes"] = it->second.bytes;
+					item["LatencySum"] = it->second.latencySum;
+					item["Buckets"] = std::vector<uint64_t>(it->second.buckets, it->second.buckets + NETWORK_STATS_BUCKETS);
+					types[it->first] = item;
+				}
+				j[names[d]] = types;
+			}
+
+			return j;
+		}
+
+		static std::string JoinLabels(const std::string &labels, const std::string &more) {
+			return labels.empty() ? more : labels + "," + more;
+		}
+
+		static void WriteSample(std::ostringstream &out, const std::string &name, const std::string &labels,
+								const nlohmann::json &value) {
+			if (value.is_null())
+				return;
+
+			out << name << "{" << labels << "} ";
+			if (value.is_boolean())
+				out << (value.get<bool>() ? 1 : 0);
+			else
+				out << value;
+			out << "\n";
+		}
+
+		static void WriteMessages(std::ostringstream &out, const nlohmann::json &messages, const std::string &labels) {
+			const char *names[2] = {"Inbound", "Outbound"};
+			const char *directions[2] = {"in", "out"};
+
+			for (size_t d = 0; d < 2; ++d) {
+				if (!messages.contains(names[d]))
+					continue;
+
+				const nlohmann::json &types = messages[names[d]];
+				for (nlohmann::json::const_iterator it = types.begin(); it != types.end(); ++it) {
+					std::string l = JoinLabels(labels, std::string("direction=\"") + directions[d] + "\",type=\"" + it.key() + "\"");
+					const nlohmann::json &buckets = it.value()["Buckets"];
+					uint64_t cumulative = 0;
+
+					WriteSample(out, "spv_messages_total", l, it.value()["Count"]);
+					WriteSample(out, "spv_message_bytes_total", l, it.value()["Bytes"]);
+					for (size_t i = 0; i < buckets.size(); ++i) {
+						std::ostringstream le;
+						if (i < NETWORK_STATS_BUCKETS - 1)
+							le << NetworkStats::BucketBounds[i];
+						else
+							le << "+Inf";
+
+						cumulative += buckets[i].get<uint64_t>();
+						WriteSample(out, "spv_message_latency_seconds_bucket", JoinLabels(l, "le=\"" + le.str() + "\""), cumulative);
+					}
+					WriteSample(out, "spv_message_latency_seconds_sum", l, it.value()["LatencySum"]);
+					WriteSample(out, "spv_message_latency_seconds_count", l, it.value()["Count"]);
+				}
+			}
+		}
+
+		std::string NetworkStats::ToText(const nlohmann::json &stats, const std::string &labels) {
+			std::ostringstream out;
+			const nlohmann::json null;
+
+			WriteSample(out, "spv_connected_peers", labels, stats.value("ConnectedPeers", null));
+			WriteSample(out, "spv_last_block_height", labels, stats.value("LastBlockHeight", null));
+			WriteSample(out, "spv_estimated_height", labels, stats.value("EstimatedHeight", null));
+			WriteSample(out, "spv_sync_progress", labels, stats.value("SyncProgress", null));
+			WriteSample(out, "spv_seconds_since_last_block", labels, stats.value("SecondsSinceLastBlock", null));
+			WriteSample(out, "spv_reconnects_total", labels, stats.value("Reconnects", null));
+			WriteSample(out, "spv_connect_failures", labels, stats.value("ConnectFailures", null));
+			WriteSample(out, "spv_bloom_false_positive_rate", labels, stats.value("BloomFalsePositiveRate", null));
+
+			if (stats.contains("Orphans")) {
+				const nlohmann::json &orphans = stats["Orphans"];
+				WriteSample(out, "spv_orphan_blocks", labels, orphans.value("Count", null));
+				WriteSample(out, "spv_orphan_bytes", labels, orphans.value("Bytes", null));
+				WriteSample(out, "spv_orphan_evictions_total", labels, orphans.value("Evictions", null));
+			}
+
+			if (stats.contains("PublishQueue")) {
+				const nlohmann::json &queue = stats["PublishQueue"];
+				WriteSample(out, "spv_publish_queue_size", labels, queue.value("Size", null));
+				WriteSample(out, "spv_publish_pending_callbacks", labels, queue.value("PendingCallbacks", null));
+			}
+
+			if (stats.contains("Peers")) {
+				const nlohmann::json &peers = stats["Peers"];
+				for (nlohmann::json::const_iterator it = peers.begin(); it != peers.end(); ++it) {
+					const nlohmann::json &peer = *it;
+					std::ostringstream host;
+					host << "peer=\"" << peer.value("Host", std::string()) << ":" << peer.value("Port", 0) << "\"";
+					std::string l = JoinLabels(labels, host.str());
+
+					WriteSample(out, "spv_peer_download_peer", l, peer.value("DownloadPeer", null));
+					WriteSample(out, "spv_peer_last_block", l, peer.value("LastBlock", null));
+					WriteSample(out, "spv_peer_ping_seconds", l, peer.value("PingTime", null));
+					WriteSample(out, "spv_peer_download_rate_bytes", l, peer.value("DownloadRate", null));
+					WriteSample(out, "spv_peer_download_bytes_total", l, peer.value("DownloadBytes", null));
+					WriteSample(out, "spv_peer_stalls_total", l, peer.value("Stalls", null));
+					WriteSample(out, "spv_peer_misbehavior_total", l, peer.value("Misbehavior", null));
+					WriteSample(out, "spv_peer_send_queue_bytes", l, peer.value("SendQueueBytes", null));
+				}
+			}
+
+			if (stats.contains("Messages"))
+				WriteMessages(out, stats["Messages"], labels);
+
+			return out.str();
+		}
+
+	}
+}
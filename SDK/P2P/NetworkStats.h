@@ -0,0 +1,68 @@
+// Copyright (c) 2012-2019 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef __ELASTOS_SDK_NETWORKSTATS_H__
+#define __ELASTOS_SDK_NETWORKSTATS_H__
+
+#include <nlohmann/json.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <map>
+#include <string>
+
+#define NETWORK_STATS_BUCKETS 10
+
+namespace Elastos {
+	namespace ElaWallet {
+
+		// Message counters and latency histograms per message type, inbound and outbound. Inbound latency is the
+		// time spent handling a message, outbound latency the time from queueing a message until its last byte was
+		// handed to the socket.
+		class NetworkStats {
+		public:
+			enum Direction {
+				Inbound = 0,
+				Outbound = 1
+			};
+
+			struct Counter {
+				uint64_t count;
+				uint64_t bytes;
+				double latencySum; // seconds
+				uint64_t buckets[NETWORK_STATS_BUCKETS]; // not cumulative, last one is +Inf
+
+				Counter();
+			};
+
+			typedef std::map<std::string, Counter> CounterMap;
+
+			// upper bounds of the latency buckets in seconds, the last bucket has no bound
+			static const double BucketBounds[NETWORK_STATS_BUCKETS - 1];
+
+		public:
+			void Record(Direction direction, const std::string &type, size_t bytes, double latency);
+
+			// add all counters of other to this, used to keep totals of disconnected peers
+			void Merge(const NetworkStats &other);
+
+			CounterMap GetCounters(Direction direction) const;
+
+			void Clear();
+
+			// {"Inbound":{"tx":{"Count":1,"Bytes":250,"LatencySum":0.0001,"Buckets":[1,0,...]}},"Outbound":{...}}
+			nlohmann::json ToJson() const;
+
+			// render stats of PeerManager::GetNetworkStats() in the plain text exposition format, labels like
+			// `wallet="abc",chain="ELA"` are added to every sample
+			static std::string ToText(const nlohmann::json &stats, const std::string &labels);
+
+		private:
+			mutable boost::mutex _lock;
+			CounterMap _counters[2];
+		};
+
+	}
+}
+
+#endif //__ELASTOS_SDK_NETWORKSTATS_H__
@@ -0,0 +1,146 @@
+// Copyright (c) 2012-2019 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "OrphanPool.h"
+
+namespace Elastos {
+	namespace ElaWallet {
+
+		OrphanPool::OrphanPool(size_t maxBytes, size_t maxPerPeer) :
+			_maxBytes(maxBytes),
+			_maxPerPeer(maxPerPeer),
+			_bytes(0),
+			_seq(0),
+			_evictions(0) {
+		}
+
+		bool OrphanPool::Insert(const MerkleBlockPtr &block, const Peer *source) {
+			const uint256 &hash = block->GetHash();
+			if (_entries.find(hash) != _entries.end())
+				return false;
+
+			size_t bytes = block->SerializedSize(MERKLEBLOCK_VERSION_1);
+			if (bytes > _maxBytes)
+				return false;
+
+			if (source != nullptr && _maxPerPeer > 0) {
+				// Evict may drop the peer's set, look it up again each round
+				std::map<const Peer *, std::set<uint64_t> >::iterator s;
+				while ((s = _bySource.find(source)) != _bySource.end() && s->second.size() >= _maxPerPeer)
+					Evict(_byAge[*s->second.begin()]);
+			}
+
+			while (!_byAge.empty() && _bytes + bytes > _maxBytes)
+				Evict(_byAge.begin()->second);
+
+			Entry entry;
+			entry.block = block;
+			entry.source = source;
+			entry.bytes = bytes;
+			entry.seq = _seq++;
+
+			_entries[hash] = entry;
+			_byPrevHash.insert(std::make_pair(block->GetPrevBlockHash(), hash));
+			_byAge[entry.seq] = hash;
+			_bySource[source].insert(entry.seq);
+			_bytes += bytes;
+
+			return true;
+		}
+
+		bool OrphanPool::Remove(const MerkleBlockPtr &block) {
+			EntryMap::iterator it = _entries.find(block->GetHash());
+			if (it == _entries.end())
+				return false;
+
+			Erase(it);
+			return true;
+		}
+
+		bool OrphanPool::Contains(const MerkleBlockPtr &block) const {
+			return _entries.find(block->GetHash()) != _entries.end();
+		}
+
+		MerkleBlockPtr OrphanPool::GetMatchPrevHash(const uint256 &prevHash) const {
+			std::multimap<uint256, uint256>::const_iterator it = _byPrevHash.find(prevHash);
+			if (it == _byPrevHash.end())
+				return nullptr;
+
+			return _entries.find(it->second)->second.block;
+		}
+
+		void OrphanPool::RemoveSource(const Peer *source) {
+			if (source == nullptr)
+				return;
+
+			std::map<const Peer *, std::set<uint64_t> >::iterator s = _bySource.find(source);
+			if (s == _bySource.end())
+				return;
+
+			std::set<uint64_t> &unowned = _bySource[nullptr];
+			for (std::set<uint64_t>::iterator seq = s->second.begin(); seq != s->second.end(); ++seq) {
+				_entries[_byAge[*seq]].source = nullptr;
+				unowned.insert(*seq);
+			}
+			_bySource.erase(s);
+		}
+
+		void OrphanPool::Clear() {
+			_entries.clear();
+			_byPrevHash.clear();
+			_byAge.clear();
+			_bySource.clear();
+			_bytes = 0;
+		}
+
+		size_t OrphanPool::Size() const {
+			return _entries.size();
+		}
+
+		size_t OrphanPool::Bytes() const {
+			return _bytes;
+		}
+
+		uint64_t OrphanPool::Evictions() const {
+			return _evictions;
+		}
+
+		OrphanPool::Stats OrphanPool::GetStats() const {
+			Stats stats;
+			stats.count = _entries.size();
+			stats.bytes = _bytes;
+			stats.evictions = _evictions;
+			return stats;
+		}
+
+		void OrphanPool::Erase(EntryMap::iterator it) {
+			const Entry &entry = it->second;
+
+			std::pair<std::multimap<uint256, uint256>::iterator, std::multimap<uint256, uint256>::iterator> range;
+			range = _byPrevHash.equal_range(entry.block->GetPrevBlockHash());
+			for (std::multimap<uint256, uint256>::iterator p = range.first; p != range.second; ++p) {
+				if (p->second == it->first) {
+					_byPrevHash.erase(p);
+					break;
+				}
+			}
+
+			_byAge.erase(entry.seq);
+
+			std::map<const Peer *, std::set<uint64_t> >::iterator s = _bySource.find(entry.source);
+			s->second.erase(entry.seq);
+			if (s->second.empty())
+				_bySource.erase(s);
+
+			_bytes -= entry.bytes;
+			_entries.erase(it);
+		}
+
+		void OrphanPool::Evict(const uint256 &hash) {
+			Erase(_entries.find(hash));
+			_evictions++;
+		}
+
+	}
+}
@@ -0,0 +1,86 @@
+// Copyright (c) 2012-2019 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef __ELASTOS_SDK_ORPHANPOOL_H__
+#define __ELASTOS_SDK_ORPHANPOOL_H__
+
+#include <Plugin/Interface/IMerkleBlock.h>
+#include <Common/uint256.h>
+
+#include <map>
+#include <set>
+
+#define ORPHAN_POOL_MAX_BYTES (8 * 1024 * 1024)
+#define ORPHAN_POOL_MAX_PER_PEER 1024
+
+namespace Elastos {
+	namespace ElaWallet {
+
+		class Peer;
+
+		// Blocks whose previous block is not yet known, indexed by hash and by previous hash. The pool is bounded by a
+		// byte budget and a per-peer count; when either is exceeded the oldest orphans are evicted first.
+		class OrphanPool {
+		public:
+			struct Stats {
+				size_t count;
+				size_t bytes;
+				uint64_t evictions;
+			};
+
+		public:
+			OrphanPool(size_t maxBytes = ORPHAN_POOL_MAX_BYTES, size_t maxPerPeer = ORPHAN_POOL_MAX_PER_PEER);
+
+			// source only identifies the relaying peer for its quota and is never dereferenced; nullptr is for
+			// blocks loaded from the database. returns false if the block is already pooled or too big to fit.
+			bool Insert(const MerkleBlockPtr &block, const Peer *source = nullptr);
+
+			bool Remove(const MerkleBlockPtr &block);
+
+			bool Contains(const MerkleBlockPtr &block) const;
+
+			MerkleBlockPtr GetMatchPrevHash(const uint256 &prevHash) const;
+
+			// a disconnected peer's orphans stay pooled without a quota, so a later peer at the same address
+			// starts with an empty one.
+			void RemoveSource(const Peer *source);
+
+			void Clear();
+
+			size_t Size() const;
+
+			size_t Bytes() const;
+
+			uint64_t Evictions() const;
+
+			Stats GetStats() const;
+
+		private:
+			struct Entry {
+				MerkleBlockPtr block;
+				const Peer *source;
+				size_t bytes;
+				uint64_t seq;
+			};
+
+			typedef std::map<uint256, Entry> EntryMap;
+
+			void Erase(EntryMap::iterator it);
+
+			void Evict(const uint256 &hash);
+
+		private:
+			size_t _maxBytes, _maxPerPeer, _bytes;
+			uint64_t _seq, _evictions;
+
+			EntryMap _entries;
+			std::multimap<uint256, uint256> _byPrevHash;
+			std::map<uint64_t, uint256> _byAge;
+			std::map<const Peer *, std::set<uint64_t> > _bySource;
+		};
+
+	}
+}
+
+#endif //__ELASTOS_SDK_ORPHANPOOL_H__
@@ -42,12 +42,22 @@
 #include <Common/hash.h>
 
 #include <arpa/inet.h>
+#include <algorithm>
 #include <cfloat>
+#include <cmath>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
 #include <sys/time.h>
+#include <sys/uio.h>
 #include <boost/thread.hpp>
 
 #define HEADER_LENGTH      24
 #define MAX_MSG_LENGTH     0x02000000
+#define MAX_SEND_QUEUE     0x04000000 // peer stopped reading, disconnect instead of queueing more
+#define RATE_WINDOW        2.0        // seconds of block download per rate sample
+#define BATCH_BYTES        (MAX_BLOCKS_COUNT * 1024) // rough size of a batch of filtered blocks, for DownloadCost
+#define DEFAULT_DOWNLOAD_RATE 65536.0 // bytes per second assumed for peers not measured yet
 #define MIN_PROTO_VERSION  70002 // peers earlier than this protocol version not supported (need v0.9 txFee relay rules)
 #define LOCAL_HOST         ((UInt128) { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xff, 0xff, 0x7f, 0x00, 0x00, 0x01 })
 #define CONNECT_TIMEOUT    3.0
@@ -58,6 +68,56 @@
 namespace Elastos {
 	namespace ElaWallet {
 
+		static uint32_t PayloadChecksum(const uint8_t *data, size_t len) {
+			uint8_t hash[SHA256_DIGEST_LENGTH];
+
+			SHA256(data, len, hash);
+			SHA256(hash, sizeof(hash), hash);
+			return *(uint32_t *) hash;
+		}
+
+		static double TimeNow() {
+			struct timeval tv;
+			gettimeofday(&tv, NULL);
+			return tv.tv_sec + (double) tv.tv_usec / 1000000;
+		}
+
+		// one scatter-gather write of header and payload starting at offset, never blocks
+		static ssize_t SendVectored(int socket, const uint8_t *header, const uint8_t *payload, size_t payloadLen,
+									size_t offset) {
+			struct iovec iov[2];
+			struct msghdr msg;
+			int count = 0;
+
+			if (offset < HEADER_LENGTH) {
+				iov[count].iov_base = (void *) (header + offset);
+				iov[count++].iov_len = HEADER_LENGTH - offset;
+				offset = 0;
+			} else {
+				offset -= HEADER_LENGTH;
+			}
+
+			if (payloadLen > offset) {
+				iov[count].iov_base = (void *) (payload + offset);
+				iov[count++].iov_len = payloadLen - offset;
+			}
+
+			memset(&msg, 0, sizeof(msg));
+			msg.msg_iov = iov;
+			msg.msg_iovlen = count;
+			return sendmsg(socket, &msg, MSG_DONTWAIT | MSG_NOSIGNAL);
+		}
+
+		struct Peer::OutboundMessage {
+			uint8_t header[HEADER_LENGTH];
+			bytes_t payload;
+			size_t offset;
+			std::string type;
+			double queueTime;
+
+			size_t Size() const { return HEADER_LENGTH + payload.size(); }
+		};
+
 		Peer::Peer(PeerManager *manager, uint32_t magicNumber) :
 				_status(Disconnected),
 				_magicNumber(magicNumber),
@@ -83,7 +143,19 @@ namespace Elastos {
 				_currentBlockHeight(0),
 				_startTime(0),
 				_downloadStartTime(0),
-				_downloadBytes(0) {
+				_downloadBytes(0),
+				_rateStart(0),
+				_downloadRate(0),
+				_rateBytes(0),
+				_blockBytes(0),
+				_stalls(0),
+				_misbehavior(0),
+				_sendQueueBytes(0),
+				_sendProgressTime(0),
+				_captureID(0),
+				_replaying(false),
+				_replayStopped(false) {
+			_wakeFds[0] = _wakeFds[1] = -1;
 
 			_managerID = manager->GetID();
 			RegisterListner(_manager);
@@ -200,6 +272,9 @@ namespace Elastos {
 		void Peer::Disconnect() {
 			int socket = _socket;
 
+			if (_replaying)
+				_replayStopped = true;
+
 			if (socket >= 0) {
 				_socket = -1;
 				if (shutdown(socket, SHUT_RDWR) < 0) {
@@ -213,49 +288,176 @@ namespace Elastos {
 		void Peer::SendMessage(const bytes_t &message, const std::string &type) {
 			if (message.size() > MAX_MSG_LENGTH) {
 				this->error("failed to send {}, length {} is too long", type, message.size());
-			} else {
-				ssize_t n = 0;
-				struct timeval tv;
-				int socket, error = 0;
-				ByteStream stream;
-
-				stream.WriteUint32(_magicNumber);
-				stream.WriteBytes(bytes_t(type.c_str(), type.size()));
-				if (type.size() < 12)
-					stream.WriteBytes(bytes_t(12 - type.size(), 0));
-				stream.WriteUint32(message.size());
-				bytes_t hash = sha256_2(message);
-				stream.WriteUint32(*(uint32_t *)hash.data());
-				stream.WriteBytes(message);
-
-				const bytes_t &buf = stream.GetBytes();
-
-				this->info("sending {}", type);
-				size_t msgLen = 0;
+				return;
+			}
+
+			uint8_t header[HEADER_LENGTH];
+			uint32_t msgLen = (uint32_t) message.size(), checksum = PayloadChecksum(message.data(), message.size());
+
+			memcpy(header, &_magicNumber, sizeof(_magicNumber));
+			memset(&header[4], 0, 12);
+			memcpy(&header[4], type.c_str(), MIN(type.size(), 12));
+			memcpy(&header[16], &msgLen, sizeof(msgLen));
+			memcpy(&header[20], &checksum, sizeof(checksum));
+
+			this->info("sending {}", type);
+
+			if (_replaying) { // the recorded remote side does not listen
+				_netStats.Record(NetworkStats::Outbound, type, HEADER_LENGTH + message.size(), 0);
+				return;
+			}
+
+			int socket, error = 0;
+			bool queued = false;
+			size_t offset = 0;
+			double start = TimeNow();
+			{
+				boost::mutex::scoped_lock scopedLock(_sendLock);
 				socket = _socket;
-				if (socket < 0) error = ENOTCONN;
 
-				gettimeofday(&tv, NULL);
-				double disconnectTime = tv.tv_sec + (double) tv.tv_usec / 1000000 + MESSAGE_TIMEOUT;
+				if (socket < 0) {
+					error = ENOTCONN;
+				} else if (_sending == nullptr && _sendQueue[0].empty() && _sendQueue[1].empty()) {
+					// nothing ahead of it, try to hand it to the kernel straight from the caller's buffer
+					ssize_t n = SendVectored(socket, header, message.data(), message.size(), 0);
+					if (n > 0)
+						offset = (size_t) n;
+					else if (n < 0 && errno != EWOULDBLOCK && errno != EAGAIN && errno != EINTR)
+						error = errno;
+				}
 
-				while (socket >= 0 && !error && msgLen < buf.size()) {
-					n = send(socket, &buf[msgLen], buf.size() - msgLen, MSG_NOSIGNAL);
-					if (n >= 0) {
-						msgLen += n;
+				if (!error && offset < HEADER_LENGTH + message.size()) {
+					if (_sendQueueBytes + HEADER_LENGTH + message.size() > MAX_SEND_QUEUE) {
+						error = ENOBUFS;
+					} else {
+						OutboundMessagePtr m(new OutboundMessage());
+						memcpy(m->header, header, HEADER_LENGTH);
+						m->payload = message;
+						m->offset = offset;
+						m->type = type;
+						m->queueTime = start;
+
+						if (_sendQueueBytes == 0)
+							_sendProgressTime = TimeNow();
+						_sendQueueBytes += m->Size() - offset;
+
+						if (offset > 0)
+							_sending = m;
+						else
+							_sendQueue[(type == MSG_PING || type == MSG_PONG) ? 0 : 1].push_back(m);
+						queued = true;
 					}
-					if (n < 0 && errno != EWOULDBLOCK) error = errno;
-					gettimeofday(&tv, NULL);
-					if (!error && tv.tv_sec + (double) tv.tv_usec / 1000000 >= disconnectTime) error = ETIMEDOUT;
-					socket = _socket;
 				}
+			}
 
-				if (error) {
-					this->error("sending {} message {}", type, FormatError(error));
-					Disconnect();
+			if (error) {
+				this->error("sending {} message {}", type, FormatError(error));
+				Disconnect();
+			} else if (queued) {
+				WakeUp();
+			} else {
+				_netStats.Record(NetworkStats::Outbound, type, HEADER_LENGTH + message.size(), TimeNow() - start);
+			}
+		}
+
+		size_t Peer::SendQueueBytes() const {
+			boost::mutex::scoped_lock scopedLock(_sendLock);
+			return _sendQueueBytes;
+		}
+
+		bool Peer::FlushSendQueue(int socket, int &error) {
+			while (true) {
+				if (_sending == nullptr) {
+					for (size_t i = 0; i < 2 && _sending == nullptr; ++i) {
+						if (!_sendQueue[i].empty()) {
+							_sending = _sendQueue[i].front();
+							_sendQueue[i].pop_front();
+						}
+					}
+
+					if (_sending == nullptr)
+						return true;
 				}
+
+				ssize_t n = SendVectored(socket, _sending->header, _sending->payload.data(),
+										 _sending->payload.size(), _sending->offset);
+				if (n < 0) {
+					if (errno == EWOULDBLOCK || errno == EAGAIN || errno == EINTR)
+						return true;
+
+					error = errno;
+					return false;
+				}
+
+				_sending->offset += n;
+				_sendQueueBytes -= n;
+				_sendProgressTime = TimeNow();
+
+				if (_sending->offset < _sending->Size())
+					return true; // socket buffer is full
+
+				_netStats.Record(NetworkStats::Outbound, _sending->type, _sending->Size(),
+								 TimeNow() - _sending->queueTime);
+				_sending.reset();
 			}
 		}
 
+		void Peer::WakeUp() {
+			boost::mutex::scoped_lock scopedLock(_sendLock);
+			if (_wakeFds[1] >= 0) {
+				uint8_t b = 0;
+				if (write(_wakeFds[1], &b, 1) < 0 && errno != EAGAIN) {
+					this->warn("wake up peer thread: {}", FormatError(errno));
+				}
+			}
+		}
+
+		ssize_t Peer::Receive(int socket, void *buf, size_t len) {
+			struct pollfd fds[2];
+			bool pending;
+			int error = 0;
+
+			{
+				boost::mutex::scoped_lock scopedLock(_sendLock);
+				pending = _sendQueueBytes > 0;
+				if (pending && TimeNow() - _sendProgressTime >= MESSAGE_TIMEOUT) {
+					errno = ETIMEDOUT;
+					return -1;
+				}
+				fds[1].fd = _wakeFds[0];
+			}
+
+			fds[0].fd = socket;
+			fds[0].events = POLLIN | (pending ? POLLOUT : 0);
+			fds[0].revents = 0;
+			fds[1].events = POLLIN;
+			fds[1].revents = 0;
+
+			// same one second granularity as the socket receive timeout
+			int r = poll(fds, 2, 1000);
+			if (r < 0)
+				return -1;
+
+			if (fds[1].revents & POLLIN) {
+				uint8_t drain[64];
+				while (read(fds[1].fd, drain, sizeof(drain)) > 0);
+			}
+
+			if (pending || (fds[1].revents & POLLIN)) {
+				boost::mutex::scoped_lock scopedLock(_sendLock);
+				if (!FlushSendQueue(socket, error)) {
+					errno = error;
+					return -1;
+				}
+			}
+
+			if (fds[0].revents & (POLLIN | POLLHUP | POLLERR))
+				return read(socket, buf, len);
+
+			errno = EWOULDBLOCK;
+			return -1;
+		}
+
 		void Peer::RerequestBlocks(const uint256 &fromBlock) {
 			size_t i = _knownBlockHashes.size();
 
@@ -340,6 +542,15 @@ namespace Elastos {
 				bytes_t payload;
 				size_t len = 0;
 				ssize_t n = 0;
+				int wakeFds[2];
+
+				if (pipe(wakeFds) == 0) {
+					fcntl(wakeFds[0], F_SETFL, fcntl(wakeFds[0], F_GETFL) | O_NONBLOCK);
+					fcntl(wakeFds[1], F_SETFL, fcntl(wakeFds[1], F_GETFL) | O_NONBLOCK);
+					boost::mutex::scoped_lock scopedLock(_sendLock);
+					_wakeFds[0] = wakeFds[0];
+					_wakeFds[1] = wakeFds[1];
+				}
 
 				gettimeofday(&tv, NULL);
 				_startTime = tv.tv_sec + (double) tv.tv_usec / 1000000;
@@ -350,7 +561,7 @@ namespace Elastos {
 					socket = _socket;
 
 					while (socket >= 0 && !error && len < HEADER_LENGTH) {
-						n = read(socket, &header[len], sizeof(header) - len);
+						n = Receive(socket, &header[len], sizeof(header) - len);
 						if (n > 0) len += n;
 						if (n == 0)
 							error = ECONNRESET;
@@ -365,6 +576,7 @@ namespace Elastos {
 						gettimeofday(&tv, NULL);
 						time = tv.tv_sec + (double) tv.tv_usec / 1000000;
 						if (!error && time >= _disconnectTime) error = ETIMEDOUT;
+						if (!error) error = CheckStall(time);
 
 						if (!error && time >= _mempoolTime) {
 							info("done waiting for mempool response");
@@ -404,7 +616,7 @@ namespace Elastos {
 							msgTimeout = time + MESSAGE_TIMEOUT;
 
 							while (socket >= 0 && !error && len < msgLen) {
-								n = read(socket, &payload[len], msgLen - len);
+								n = Receive(socket, &payload[len], msgLen - len);
 								if (n > 0) len += n;
 								if (n == 0)
 									error = ECONNRESET;
@@ -429,11 +641,11 @@ namespace Elastos {
 									this->error("read message error: {}", FormatError(error));
 								}
 							} else if (len == msgLen) {
-								bytes_t hash = sha256_2(payload);;
+								uint32_t payloadChecksum = PayloadChecksum(payload.data(), msgLen);
 
-								if (*(uint32_t *)(&hash[0]) != checksum) { // verify checksum
+								if (payloadChecksum != checksum) { // verify checksum
 									this->error("reading {}, invalid checksum {:x}, expected {:x}, payload length:{},",
-												type, UInt32GetLE(&hash), checksum, msgLen);
+												type, payloadChecksum, checksum, msgLen);
 									error = EPROTO;
 								} else if (!AcceptMessage(payload, type)) error = EPROTO;
 							}
@@ -445,12 +657,28 @@ namespace Elastos {
 			if (_socket == -1)
 				error = 0;
 
-			socket = _socket;
-			_socket = -1;
+			{
+				boost::mutex::scoped_lock scopedLock(_sendLock);
+				socket = _socket;
+				_socket = -1;
+				_sendQueue[0].clear();
+				_sendQueue[1].clear();
+				_sending.reset();
+				_sendQueueBytes = 0;
+				for (size_t i = 0; i < 2; ++i) {
+					if (_wakeFds[i] >= 0) close(_wakeFds[i]);
+					_wakeFds[i] = -1;
+				}
+			}
+			SetWaitingBlocks(false);
 			_status = Peer::Disconnected;
 			if (socket >= 0) close(socket);
 			info("disconnected");
 
+			NotifyDisconnected(error);
+		}
+
+		void Peer::NotifyDisconnected(int error) {
 			while (!_pongCallbackList.empty()) {
 				Peer::PeerCallback pongCallback = PopPongCallback();
 				if (pongCallback) pongCallback(0);
@@ -461,6 +689,55 @@ namespace Elastos {
 			if (_listener) _listener->OnDisconnected(shared_from_this(), error);
 		}
 
+		int Peer::Replay(const PeerCapturePtr &capture, uint32_t peer, size_t maxBlocks, bool realtime) {
+			PeerCapture::Frame frame;
+			size_t blocks = 0;
+			double start;
+			int error = 0;
+
+			if (capture->GetMagicNumber() != _magicNumber) {
+				this->error("capture is from another network, magic {:x}", capture->GetMagicNumber());
+				return EINVAL;
+			}
+
+			_replaying = true;
+			_replayStopped = false;
+			_status = Peer::Connecting;
+			_startTime = start = TimeNow();
+			info("replaying capture");
+			SendMessage(MSG_VERSION, Message::DefaultParam);
+
+			while (!error && !_replayStopped && (maxBlocks == 0 || blocks < maxBlocks) && capture->Read(peer, frame)) {
+				if (realtime) {
+					double wait = start + frame.time - TimeNow();
+					if (wait > 0)
+						usleep((useconds_t) (wait * 1000000));
+				}
+
+				if (frame.type == MSG_MERKLEBLOCK)
+					blocks++;
+
+				if (!AcceptMessage(frame.payload, frame.type)) {
+					this->error("replay stopped at {} message, {} merkleblock(s) in", frame.type, blocks);
+					error = EPROTO;
+				}
+			}
+
+			SetWaitingBlocks(false);
+			_status = Peer::Disconnected;
+			info("replay finished, {} merkleblock(s)", blocks);
+			NotifyDisconnected(error);
+			_replaying = false;
+
+			return error;
+		}
+
+		void Peer::SetCapture(const PeerCapturePtr &capture) {
+			_capture = capture;
+			if (_capture)
+				_captureID = _capture->AddPeer();
+		}
+
 		void Peer::RegisterListner(Peer::Listener *listener) {
 			_listener = listener;
 		}
@@ -490,6 +767,9 @@ namespace Elastos {
 		bool Peer::AcceptMessage(const bytes_t &msg, const std::string &type) {
 			bool r = false;
 
+			if (_capture && !_replaying)
+				_capture->Record(_captureID, type, msg);
+
 			if (_currentBlock != nullptr && MSG_TX != type) { // if we receive a non-tx message, merkleblock is done
 				this->error("incomplete merkleblock {}, expected {} more tx, got {}",
 							_currentBlock->GetHash().GetHex(), _currentBlockTxHashes.size(), type);
@@ -497,8 +777,10 @@ namespace Elastos {
 				_currentBlock.reset();
 				r = 0;
 			} else if (_messages.find(type) != _messages.end()) {
+				double start = TimeNow();
 				_downloadBytes += msg.size();
 				r = _messages[type]->Accept(msg);
+				_netStats.Record(NetworkStats::Inbound, type, HEADER_LENGTH + msg.size(), TimeNow() - start);
 			} else {
 				this->error("dropping {}, length {}, not implemented", type, msg.size());
 			}
@@ -547,11 +829,181 @@ namespace Elastos {
 		}
 
 		bool Peer::WaitingBlocks() const {
-			return _waitingBlocks;
+			boost::mutex::scoped_lock scopedLock(_syncLock);
+			return _blockRequests.Waiting();
 		}
 
 		void Peer::SetWaitingBlocks(bool wait) {
-			_waitingBlocks = wait;
+			if (!wait) {
+				boost::mutex::scoped_lock scopedLock(_syncLock);
+				_blockRequests.Clear();
+				_probeBlocks.clear();
+				_rateStart = 0;
+			}
+		}
+
+		void Peer::RequestBlocks(const std::vector<uint256> &blockHashes) {
+			if (blockHashes.empty())
+				return;
+
+			{
+				boost::mutex::scoped_lock scopedLock(_syncLock);
+				if (!_blockRequests.Request(blockHashes)) {
+					debug("deferring {} block(s), {} batch(es) outstanding", blockHashes.size(),
+						  _blockRequests.Batches());
+					return;
+				}
+			}
+
+			SendBlockRequest(blockHashes);
+		}
+
+		void Peer::SendBlockRequest(const std::vector<uint256> &blockHashes) {
+			// ask for the next batch first, its inv then arrives while this one is still streaming
+			if (blockHashes.size() >= MAX_BLOCKS_COUNT) {
+				GetBlocksParameter param;
+				param.locators.push_back(blockHashes.back());
+				param.locators.push_back(blockHashes.front());
+				param.hashStop = 0;
+				SendMessage(MSG_GETBLOCKS, param);
+			}
+
+			GetDataParameter getDataParam({}, blockHashes);
+			SendMessage(MSG_GETDATA, getDataParam);
+		}
+
+		void Peer::AddBlockBatch(const uint256 &lastHash) {
+			boost::mutex::scoped_lock scopedLock(_syncLock);
+			_blockRequests.BatchSent(lastHash, TimeNow());
+		}
+
+		void Peer::ProbeDownload(const std::vector<uint256> &blockHashes) {
+			{
+				boost::mutex::scoped_lock scopedLock(_syncLock);
+				_probeBlocks.insert(blockHashes.begin(), blockHashes.end());
+			}
+
+			RequestBlocks(blockHashes);
+		}
+
+		bool Peer::BlockReceived(const uint256 &hash, size_t bytes) {
+			std::vector<std::vector<uint256> > next;
+			bool probe;
+			{
+				boost::mutex::scoped_lock scopedLock(_syncLock);
+				probe = _probeBlocks.erase(hash) > 0;
+				if (!_blockRequests.Waiting())
+					return probe;
+
+				double now = TimeNow();
+				_blockBytes += bytes;
+				_rateBytes += bytes;
+				SampleDownloadRate(now);
+
+				if (!_blockRequests.Received(hash, bytes, now, _pingTime, next))
+					return probe;
+
+				// a probe is over before a whole RATE_WINDOW, the batch it completed is the first sample
+				if (_downloadRate == 0)
+					_downloadRate = _blockRequests.LastRate();
+				if (!_blockRequests.Waiting())
+					_probeBlocks.clear(); // notfound blocks
+
+				debug("block batch done, window {}, {} deferred", _blockRequests.Window(), _blockRequests.Deferred());
+			}
+
+			for (size_t i = 0; i < next.size(); ++i)
+				SendBlockRequest(next[i]);
+
+			return probe;
+		}
+
+		size_t Peer::SyncWindow() const {
+			boost::mutex::scoped_lock scopedLock(_syncLock);
+			return _blockRequests.Window();
+		}
+
+		void Peer::SampleDownloadRate(double now) {
+			// only time spent waiting for requested blocks counts, an idle synced peer keeps its last rate
+			if (!_blockRequests.Waiting()) {
+				_rateStart = 0;
+			} else if (_rateStart == 0) {
+				_rateStart = now;
+				_rateBytes = 0;
+			} else if (now - _rateStart >= RATE_WINDOW) {
+				double sample = _rateBytes / (now - _rateStart);
+				_downloadRate = _downloadRate == 0 ? sample : _downloadRate * 0.7 + sample * 0.3;
+				_rateStart = now;
+				_rateBytes = 0;
+			}
+		}
+
+		int Peer::CheckStall(double now) {
+			boost::mutex::scoped_lock scopedLock(_syncLock);
+			SampleDownloadRate(now);
+
+			BlockRequestWindow::Progress progress = _blockRequests.Check(now);
+			if (progress == BlockRequestWindow::Progressing)
+				return 0;
+
+			_stalls++;
+			if (progress == BlockRequestWindow::TimedOut) {
+				// a lost merkleblock or dropped getdata would hold every deferred inventory until disconnect
+				warn("block batch timed out after {} stall(s), {} inventory(ies) deferred", _stalls,
+					 _blockRequests.Deferred());
+				return ETIMEDOUT;
+			}
+
+			warn("block download stalled, {} stall(s)", _stalls);
+			return 0;
+		}
+
+		Peer::Stats Peer::GetStats() const {
+			Stats stats;
+
+			stats.host = GetHost();
+			stats.port = GetPort();
+			stats.lastBlock = _lastblock;
+			stats.pingTime = _pingTime;
+			stats.downloadPeer = false;
+
+			boost::mutex::scoped_lock scopedLock(_syncLock);
+			stats.downloadRate = _downloadRate;
+			stats.downloadBytes = _blockBytes;
+			stats.stalls = _stalls;
+			stats.misbehavior = _misbehavior;
+			scopedLock.unlock();
+
+			stats.sendQueueBytes = SendQueueBytes();
+			return stats;
+		}
+
+		double Peer::DownloadCost() const {
+			Stats stats;
+			stats.pingTime = _pingTime;
+
+			boost::mutex::scoped_lock scopedLock(_syncLock);
+			stats.downloadRate = _downloadRate;
+			stats.stalls = _stalls;
+			scopedLock.unlock();
+
+			return DownloadCost(stats);
+		}
+
+		double Peer::DownloadCost(const Stats &stats) {
+			double rtt = stats.pingTime < DBL_MAX ? stats.pingTime : CONNECT_TIMEOUT;
+			double rate = stats.downloadRate > 0 ? stats.downloadRate : DEFAULT_DOWNLOAD_RATE;
+
+			return (rtt + BATCH_BYTES / rate) * (1 + stats.stalls);
+		}
+
+		void Peer::AddMisbehavior() {
+			boost::mutex::scoped_lock scopedLock(_syncLock);
+			_misbehavior++;
+		}
+
+		const NetworkStats &Peer::GetNetworkStats() const {
+			return _netStats;
 		}
 
 		bool Peer::SentMempool() {
@@ -23,16 +23,21 @@
 #define __ELASTOS_SDK_PEER_H__
 
 #include "PeerInfo.h"
+#include "NetworkStats.h"
+#include "PeerCapture.h"
+#include "BlockRequestWindow.h"
 #include "Message/Message.h"
 
 #include <Common/Log.h>
 #include <Common/ElementSet.h>
 #include <Common/uint256.h>
 
+#include <atomic>
 #include <deque>
 #include <boost/shared_ptr.hpp>
 #include <boost/enable_shared_from_this.hpp>
 #include <boost/function.hpp>
+#include <boost/thread/mutex.hpp>
 #include <sys/types.h>
 #include <sys/socket.h>
 
@@ -104,6 +109,20 @@ namespace Elastos {
 
 			typedef boost::function<void(const uint256 &, int, const std::string &)> PeerPubTxCallback;
 
+			// rolling measurements of one connection, for download peer selection and monitoring
+			struct Stats {
+				std::string host;
+				uint16_t port;
+				uint32_t lastBlock;
+				double pingTime; // seconds, low pass filtered over pings, DBL_MAX before the handshake
+				double downloadRate; // block bytes per second while blocks were requested, 0 until measured
+				uint64_t downloadBytes; // block bytes received on this connection
+				uint32_t stalls; // times a block request made no progress for a whole stall timeout
+				uint32_t misbehavior;
+				size_t sendQueueBytes;
+				bool downloadPeer; // set by the peer manager
+			};
+
 		public:
 			Peer(PeerManager *manager, uint32_t magicNumber);
 
@@ -115,6 +134,15 @@ namespace Elastos {
 
 			void UnRegisterListener();
 
+			// record every inbound message of this connection to capture, set before Connect()
+			void SetCapture(const PeerCapturePtr &capture);
+
+			// Run the frames capture recorded from peer through this peer's message handlers on the calling thread,
+			// as if they arrived on its socket, then report the disconnect to the listener. Nothing is sent while
+			// replaying. Stops after maxBlocks merkleblocks if not 0, and keeps the recorded pace if realtime is set.
+			// returns the error the replay stopped with, 0 when the frames ran out.
+			int Replay(const PeerCapturePtr &capture, uint32_t peer, size_t maxBlocks = 0, bool realtime = false);
+
 			void SendMessage(const std::string &msgType, const SendMessageParameter &parameter);
 
 			const uint128 &getAddress() const;
@@ -161,8 +189,13 @@ namespace Elastos {
 
 			void Disconnect();
 
+			// queues the message and returns without waiting for the socket. What doesn't fit in the
+			// socket buffer right away is written by the peer thread, ping/pong ahead of everything else.
 			void SendMessage(const bytes_t &message, const std::string &type);
 
+			// bytes queued and not yet written to the socket
+			size_t SendQueueBytes() const;
+
 			void RerequestBlocks(const uint256 &fromBlock);
 
 			void ScheduleDisconnect(double time);
@@ -207,10 +240,43 @@ namespace Elastos {
 
 			void SetSentGetdata(bool sent);
 
+			// true while getdata batches for blocks are outstanding, passing false forgets them
 			bool WaitingBlocks() const;
 
 			void SetWaitingBlocks(bool wait);
 
+			// Inventory of blocks to download. Requested right away while fewer than SyncWindow() batches
+			// are outstanding, deferred otherwise; a full batch also asks for the next one.
+			void RequestBlocks(const std::vector<uint256> &blockHashes);
+
+			// a getdata for blocks went out, lastHash is the last block it asks for
+			void AddBlockBatch(const uint256 &lastHash);
+
+			// Request blocks only to measure the download rate of a peer that is not downloading the chain.
+			// BlockReceived() tells them apart from the blocks the peer manager asked for.
+			void ProbeDownload(const std::vector<uint256> &blockHashes);
+
+			// a merkleblock, or notfound for one, arrived. Completes the oldest batch when it is its last
+			// block, which resizes the window and releases a deferred inventory. Returns true for a block
+			// requested by ProbeDownload(), which is of no further use.
+			bool BlockReceived(const uint256 &hash, size_t bytes);
+
+			size_t SyncWindow() const;
+
+			Stats GetStats() const;
+
+			// estimated seconds to download a batch of blocks from this peer, lower is better. Unmeasured peers
+			// get a default rate, and every stall counts as another batch.
+			double DownloadCost() const;
+
+			// DownloadCost() of a stats snapshot
+			static double DownloadCost(const Stats &stats);
+
+			void AddMisbehavior();
+
+			// per message type counters of this connection
+			const NetworkStats &GetNetworkStats() const;
+
 			bool SentMempool();
 
 			void SetSentMempool(bool sent);
@@ -371,6 +437,24 @@ namespace Elastos {
 
 			void PeerThreadRoutine();
 
+			// fail pending callbacks and tell the listener, last thing a peer thread does
+			void NotifyDisconnected(int error);
+
+			void SendBlockRequest(const std::vector<uint256> &blockHashes);
+
+			// read() for the peer thread that also drains the send queue while waiting for input
+			ssize_t Receive(int socket, void *buf, size_t len);
+
+			// write queued messages until the socket would block, call with _sendLock held
+			bool FlushSendQueue(int socket, int &error);
+
+			void WakeUp();
+
+			void SampleDownloadRate(double now);
+
+			// ETIMEDOUT once the oldest block batch timed out, 0 otherwise
+			int CheckStall(double now);
+
 		private:
 			friend class Message;
 
@@ -389,7 +473,7 @@ namespace Elastos {
 			uint64_t _downloadStartTime; // millisecond
 			uint32_t _downloadBytes;
 			volatile double _disconnectTime, _mempoolTime;
-			bool _sentVerack, _gotVerack, _sentGetaddr, _sentFilter, _sentGetdata, _sentMempool, _sentGetblocks, _waitingBlocks;
+			bool _sentVerack, _gotVerack, _sentGetaddr, _sentFilter, _sentGetdata, _sentMempool, _sentGetblocks;
 			uint256 _lastBlockHash;
 			MerkleBlockPtr _currentBlock;
 			std::vector<uint256> _currentBlockTxHashes, _knownBlockHashes, _knownTxHashes;
@@ -399,6 +483,29 @@ namespace Elastos {
 			PeerCallback _mempoolCallback;
 			std::deque<PeerCallback> _pongCallbackList;
 
+			mutable boost::mutex _syncLock;
+			BlockRequestWindow _blockRequests;
+			std::set<uint256> _probeBlocks;
+			double _rateStart, _downloadRate;
+			size_t _rateBytes;
+			uint64_t _blockBytes;
+			uint32_t _stalls, _misbehavior;
+			NetworkStats _netStats;
+
+			PeerCapturePtr _capture;
+			uint32_t _captureID;
+			std::atomic<bool> _replaying, _replayStopped;
+
+			struct OutboundMessage;
+			typedef boost::shared_ptr<OutboundMessage> OutboundMessagePtr;
+
+			mutable boost::mutex _sendLock;
+			std::deque<OutboundMessagePtr> _sendQueue[2]; // ping/pong, everything else
+			OutboundMessagePtr _sending; // partially written, finishes before anything else goes out
+			size_t _sendQueueBytes;
+			double _sendProgressTime;
+			int _wakeFds[2];
+
 			typedef boost::shared_ptr<Message> MessagePtr;
 			std::map<std::string, MessagePtr> _messages;
 			PeerManager *_manager;
@@ -0,0 +1,217 @@
+// Copyright (c) 2012-2019 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "PeerCapture.h"
+
+#include <Common/ByteStream.h>
+#include <Common/Log.h>
+
+#include <sys/time.h>
+#include <cstring>
+
+#define CAPTURE_MAGIC        "ELAPCAP1"
+#define CAPTURE_MAGIC_LENGTH 8
+#define CAPTURE_TYPE_LENGTH  12
+// peer(4) time in microseconds(8) type(12) payload length(4)
+#define FRAME_HEADER_LENGTH  (4 + 8 + CAPTURE_TYPE_LENGTH + 4)
+#define MAX_FRAME_PAYLOAD    0x02000000 // same bound as MAX_MSG_LENGTH
+
+namespace Elastos {
+	namespace ElaWallet {
+
+		static double TimeNow() {
+			struct timeval tv;
+			gettimeofday(&tv, NULL);
+			return tv.tv_sec + (double) tv.tv_usec / 1000000;
+		}
+
+		PeerCapture::PeerCapture() :
+			_writing(false),
+			_magicNumber(0),
+			_peers(0),
+			_startTime(0),
+			_frames(0) {
+		}
+
+		PeerCapture::~PeerCapture() {
+			Close();
+		}
+
+		bool PeerCapture::Create(const std::string &path, uint32_t magicNumber) {
+			boost::mutex::scoped_lock scopedLock(_lock);
+
+			_file.open(path.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+			if (!_file.is_open()) {
+				Log::error("create capture file {} fail", path);
+				return false;
+			}
+
+			ByteStream stream;
+			stream.WriteBytes(CAPTURE_MAGIC, CAPTURE_MAGIC_LENGTH);
+			stream.WriteUint32(magicNumber);
+			_file.write((const char *) stream.GetBytes().data(), stream.GetBytes().size());
+
+			_writing = true;
+			_magicNumber = magicNumber;
+			_peers = 0;
+			_frames = 0;
+			_startTime = TimeNow();
+			Log::info("capturing inbound messages to {}", path);
+			return true;
+		}
+
+		bool PeerCapture::Open(const std::string &path) {
+			boost::mutex::scoped_lock scopedLock(_lock);
+
+			_file.open(path.c_str(), std::ios::in | std::ios::binary);
+			if (!_file.is_open()) {
+				Log::error("open capture file {} fail", path);
+				return false;
+			}
+
+			_writing = false;
+			_frames = 0;
+			if (!Rewind()) {
+				Log::error("{} is not a capture file", path);
+				_file.close();
+				return false;
+			}
+
+			return true;
+		}
+
+		void PeerCapture::Close() {
+			boost::mutex::scoped_lock scopedLock(_lock);
+			if (_file.is_open()) {
+				_file.flush();
+				_file.close();
+			}
+		}
+
+		uint32_t PeerCapture::GetMagicNumber() const {
+			boost::mutex::scoped_lock scopedLock(_lock);
+			return _magicNumber;
+		}
+
+		uint32_t PeerCapture::AddPeer() {
+			boost::mutex::scoped_lock scopedLock(_lock);
+			return _peers++;
+		}
+
+		void PeerCapture::Record(uint32_t peer, const std::string &type, const bytes_t &payload) {
+			char typeField[CAPTURE_TYPE_LENGTH];
+			ByteStream stream;
+
+			memset(typeField, 0, sizeof(typeField));
+			memcpy(typeField, type.c_str(), MIN(type.size(), sizeof(typeField)));
+
+			boost::mutex::scoped_lock scopedLock(_lock);
+			if (!_writing || !_file.is_open())
+				return;
+
+			stream.WriteUint32(peer);
+			stream.WriteUint64((uint64_t) ((TimeNow() - _startTime) * 1000000));
+			stream.WriteBytes(typeField, sizeof(typeField));
+			stream.WriteUint32((uint32_t) payload.size());
+			stream.WriteBytes(payload);
+			_file.write((const char *) stream.GetBytes().data(), stream.GetBytes().size());
+			_frames++;
+		}
+
+		bool PeerCapture::Read(Frame &frame) {
+			uint8_t header[FRAME_HEADER_LENGTH];
+			char typeField[CAPTURE_TYPE_LENGTH + 1];
+			uint64_t micros;
+			uint32_t len;
+
+			boost::mutex::scoped_lock scopedLock(_lock);
+			if (_writing || !_file.is_open())
+				return false;
+
+			if (!_file.read((char *) header, sizeof(header)))
+				return false;
+
+			ByteStream stream = ByteStream::View(header, sizeof(header));
+			stream.ReadUint32(frame.peer);
+			stream.ReadUint64(micros);
+			stream.ReadBytes(typeField, CAPTURE_TYPE_LENGTH);
+			stream.ReadUint32(len);
+
+			if (len > MAX_FRAME_PAYLOAD) {
+				Log::error("capture frame {} too long: {}", _frames, len);
+				return false;
+			}
+
+			typeField[CAPTURE_TYPE_LENGTH] = '\0';
+			frame.type = typeField;
+			frame.time = (double) micros / 1000000;
+			frame.payload.resize(len);
+			if (len > 0 && !_file.read((char *) frame.payload.data(), len)) {
+				Log::error("capture frame {} truncated", _frames);
+				return false;
+			}
+
+			_frames++;
+			return true;
+		}
+
+		bool PeerCapture::Read(uint32_t peer, Frame &frame) {
+			while (Read(frame)) {
+				if (frame.peer == peer)
+					return true;
+			}
+
+			return false;
+		}
+
+		std::map<uint32_t, size_t> PeerCapture::CountFrames(const std::string &type) {
+			std::map<uint32_t, size_t> counts;
+			Frame frame;
+
+			while (Read(frame)) {
+				if (frame.type == type)
+					counts[frame.peer]++;
+			}
+
+			boost::mutex::scoped_lock scopedLock(_lock);
+			Rewind();
+			return counts;
+		}
+
+		uint32_t PeerCapture::BusiestPeer(const std::string &type) {
+			std::map<uint32_t, size_t> counts = CountFrames(type);
+			uint32_t peer = 0;
+			size_t max = 0;
+
+			for (std::map<uint32_t, size_t>::iterator it = counts.begin(); it != counts.end(); ++it) {
+				if (it->second > max) {
+					max = it->second;
+					peer = it->first;
+				}
+			}
+
+			return peer;
+		}
+
+		size_t PeerCapture::FramesRecorded() const {
+			boost::mutex::scoped_lock scopedLock(_lock);
+			return _frames;
+		}
+
+		bool PeerCapture::Rewind() {
+			uint8_t header[CAPTURE_MAGIC_LENGTH + 4];
+
+			_file.clear();
+			_file.seekg(0);
+			if (!_file.read((char *) header, sizeof(header)) || memcmp(header, CAPTURE_MAGIC, CAPTURE_MAGIC_LENGTH) != 0)
+				return false;
+
+			ByteStream stream = ByteStream::View(&header[CAPTURE_MAGIC_LENGTH], 4);
+			stream.ReadUint32(_magicNumber);
+			_frames = 0;
+			return true;
+		}
+
+	}
+}
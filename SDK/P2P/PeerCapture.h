@@ -0,0 +1,82 @@
+// Copyright (c) 2012-2019 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef __ELASTOS_SDK_PEERCAPTURE_H__
+#define __ELASTOS_SDK_PEERCAPTURE_H__
+
+#include <Common/typedefs.h>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <fstream>
+#include <map>
+#include <string>
+
+namespace Elastos {
+	namespace ElaWallet {
+
+		// A file of inbound message frames, as recorded by peers with a capture attached and fed back by
+		// Peer::Replay(). Each frame keeps the id of the peer it came from, its type, its payload and the time it
+		// arrived relative to the start of the capture.
+		class PeerCapture {
+		public:
+			struct Frame {
+				uint32_t peer;
+				double time; // seconds since the capture was created
+				std::string type;
+				bytes_t payload;
+			};
+
+		public:
+			PeerCapture();
+
+			~PeerCapture();
+
+			// truncate path and start recording, magicNumber is kept to refuse replaying another network
+			bool Create(const std::string &path, uint32_t magicNumber);
+
+			bool Open(const std::string &path);
+
+			void Close();
+
+			uint32_t GetMagicNumber() const;
+
+			// id for the frames of a new connection
+			uint32_t AddPeer();
+
+			void Record(uint32_t peer, const std::string &type, const bytes_t &payload);
+
+			// next frame in file order, of any peer
+			bool Read(Frame &frame);
+
+			// next frame recorded from peer
+			bool Read(uint32_t peer, Frame &frame);
+
+			// count frames of type per peer and go back to the first frame
+			std::map<uint32_t, size_t> CountFrames(const std::string &type);
+
+			// the peer that sent most frames of type, typically the download peer for MSG_MERKLEBLOCK
+			uint32_t BusiestPeer(const std::string &type);
+
+			size_t FramesRecorded() const;
+
+		private:
+			bool Rewind();
+
+		private:
+			mutable boost::mutex _lock;
+			std::fstream _file;
+			bool _writing;
+			uint32_t _magicNumber, _peers;
+			double _startTime;
+			size_t _frames;
+		};
+
+		typedef boost::shared_ptr<PeerCapture> PeerCapturePtr;
+
+	}
+}
+
+#endif //__ELASTOS_SDK_PEERCAPTURE_H__
@@ -17,7 +17,10 @@ namespace Elastos {
 				Port(0),
 				Timestamp(0),
 				Services(SERVICES_NODE_NETWORK | SERVICES_NODE_BLOOM),
-				Flags(0) {
+				Flags(0),
+				LastSuccess(0),
+				Latency(0),
+				Failures(0) {
 
 		}
 
@@ -26,7 +29,10 @@ namespace Elastos {
 				Timestamp(timestamp),
 				Address(addr),
 				Services(SERVICES_NODE_NETWORK | SERVICES_NODE_BLOOM),
-				Flags(0) {
+				Flags(0),
+				LastSuccess(0),
+				Latency(0),
+				Failures(0) {
 		}
 
 		PeerInfo::PeerInfo(const uint128 &addr, uint16_t port, uint64_t timestamp, uint64_t services) :
@@ -34,7 +40,10 @@ namespace Elastos {
 				Timestamp(timestamp),
 				Services(services),
 				Address(addr),
-				Flags(0) {
+				Flags(0),
+				LastSuccess(0),
+				Latency(0),
+				Failures(0) {
 		}
 
 		PeerInfo::PeerInfo(const PeerInfo &peerInfo) {
@@ -47,6 +56,9 @@ namespace Elastos {
 			Port = peerInfo.Port;
 			Flags = peerInfo.Flags;
 			Services = peerInfo.Services;
+			LastSuccess = peerInfo.LastSuccess;
+			Latency = peerInfo.Latency;
+			Failures = peerInfo.Failures;
 
 			return *this;
 		}
@@ -92,5 +104,17 @@ namespace Elastos {
 			return std::string(temp);
 		}
 
+		double PeerInfo::Score(uint64_t now) const {
+			uint64_t seen = LastSuccess > Timestamp ? LastSuccess : Timestamp;
+			double score = seen < now ? -(double) (now - seen) / 3600 : 0; // an hour of age costs one point
+
+			if (LastSuccess != 0)
+				score += 24; // a peer that answered before beats an unknown address up to a day fresher
+			score -= Latency / 1000.0;
+			score -= 6.0 * Failures;
+
+			return score;
+		}
+
 	}
 }
@@ -22,6 +22,9 @@ namespace Elastos {
 			uint64_t Services; // bitcoin network services supported by peer
 			uint64_t Timestamp; // timestamp reported by peer
 			uint8_t Flags; // scratch variable
+			uint64_t LastSuccess; // local time of the last completed handshake, 0 if never
+			uint32_t Latency; // handshake round trip of the last success, in milliseconds
+			uint32_t Failures; // connection failures since the last success
 
 			PeerInfo();
 
@@ -44,6 +47,9 @@ namespace Elastos {
 			bool IsIPv4() const;
 
 			std::string GetHost() const;
+
+			// address book rank, higher is better: recently good peers first, then fresh addresses
+			double Score(uint64_t now) const;
 		};
 
 	}
@@ -24,10 +24,17 @@
 #include <netinet/in.h>
 #include <boost/bind.hpp>
 #include <boost/thread.hpp>
+#include <cfloat>
+#include <algorithm>
 #include <arpa/inet.h>
 
 #define PROTOCOL_TIMEOUT      120.0
 #define MAX_CONNECT_FAILURES  1000 // notify user of network problems after this many connect failures in a row
+#define MAX_PEER_FAILURES     3 // drop an address from the book after this many connect failures in a row
+#define DNS_LOOKUP_INTERVAL   60 // don't query the dns seeds again within this many seconds
+#define MAX_DOWNLOAD_STALLS   3 // replace the download peer after this many stalled block requests
+#define DOWNLOAD_PEER_HYSTERESIS 2.0 // a connected peer must be this many times cheaper to replace the download peer
+#define PROBE_BLOCKS_COUNT    50 // blocks a peer that is not downloading the chain fetches to measure its rate
 #define PEER_FLAG_SYNCED      0x01
 #define PEER_FLAG_NEEDSUPDATE 0x02
 
@@ -153,6 +160,9 @@ namespace Elastos {
 
 				_keepAliveTimestamp(0),
 				_earliestKeyTime(earliestKeyTime),
+				_dnsLookupTime(0),
+				_lastBlockTime(0),
+				_reconnectCount(0),
 				_reconnectSeconds(reconnectSeconds),
 				_syncStartHeight(0),
 				_filterUpdateHeight(0),
@@ -185,11 +195,12 @@ namespace Elastos {
 					_lastBlock = checkBlock;
 			}
 
+			BlockSet loaded;
 			MerkleBlockPtr block = nullptr, earlistBlock = nullptr;
 			for (size_t i = 0; i < blocks.size(); i++) {
 				assert(blocks[i]->GetHeight() !=
 					   BLOCK_UNKNOWN_HEIGHT); // height must be saved/restored along with serialized block
-				_orphans.Insert(blocks[i]);
+				loaded.Insert(blocks[i]);
 
 				if ((blocks[i]->GetHeight() % BLOCK_DIFFICULTY_INTERVAL) == 0 &&
 					(block == nullptr || blocks[i]->GetHeight() > block->GetHeight()))
@@ -204,8 +215,14 @@ namespace Elastos {
 			while (block != nullptr) {
 				_blocks.Insert(block);
 				_lastBlock = block;
-				_orphans.Remove(block);
-				block = _orphans.GetMatchPrevHash(block->GetHash());
+				loaded.Remove(block);
+				block = loaded.GetMatchPrevHash(block->GetHash());
+			}
+
+			// whatever did not connect stays as orphans, subject to the pool's byte budget
+			for (size_t i = 0; i < blocks.size(); i++) {
+				if (loaded.Contains(blocks[i]))
+					_orphans.Insert(blocks[i]);
 			}
 		}
 
@@ -259,6 +276,11 @@ namespace Elastos {
 			lock.lock();
 //			if (_connectFailureCount >= MAX_CONNECT_FAILURES) _connectFailureCount = 0; //this is a manual retry
 
+			if (!_enableReconnect) { // disconnected while a dns lookup was pending
+				lock.unlock();
+				return;
+			}
+
 			if ((!_downloadPeer || _lastBlock->GetHeight() < _estimatedHeight) && _syncStartHeight == 0) {
 				_syncStartHeight = _lastBlock->GetHeight() + 1;
 				lock.unlock();
@@ -285,7 +307,10 @@ namespace Elastos {
 				while (!peers.empty() && _connectedPeers.size() < _maxConnectCount) {
 					size_t i = BRRand((uint32_t) peers.size()); // index of random peer
 
-					i = i * i / peers.size(); // bias random peer selection toward peers with more recent timestamp
+					i = i * i / peers.size(); // bias random peer selection toward peers with a better score
+
+					if (peers[0].LastSuccess != 0 && peers[0].Failures == 0)
+						i = 0; // the best peer answered last time, try it first
 
 					for (size_t j = _connectedPeers.size(); i != SIZE_MAX && j > 0; j--) {
 						if (peers[i] != _connectedPeers[j - 1]->GetPeerInfo()) continue;
@@ -298,6 +323,7 @@ namespace Elastos {
 						newPeer->InitDefaultMessages();
 						newPeer->SetPeerInfo(peers[i]);
 						newPeer->setEarliestKeyTime(_earliestKeyTime);
+						newPeer->SetCapture(_capture);
 						peers.erase(peers.begin() + i);
 
 						_connectedPeers.push_back(newPeer);
@@ -312,7 +338,10 @@ namespace Elastos {
 				connectionStatusChanged = true;
 			}
 
-			if (_connectedPeers.empty()) {
+			if (_connectedPeers.empty() && _dnsThreadCount > 0) {
+				Log::info("{} waiting for dns seeds", GetID());
+				lock.unlock();
+			} else if (_connectedPeers.empty()) {
 				Log::error("{} sync failed: {}", GetID(), std::string(strerror(ENETUNREACH)));
 				SyncStopped();
 				lock.unlock();
@@ -373,20 +402,23 @@ namespace Elastos {
 			_blocks.Clear();
 			_orphans.Clear();
 			_checkpoints.Clear();
-			_txRelays.clear();
-			_txRequests.clear();
-			_publishedTx.clear();
-			_publishedTxHashes.clear();
+			_txRelays.Clear();
+			_txRequests.Clear();
+			_publishedTx.Clear();
 
 			InitBlocks({});
 		}
 
 		void PeerManager::ReconnectLaster(time_t seconds) {
+			lock.lock();
+			_reconnectCount++;
+			lock.unlock();
+
 			Disconnect();
 			ConnectLaster(seconds);
 		}
 
-		double PeerManager::GetSyncProgressInternal(uint32_t startHeight) {
+		double PeerManager::GetSyncProgressInternal(uint32_t startHeight) const {
 			double progress;
 
 			if (startHeight == 0) startHeight = _syncStartHeight;
@@ -489,6 +521,76 @@ namespace Elastos {
 			return _lastBlock->GetTimestamp();
 		}
 
+		std::vector<Peer::Stats> PeerManager::GetPeerStats() const {
+			boost::mutex::scoped_lock scopedLock(lock);
+			std::vector<Peer::Stats> stats;
+
+			for (size_t i = 0; i < _connectedPeers.size(); ++i) {
+				stats.push_back(_connectedPeers[i]->GetStats());
+				stats.back().downloadPeer = _connectedPeers[i] == _downloadPeer;
+			}
+
+			return stats;
+		}
+
+		OrphanPool::Stats PeerManager::GetOrphanStats() const {
+			boost::mutex::scoped_lock scopedLock(lock);
+			return _orphans.GetStats();
+		}
+
+		nlohmann::json PeerManager::GetNetworkStats() const {
+			nlohmann::json j, peers = nlohmann::json::array();
+			NetworkStats totals;
+			time_t now = time(NULL);
+
+			boost::mutex::scoped_lock scopedLock(lock);
+			j["ChainID"] = _chainID;
+			j["ConnectStatus"] = _connectStatus == Peer::Connecting ? "Connecting" :
+								 (_connectStatus == Peer::Connected ? "Connected" : "Disconnected");
+			j["ConnectedPeers"] = _connectedPeers.size();
+			j["LastBlockHeight"] = _lastBlock ? _lastBlock->GetHeight() : 0;
+			j["EstimatedHeight"] = _estimatedHeight;
+			j["SyncProgress"] = GetSyncProgressInternal(0);
+			j["SecondsSinceLastBlock"] = _lastBlockTime > 0 ? nlohmann::json(now - _lastBlockTime) : nlohmann::json();
+			j["Reconnects"] = _reconnectCount;
+			j["ConnectFailures"] = _connectFailureCount;
+			j["BloomFalsePositiveRate"] = _fpRate;
+
+			OrphanPool::Stats orphans = _orphans.GetStats();
+			j["Orphans"]["Count"] = orphans.count;
+			j["Orphans"]["Bytes"] = orphans.bytes;
+			j["Orphans"]["Evictions"] = orphans.evictions;
+
+			j["PublishQueue"]["Size"] = _publishedTx.Size();
+			j["PublishQueue"]["PendingCallbacks"] = _publishedTx.PendingCallbacks();
+
+			totals.Merge(_netStats);
+			for (size_t i = 0; i < _connectedPeers.size(); ++i) {
+				const PeerPtr &peer = _connectedPeers[i];
+				Peer::Stats stats = peer->GetStats();
+				nlohmann::json item;
+
+				item["Host"] = stats.host;
+				item["Port"] = stats.port;
+				item["DownloadPeer"] = peer == _downloadPeer;
+				item["LastBlock"] = stats.lastBlock;
+				item["PingTime"] = stats.pingTime < DBL_MAX ? nlohmann::json(stats.pingTime) : nlohmann::json();
+				item["DownloadRate"] = stats.downloadRate;
+				item["DownloadBytes"] = stats.downloadBytes;
+				item["Stalls"] = stats.stalls;
+				item["Misbehavior"] = stats.misbehavior;
+				item["SendQueueBytes"] = stats.sendQueueBytes;
+				item["Messages"] = peer->GetNetworkStats().ToJson();
+				peers.push_back(item);
+
+				totals.Merge(peer->GetNetworkStats());
+			}
+			j["Peers"] = peers;
+			j["Messages"] = totals.ToJson();
+
+			return j;
+		}
+
 		uint256 PeerManager::GetLastBlockHash() const {
 			boost::mutex::scoped_lock scopedLock(lock);
 			return _lastBlock->GetHash();
@@ -512,6 +614,30 @@ namespace Elastos {
 			return GetSyncProgressInternal(startHeight);
 		}
 
+		void PeerManager::SetCapture(const PeerCapturePtr &capture) {
+			boost::mutex::scoped_lock scoped_lock(lock);
+			_capture = capture;
+		}
+
+		int PeerManager::Replay(const PeerCapturePtr &capture, size_t maxBlocks, bool realtime) {
+			uint32_t source = capture->BusiestPeer(MSG_MERKLEBLOCK);
+			std::vector<uint128> addrList = AddressLookup("127.0.0.1");
+			PeerPtr peer = PeerPtr(new Peer(this, _chainParams->MagicNumber()));
+
+			peer->InitDefaultMessages();
+			peer->SetPeerInfo(PeerInfo(addrList.empty() ? uint128() : addrList[0], _chainParams->StandardPort(), 0, 0));
+			peer->setEarliestKeyTime(_earliestKeyTime);
+
+			{
+				boost::mutex::scoped_lock scoped_lock(lock);
+				_enableReconnect = false;
+				_connectedPeers.push_back(peer);
+			}
+
+			Log::info("{} replaying capture peer {}", GetID(), source);
+			return peer->Replay(capture, source, maxBlocks, realtime);
+		}
+
 		bool PeerManager::SetFixedPeer(const std::string &address, uint16_t port) {
 			std::vector<uint128> addrList = AddressLookup(address);
 			if (addrList.empty()) {
@@ -570,51 +696,65 @@ namespace Elastos {
 
 		void PeerManager::PublishTransaction(const TransactionPtr &tx,
 											 const Peer::PeerPubTxCallback &callback) {
+			if (tx) PublishTransactions({tx}, callback);
+		}
 
-			bool txValid = (tx != nullptr);
-			if (tx) lock.lock();
+		void PeerManager::PublishTransactions(const std::vector<TransactionPtr> &txns) {
+			PublishTransactions(txns, boost::bind(&PeerManager::FireTxPublished, this, _1, _2, _3));
+		}
 
-			if (tx && !tx->IsSigned()) {
-				lock.unlock();
-				if (!callback.empty()) callback(tx->GetHash(), EINVAL, "tx not signed"); // transaction not signed
-				txValid = false;
-//			} else if (tx && !_isConnected) {
-//				int connectFailureCount = connectFailureCount;
-//				lock.unlock();
-//
-//				if (connectFailureCount >= MAX_CONNECT_FAILURES ||
-//					(!fireNetworkIsReachable())) {
-//					if (!callback.empty()) callback(ENOTCONN); // not connected to bitcoin network
-//				} else lock.lock();
-			}
+		void PeerManager::PublishTransactions(const std::vector<TransactionPtr> &txns,
+											  const Peer::PeerPubTxCallback &callback) {
+			std::vector<TransactionPtr> unsignedTxns;
+			size_t queued = 0;
 
-			if (txValid) {
-				size_t i, count = 0;
+			{
+				boost::mutex::scoped_lock scopedLock(lock);
+				uint32_t now = (uint32_t) time(NULL);
 
-				tx->SetTimestamp((uint32_t) time(NULL)); // set timestamp to publish time
-				AddTxToPublishList(tx, callback);
+				for (size_t i = 0; i < txns.size(); ++i) {
+					if (!txns[i]) continue;
+
+					if (!txns[i]->IsSigned()) {
+						unsignedTxns.push_back(txns[i]);
+						continue;
+					}
 
-				for (i = _connectedPeers.size(); i > 0; i--) {
-					if (_connectedPeers[i - 1]->GetConnectStatus() == Peer::Connected) count++;
+					txns[i]->SetTimestamp(now); // set timestamp to publish time
+					AddTxToPublishList(txns[i], callback);
+					queued++;
 				}
 
-				for (i = _connectedPeers.size(); i > 0; i--) {
-					const PeerPtr &peer = _connectedPeers[i - 1];
+				if (queued > 0) {
+					size_t i, count = 0;
+
+					for (i = _connectedPeers.size(); i > 0; i--) {
+						if (_connectedPeers[i - 1]->GetConnectStatus() == Peer::Connected) count++;
+					}
 
-					if (peer->GetConnectStatus() != Peer::Connected) continue;
+					for (i = _connectedPeers.size(); i > 0; i--) {
+						const PeerPtr &peer = _connectedPeers[i - 1];
 
-					// instead of publishing to all peers, leave out downloadPeer to see if tx propogates/gets relayed back
-					// TODO: XXX connect to a random peer with an empty or fake bloom filter just for publishing
-					if (peer != _downloadPeer || count == 1) {
-						PublishPendingTx(peer);
+						if (peer->GetConnectStatus() != Peer::Connected) continue;
 
-						PingParameter pingParameter(_lastBlock->GetHeight(),
-													boost::bind(&PeerManager::PublishTxInvDone, this, peer, _1));
-						peer->SendMessage(MSG_PING, pingParameter);
+						// instead of publishing to all peers, leave out downloadPeer to see if tx propogates/gets relayed back
+						// TODO: XXX connect to a random peer with an empty or fake bloom filter just for publishing
+						if (peer != _downloadPeer || count == 1) {
+							PublishPendingTx(peer);
+
+							PingParameter pingParameter(_lastBlock->GetHeight(),
+														boost::bind(&PeerManager::PublishTxInvDone, this, peer, _1));
+							peer->SendMessage(MSG_PING, pingParameter);
+						}
 					}
+
+					Log::info("{} publishing {} tx", GetID(), queued);
 				}
+			}
 
-				lock.unlock();
+			for (size_t i = 0; i < unsignedTxns.size(); ++i) {
+				if (!callback.empty())
+					callback(unsignedTxns[i]->GetHash(), EINVAL, "tx not signed"); // transaction not signed
 			}
 		}
 
@@ -625,12 +765,7 @@ namespace Elastos {
 
 			{
 				boost::mutex::scoped_lock scoped_lock(lock);
-				for (size_t i = _txRelays.size(); i > 0; i--) {
-					if (_txRelays[i - 1].GetTransactionHash() != txHash)
-						continue;
-					count = _txRelays[i - 1].GetPeers().size();
-					break;
-				}
+				count = _txRelays.Count(txHash);
 			}
 
 			return count;
@@ -786,48 +921,32 @@ namespace Elastos {
 		}
 
 		void PeerManager::SortPeers() {
-			// comparator for sorting peers by timestamp, most recent first
-			std::sort(_peers.begin(), _peers.end(), [](const PeerInfo &first, const PeerInfo &second) {
-				return first.Timestamp > second.Timestamp;
+			uint64_t now = time(NULL);
+
+			// comparator for sorting peers by address book score, best first
+			std::sort(_peers.begin(), _peers.end(), [now](const PeerInfo &first, const PeerInfo &second) {
+				return first.Score(now) > second.Score(now);
 			});
 		}
 
 		void PeerManager::FindPeers() {
 			uint64_t services = SERVICES_NODE_NETWORK | SERVICES_NODE_BLOOM | _chainParams->Services();
 			time_t now = time(NULL);
-			struct timespec ts;
-
-			_peers.clear();
 
 			if (_fixedPeer.Address != 0) {
+				_peers.clear();
 				_peers.push_back(_fixedPeer);
 				_peers[0].Services = services;
 				_peers[0].Timestamp = now;
-			} else {
+			} else if (_dnsThreadCount == 0 && _dnsLookupTime + DNS_LOOKUP_INTERVAL <= now) {
+				// seeds resolve in the background and connect as soon as one answers, the caller keeps whatever
+				// addresses the book already has
+				_dnsLookupTime = now;
 				const std::vector<std::string> &dnsSeeds = _chainParams->DNSSeeds();
-				for (size_t i = 1; i < dnsSeeds.size(); i++) {
+				for (size_t i = 0; i < dnsSeeds.size(); i++) {
 					boost::thread workThread(boost::bind(&PeerManager::FindPeersThreadRoutine, this, dnsSeeds[i], services));
 					_dnsThreadCount++;
 				}
-
-				std::vector<uint128> addrList = AddressLookup(dnsSeeds[0]);
-				for (std::vector<uint128>::iterator addr = addrList.begin();
-					 addr != addrList.end() && (*addr) != 0; addr++) {
-					_peers.emplace_back(*addr, _chainParams->StandardPort(), now, services);
-				}
-
-				ts.tv_sec = 0;
-				ts.tv_nsec = 1;
-
-				do {
-					Unlock();
-					nanosleep(&ts, NULL); // pthread_yield() isn't POSIX standard :(
-					Lock();
-				} while (_dnsThreadCount > 0 && _peers.size() < PEER_MAX_CONNECTIONS);
-
-				SortPeers();
-
-				Log::debug("{} found {} peers", GetID(), _peers.size());
 			}
 		}
 
@@ -836,26 +955,38 @@ namespace Elastos {
 
 			if (_downloadPeer != nullptr) {
 				// don't cancel timeout if there's a pending tx publish callback
-				for (size_t i = _publishedTx.size(); i > 0; i--) {
-					if (_publishedTx[i - 1].HasCallback()) return;
-				}
+				if (_publishedTx.HasPendingCallbacks()) return;
 
 				_downloadPeer->ScheduleDisconnect(-1); // cancel sync timeout
 			}
 		}
 
 		void PeerManager::AddTxToPublishList(const TransactionPtr &tx, const Peer::PeerPubTxCallback &callback) {
-			if (tx && tx->GetBlockHeight() == TX_UNCONFIRMED) {
-				for (size_t i = _publishedTx.size(); i > 0; i--) {
-					if (_publishedTx[i - 1].GetTransaction()->IsEqual(*tx)) return;
-				}
+			if (!tx || tx->GetBlockHeight() != TX_UNCONFIRMED || _publishedTx.Contains(tx->GetHash()))
+				return;
+
+			// depth first over unconfirmed inputs that are not queued yet, so every tx is queued after its parents.
+			// each input hash is looked up in the wallet at most once.
+			std::vector<std::pair<TransactionPtr, size_t> > stack;
+			std::set<uint256> visited;
 
-				_publishedTx.emplace_back(tx, callback);
-				_publishedTxHashes.push_back(tx->GetHash());
+			stack.push_back(std::make_pair(tx, 0));
+			visited.insert(tx->GetHash());
+			while (!stack.empty()) {
+				TransactionPtr t = stack.back().first;
+				size_t next = stack.back().second++;
+
+				if (next < t->GetInputs().size()) {
+					const uint256 &hash = t->GetInputs()[next]->TxHash();
+					if (!visited.insert(hash).second || _publishedTx.Contains(hash))
+						continue;
 
-				for (size_t i = 0; i < tx->GetInputs().size(); i++) {
-					AddTxToPublishList(_wallet->TransactionForHash(tx->GetInputs()[i]->TxHash()),
-									   Peer::PeerPubTxCallback());
+					TransactionPtr parent = _wallet->TransactionForHash(hash);
+					if (parent && parent->GetBlockHeight() == TX_UNCONFIRMED)
+						stack.push_back(std::make_pair(parent, 0));
+				} else {
+					_publishedTx.Insert(PublishedTransaction(t, t == tx ? callback : Peer::PeerPubTxCallback()));
+					stack.pop_back();
 				}
 			}
 		}
@@ -864,16 +995,17 @@ namespace Elastos {
 			time_t now = time(nullptr);
 
 			Peer::ConnectStatus status = Peer::Disconnected;
-			bool connectionStatusChanged = false;
+			bool connectionStatusChanged = false, willSave = false, rejected = false;
 			PeerPtr peer = peerPtr;
+			PeerInfo saveInfo;
 
 			lock.lock();
 
-
 			// TODO: XXX does this work with 0.11 pruned nodes?
 			if ((peer->GetServices() & _chainParams->Services()) != _chainParams->Services()) {
 				peer->warn("unsupported node type");
 				peer->Disconnect();
+				rejected = true;
 			} else if (peer->GetServices() == 0 && peer->GetLastBlock() == 0) {
 				// Get address from address server
 				peer->SendMessage(MSG_GETADDR, Message::DefaultParam);
@@ -888,11 +1020,13 @@ namespace Elastos {
 				peer->warn("node doesn't carry full blocks");
 				peer->Disconnect();
 				_blackPeers.insert(peer->GetPeerInfo());
+				rejected = true;
 			} else if (peer->GetLastBlock() + 10 < _lastBlock->GetHeight()) {
 				peer->warn("peer->lastBlock: {} !=  lastBlock->height: {}", peer->GetLastBlock(),
 						   _lastBlock->GetHeight());
 				peer->warn("node isn't synced");
 				peer->Disconnect();
+				rejected = true;
 //			} else if (peer->GetVersion() >= 70011 &&
 //					   (peer->GetServices() & SERVICES_NODE_BLOOM) != SERVICES_NODE_BLOOM) {
 //				peer->warn("node doesn't support SPV mode");
@@ -918,7 +1052,7 @@ namespace Elastos {
 					const PeerPtr &p = _connectedPeers[i - 1];
 
 					if (p->GetConnectStatus() != Peer::Connected) continue;
-					if ((p->GetPingTime() < peer->GetPingTime() && p->GetLastBlock() >= peer->GetLastBlock()) ||
+					if ((p->DownloadCost() < peer->DownloadCost() && p->GetLastBlock() >= peer->GetLastBlock()) ||
 						p->GetLastBlock() > peer->GetLastBlock())
 						peer = p;
 				}
@@ -955,6 +1089,10 @@ namespace Elastos {
 				}
 			}
 
+			// only peers that passed the checks above earn a success in the address book
+			if (!rejected)
+				willSave = PeerSucceeded(peerPtr, saveInfo);
+
 			status = GetConnectStatusInternal();
 			if (_connectStatus != status) {
 				_connectStatus = status;
@@ -962,13 +1100,15 @@ namespace Elastos {
 			}
 
 			lock.unlock();
+			if (willSave) FireSavePeers(false, {saveInfo});
 			if (connectionStatusChanged) FireConnectStatusChanged(status);
 		}
 
 		void PeerManager::OnDisconnected(const PeerPtr &peer, int error) {
 			int willSave = 0, txError = 0;
-			bool willReconnect = false, isBlack = false, connectionStatusChanged = false;
+			bool willReconnect = false, isBlack = false, connectionStatusChanged = false, saveFailure = false;
 			Peer::ConnectStatus status = Peer::Disconnected;
+			PeerInfo failedInfo;
 
 			{
 				boost::mutex::scoped_lock scopedLock(lock);
@@ -977,7 +1117,7 @@ namespace Elastos {
 					_connectFailureCount++;
 					PeerMisbehaving(peer);
 				} else if (error) { // timeout or some non-protocol related network error
-					RemovePeer(peer);
+					saveFailure = PeerFailed(peer, failedInfo);
 					_connectFailureCount++;
 
 					// if it's a timeout and there's pending tx publish callbacks, the tx publish timed out
@@ -987,9 +1127,9 @@ namespace Elastos {
 						txError = ETIMEDOUT;
 				}
 
-				for (size_t i = _txRelays.size(); i > 0; i--) {
-					_txRelays[i - 1].RemovePeer(peer);
-				}
+				_txRelays.RemovePeer(peer->GetPeerInfo());
+				_netStats.Merge(peer->GetNetworkStats());
+				_orphans.RemoveSource(peer.get());
 
 				if (_blackPeers.find(peer->GetPeerInfo()) != _blackPeers.end()) {
 					RemovePeer(peer);
@@ -1014,6 +1154,7 @@ namespace Elastos {
 				} else if (_enableReconnect && _connectFailureCount < MAX_CONNECT_FAILURES) {
 					peer->info("will reconnect");
 					willReconnect = true;
+					_reconnectCount++;
 				}
 
 				for (std::vector<PeerPtr>::iterator p = _connectedPeers.begin(); p != _connectedPeers.end();) {
@@ -1034,6 +1175,7 @@ namespace Elastos {
 			}
 
 			if (connectionStatusChanged) FireConnectStatusChanged(status);
+			if (saveFailure && !willSave) FireSavePeers(false, {failedInfo});
 			if (willSave) FireSavePeers(true, {});
 			if (willSave) FireSyncStopped(error);
 			if (isBlack) FireSaveBlackPeer(peer->GetPeerInfo());
@@ -1065,8 +1207,8 @@ namespace Elastos {
 					}
 				}
 
-				std::sort(save.begin(), save.end(), [](const PeerInfo &first, const PeerInfo &second) {
-					return first.Timestamp > second.Timestamp;
+				std::sort(save.begin(), save.end(), [now](const PeerInfo &first, const PeerInfo &second) {
+					return first.Score(now) > second.Score(now);
 				});
 
 				// limit total to 2500 peers
@@ -1106,13 +1248,11 @@ namespace Elastos {
                     peer->ScheduleDisconnect(PROTOCOL_TIMEOUT);
                 }
 
-				for (size_t i = _publishedTx.size(); i > 0; i--) { // see if tx is in list of published tx
-					if (_publishedTxHashes[i - 1] == tx->GetHash()) {
-						pubTx = _publishedTx[i - 1];
-						_publishedTx[i - 1].ResetCallback();
-						relayCount = AddPeerToList(peer, tx->GetHash(), _txRelays);
-					} else if (_publishedTx[i - 1].HasCallback()) hasPendingCallbacks = 1;
+				if (_publishedTx.Contains(tx->GetHash())) { // see if tx is in list of published tx
+					pubTx = _publishedTx.ResetCallback(tx->GetHash());
+					relayCount = _txRelays.AddPeer(tx->GetHash(), peer->GetPeerInfo());
 				}
+				hasPendingCallbacks = _publishedTx.HasPendingCallbacks();
 
 				// cancel tx publish timeout if no publish callbacks are pending, and syncing is done or this is not downloadPeer
 				if (!hasPendingCallbacks && (_syncStartHeight == 0 || peer != _downloadPeer)) {
@@ -1136,9 +1276,9 @@ namespace Elastos {
 					// keep track of how many peers have or relay a tx, this indicates how likely the tx is to confirm
 					// (we only need to track this after syncing is complete)
 					if (_syncStartHeight == 0)
-						relayCount = AddPeerToList(peer, tx->GetHash(), _txRelays);
+						relayCount = _txRelays.AddPeer(tx->GetHash(), peer->GetPeerInfo());
 
-					RemovePeerFromList(peer, tx->GetHash(), _txRequests);
+					_txRequests.RemovePeer(tx->GetHash(), peer->GetPeerInfo());
 
 					if (_bloomFilter != nullptr) { // check if bloom filter is already being updated
 
@@ -1183,14 +1323,12 @@ namespace Elastos {
 				TransactionPtr tx = _wallet->TransactionForHash(txHash);
 				peer->info("has tx");
 
-				for (size_t i = _publishedTx.size(); i > 0; i--) { // see if tx is in list of published tx
-					if (_publishedTxHashes[i - 1] == txHash) {
-						if (!tx) tx = _publishedTx[i - 1].GetTransaction();
-						pubTx = _publishedTx[i - 1];
-						_publishedTx[i - 1].ResetCallback();
-						relayCount = AddPeerToList(peer, txHash, _txRelays);
-					} else if (_publishedTx[i - 1].HasCallback()) hasPendingCallbacks = 1;
+				if (_publishedTx.Contains(txHash)) { // see if tx is in list of published tx
+					pubTx = _publishedTx.ResetCallback(txHash);
+					if (!tx) tx = pubTx.GetTransaction();
+					relayCount = _txRelays.AddPeer(txHash, peer->GetPeerInfo());
 				}
+				hasPendingCallbacks = _publishedTx.HasPendingCallbacks();
 
 				// cancel tx publish timeout if no publish callbacks are pending, and syncing is done or this is not downloadPeer
 				if (!hasPendingCallbacks && (_syncStartHeight == 0 || peer != _downloadPeer)) {
@@ -1209,7 +1347,7 @@ namespace Elastos {
 					// keep track of how many peers have or relay a tx, this indicates how likely the tx is to confirm
 					// (we only need to track this after syncing is complete)
 					if (_syncStartHeight == 0)
-						relayCount = AddPeerToList(peer, txHash, _txRelays);
+						relayCount = _txRelays.AddPeer(txHash, peer->GetPeerInfo());
 
 					// set timestamp when tx is verified
 					if (relayCount >= _maxConnectCount && tx && tx->GetBlockHeight() == TX_UNCONFIRMED &&
@@ -1218,7 +1356,7 @@ namespace Elastos {
 						_wallet->UpdateTransactions(hashes, TX_UNCONFIRMED, (uint32_t) time(NULL));
 					}
 
-					RemovePeerFromList(peer, txHash, _txRequests);
+					_txRequests.RemovePeer(txHash, peer->GetPeerInfo());
 				}
 			}
 
@@ -1232,20 +1370,12 @@ namespace Elastos {
 				boost::mutex::scoped_lock scopedLock(lock);
 				peer->info("rejected tx: code {}, reason {}", code, reason);
 				tx = _wallet->TransactionForHash(txHash);
-				RemovePeerFromList(peer, txHash, _txRequests);
-
-				for (size_t i = _publishedTx.size(); i > 0; --i) { // see if tx is in list of published tx
-					if (_publishedTxHashes[i - 1] == txHash) {
-						pubTx = _publishedTx[i - 1];
-						_publishedTx[i - 1].ResetCallback();
-						_publishedTx.erase(_publishedTx.begin() + (i - 1));
-						_publishedTxHashes.erase(_publishedTxHashes.begin() + (i - 1));
-						break;
-					}
-				}
+				_txRequests.RemovePeer(txHash, peer->GetPeerInfo());
+
+				pubTx = _publishedTx.Remove(txHash); // see if tx is in list of published tx
 
 				if (tx) {
-					if (RemovePeerFromList(peer, txHash, _txRelays) && tx->GetBlockHeight() == TX_UNCONFIRMED) {
+					if (_txRelays.RemovePeer(txHash, peer->GetPeerInfo()) && tx->GetBlockHeight() == TX_UNCONFIRMED) {
 						// set timestamp 0 to mark tx as unverified
 						_wallet->UpdateTransactions({txHash}, TX_UNCONFIRMED, 0);
 					}
@@ -1282,6 +1412,7 @@ namespace Elastos {
 
 			{
 				boost::mutex::scoped_lock scopedLock(lock);
+				_lastBlockTime = time(NULL);
 				prev = _blocks.Get(block->GetPrevBlockHash());
 
 				if (prev) {
@@ -1347,7 +1478,8 @@ namespace Elastos {
 							peer->SendMessage(MSG_GETBLOCKS, getBlocksParameter);
 						}
 
-						_orphans.Insert(block); // BUG: limit total orphans to avoid memory exhaustion attack
+						if (!_orphans.Insert(block, peer.get()))
+							peer->debug("orphan #{} not pooled", block->GetHeight());
 						_lastOrphan = block;
 						peer->ScheduleDisconnect(PROTOCOL_TIMEOUT); // reschedule sync timeout
 					}
@@ -1355,6 +1487,8 @@ namespace Elastos {
 					peer->warn("relayed invalid block");
 					PeerMisbehaving(peer);
 				} else if (block->GetPrevBlockHash() == _lastBlock->GetHash()) { // new block extends main chain
+					if (IsTrustedHistory(block))
+						block->DiscardAuxPow(); // pow was checked on receipt, keep only the header
 					_blocks.Insert(block);
 					_lastBlock = block;
 					_wallet->SetBlockHeight(_lastBlock->GetHeight());
@@ -1368,6 +1502,23 @@ namespace Elastos {
 						txTotal = 0;
 					}
 
+					if (peer == _downloadPeer && (block->GetHeight() % 500) == 0 &&
+						block->GetHeight() < _estimatedHeight) {
+						DownloadPeerVerdict verdict = JudgeDownloadPeer();
+						if (verdict == DownloadPeerStalled) {
+							PeerInfo info;
+							peer->warn("download peer stalls, switching");
+							PeerFailed(peer, info); // rank it below the others for the reconnect
+							peer->Disconnect();
+						} else if (verdict == DownloadPeerSlow) {
+							// a working peer that is only slower keeps its standing in the address book
+							peer->warn("download peer is slow, switching");
+							peer->Disconnect();
+						} else {
+							ProbeDownloadCandidate();
+						}
+					}
+
 					if (txHashes.size() > 0)
 						_wallet->UpdateTransactions(txHashes, block->GetHeight(), block->GetTimestamp());
 					if (_downloadPeer) _downloadPeer->SetCurrentBlockHeight(block->GetHeight());
@@ -1402,6 +1553,8 @@ namespace Elastos {
 
 					b = _blocks.Get(block->GetHash());
 					if (b != nullptr) _blocks.Remove(b);
+					if (IsTrustedHistory(block))
+						block->DiscardAuxPow();
 					_blocks.Insert(block);
 
 					if (b != nullptr && b != block) {
@@ -1412,7 +1565,7 @@ namespace Elastos {
 					block->GetHeight() >
 							   _lastBlock->GetHeight() + 1) { // special case, new block mined durring rescan
 					peer->info("marking new block #{} as orphan until rescan completes", block->GetHeight());
-					_orphans.Insert(block); // mark as orphan til we're caught up
+					_orphans.Insert(block, peer.get()); // mark as orphan til we're caught up
 					_lastOrphan = block;
 				} else if (block->GetHeight() <= _chainParams->LastCheckpoint().Height()) { // old fork
 					peer->info("ignoring block on fork older than most recent checkpoint, block #{}, hash: {}",
@@ -1523,8 +1676,8 @@ namespace Elastos {
 									 const std::vector<uint256> &blockHashes) {
 			boost::mutex::scoped_lock scopedLock(lock);
 			for (size_t i = 0; i < txHashes.size(); i++) {
-				RemovePeerFromList(peer, txHashes[i], _txRelays);
-				RemovePeerFromList(peer, txHashes[i], _txRequests);
+				_txRelays.RemovePeer(txHashes[i], peer->GetPeerInfo());
+				_txRequests.RemovePeer(txHashes[i], peer->GetPeerInfo());
 			}
 		}
 
@@ -1554,20 +1707,16 @@ namespace Elastos {
 
 			{
 				boost::mutex::scoped_lock scopedLock(lock);
-				for (size_t i = _publishedTx.size(); i > 0; i--) {
-					if (_publishedTx[i - 1].GetTransaction()->GetHash() == txHash) {
-						pubTx = _publishedTx[i - 1];
-						//_publishedTx[i - 1].ResetCallback();
-					} else if (_publishedTx[i - 1].HasCallback())
-						hasPendingCallbacks = 1;
-				}
+				pubTx = _publishedTx.Get(txHash);
+				// only callbacks of other published tx count, this one fires below
+				hasPendingCallbacks = _publishedTx.PendingCallbacks() > (pubTx.HasCallback() ? 1 : 0);
 
 				// cancel tx publish timeout if no publish callbacks are pending, and syncing is done or this is not downloadPeer
 				if (!hasPendingCallbacks && (_syncStartHeight == 0 || peer != _downloadPeer)) {
 					peer->ScheduleDisconnect(-1); // cancel publish tx timeout
 				}
 
-				//AddPeerToList(peer, txHash, _txRelays);
+				//_txRelays.AddPeer(txHash, peer->GetPeerInfo());
 				if (pubTx.GetTransaction() != nullptr)
 					_wallet->RegisterTransaction(pubTx.GetTransaction());
 				if (pubTx.GetTransaction() != nullptr && !_wallet->TransactionIsValid(pubTx.GetTransaction()))
@@ -1596,57 +1745,120 @@ namespace Elastos {
 			}
 		}
 
-		size_t PeerManager::PublishPendingTx(const PeerPtr &peer) {
-			std::vector<uint256> pendingHashes;
+		bool PeerManager::PeerSucceeded(const PeerPtr &peer, PeerInfo &info) {
+			std::vector<PeerInfo>::iterator p = std::find(_peers.begin(), _peers.end(), peer->GetPeerInfo());
+			if (p == _peers.end())
+				return false;
 
-			for (size_t i = _publishedTx.size(); i > 0; i--) {
-				if (!_publishedTx[i - 1].HasCallback() ||
-					_publishedTx[i - 1].GetTransaction()->GetBlockHeight() != TX_UNCONFIRMED)
+			p->LastSuccess = time(NULL);
+			p->Latency = peer->GetPingTime() < DBL_MAX ? (uint32_t) (peer->GetPingTime() * 1000) : 0;
+			p->Failures = 0;
+			info = *p;
+			SortPeers();
+			return true;
+		}
+
+		bool PeerManager::PeerFailed(const PeerPtr &peer, PeerInfo &info) {
+			std::vector<PeerInfo>::iterator p = std::find(_peers.begin(), _peers.end(), peer->GetPeerInfo());
+			if (p == _peers.end())
+				return false;
+
+			p->Failures++;
+			info = *p;
+			if (p->Failures >= MAX_PEER_FAILURES)
+				_peers.erase(p);
+			else
+				SortPeers();
+
+			return true;
+		}
+
+		bool PeerManager::IsTrustedHistory(const MerkleBlockPtr &block) const {
+			// the same week before earliestKeyTime the chain download starts from, no wallet tx can be that old
+			return block->GetHeight() <= _chainParams->LastCheckpoint().Height() ||
+				   block->GetTimestamp() + 7 * 24 * 60 * 60 < _earliestKeyTime;
+		}
+
+		PeerManager::DownloadPeerVerdict PeerManager::JudgeDownloadPeer() const {
+			std::vector<Peer::Stats> others;
+			for (size_t i = _connectedPeers.size(); i > 0; i--) {
+				const PeerPtr &p = _connectedPeers[i - 1];
+				if (p != _downloadPeer && p->GetConnectStatus() == Peer::Connected)
+					others.push_back(p->GetStats());
+			}
+
+			return JudgeDownloadPeer(_downloadPeer->GetStats(), others);
+		}
+
+		void PeerManager::ProbeDownloadCandidate() {
+			// Only the download peer gets block batches during the sync, the others would never have a rate to
+			// compare. Let the unmeasured peer with the lowest ping fetch the last few blocks through a filter
+			// that matches nothing, so no transactions come along with them.
+			PeerPtr candidate;
+			for (size_t i = _connectedPeers.size(); i > 0; i--) {
+				const PeerPtr &p = _connectedPeers[i - 1];
+
+				if (p == _downloadPeer || p->GetConnectStatus() != Peer::Connected || p->SentFilter() ||
+					p->WaitingBlocks() || p->GetLastBlock() < _downloadPeer->GetLastBlock())
 					continue;
-				peer->ScheduleDisconnect(PROTOCOL_TIMEOUT);  // schedule publish timeout
-				pendingHashes.push_back(_publishedTx[i - 1].GetTransaction()->GetHash());
+
+				if (candidate == nullptr || p->GetPingTime() < candidate->GetPingTime())
+					candidate = p;
 			}
 
-			InventoryParameter inventoryParameter;
-			inventoryParameter.txHashes = pendingHashes;
-			peer->SendMessage(MSG_INV, inventoryParameter);
+			if (candidate == nullptr)
+				return;
 
-			return pendingHashes.size();
+			std::vector<uint256> blockHashes;
+			for (MerkleBlockPtr block = _lastBlock; block != nullptr && blockHashes.size() < PROBE_BLOCKS_COUNT;
+				 block = _blocks.Get(block->GetPrevBlockHash()))
+				blockHashes.insert(blockHashes.begin(), block->GetHash());
+
+			FilterLoadParameter filterParam;
+			filterParam.Filter = BloomFilterPtr(new BloomFilter(BLOOM_REDUCED_FALSEPOSITIVE_RATE, 1, 0,
+																BLOOM_UPDATE_NONE));
+			candidate->SendMessage(MSG_FILTERLOAD, filterParam);
+
+			candidate->info("probing download rate with {} block(s)", blockHashes.size());
+			candidate->ProbeDownload(blockHashes);
 		}
 
-		size_t
-		PeerManager::AddPeerToList(const PeerPtr &peer, const uint256 &txHash, std::vector<TransactionPeerList> &list) {
-			for (size_t i = list.size(); i > 0; i--) {
-				if (list[i - 1].GetTransactionHash() != txHash)
-					continue;
+		PeerManager::DownloadPeerVerdict PeerManager::JudgeDownloadPeer(const Peer::Stats &download,
+																		const std::vector<Peer::Stats> &others) {
+			if (download.stalls >= MAX_DOWNLOAD_STALLS)
+				return DownloadPeerStalled;
 
-				for (size_t j = list[i - 1].GetPeers().size(); j > 0; j--) {
-					if (list[i - 1].GetPeers()[j - 1]->IsEqual(peer.get()))
-						return list[i - 1].GetPeers().size();
-				}
+			if (download.downloadRate == 0) // not measured yet
+				return KeepDownloadPeer;
+
+			// an unmeasured peer is only priced at a guessed rate, it can't show the download peer is slow
+			double cost = Peer::DownloadCost(download);
+			for (size_t i = 0; i < others.size(); ++i) {
+				if (others[i].downloadRate == 0 || others[i].lastBlock < download.lastBlock)
+					continue;
 
-				list[i - 1].AddPeer(peer);
-				return list[i - 1].GetPeers().size();
+				if (Peer::DownloadCost(others[i]) * DOWNLOAD_PEER_HYSTERESIS < cost)
+					return DownloadPeerSlow;
 			}
 
-			list.push_back(TransactionPeerList(txHash, {peer}));
-			return 1;
+			return KeepDownloadPeer;
 		}
 
-		bool PeerManager::RemovePeerFromList(const PeerPtr &peer, const uint256 &txHash,
-											 std::vector<TransactionPeerList> &list) {
-			bool removed = false;
-			for (size_t i = list.size(); i > 0; i--) {
-				if (list[i - 1].GetTransactionHash() == txHash) {
-					removed = list[i - 1].RemovePeer(peer);
-					break;
-				}
-			}
+		size_t PeerManager::PublishPendingTx(const PeerPtr &peer) {
+			std::vector<uint256> pendingHashes = _publishedTx.GetPendingHashes(); // parents first
+
+			if (!pendingHashes.empty())
+				peer->ScheduleDisconnect(PROTOCOL_TIMEOUT);  // schedule publish timeout
+
+			InventoryParameter inventoryParameter;
+			inventoryParameter.txHashes = pendingHashes;
+			peer->SendMessage(MSG_INV, inventoryParameter);
 
-			return removed;
+			return pendingHashes.size();
 		}
 
 		void PeerManager::PeerMisbehaving(const PeerPtr &peer) {
+			peer->AddMisbehavior();
 			RemovePeer(peer);
 
 			if (++_misbehavinCount >= 10) { // clear out stored peers so we get a fresh list from DNS for next connect
@@ -1662,6 +1874,10 @@ namespace Elastos {
 			return _chainID;
 		}
 
+		uint32_t PeerManager::GetMagicNumber() const {
+			return _chainParams->MagicNumber();
+		}
+
 		const std::vector<PeerInfo> &PeerManager::GetPeers() const {
 			return _peers;
 		}
@@ -1754,7 +1970,7 @@ namespace Elastos {
 			lock.lock();
 			if (success) {
 				MempoolParameter mempoolParameter;
-				mempoolParameter.KnownTxHashes = _publishedTxHashes;
+				mempoolParameter.KnownTxHashes = _publishedTx.GetHashes();
 				mempoolParameter.CompletionCallback = boost::bind(&PeerManager::MempoolDone, this, peer, _1);
 				peer->SendMessage(MSG_MEMPOOL, mempoolParameter);
 				lock.unlock();
@@ -1891,7 +2107,7 @@ namespace Elastos {
 					peer->SendMessage(MSG_PING, pingParameter);
 				} else {
 					MempoolParameter mempoolParameter;
-					mempoolParameter.KnownTxHashes = _publishedTxHashes;
+					mempoolParameter.KnownTxHashes = _publishedTx.GetHashes();
 					mempoolParameter.CompletionCallback = boost::bind(&PeerManager::MempoolDone, this, peer, _1);
 					peer->SendMessage(MSG_MEMPOOL, mempoolParameter);
 				}
@@ -1931,10 +2147,10 @@ namespace Elastos {
 			std::vector<uint256> txHashes;
 
 			for (size_t i = 0; i < tx.size(); i++) {
-				if (!PeerListHasPeer(_txRelays, tx[i]->GetHash(), peer) &&
-					!PeerListHasPeer(_txRequests, tx[i]->GetHash(), peer)) {
+				if (!_txRelays.HasPeer(tx[i]->GetHash(), peer->GetPeerInfo()) &&
+					!_txRequests.HasPeer(tx[i]->GetHash(), peer->GetPeerInfo())) {
 					txHashes.push_back(tx[i]->GetHash());
-					AddPeerToList(peer, tx[i]->GetHash(), _txRequests);
+					_txRequests.AddPeer(tx[i]->GetHash(), peer->GetPeerInfo());
 				}
 			}
 
@@ -1951,22 +2167,6 @@ namespace Elastos {
 			} else peer->SetFlags(peer->GetFlags() | PEER_FLAG_SYNCED);
 		}
 
-		bool PeerManager::PeerListHasPeer(const std::vector<TransactionPeerList> &peerList, const uint256 &txhash,
-										  const PeerPtr &peer) {
-			for (size_t i = peerList.size(); i > 0; i--) {
-				if (peerList[i - 1].GetTransactionHash() != txhash) continue;
-
-				for (size_t j = peerList[i - 1].GetPeers().size(); j > 0; j--) {
-					if (peerList[i - 1].GetPeers()[j - 1]->IsEqual(peer.get()))
-						return true;
-				}
-
-				break;
-			}
-
-			return false;
-		}
-
 		void PeerManager::RequestUnrelayedTxGetDataDone(const PeerPtr &callbackPeer, int success) {
 			bool isPublishing;
 			size_t count = 0;
@@ -1991,20 +2191,12 @@ namespace Elastos {
 
 				for (size_t i = tx.size(); i > 0; i--) {
 					hash = tx[i - 1]->GetHash();
-					isPublishing = false;
-
-					for (size_t j = _publishedTx.size(); !isPublishing && j > 0; j--) {
-						if (_publishedTx[j - 1].GetTransaction()->IsEqual(*tx[i - 1]) &&
-							_publishedTx[j - 1].HasCallback())
-							isPublishing = true;
-						break;
-					}
+					isPublishing = _publishedTx.Get(hash).HasCallback();
 
-					if (!isPublishing && PeerListCount(_txRelays, hash) == 0 &&
-						PeerListCount(_txRequests, hash) == 0) {
+					if (!isPublishing && _txRelays.Count(hash) == 0 && _txRequests.Count(hash) == 0) {
 						peer->info("removing tx unconfirmed at: {}, txHash: {}", _lastBlock->GetHeight(), hash.GetHex());
 						_wallet->RemoveTransaction(hash);
-					} else if (!isPublishing && PeerListCount(_txRelays, hash) < _maxConnectCount) {
+					} else if (!isPublishing && _txRelays.Count(hash) < _maxConnectCount) {
 						// set timestamp 0 to mark as unverified
 						_wallet->UpdateTransactions({hash}, TX_UNCONFIRMED, 0);
 					}
@@ -2012,15 +2204,6 @@ namespace Elastos {
 			}
 		}
 
-		size_t PeerManager::PeerListCount(const std::vector<TransactionPeerList> &list, const uint256 &txhash) {
-			for (size_t i = list.size(); i > 0; i--) {
-				if (list[i - 1].GetTransactionHash() == txhash)
-					return list[i - 1].GetPeers().size();
-			}
-
-			return 0;
-		}
-
 		void PeerManager::PublishTxInvDone(const PeerPtr &peer, int success) {
 			boost::mutex::scoped_lock scopedLock(lock);
 			RequestUnrelayedTx(peer);
@@ -2029,12 +2212,31 @@ namespace Elastos {
 		void PeerManager::FindPeersThreadRoutine(const std::string &hostname, uint64_t services) {
 			std::vector<uint128> addrList = AddressLookup(hostname);
 			time_t now = time(NULL);
+			size_t found = 0;
+			bool connect;
 
-			boost::mutex::scoped_lock scopedLock(lock);
+			lock.lock();
 			for (std::vector<uint128>::iterator addr = addrList.begin(); addr != addrList.end() && (*addr) != 0; addr++) {
-				_peers.emplace_back(*addr, _chainParams->StandardPort(), now, services);
+				PeerInfo info(*addr, _chainParams->StandardPort(), now, services);
+				std::vector<PeerInfo>::iterator p = std::find(_peers.begin(), _peers.end(), info);
+				if (p == _peers.end()) {
+					_peers.push_back(info);
+					found++;
+				} else {
+					p->Timestamp = now;
+				}
 			}
+			SortPeers();
+			Log::debug("{} {} found {} new peers", GetID(), hostname, found);
+
+			// the first seed that answers starts the connection, the last one reports failure if nobody did
 			_dnsThreadCount--;
+			connect = _enableReconnect && _connectedPeers.size() < _maxConnectCount &&
+					  (found > 0 || _dnsThreadCount == 0);
+			lock.unlock();
+
+			if (connect)
+				Connect();
 		}
 
 	}
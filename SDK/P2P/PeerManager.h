@@ -7,7 +7,9 @@
 
 #include "Peer.h"
 #include "TransactionPeerList.h"
-#include "PublishedTransaction.h"
+#include "PublishQueue.h"
+#include "OrphanPool.h"
+#include "NetworkStats.h"
 
 #include <Common/Lockable.h>
 #include <WalletCore/BloomFilter.h>
@@ -144,10 +146,45 @@ namespace Elastos {
 
 			void PublishTransaction(const TransactionPtr &transaction, const Peer::PeerPubTxCallback &callback);
 
+			// queue all transactions, then send every connected peer one inv and one ping for the whole batch.
+			// callback fires once per transaction.
+			void PublishTransactions(const std::vector<TransactionPtr> &transactions);
+
+			void PublishTransactions(const std::vector<TransactionPtr> &transactions,
+									 const Peer::PeerPubTxCallback &callback);
+
 			uint64_t GetRelayCount(const uint256 &txHash) const;
 
+			OrphanPool::Stats GetOrphanStats() const;
+
+			// connected peers, with the one blocks are downloaded from marked
+			std::vector<Peer::Stats> GetPeerStats() const;
+
+			enum DownloadPeerVerdict {
+				KeepDownloadPeer,
+				DownloadPeerStalled,
+				DownloadPeerSlow
+			};
+
+			// whether the download peer should be replaced, given the other connected peers. Only peers with a
+			// measured download rate and at least its last block can make it look slow.
+			static DownloadPeerVerdict JudgeDownloadPeer(const Peer::Stats &download,
+														 const std::vector<Peer::Stats> &others);
+
+			// sync state, peers, queues and message counters in json, see NetworkStats::ToText for the text form
+			nlohmann::json GetNetworkStats() const;
+
+			// record inbound messages of peers connected from now on, nullptr stops recording for new peers
+			void SetCapture(const PeerCapturePtr &capture);
+
+			// Stop dialing out and replay the peer of capture that sent most merkleblocks through a stand-in peer
+			// on the calling thread. See Peer::Replay() for maxBlocks and realtime.
+			int Replay(const PeerCapturePtr &capture, size_t maxBlocks = 0, bool realtime = false);
+
 			const std::string &GetChainID() const;
 
+			uint32_t GetMagicNumber() const;
+
 			const std::vector<PeerInfo> &GetPeers() const;
 
 			void SetPeers(const std::vector<PeerInfo> &peers);
@@ -187,6 +224,19 @@ namespace Elastos {
 
 			void RemovePeer(const PeerPtr &peer);
 
+			bool PeerSucceeded(const PeerPtr &peer, PeerInfo &info);
+
+			bool PeerFailed(const PeerPtr &peer, PeerInfo &info);
+
+			// blocks at or below the last checkpoint or more than a week before earliestKeyTime, which are only
+			// needed to link the chain and can be kept as headers once their proof of work was checked
+			bool IsTrustedHistory(const MerkleBlockPtr &block) const;
+
+			DownloadPeerVerdict JudgeDownloadPeer() const;
+
+			// have a connected peer without a filter download a few blocks, for JudgeDownloadPeer() to compare
+			void ProbeDownloadCandidate();
+
 			Peer::ConnectStatus GetConnectStatusInternal() const;
 
 		private:
@@ -232,12 +282,6 @@ namespace Elastos {
 
 			size_t PublishPendingTx(const PeerPtr &peer);
 
-			size_t
-			AddPeerToList(const PeerPtr &peer, const uint256 &txHash, std::vector<TransactionPeerList> &peerList);
-
-			bool
-			RemovePeerFromList(const PeerPtr &peer, const uint256 &txHash, std::vector<TransactionPeerList> &peerList);
-
 			void PeerMisbehaving(const PeerPtr &peer);
 
 			std::vector<uint128> AddressLookup(const std::string &hostname);
@@ -250,11 +294,6 @@ namespace Elastos {
 
 			void RequestUnrelayedTx(const PeerPtr &peer);
 
-			bool PeerListHasPeer(const std::vector<TransactionPeerList> &peerList, const uint256 &txhash,
-								 const PeerPtr &peer);
-
-			size_t PeerListCount(const std::vector<TransactionPeerList> &list, const uint256 &txhash);
-
 			void UpdateAddressOnlyDone(const PeerPtr &peer, int success);
 
 			void LoadBloomFilterDone(const PeerPtr &peer, int success);
@@ -275,7 +314,7 @@ namespace Elastos {
 
 			void ReconnectLaster(time_t seconds);
 
-			double GetSyncProgressInternal(uint32_t startHeight);
+			double GetSyncProgressInternal(uint32_t startHeight) const;
 
 		private:
 			int _isConnected, _connectFailureCount, _misbehavinCount, _dnsThreadCount, _maxConnectCount;
@@ -290,17 +329,19 @@ namespace Elastos {
 			PeerPtr _downloadPeer;
 
 			mutable std::string _downloadPeerName;
-			time_t _keepAliveTimestamp, _earliestKeyTime;
+			time_t _keepAliveTimestamp, _earliestKeyTime, _dnsLookupTime, _lastBlockTime;
+			uint32_t _reconnectCount;
 			uint32_t _reconnectSeconds, _syncStartHeight, _filterUpdateHeight, _estimatedHeight;
 			BloomFilterPtr _bloomFilter;
 			double _fpRate, _averageTxPerBlock;
 			BlockSet _blocks;
-			BlockSet _orphans;
+			OrphanPool _orphans;
 			BlockSet _checkpoints;
 			MerkleBlockPtr _lastBlock, _lastOrphan;
-			std::vector<TransactionPeerList> _txRelays, _txRequests;
-			std::vector<PublishedTransaction> _publishedTx;
-			std::vector<uint256> _publishedTxHashes;
+			TransactionPeerList _txRelays, _txRequests;
+			PublishQueue _publishedTx;
+			NetworkStats _netStats; // totals of disconnected peers
+			PeerCapturePtr _capture;
 
 			std::string _chainID;
 			std::string _netType;
@@ -0,0 +1,119 @@
+// Copyright (c) 2012-2019 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "PublishQueue.h"
+
+#include <Wallet/Wallet.h>
+
+namespace Elastos {
+	namespace ElaWallet {
+
+		PublishQueue::PublishQueue() :
+			_seq(0),
+			_pendingCallbacks(0) {
+		}
+
+		bool PublishQueue::Insert(const PublishedTransaction &pubTx) {
+			const uint256 &hash = pubTx.GetTransaction()->GetHash();
+			if (_entries.find(hash) != _entries.end())
+				return false;
+
+			Entry entry;
+			entry.pubTx = pubTx;
+			entry.seq = _seq++;
+
+			_entries[hash] = entry;
+			_order[entry.seq] = hash;
+			if (pubTx.HasCallback())
+				_pendingCallbacks++;
+
+			return true;
+		}
+
+		bool PublishQueue::Contains(const uint256 &txHash) const {
+			return _entries.find(txHash) != _entries.end();
+		}
+
+		PublishedTransaction PublishQueue::Get(const uint256 &txHash) const {
+			EntryMap::const_iterator it = _entries.find(txHash);
+			if (it == _entries.end())
+				return PublishedTransaction();
+
+			return it->second.pubTx;
+		}
+
+		PublishedTransaction PublishQueue::ResetCallback(const uint256 &txHash) {
+			EntryMap::iterator it = _entries.find(txHash);
+			if (it == _entries.end())
+				return PublishedTransaction();
+
+			PublishedTransaction pubTx = it->second.pubTx;
+			if (pubTx.HasCallback()) {
+				it->second.pubTx.ResetCallback();
+				_pendingCallbacks--;
+			}
+
+			return pubTx;
+		}
+
+		PublishedTransaction PublishQueue::Remove(const uint256 &txHash) {
+			EntryMap::iterator it = _entries.find(txHash);
+			if (it == _entries.end())
+				return PublishedTransaction();
+
+			PublishedTransaction pubTx = it->second.pubTx;
+			if (pubTx.HasCallback())
+				_pendingCallbacks--;
+
+			_order.erase(it->second.seq);
+			_entries.erase(it);
+
+			return pubTx;
+		}
+
+		bool PublishQueue::HasPendingCallbacks() const {
+			return _pendingCallbacks > 0;
+		}
+
+		size_t PublishQueue::PendingCallbacks() const {
+			return _pendingCallbacks;
+		}
+
+		std::vector<uint256> PublishQueue::GetPendingHashes() const {
+			std::vector<uint256> hashes;
+
+			if (_pendingCallbacks == 0)
+				return hashes;
+
+			for (std::map<uint64_t, uint256>::const_iterator it = _order.begin(); it != _order.end(); ++it) {
+				const PublishedTransaction &pubTx = _entries.find(it->second)->second.pubTx;
+				if (pubTx.HasCallback() && pubTx.GetTransaction()->GetBlockHeight() == TX_UNCONFIRMED)
+					hashes.push_back(it->second);
+			}
+
+			return hashes;
+		}
+
+		std::vector<uint256> PublishQueue::GetHashes() const {
+			std::vector<uint256> hashes;
+
+			hashes.reserve(_order.size());
+			for (std::map<uint64_t, uint256>::const_iterator it = _order.begin(); it != _order.end(); ++it)
+				hashes.push_back(it->second);
+
+			return hashes;
+		}
+
+		size_t PublishQueue::Size() const {
+			return _entries.size();
+		}
+
+		void PublishQueue::Clear() {
+			_entries.clear();
+			_order.clear();
+			_pendingCallbacks = 0;
+		}
+
+	}
+}
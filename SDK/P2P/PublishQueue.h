@@ -0,0 +1,68 @@
+// Copyright (c) 2012-2019 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef __ELASTOS_SDK_PUBLISHQUEUE_H__
+#define __ELASTOS_SDK_PUBLISHQUEUE_H__
+
+#include "PublishedTransaction.h"
+
+#include <map>
+
+namespace Elastos {
+	namespace ElaWallet {
+
+		// Transactions being published, indexed by hash. Iteration follows insertion order, so a caller that inserts
+		// inputs before the transactions spending them gets parent-first announcements. The number of entries still
+		// waiting on a publish callback is tracked so checking for pending callbacks needs no scan.
+		class PublishQueue {
+		public:
+			PublishQueue();
+
+			// returns false if a transaction with the same hash is already queued
+			bool Insert(const PublishedTransaction &pubTx);
+
+			bool Contains(const uint256 &txHash) const;
+
+			// returns an empty entry if txHash is not queued
+			PublishedTransaction Get(const uint256 &txHash) const;
+
+			// clears the callback of txHash so it fires only once, returning the entry as it was before
+			PublishedTransaction ResetCallback(const uint256 &txHash);
+
+			// returns the removed entry, or an empty one if txHash is not queued
+			PublishedTransaction Remove(const uint256 &txHash);
+
+			bool HasPendingCallbacks() const;
+
+			size_t PendingCallbacks() const;
+
+			// hashes of unconfirmed transactions that still wait on a callback, in insertion order
+			std::vector<uint256> GetPendingHashes() const;
+
+			std::vector<uint256> GetHashes() const;
+
+			size_t Size() const;
+
+			void Clear();
+
+		private:
+			struct Entry {
+				PublishedTransaction pubTx;
+				uint64_t seq;
+			};
+
+			typedef std::map<uint256, Entry> EntryMap;
+
+		private:
+			uint64_t _seq;
+			size_t _pendingCallbacks;
+
+			EntryMap _entries;
+			std::map<uint64_t, uint256> _order;
+		};
+
+	}
+}
+
+#endif //__ELASTOS_SDK_PUBLISHQUEUE_H__
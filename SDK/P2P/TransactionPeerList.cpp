@@ -7,34 +7,65 @@
 namespace Elastos {
 	namespace ElaWallet {
 
-		TransactionPeerList::TransactionPeerList(const uint256 &txHash, const std::vector<PeerPtr> &peers) :
-			_peers(peers),
-			_txHash(txHash) {
+		size_t TransactionPeerList::AddPeer(const uint256 &txHash, const PeerInfo &peer) {
+			std::set<PeerInfo> &peers = _peers[txHash];
+			if (peers.insert(peer).second)
+				_txHashes[peer].insert(txHash);
+
+			return peers.size();
 		}
 
-		const uint256 &TransactionPeerList::GetTransactionHash() const {
-			return _txHash;
+		bool TransactionPeerList::RemovePeer(const uint256 &txHash, const PeerInfo &peer) {
+			std::map<uint256, std::set<PeerInfo> >::iterator it = _peers.find(txHash);
+			if (it == _peers.end() || it->second.erase(peer) == 0)
+				return false;
+
+			if (it->second.empty())
+				_peers.erase(it);
+
+			std::map<PeerInfo, std::set<uint256> >::iterator p = _txHashes.find(peer);
+			p->second.erase(txHash);
+			if (p->second.empty())
+				_txHashes.erase(p);
+
+			return true;
 		}
 
-		const std::vector<PeerPtr> &TransactionPeerList::GetPeers() const {
-			return _peers;
+		size_t TransactionPeerList::RemovePeer(const PeerInfo &peer) {
+			std::map<PeerInfo, std::set<uint256> >::iterator p = _txHashes.find(peer);
+			if (p == _txHashes.end())
+				return 0;
+
+			size_t count = p->second.size();
+			for (std::set<uint256>::iterator h = p->second.begin(); h != p->second.end(); ++h) {
+				std::map<uint256, std::set<PeerInfo> >::iterator it = _peers.find(*h);
+				it->second.erase(peer);
+				if (it->second.empty())
+					_peers.erase(it);
+			}
+
+			_txHashes.erase(p);
+			return count;
 		}
 
-		void TransactionPeerList::AddPeer(const PeerPtr &peer) {
-			_peers.push_back(peer);
+		bool TransactionPeerList::HasPeer(const uint256 &txHash, const PeerInfo &peer) const {
+			std::map<uint256, std::set<PeerInfo> >::const_iterator it = _peers.find(txHash);
+			return it != _peers.end() && it->second.find(peer) != it->second.end();
 		}
 
-		bool TransactionPeerList::RemovePeer(const PeerPtr &peer) {
-			bool removed = false;
-			for (std::vector<PeerPtr>::iterator p = _peers.begin(); p != _peers.end();) {
-				if ((*p) == peer) {
-					p = _peers.erase(p);
-					removed = true;
-				} else {
-					++p;
-				}
-			}
-			return removed;
+		size_t TransactionPeerList::Count(const uint256 &txHash) const {
+			std::map<uint256, std::set<PeerInfo> >::const_iterator it = _peers.find(txHash);
+			return it == _peers.end() ? 0 : it->second.size();
+		}
+
+		size_t TransactionPeerList::Size() const {
+			return _peers.size();
 		}
+
+		void TransactionPeerList::Clear() {
+			_peers.clear();
+			_txHashes.clear();
+		}
+
 	}
 }
@@ -5,26 +5,40 @@
 #ifndef __ELASTOS_SDK_TRANSACTIONPEERLIST_H__
 #define __ELASTOS_SDK_TRANSACTIONPEERLIST_H__
 
-#include "Peer.h"
+#include "PeerInfo.h"
+
+#include <Common/uint256.h>
+
+#include <map>
+#include <set>
 
 namespace Elastos {
 	namespace ElaWallet {
 
+		// Peers that relayed or were asked for each transaction, keyed by tx hash with a reverse index by peer so a
+		// disconnecting peer can be dropped without walking every transaction. Peers are identified by address and
+		// port, the same identity Peer::IsEqual uses.
 		class TransactionPeerList {
 		public:
-			TransactionPeerList(const uint256 &txHash, const std::vector<PeerPtr> &peers);
+			// returns the number of peers known for txHash after adding
+			size_t AddPeer(const uint256 &txHash, const PeerInfo &peer);
+
+			bool RemovePeer(const uint256 &txHash, const PeerInfo &peer);
+
+			// forget peer for every transaction, returns the number of transactions it was listed for
+			size_t RemovePeer(const PeerInfo &peer);
 
-			const uint256 &GetTransactionHash() const;
+			bool HasPeer(const uint256 &txHash, const PeerInfo &peer) const;
 
-			const std::vector<PeerPtr> &GetPeers() const;
+			size_t Count(const uint256 &txHash) const;
 
-			void AddPeer(const PeerPtr &peer);
+			size_t Size() const;
 
-			bool RemovePeer(const PeerPtr &peer);
+			void Clear();
 
 		private:
-			uint256 _txHash;
-			std::vector<PeerPtr> _peers;
+			std::map<uint256, std::set<PeerInfo> > _peers;
+			std::map<PeerInfo, std::set<uint256> > _txHashes;
 		};
 
 	}
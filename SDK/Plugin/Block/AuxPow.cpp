@@ -50,6 +50,37 @@ namespace Elastos {
 			return SerializeBtcBlockHeader(ostream, _parBlockHeader);
 		}
 
+		size_t AuxPow::SerializedSize() const {
+			size_t size = 0;
+
+			size += sizeof(_parCoinBaseTx->version);
+			size += ByteStream::VarUintSize(_parCoinBaseTx->inCount);
+			for (size_t i = 0; i < _parCoinBaseTx->inCount; ++i) {
+				const BRTxInput *in = &_parCoinBaseTx->inputs[i];
+				size += sizeof(in->txHash) + sizeof(in->index) + sizeof(in->sequence);
+				size += ByteStream::VarUintSize(in->sigLen) + in->sigLen;
+			}
+			size += ByteStream::VarUintSize(_parCoinBaseTx->outCount);
+			for (size_t i = 0; i < _parCoinBaseTx->outCount; ++i) {
+				const BRTxOutput *out = &_parCoinBaseTx->outputs[i];
+				size += sizeof(out->amount);
+				size += ByteStream::VarUintSize(out->scriptLen) + out->scriptLen;
+			}
+			size += sizeof(_parCoinBaseTx->lockTime);
+
+			const size_t hashSize = _parentHash.size();
+			size += hashSize;
+			size += ByteStream::VarUintSize(_parCoinBaseMerkle.size()) + _parCoinBaseMerkle.size() * hashSize;
+			size += sizeof(_parMerkleIndex);
+			size += ByteStream::VarUintSize(_auxMerkleBranch.size()) + _auxMerkleBranch.size() * hashSize;
+			size += sizeof(_auxMerkleIndex);
+
+			// version, prevBlock, merkleRoot, timestamp, target, nonce
+			size += 4 + 32 + 32 + 4 + 4 + 4;
+
+			return size;
+		}
+
 		bool AuxPow::Deserialize(const ByteStream &istream) {
 			if (!DeserializeBtcTransaction(istream, _parCoinBaseTx)) {
 				Log::error("deserialize AuxPow btc tx error");
@@ -295,6 +326,16 @@ namespace Elastos {
 			return *this;
 		}
 
+		void AuxPow::Clear() {
+			_auxMerkleBranch.clear();
+			_parCoinBaseMerkle.clear();
+			_auxMerkleIndex = 0;
+			_parMerkleIndex = 0;
+			_parentHash = 0;
+			SetBTCTransaction(BRTransactionNew());
+			SetParBlockHeader(BRMerkleBlockNew());
+		}
+
 		BRTransaction *AuxPow::GetBTCTransaction() const {
 			return _parCoinBaseTx;
 		}
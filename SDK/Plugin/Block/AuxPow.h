@@ -40,8 +40,14 @@ namespace Elastos {
 
 			virtual bool Deserialize(const ByteStream &istream);
 
+			// exact number of bytes Serialize() writes
+			size_t SerializedSize() const;
+
 			BRTransaction *GetBTCTransaction() const;
 
+			// reset to an empty proof; the result still serializes and deserializes
+			void Clear();
+
 			void SetBTCTransaction(BRTransaction *transaction);
 
 			BRMerkleBlock *GetParBlockHeader() const;
@@ -59,6 +59,21 @@ namespace Elastos {
 			stream.WriteUint8(1);
 		}
 
+		size_t IDAuxPow::SerializedSize() const {
+			size_t size = 0;
+
+			size += _idAuxBlockTx.SerializedSize();
+			size += sizeof(uint32_t) + _idAuxMerkleBranch.size() * 32;
+			size += sizeof(_idAuxMerkleIndex);
+
+			// version, prevBlock, merkleRoot, timestamp, target, nonce, height
+			size += 4 + 32 + 32 + 4 + 4 + 4 + 4;
+			size += _mainBlockHeader->auxPow.SerializedSize();
+			size += 1;
+
+			return size;
+		}
+
 		bool IDAuxPow::Deserialize(const ByteStream &stream) {
 			if (!_idAuxBlockTx.Deserialize(stream)) {
 				return false;
@@ -123,6 +138,13 @@ namespace Elastos {
 			_idAuxBlockTx = tx;
 		}
 
+		void IDAuxPow::Clear() {
+			_idAuxMerkleBranch.clear();
+			_idAuxMerkleIndex = 0;
+			_idAuxBlockTx = Transaction();
+			SetMainBlockHeader(ELAMerkleBlockNew());
+		}
+
 		void IDAuxPow::SetMainBlockHeader(ELAMerkleBlock *blockHeader) {
 			if (_mainBlockHeader) {
 				ELAMerkleBlockFree(_mainBlockHeader);
@@ -30,8 +30,14 @@ namespace Elastos {
 
 			virtual bool Deserialize(const ByteStream &istream);
 
+			// exact number of bytes Serialize() writes
+			size_t SerializedSize() const;
+
 			IDAuxPow &operator=(const IDAuxPow &idAuxPow);
 
+			// reset to an empty proof; the result still serializes and deserializes
+			void Clear();
+
 			void SetIdAuxMerkleBranch(const std::vector<uint256> &idAuxMerkleBranch);
 			void SetIdAuxMerkleIndex(uint32_t index);
 			void SetIdAuxBlockTx(const Transaction &tx);
@@ -89,11 +89,16 @@ namespace Elastos {
 		}
 
 		void MerkleBlock::Serialize(ByteStream &ostream, int version) const {
+			ostream.Reserve(SerializedSize(version));
 			MerkleBlockBase::SerializeNoAux(ostream);
 			_auxPow.Serialize(ostream);
 			MerkleBlockBase::SerializeAfterAux(ostream);
 		}
 
+		size_t MerkleBlock::SerializedSize(int version) const {
+			return SerializedSizeNoAux() + _auxPow.SerializedSize() + SerializedSizeAfterAux();
+		}
+
 		bool MerkleBlock::Deserialize(const ByteStream &istream, int version) {
 			if (!MerkleBlockBase::DeserializeNoAux(istream) || !_auxPow.Deserialize(istream) ||
 				!MerkleBlockBase::DeserializeAfterAux(istream))
@@ -111,6 +116,10 @@ namespace Elastos {
 			_auxPow = pow;
 		}
 
+		void MerkleBlock::DiscardAuxPow() {
+			_auxPow.Clear();
+		}
+
 		MerkleBlockPtr MerkleBlockFactory::createBlock() {
 			return MerkleBlockPtr(new MerkleBlock);
 		}
@@ -32,6 +32,8 @@ namespace Elastos {
 
 			virtual bool Deserialize(const ByteStream &istream, int version);
 
+			virtual size_t SerializedSize(int version) const;
+
 			virtual const uint256 &GetHash() const;
 
 			virtual bool IsValid(uint32_t currentTime) const;
@@ -42,6 +44,8 @@ namespace Elastos {
 
 			void SetAuxPow(const AuxPow &pow);
 
+			virtual void DiscardAuxPow();
+
 		private:
 			AuxPow _auxPow;
 		};
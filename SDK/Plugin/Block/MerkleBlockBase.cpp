@@ -168,6 +168,20 @@ namespace Elastos {
 			ostream.WriteVarBytes(_flags);
 		}
 
+		size_t MerkleBlockBase::SerializedSizeNoAux() const {
+			return sizeof(_version) + _prevBlock.size() + _merkleRoot.size() + sizeof(_timestamp) + sizeof(_target) +
+				   sizeof(_nonce) + sizeof(_height);
+		}
+
+		size_t MerkleBlockBase::SerializedSizeAfterAux() const {
+			size_t size = 1 + sizeof(_totalTx) + sizeof(uint32_t);
+
+			size += _hashes.size() * _merkleRoot.size();
+			size += ByteStream::VarUintSize(_flags.size()) + _flags.size();
+
+			return size;
+		}
+
 		bool MerkleBlockBase::DeserializeAfterAux(const ByteStream &istream) {
 			istream.Skip(1);    //correspond to serialization of node, should get one byte here
 
@@ -178,11 +192,13 @@ namespace Elastos {
 			if (!istream.ReadUint32(hashesCount))
 				return false;
 
+			if (hashesCount > (istream.size() - istream.Position()) / 32)
+				return false;
+
+			_hashes.resize(hashesCount);
 			for (size_t i = 0; i < hashesCount; ++i) {
-				uint256 hash;
-				if (!istream.ReadBytes(hash))
+				if (!istream.ReadBytes(_hashes[i]))
 					return false;
-				_hashes.push_back(hash);
 			}
 
 			if (!istream.ReadVarBytes(_flags))
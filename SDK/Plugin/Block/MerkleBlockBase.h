@@ -80,6 +80,10 @@ namespace Elastos {
 
 			void SerializeAfterAux(ByteStream &ostream) const;
 
+			size_t SerializedSizeNoAux() const;
+
+			size_t SerializedSizeAfterAux() const;
+
 			bool DeserializeAfterAux(const ByteStream &istream);
 
 			uint256 MerkleBlockRootR(size_t *hashIdx, size_t *flagIdx, int depth) const;
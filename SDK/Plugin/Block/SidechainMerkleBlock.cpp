@@ -22,6 +22,7 @@ namespace Elastos {
 		}
 
 		void SidechainMerkleBlock::Serialize(ByteStream &ostream, int version) const {
+			ostream.Reserve(SerializedSize(version));
 			MerkleBlockBase::SerializeNoAux(ostream);
 
 			if (version == MERKLEBLOCK_VERSION_0)
@@ -30,6 +31,15 @@ namespace Elastos {
 			MerkleBlockBase::SerializeAfterAux(ostream);
 		}
 
+		size_t SidechainMerkleBlock::SerializedSize(int version) const {
+			size_t size = SerializedSizeNoAux() + SerializedSizeAfterAux();
+
+			if (version == MERKLEBLOCK_VERSION_0)
+				size += idAuxPow.SerializedSize();
+
+			return size;
+		}
+
 		bool SidechainMerkleBlock::Deserialize(const ByteStream &istream, int version) {
 			if (!MerkleBlockBase::DeserializeNoAux(istream)) {
 				Log::error("merkle deserialize side without aux fail");
@@ -93,6 +103,10 @@ namespace Elastos {
 			return "SideStandard";
 		}
 
+		void SidechainMerkleBlock::DiscardAuxPow() {
+			idAuxPow.Clear();
+		}
+
 		MerkleBlockPtr SidechainMerkleBlockFactory::createBlock() {
 			return MerkleBlockPtr(new SidechainMerkleBlock);
 		}
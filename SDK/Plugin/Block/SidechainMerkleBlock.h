@@ -24,12 +24,16 @@ namespace Elastos {
 
 			virtual bool Deserialize(const ByteStream &istream, int version);
 
+			virtual size_t SerializedSize(int version) const;
+
 			virtual const uint256 &GetHash() const;
 
 			virtual bool IsValid(uint32_t currentTime) const;
 
 			virtual std::string GetBlockType() const;
 
+			virtual void DiscardAuxPow();
+
 		private:
 			IDAuxPow idAuxPow;
 		};
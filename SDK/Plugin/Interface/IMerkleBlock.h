@@ -23,6 +23,9 @@ namespace Elastos {
 
 			virtual bool Deserialize(const ByteStream &istream, int version) = 0;
 
+			// exact number of bytes Serialize(ostream, version) writes
+			virtual size_t SerializedSize(int version) const = 0;
+
 			virtual uint32_t GetTotalTx() const = 0;
 
 			virtual uint32_t GetHeight() const = 0;
@@ -64,6 +67,10 @@ namespace Elastos {
 			virtual std::string GetBlockType() const = 0;
 
 			virtual size_t MerkleBlockTxHashes(std::vector<uint256> &txHashes) const = 0;
+
+			// drop the proof-of-work data once the block is validated and connected; the block keeps its hash,
+			// header fields and partial merkle tree, but IsValid() no longer holds
+			virtual void DiscardAuxPow() = 0;
 		};
 
 		typedef boost::shared_ptr<IMerkleBlock> MerkleBlockPtr;
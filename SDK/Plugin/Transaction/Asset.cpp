@@ -48,11 +48,10 @@ namespace Elastos {
 
 		size_t Asset::EstimateSize() const {
 			size_t size = 0;
-			ByteStream stream;
 
-			size += stream.WriteVarUint(_name.size());
+			size += ByteStream::VarUintSize(_name.size());
 			size += _name.size();
-			size += stream.WriteVarUint(_description.size());
+			size += ByteStream::VarUintSize(_description.size());
 			size += _description.size();
 			size += 3;
 
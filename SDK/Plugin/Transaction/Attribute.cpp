@@ -52,10 +52,9 @@ namespace Elastos {
 
 		size_t Attribute::EstimateSize() const {
 			size_t size = 0;
-			ByteStream stream;
 
 			size += 1;
-			size += stream.WriteVarUint(_data.size());
+			size += ByteStream::VarUintSize(_data.size());
 			size += _data.size();
 
 			return size;
@@ -276,53 +276,53 @@ namespace Elastos {
 		}
 
 		size_t CRCProposal::EstimateSize(uint8_t version) const {
-			ByteStream stream, byteStream;
+			ByteStream byteStream;
 			size_t size = 0;
 
 			size += sizeof(uint16_t);
-			size += stream.WriteVarUint(_categoryData.size());
+			size += ByteStream::VarUintSize(_categoryData.size());
 			size += _categoryData.size();
-			size += stream.WriteVarUint(_ownerPublicKey.size());
+			size += ByteStream::VarUintSize(_ownerPublicKey.size());
 			size += _ownerPublicKey.size();
 			size += _draftHash.size();
 
 			switch (_type) {
 				case elip:
 				case normal:
-					size += stream.WriteVarUint(_budgets.size());
+					size += ByteStream::VarUintSize(_budgets.size());
 
 					for (size_t i = 0; i < _budgets.size(); ++i) {
 						_budgets[i].Serialize(byteStream);
 					}
 					size += byteStream.GetBytes().size();
 					size += _recipient.ProgramHash().size();
-					size += stream.WriteVarUint(_signature.size());
+					size += ByteStream::VarUintSize(_signature.size());
 					size += _signature.size();
 					break;
 
 				case secretaryGeneralElection:
-					size += stream.WriteVarUint(_secretaryPublicKey.size());
+					size += ByteStream::VarUintSize(_secretaryPublicKey.size());
 					size += _secretaryPublicKey.size();
 					size += _secretaryDID.ProgramHash().size();
-					size += stream.WriteVarUint(_secretarySignature.size());
+					size += ByteStream::VarUintSize(_secretarySignature.size());
 					size += _secretarySignature.size();
-					size += stream.WriteVarUint(_signature.size());
+					size += ByteStream::VarUintSize(_signature.size());
 					size += _signature.size();
 					break;
 
 				case changeProposalOwner:
 					size += _targetProposalHash.size();
 					size += _newRecipient.ProgramHash().size();
-					size += stream.WriteVarUint(_newOwnerPublicKey.size());
+					size += ByteStream::VarUintSize(_newOwnerPublicKey.size());
 					size += _newOwnerPublicKey.size();
-					size += stream.WriteVarUint(_signature.size());
+					size += ByteStream::VarUintSize(_signature.size());
 					size += _signature.size();
-					size += stream.WriteVarUint(_newOwnerSignature.size());
+					size += ByteStream::VarUintSize(_newOwnerSignature.size());
 					size += _newOwnerSignature.size();
 					break;
 
 				case terminateProposal:
-					size += stream.WriteVarUint(_signature.size());
+					size += ByteStream::VarUintSize(_signature.size());
 					size += _signature.size();
 					size += _targetProposalHash.size();
 					break;
@@ -332,7 +332,7 @@ namespace Elastos {
 			}
 
 			size += _crCouncilMemberDID.ProgramHash().size();
-			size += stream.WriteVarUint(_crCouncilMemberSignature.size());
+			size += ByteStream::VarUintSize(_crCouncilMemberSignature.size());
 			size += _crCouncilMemberSignature.size();
 
 			return size;
@@ -35,12 +35,11 @@ namespace Elastos {
 		}
 
 		size_t CRCProposalRealWithdraw::EstimateSize(uint8_t version) const {
-			ByteStream stream;
 			size_t size = 0;
 
 			size += sizeof(uint16_t);
 
-			size += stream.WriteVarUint(_withdrawTxHashes.size());
+			size += ByteStream::VarUintSize(_withdrawTxHashes.size());
 			// 32 == sizeof(uint256)
 			size += _withdrawTxHashes.size() * 32;
 
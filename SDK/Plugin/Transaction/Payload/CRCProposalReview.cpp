@@ -88,14 +88,13 @@ namespace Elastos {
 		}
 
 		size_t CRCProposalReview::EstimateSize(uint8_t version) const {
-			ByteStream stream;
 			size_t size = 0;
 
 			size += _proposalHash.size();
 			size += sizeof(uint8_t);
 			size += _opinionHash.size();
 			size += _did.ProgramHash().size();
-			size += stream.WriteVarUint(_signature.size());
+			size += ByteStream::VarUintSize(_signature.size());
 			size += _signature.size();
 
 			return size;
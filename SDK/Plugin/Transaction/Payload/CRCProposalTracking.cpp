@@ -152,7 +152,6 @@ namespace Elastos {
 		}
 
 		size_t CRCProposalTracking::EstimateSize(uint8_t version) const {
-			ByteStream stream;
 			size_t size = 0;
 
 			size += _proposalHash.size();
@@ -160,23 +159,23 @@ namespace Elastos {
 
 			size += sizeof(uint8_t); // stage
 
-			size += stream.WriteVarUint(_ownerPubKey.size());
+			size += ByteStream::VarUintSize(_ownerPubKey.size());
 			size += _ownerPubKey.size();
 
-			size += stream.WriteVarUint(_newOwnerPubKey.size());
+			size += ByteStream::VarUintSize(_newOwnerPubKey.size());
 			size += _newOwnerPubKey.size();
 
-			size += stream.WriteVarUint(_ownerSign.size());
+			size += ByteStream::VarUintSize(_ownerSign.size());
 			size += _ownerSign.size();
 
-			size += stream.WriteVarUint(_newOwnerSign.size());
+			size += ByteStream::VarUintSize(_newOwnerSign.size());
 			size += _newOwnerSign.size();
 
 			size += sizeof(uint8_t); // type
 
 			size += _secretaryGeneralOpinionHash.size();
 
-			size += stream.WriteVarUint(_secretaryGeneralSignature.size());
+			size += ByteStream::VarUintSize(_secretaryGeneralSignature.size());
 			size += _secretaryGeneralSignature.size();
 
 			return size;
@@ -78,13 +78,12 @@ namespace Elastos {
 		}
 
 		size_t CRCProposalWithdraw::EstimateSize(uint8_t version) const {
-			ByteStream stream;
 			size_t size = 0;
 
 			size += _proposalHash.size();
-			size += stream.WriteVarUint(_ownerPubkey.size());
+			size += ByteStream::VarUintSize(_ownerPubkey.size());
 			size += _ownerPubkey.size();
-			size += stream.WriteVarUint(_signature.size());
+			size += ByteStream::VarUintSize(_signature.size());
 			if (version == CRCProposalWithdrawVersion_01) {
 				size += _recipient.ProgramHash().size();
 				size += sizeof(uint64_t);
@@ -40,13 +40,12 @@ namespace Elastos {
 		}
 
 		size_t CRCouncilMemberClaimNode::EstimateSize(uint8_t version) const {
-			ByteStream stream;
 			size_t size = 0;
 
-			size += stream.WriteVarUint(_nodePublicKey.size());
+			size += ByteStream::VarUintSize(_nodePublicKey.size());
 			size += _nodePublicKey.size();
 			size += _crCouncilMemberDID.ProgramHash().size();
-			size += stream.WriteVarUint(_crCouncilMemberSignature.size());
+			size += ByteStream::VarUintSize(_crCouncilMemberSignature.size());
 			size += _crCouncilMemberSignature.size();
 
 			return size;
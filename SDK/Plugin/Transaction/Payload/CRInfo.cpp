@@ -75,19 +75,18 @@ namespace Elastos {
 
 		size_t CRInfo::EstimateSize(uint8_t version) const {
 			size_t size = 0;
-			ByteStream stream;
 
-			size += stream.WriteVarUint(_code.size());
+			size += ByteStream::VarUintSize(_code.size());
 			size += _code.size();
 			size += _cid.size();
 			if (version > CRInfoVersion)
 				size += _did.size();
-			size += stream.WriteVarUint(_nickName.size());
+			size += ByteStream::VarUintSize(_nickName.size());
 			size += _nickName.size();
-			size += stream.WriteVarUint(_url.size());
+			size += ByteStream::VarUintSize(_url.size());
 			size += _url.size();
 			size += sizeof(_location);
-			size += stream.WriteVarUint(_signature.size());
+			size += ByteStream::VarUintSize(_signature.size());
 			size += _signature.size();
 
 			return size;
@@ -43,11 +43,10 @@ namespace Elastos {
 
 		size_t CancelProducer::EstimateSize(uint8_t version) const {
 			size_t size = 0;
-			ByteStream stream;
 
-			size += stream.WriteVarUint(_publicKey.size());
+			size += ByteStream::VarUintSize(_publicKey.size());
 			size += _publicKey.size();
-			size += stream.WriteVarUint(_signature.size());
+			size += ByteStream::VarUintSize(_signature.size());
 			size += _signature.size();
 
 			return size;
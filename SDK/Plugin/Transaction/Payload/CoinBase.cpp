@@ -35,9 +35,8 @@ namespace Elastos {
 
 		size_t CoinBase::EstimateSize(uint8_t version) const {
 			size_t size = 0;
-			ByteStream stream;
 
-			size += stream.WriteVarUint(_coinBaseData.size());
+			size += ByteStream::VarUintSize(_coinBaseData.size());
 			size += _coinBaseData.size();
 
 			return size;
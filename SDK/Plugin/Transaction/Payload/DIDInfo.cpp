@@ -54,16 +54,15 @@ namespace Elastos {
 		}
 
 		size_t DIDHeaderInfo::EstimateSize(uint8_t version) const {
-			ByteStream stream;
 			size_t size = 0;
 
-			size = stream.WriteVarUint(_specification.size());
+			size = ByteStream::VarUintSize(_specification.size());
 			size += _specification.size();
-			size += stream.WriteVarUint(_operation.size());
+			size += ByteStream::VarUintSize(_operation.size());
 			size += _operation.size();
 
 			if (_operation == UPDATE_DID) {
-				size += stream.WriteVarUint(_previousTxid.size());
+				size += ByteStream::VarUintSize(_previousTxid.size());
 				size += _previousTxid.size();
 			}
 
@@ -954,14 +953,13 @@ namespace Elastos {
 		}
 
 		size_t DIDProofInfo::EstimateSize(uint8_t version) const {
-			ByteStream stream;
 			size_t size = 0;
 
-			size += stream.WriteVarUint(_type.size());
+			size += ByteStream::VarUintSize(_type.size());
 			size += _type.size();
-			size += stream.WriteVarUint(_verificationMethod.size());
+			size += ByteStream::VarUintSize(_verificationMethod.size());
 			size += _verificationMethod.size();
-			size += stream.WriteVarUint(_signature.size());
+			size += ByteStream::VarUintSize(_signature.size());
 			size += _signature.size();
 
 			return size;
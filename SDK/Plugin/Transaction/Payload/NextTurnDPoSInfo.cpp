@@ -65,18 +65,17 @@ namespace Elastos {
 
 		size_t NextTurnDPoSInfo::EstimateSize(uint8_t version) const {
 			size_t size = 0;
-			ByteStream stream;
 
 			size += sizeof(_workingHeight);
-			size += stream.WriteVarUint(_crPublicKeys.size());
+			size += ByteStream::VarUintSize(_crPublicKeys.size());
 			for (size_t i = 0; i < _crPublicKeys.size(); ++i) {
-				size += stream.WriteVarUint(_crPublicKeys[i].size());
+				size += ByteStream::VarUintSize(_crPublicKeys[i].size());
 				size += _crPublicKeys[i].size();
 			}
 
-			size += stream.WriteVarUint(_dposPublicKeys.size());
+			size += ByteStream::VarUintSize(_dposPublicKeys.size());
 			for (size_t i = 0; i < _dposPublicKeys.size(); ++i) {
-				size += stream.WriteVarUint(_dposPublicKeys[i].size());
+				size += ByteStream::VarUintSize(_dposPublicKeys[i].size());
 				size += _dposPublicKeys[i].size();
 			}
 
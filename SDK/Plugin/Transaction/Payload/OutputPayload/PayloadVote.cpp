@@ -235,23 +235,22 @@ namespace Elastos {
 		}
 
 		size_t PayloadVote::EstimateSize() const {
-			ByteStream stream;
 			size_t size = 0;
 
 			size += 1;
-			size += stream.WriteVarUint(_content.size());
+			size += ByteStream::VarUintSize(_content.size());
 			for (std::vector<VoteContent>::const_iterator vc = _content.cbegin(); vc != _content.cend(); ++vc) {
 				size += 1;
-				size += stream.WriteVarUint((*vc).GetCandidateVotes().size());
+				size += ByteStream::VarUintSize((*vc).GetCandidateVotes().size());
 
 				const std::vector<CandidateVotes> &candidateVotes = (*vc).GetCandidateVotes();
 				std::vector<CandidateVotes>::const_iterator cv;
 				for (cv = candidateVotes.cbegin(); cv != candidateVotes.cend(); ++cv) {
-					size += stream.WriteVarUint((*cv).GetCandidate().size());
+					size += ByteStream::VarUintSize((*cv).GetCandidate().size());
 					size += (*cv).GetCandidate().size();
 
 					if (_version >= VOTE_PRODUCER_CR_VERSION) {
-						size += stream.WriteVarUint((*cv).GetVotes().getUint64());
+						size += sizeof(uint64_t);
 					}
 				}
 			}
@@ -118,20 +118,19 @@ namespace Elastos {
 
 		size_t ProducerInfo::EstimateSize(uint8_t version) const {
 			size_t size = 0;
-			ByteStream stream;
 
-			size += stream.WriteVarUint(_ownerPublicKey.size());
+			size += ByteStream::VarUintSize(_ownerPublicKey.size());
 			size += _ownerPublicKey.size();
-			size += stream.WriteVarUint(_nodePublicKey.size());
+			size += ByteStream::VarUintSize(_nodePublicKey.size());
 			size += _nodePublicKey.size();
-			size += stream.WriteVarUint(_nickName.size());
+			size += ByteStream::VarUintSize(_nickName.size());
 			size += _nickName.size();
-			size += stream.WriteVarUint(_url.size());
+			size += ByteStream::VarUintSize(_url.size());
 			size += _url.size();
 			size += sizeof(_location);
-			size += stream.WriteVarUint(_address.size());
+			size += ByteStream::VarUintSize(_address.size());
 			size += _address.size();
-			size += stream.WriteVarUint(_signature.size());
+			size += ByteStream::VarUintSize(_signature.size());
 			size += _signature.size();
 
 			return size;
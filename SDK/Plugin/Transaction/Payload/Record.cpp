@@ -45,11 +45,10 @@ namespace Elastos {
 
 		size_t Record::EstimateSize(uint8_t version) const {
 			size_t size = 0;
-			ByteStream stream;
 
-			size += stream.WriteVarUint(_recordType.size());
+			size += ByteStream::VarUintSize(_recordType.size());
 			size += _recordType.size();
-			size += stream.WriteVarUint(_recordData.size());
+			size += ByteStream::VarUintSize(_recordData.size());
 			size += _recordData.size();
 
 			return size;
@@ -36,8 +36,7 @@ namespace Elastos {
 			size_t size = 0;
 			size += _cid.size();
 
-			ByteStream stream;
-			size += stream.WriteVarUint(_signature.size());
+			size += ByteStream::VarUintSize(_signature.size());
 			size += _signature.size();
 
 			return size;
@@ -177,28 +177,43 @@ namespace Elastos {
 
 		size_t Program::EstimateSize() const {
 			size_t size = 0;
-			ByteStream stream;
 
 			if (_parameter.empty()) {
 				if (SignType(_code.back()) == SignTypeMultiSign) {
 					uint8_t m = (uint8_t)(_code[0] - OP_1 + 1);
 					uint64_t signLen = m * 64ul;
-					size += stream.WriteVarUint(signLen);
+					size += ByteStream::VarUintSize(signLen);
 					size += signLen;
 				} else if (SignType(_code.back()) == SignTypeStandard) {
 					size += 65;
 				}
 			} else {
-				size += stream.WriteVarUint(_parameter.size());
+				size += ByteStream::VarUintSize(_parameter.size());
 				size += _parameter.size();
 			}
 
-			size += stream.WriteVarUint(_code.size());
+			size += ByteStream::VarUintSize(_code.size());
 			size += _code.size();
 
 			return size;
 		}
 
+		size_t Program::SerializedSize(bool extend) const {
+			size_t size = 0;
+
+			size += ByteStream::VarUintSize(_parameter.size());
+			size += _parameter.size();
+			size += ByteStream::VarUintSize(_code.size());
+			size += _code.size();
+
+			if (extend) {
+				size += ByteStream::VarUintSize(_path.size());
+				size += _path.size();
+			}
+
+			return size;
+		}
+
 		void Program::Serialize(ByteStream &ostream, bool extend) const {
 			ostream.WriteVarBytes(_parameter);
 			ostream.WriteVarBytes(_code);
@@ -49,6 +49,10 @@ namespace Elastos {
 
 			size_t EstimateSize() const;
 
+			// exact number of bytes Serialize(ostream, extend) writes, unlike EstimateSize() an unsigned
+			// program counts its empty parameter
+			size_t SerializedSize(bool extend = false) const;
+
 			void Serialize(ByteStream &ostream, bool extend = false) const;
 
 			bool Deserialize(const ByteStream &istream, bool extend = false);
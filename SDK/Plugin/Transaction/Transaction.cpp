@@ -35,17 +35,25 @@
 #include <Common/ErrorChecker.h>
 #include <Common/hash.h>
 #include <Common/JsonSerializer.h>
+#include <Common/BlockAllocator.h>
 
 #include <boost/make_shared.hpp>
+#include <boost/thread/mutex.hpp>
 #include <cstring>
 
 #define STANDARD_FEE_PER_KB 10000
 #define DEFAULT_PAYLOAD_TYPE  transferAsset
 #define TX_LOCKTIME          0x00000000
+#define TX_CACHE_LOCKS       64
 
 namespace Elastos {
 	namespace ElaWallet {
 
+		static size_t BlockCapacity(const ByteStream &istream, uint64_t count) {
+			uint64_t remain = istream.size() - istream.Position();
+			return (size_t) (count < remain ? count : remain);
+		}
+
 		Transaction::Transaction() :
 				_version(TxVersion::Default),
 				_lockTime(TX_LOCKTIME),
@@ -55,7 +63,9 @@ namespace Elastos {
 				_payload(nullptr),
 				_type(DEFAULT_PAYLOAD_TYPE),
 				_isRegistered(false),
+				_cached(0),
 				_txHash(0),
+				_shaData(0),
 				_timestamp(0) {
 			_payload = InitPayload(_type);
 		}
@@ -68,7 +78,9 @@ namespace Elastos {
 			_fee(0),
 			_type(type),
 			_isRegistered(false),
+			_cached(0),
 			_txHash(0),
+			_shaData(0),
 			_timestamp(0),
 			_payload(payload) {
 		}
@@ -80,6 +92,12 @@ namespace Elastos {
 		Transaction &Transaction::operator=(const Transaction &orig) {
 			_isRegistered = orig._isRegistered;
 			_txHash = orig.GetHash();
+			// only the caches orig has published are complete, another thread may be filling the others
+			uint8_t cached = orig._cached.load(std::memory_order_acquire) | CachedHash;
+			_shaData = cached & CachedShaData ? orig._shaData : uint256(0);
+			_unsignedData = cached & CachedUnsigned ? orig._unsignedData : ByteStream();
+			_unsignedDataExtend = cached & CachedUnsignedExtend ? orig._unsignedDataExtend : ByteStream();
+			_cached.store(cached, std::memory_order_relaxed);
 
 			_version = orig._version;
 			_lockTime = orig._lockTime;
@@ -95,23 +113,31 @@ namespace Elastos {
 			*_payload = *orig._payload;
 
 			_inputs.clear();
+			_inputs.reserve(orig._inputs.size());
+			BlockAllocator<TransactionInput> inputBlock(orig._inputs.size());
 			for (size_t i = 0; i < orig._inputs.size(); ++i) {
-				_inputs.push_back(InputPtr(new TransactionInput(*orig._inputs[i])));
+				_inputs.push_back(inputBlock.New(*orig._inputs[i]));
 			}
 
+			// outputs are allocated one by one, a wallet utxo keeps its output alive long after the tx is gone
 			_outputs.clear();
+			_outputs.reserve(orig._outputs.size());
 			for (size_t i = 0; i < orig._outputs.size(); ++i) {
-				_outputs.push_back(OutputPtr(new TransactionOutput(*orig._outputs[i])));
+				_outputs.push_back(boost::make_shared<TransactionOutput>(*orig._outputs[i]));
 			}
 
 			_attributes.clear();
+			_attributes.reserve(orig._attributes.size());
+			BlockAllocator<Attribute> attributeBlock(orig._attributes.size());
 			for (size_t i = 0; i < orig._attributes.size(); ++i) {
-				_attributes.push_back(AttributePtr(new Attribute(*orig._attributes[i])));
+				_attributes.push_back(attributeBlock.New(*orig._attributes[i]));
 			}
 
 			_programs.clear();
+			_programs.reserve(orig._programs.size());
+			BlockAllocator<Program> programBlock(orig._programs.size());
 			for (size_t i = 0; i < orig._programs.size(); ++i) {
-				_programs.push_back(ProgramPtr(new Program(*orig._programs[i])));
+				_programs.push_back(programBlock.New(*orig._programs[i]));
 			}
 
 			return *this;
@@ -129,20 +155,28 @@ namespace Elastos {
 		}
 
 		void Transaction::ResetHash() {
+			_cached.store(0, std::memory_order_relaxed);
 			_txHash = 0;
+			_shaData = 0;
+			_unsignedData.Reset();
+			_unsignedDataExtend.Reset();
 		}
 
 		const uint256 &Transaction::GetHash() const {
-			if (_txHash == 0) {
-				ByteStream stream;
-				SerializeUnsigned(stream);
-				_txHash = sha256_2(stream.GetBytes());
+			if (!IsCached(CachedHash)) {
+				boost::mutex::scoped_lock lock(CacheLock());
+				if (!IsCached(CachedHash)) {
+					_txHash = sha256_2(UnsignedDataLocked(false).GetBytes());
+					_cached.fetch_or(CachedHash, std::memory_order_release);
+				}
 			}
+
 			return _txHash;
 		}
 
 		void Transaction::SetHash(const uint256 &hash) {
 			_txHash = hash;
+			_cached.fetch_or(CachedHash, std::memory_order_relaxed);
 		}
 
 		const Transaction::TxVersion &Transaction::GetVersion() const {
@@ -151,6 +185,7 @@ namespace Elastos {
 
 		void Transaction::SetVersion(const TxVersion &version) {
 			_version = version;
+			ResetHash();
 		}
 
 		uint8_t Transaction::GetTransactionType() const {
@@ -204,6 +239,7 @@ namespace Elastos {
 		void Transaction::FixIndex() {
 			for (uint16_t i = 0; i < _outputs.size(); ++i)
 				_outputs[i]->SetFixedIndex(i);
+			ResetHash();
 		}
 
 		OutputPtr Transaction::OutputOfIndex(uint16_t fixedIndex) const {
@@ -218,16 +254,19 @@ namespace Elastos {
 
 		void Transaction::SetOutputs(const std::vector<OutputPtr> &outputs) {
 			_outputs = outputs;
+			ResetHash();
 		}
 
 		void Transaction::AddOutput(const OutputPtr &output) {
 			_outputs.push_back(output);
+			ResetHash();
 		}
 
 		void Transaction::RemoveOutput(const OutputPtr &output) {
 			for (std::vector<OutputPtr>::iterator it = _outputs.begin(); it != _outputs.end(); ) {
 				if (output == (*it)) {
 					it = _outputs.erase(it);
+					ResetHash();
 					break;
 				} else {
 					++it;
@@ -245,6 +284,7 @@ namespace Elastos {
 
 		void Transaction::AddInput(const InputPtr &Input) {
 			_inputs.push_back(Input);
+			ResetHash();
 		}
 
 		bool Transaction::ContainInput(const uint256 &hash, uint32_t n) const {
@@ -265,6 +305,7 @@ namespace Elastos {
 		void Transaction::SetLockTime(uint32_t t) {
 
 			_lockTime = t;
+			ResetHash();
 		}
 
 		uint32_t Transaction::GetBlockHeight() const {
@@ -284,8 +325,31 @@ namespace Elastos {
 		}
 
 		size_t Transaction::EstimateSize() const {
+			size_t txSize = UnsignedSize(false);
+
+			txSize += ByteStream::VarUintSize(_programs.size());
+			for (size_t i = 0; i < _programs.size(); ++i)
+				txSize += _programs[i]->EstimateSize();
+
+			return txSize;
+		}
+
+		size_t Transaction::SerializedSize(bool extend) const {
+			size_t txSize;
+			if (IsCached(extend ? CachedUnsignedExtend : CachedUnsigned))
+				txSize = (extend ? _unsignedDataExtend : _unsignedData).size();
+			else
+				txSize = UnsignedSize(extend);
+
+			txSize += ByteStream::VarUintSize(_programs.size());
+			for (size_t i = 0; i < _programs.size(); ++i)
+				txSize += _programs[i]->SerializedSize(extend);
+
+			return txSize;
+		}
+
+		size_t Transaction::UnsignedSize(bool extend) const {
 			size_t i, txSize = 0;
-			ByteStream stream;
 
 			if (_version >= TxVersion::V09)
 				txSize += 1;
@@ -296,24 +360,20 @@ namespace Elastos {
 			// payload
 			txSize += _payload->EstimateSize(_payloadVersion);
 
-			txSize += stream.WriteVarUint(_attributes.size());
+			txSize += ByteStream::VarUintSize(_attributes.size());
 			for (i = 0; i < _attributes.size(); ++i)
 				txSize += _attributes[i]->EstimateSize();
 
-			txSize += stream.WriteVarUint(_inputs.size());
+			txSize += ByteStream::VarUintSize(_inputs.size());
 			for (i = 0; i < _inputs.size(); ++i)
 				txSize += _inputs[i]->EstimateSize();
 
-			txSize += stream.WriteVarUint(_outputs.size());
+			txSize += ByteStream::VarUintSize(_outputs.size());
 			for (i = 0; i < _outputs.size(); ++i)
-				txSize += _outputs[i]->EstimateSize();
+				txSize += _outputs[i]->SerializedSize(_version, extend);
 
 			txSize += sizeof(_lockTime);
 
-			txSize += stream.WriteVarUint(_programs.size());
-			for (i = 0; i < _programs.size(); ++i)
-				txSize += _programs[i]->EstimateSize();
-
 			return txSize;
 		}
 
@@ -404,10 +464,12 @@ namespace Elastos {
 
 		void Transaction::SetPayload(const PayloadPtr &payload) {
 			_payload = payload;
+			ResetHash();
 		}
 
 		void Transaction::AddAttribute(const AttributePtr &attribute) {
 			_attributes.push_back(attribute);
+			ResetHash();
 		}
 
 		const std::vector<AttributePtr> &Transaction::GetAttributes() const {
@@ -439,6 +501,7 @@ namespace Elastos {
 		}
 
 		void Transaction::Serialize(ByteStream &ostream, bool extend) const {
+			ostream.Reserve(SerializedSize(extend));
 			SerializeUnsigned(ostream, extend);
 
 			ostream.WriteVarUint(_programs.size());
@@ -448,6 +511,45 @@ namespace Elastos {
 		}
 
 		void Transaction::SerializeUnsigned(ByteStream &ostream, bool extend) const {
+			ostream.WriteBytes(UnsignedData(extend).GetBytes());
+		}
+
+		const ByteStream &Transaction::UnsignedData(bool extend) const {
+			uint8_t flag = extend ? CachedUnsignedExtend : CachedUnsigned;
+			if (IsCached(flag))
+				return extend ? _unsignedDataExtend : _unsignedData;
+
+			boost::mutex::scoped_lock lock(CacheLock());
+			return UnsignedDataLocked(extend);
+		}
+
+		const ByteStream &Transaction::UnsignedDataLocked(bool extend) const {
+			uint8_t flag = extend ? CachedUnsignedExtend : CachedUnsigned;
+			ByteStream &ostream = extend ? _unsignedDataExtend : _unsignedData;
+			if (IsCached(flag))
+				return ostream;
+
+			ostream.Reset();
+			WriteUnsigned(ostream, extend);
+			_cached.fetch_or(flag, std::memory_order_release);
+			return ostream;
+		}
+
+		bool Transaction::IsCached(uint8_t flag) const {
+			return (_cached.load(std::memory_order_acquire) & flag) != 0;
+		}
+
+		boost::mutex &Transaction::CacheLock() const {
+			// a lock per tx would cost more memory than the caches it guards, txns share a few
+			static boost::mutex locks[TX_CACHE_LOCKS];
+			return locks[(reinterpret_cast<uintptr_t>(this) / sizeof(void *)) % TX_CACHE_LOCKS];
+		}
+
+		void Transaction::WriteUnsigned(ByteStream &ostream, bool extend) const {
+			ErrorChecker::CheckCondition(_payload == nullptr, Error::Transaction,
+										 "payload should not be null");
+
+			ostream.Reserve(UnsignedSize(extend));
 			if (_version >= TxVersion::V09) {
 				ostream.WriteByte(_version);
 			}
@@ -455,9 +557,6 @@ namespace Elastos {
 
 			ostream.WriteByte(_payloadVersion);
 
-			ErrorChecker::CheckCondition(_payload == nullptr, Error::Transaction,
-										 "payload should not be null");
-
 			_payload->Serialize(ostream, _payloadVersion);
 
 			ostream.WriteVarUint(_attributes.size());
@@ -500,6 +599,7 @@ namespace Elastos {
 
 		bool Transaction::Deserialize(const ByteStream &istream, bool extend) {
 			Reinit();
+			size_t start = istream.Position();
 
 			if (!DeserializeType(istream)) {
 				return false;
@@ -521,8 +621,10 @@ namespace Elastos {
 			if (!istream.ReadVarUint(attributeLength))
 				return false;
 
+			// counts come from the wire, never reserve more elements than there are bytes left
+			BlockAllocator<Attribute> attributeBlock(BlockCapacity(istream, attributeLength));
 			for (size_t i = 0; i < attributeLength; i++) {
-				AttributePtr attribute(new Attribute());
+				AttributePtr attribute = attributeBlock.New();
 				if (!attribute->Deserialize(istream)) {
 					Log::error("deserialize tx attribute[{}] error", i);
 					return false;
@@ -536,9 +638,10 @@ namespace Elastos {
 				return false;
 			}
 
-			_inputs.reserve(inCount);
+			_inputs.reserve(BlockCapacity(istream, inCount));
+			BlockAllocator<TransactionInput> inputBlock(BlockCapacity(istream, inCount));
 			for (size_t i = 0; i < inCount; i++) {
-				InputPtr input(new TransactionInput());
+				InputPtr input = inputBlock.New();
 				if (!input->Deserialize(istream)) {
 					Log::error("deserialize tx input [{}] error", i);
 					return false;
@@ -557,9 +660,9 @@ namespace Elastos {
 				return false;
 			}
 
-			_outputs.reserve(outputLength);
+			_outputs.reserve(BlockCapacity(istream, outputLength));
 			for (size_t i = 0; i < outputLength; i++) {
-				OutputPtr output(new TransactionOutput());
+				OutputPtr output = boost::make_shared<TransactionOutput>();
 				if (!output->Deserialize(istream, _version, extend)) {
 					Log::error("deserialize tx output[{}] error", i);
 					return false;
@@ -576,14 +679,20 @@ namespace Elastos {
 				return false;
 			}
 
+			// the bytes just read are the unsigned serialization, hash them instead of writing them again. They are
+			// not kept, most loaded txns are never serialized
+			if (!extend)
+				_txHash = sha256_2(bytes_t(istream.Data() + start, istream.Position() - start));
+
 			uint64_t programLength = 0;
 			if (!istream.ReadVarUint(programLength)) {
 				Log::error("deserialize tx program length error");
 				return false;
 			}
 
+			BlockAllocator<Program> programBlock(BlockCapacity(istream, programLength));
 			for (size_t i = 0; i < programLength; i++) {
-				ProgramPtr program(new Program());
+				ProgramPtr program = programBlock.New();
 				if (!program->Deserialize(istream, extend)) {
 					Log::error("deserialize program[{}] error", i);
 					return false;
@@ -591,9 +700,12 @@ namespace Elastos {
 				_programs.push_back(program);
 			}
 
-			ByteStream stream;
-			SerializeUnsigned(stream);
-			_txHash = sha256_2((stream.GetBytes()));
+			if (extend) {
+				ByteStream unsignedData;
+				WriteUnsigned(unsignedData, false);
+				_txHash = sha256_2(unsignedData.GetBytes());
+			}
+			_cached.store(CachedHash, std::memory_order_relaxed);
 
 			return true;
 		}
@@ -648,6 +760,7 @@ namespace Elastos {
 				_fee = j["Fee"].get<uint64_t>();
 
 				_txHash.SetHex(j["TxHash"].get<std::string>());
+				_cached.store(CachedHash, std::memory_order_relaxed);
 			} catch (const nlohmann::detail::exception &e) {
 				ErrorChecker::ThrowLogicException(Error::Code::JsonFormatError, "tx from json: " +
 																				std::string(e.what()));
@@ -682,7 +795,7 @@ namespace Elastos {
 			std::string addr;
 			nlohmann::json summary, outputPayload;
 			std::vector<nlohmann::json> outputPayloads;
-			std::string direction = "Received";
+			bool sent = false;
 			BigInt inputAmount(0), outputAmount(0), changeAmount(0);
 			uint64_t fee = 0;
 			std::string topUpSidechain;
@@ -707,14 +820,14 @@ namespace Elastos {
 						}
 
 						// sent or moved
-						direction = "Sent";
+						sent = true;
 						inputAmount += spentAmount;
 					}
 				}
 			}
 
 			nlohmann::json inputJson;
-			if (direction == "Sent") {
+			if (sent) {
 				for (it = inputList.begin(); it != inputList.end(); ++it) {
 					inputJson[it->first] = it->second.getDec();
 				}
@@ -725,12 +838,9 @@ namespace Elastos {
 			for (OutputArray::iterator o = _outputs.begin(); o != _outputs.end(); ++o) {
 				const BigInt &oAmount = (*o)->Amount();
 				addr = (*o)->Addr()->String();
-				for (std::map<std::string, std::string>::const_iterator it = genesisAddresses.cbegin(); it != genesisAddresses.cend(); ++it) {
-					if (addr == it->second) {
-						topUpSidechain = it->first;
-						break;
-					}
-				}
+				std::string chainID = TopUpSidechainOf(addr, genesisAddresses);
+				if (!chainID.empty())
+					topUpSidechain = chainID;
 
 				if ((*o)->GetType() == TransactionOutput::VoteOutput) {
 					outputPayload = (*o)->GetPayload()->ToJson();
@@ -745,7 +855,7 @@ namespace Elastos {
 					outputAmount += oAmount;
 				}
 
-				if (detail && (direction == "Sent" || (direction != "Sent" && containAddress))) {
+				if (detail && (sent || containAddress)) {
 					if (outputList.find(addr) == outputList.end()) {
 						outputList[addr] = oAmount;
 					} else {
@@ -759,34 +869,15 @@ namespace Elastos {
 				outputJson[it->first] = it->second.getDec();
 			}
 
-			if (direction == "Sent" && outputAmount == BigInt(0)) {
-				direction = "Moved";
-			}
-
 			if (inputAmount > (outputAmount + changeAmount)) {
 				fee = (inputAmount - outputAmount - changeAmount).getUint64();
 			} else {
 				fee = 0;
 			}
 
-			BigInt amount(0);
-			if (direction == "Received") {
-				amount = changeAmount;
-			} else if (direction == "Sent") {
-				amount = outputAmount;
-			} else {
-				amount = 0;
-			}
-
-			summary["TxHash"] = GetHash().GetHex();
-			summary["Status"] = GetConfirmStatus(wallet->LastBlockHeight());
-			summary["ConfirmStatus"] = confirms;
-			summary["Timestamp"] = GetTimestamp();
-			summary["Direction"] = direction;
-			summary["Amount"] = amount.getDec();
-			summary["Type"] = GetTransactionType();
-			summary["TopUpSidechain"] = topUpSidechain;
-			summary["Height"] = GetBlockHeight();
+			summary = SummaryOf(GetHash(), GetConfirmStatus(wallet->LastBlockHeight()), confirms, GetTimestamp(),
+								GetTransactionType(), GetBlockHeight(), sent, outputAmount, changeAmount,
+								topUpSidechain);
 			if (detail) {
 				std::string memo;
 				for (size_t i = 0; i < _attributes.size(); ++i) {
@@ -828,10 +919,57 @@ namespace Elastos {
 			return summary;
 		}
 
+		nlohmann::json Transaction::SummaryOf(const uint256 &hash, const std::string &status, uint32_t confirms,
+											  time_t timestamp, uint8_t type, uint32_t height, bool sent,
+											  const BigInt &outputAmount, const BigInt &changeAmount,
+											  const std::string &topUpSidechain) {
+			nlohmann::json summary;
+			std::string direction = "Received";
+			BigInt amount(0);
+
+			if (!sent) {
+				amount = changeAmount;
+			} else if (outputAmount == BigInt(0)) {
+				direction = "Moved";
+			} else {
+				direction = "Sent";
+				amount = outputAmount;
+			}
+
+			summary["TxHash"] = hash.GetHex();
+			summary["Status"] = status;
+			summary["ConfirmStatus"] = confirms;
+			summary["Timestamp"] = timestamp;
+			summary["Direction"] = direction;
+			summary["Amount"] = amount.getDec();
+			summary["Type"] = type;
+			summary["TopUpSidechain"] = topUpSidechain;
+			summary["Height"] = height;
+
+			return summary;
+		}
+
+		std::string Transaction::TopUpSidechainOf(const std::string &addr,
+												  const std::map<std::string, std::string> &genesisAddresses) {
+			for (std::map<std::string, std::string>::const_iterator it = genesisAddresses.cbegin();
+				 it != genesisAddresses.cend(); ++it) {
+				if (addr == it->second)
+					return it->first;
+			}
+
+			return "";
+		}
+
 		uint256 Transaction::GetShaData() const {
-			ByteStream stream;
-			SerializeUnsigned(stream);
-			return uint256(sha256(stream.GetBytes()));
+			if (!IsCached(CachedShaData)) {
+				boost::mutex::scoped_lock lock(CacheLock());
+				if (!IsCached(CachedShaData)) {
+					_shaData = uint256(sha256(UnsignedDataLocked(false).GetBytes()));
+					_cached.fetch_or(CachedShaData, std::memory_order_release);
+				}
+			}
+
+			return _shaData;
 		}
 
 		PayloadPtr Transaction::InitPayload(uint8_t type) {
@@ -895,6 +1033,7 @@ namespace Elastos {
 			_attributes.clear();
 			_programs.clear();
 			_payload.reset();
+			ResetHash();
 		}
 
 		uint8_t Transaction::GetPayloadVersion() const {
@@ -903,6 +1042,7 @@ namespace Elastos {
 
 		void Transaction::SetPayloadVersion(uint8_t version) {
 			_payloadVersion = version;
+			ResetHash();
 		}
 
 		uint64_t Transaction::GetFee() const {
@@ -914,7 +1054,7 @@ namespace Elastos {
 		}
 
 		bool Transaction::IsEqual(const Transaction &tx) const {
-			return _txHash == tx.GetHash();
+			return GetHash() == tx.GetHash();
 		}
 
 		uint32_t Transaction::GetConfirms(uint32_t walletBlockHeight) const {
@@ -6,10 +6,14 @@
 #define __ELASTOS_SDK_TRANSACTION_H__
 
 #include <Common/JsonSerializer.h>
+#include <Common/BigInt.h>
 #include <Plugin/Interface/ELAMessageSerializable.h>
 #include <Plugin/Transaction/Payload/IPayload.h>
 
 #include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <atomic>
 
 namespace Elastos {
 	namespace ElaWallet {
@@ -107,6 +111,8 @@ namespace Elastos {
 
 			void SetHash(const uint256 &hash);
 
+			// drop the cached hash, digest and serialization. Mutators of this class do it themselves,
+			// call it after changing an input, output, attribute or payload through its pointer.
 			void ResetHash();
 
 			const TxVersion &GetVersion() const;
@@ -155,8 +161,12 @@ namespace Elastos {
 
 			void SetTimestamp(time_t timestamp);
 
+			// projected size once signed, unsigned programs count the signature they will carry
 			size_t EstimateSize() const;
 
+			// exact number of bytes Serialize(ostream, extend) writes now
+			size_t SerializedSize(bool extend = false) const;
+
 			nlohmann::json GetSignedInfo() const;
 
 			bool IsSigned() const;
@@ -195,6 +205,16 @@ namespace Elastos {
 
 			nlohmann::json GetSummary(const WalletPtr &wallet, const std::map<std::string, std::string> &genesisAddresses, uint32_t confirms, bool detail);
 
+			// the fields of every summary, shared with TransactionView. sent: an input spent a coin of the wallet
+			static nlohmann::json SummaryOf(const uint256 &hash, const std::string &status, uint32_t confirms,
+											time_t timestamp, uint8_t type, uint32_t height, bool sent,
+											const BigInt &outputAmount, const BigInt &changeAmount,
+											const std::string &topUpSidechain);
+
+			// the chain whose genesis address addr is, empty if none
+			static std::string TopUpSidechainOf(const std::string &addr,
+												const std::map<std::string, std::string> &genesisAddresses);
+
 			uint8_t	GetPayloadVersion() const;
 
 			void SetPayloadVersion(uint8_t version);
@@ -222,10 +242,31 @@ namespace Elastos {
 
 			void Reinit();
 
+			// unsigned serialization, built on first use and kept until ResetHash()
+			const ByteStream &UnsignedData(bool extend) const;
+
+			// the fill of UnsignedData() for callers that already hold CacheLock()
+			const ByteStream &UnsignedDataLocked(bool extend) const;
+
+			void WriteUnsigned(ByteStream &ostream, bool extend) const;
+
+			bool IsCached(uint8_t flag) const;
+
+			boost::mutex &CacheLock() const;
+
+			size_t UnsignedSize(bool extend) const;
+
 
 		protected:
 			bool _isRegistered;
+			// const getters of any thread fill the caches below under CacheLock(), the flag of a cache is set once
+			// it is complete. Mutators are not concurrent with readers and reset them without the lock.
+			enum { CachedHash = 1, CachedShaData = 2, CachedUnsigned = 4, CachedUnsignedExtend = 8 };
+			mutable std::atomic<uint8_t> _cached;
 			mutable uint256 _txHash;
+			mutable uint256 _shaData;
+			// programs are left out: signing changes them through ProgramPtr
+			mutable ByteStream _unsignedData, _unsignedDataExtend;
 
 			TxVersion _version; // uint8_t
 			uint32_t _lockTime;
@@ -0,0 +1,56 @@
+// Copyright (c) 2012-2019 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "TransactionBuilder.h"
+
+#include <Plugin/Transaction/Transaction.h>
+#include <Plugin/Transaction/TransactionInput.h>
+#include <Plugin/Transaction/Program.h>
+
+namespace Elastos {
+	namespace ElaWallet {
+
+		TransactionBuilder::TransactionBuilder(const TransactionPtr &tx) :
+			_tx(tx),
+			_size(tx->EstimateSize()) {
+			const std::vector<ProgramPtr> &programs = _tx->GetPrograms();
+			for (size_t i = 0; i < programs.size(); ++i)
+				_codes.insert(programs[i]->GetCode());
+		}
+
+		TransactionBuilder::~TransactionBuilder() {
+		}
+
+		void TransactionBuilder::AddInput(const InputPtr &input) {
+			size_t count = _tx->GetInputs().size();
+
+			_tx->AddInput(input);
+			_size += ByteStream::VarUintSize(count + 1) - ByteStream::VarUintSize(count) + input->EstimateSize();
+		}
+
+		bool TransactionBuilder::ContainsProgram(const bytes_t &code) const {
+			return _codes.find(code) != _codes.end();
+		}
+
+		bool TransactionBuilder::AddUniqueProgram(const ProgramPtr &program) {
+			if (!_codes.insert(program->GetCode()).second)
+				return false;
+
+			size_t count = _tx->GetPrograms().size();
+			_tx->AddProgram(program);
+			_size += ByteStream::VarUintSize(count + 1) - ByteStream::VarUintSize(count) + program->EstimateSize();
+
+			return true;
+		}
+
+		size_t TransactionBuilder::EstimateSize() const {
+			return _size;
+		}
+
+		const TransactionPtr &TransactionBuilder::GetTransaction() const {
+			return _tx;
+		}
+
+	}
+}
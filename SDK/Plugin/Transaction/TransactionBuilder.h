@@ -0,0 +1,57 @@
+// Copyright (c) 2012-2019 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef __ELASTOS_SDK_TRANSACTIONBUILDER_H__
+#define __ELASTOS_SDK_TRANSACTIONBUILDER_H__
+
+#include <Common/typedefs.h>
+
+#include <boost/shared_ptr.hpp>
+
+#include <set>
+
+namespace Elastos {
+	namespace ElaWallet {
+
+		class Transaction;
+		class TransactionInput;
+		class Program;
+		typedef boost::shared_ptr<Transaction> TransactionPtr;
+		typedef boost::shared_ptr<TransactionInput> InputPtr;
+		typedef boost::shared_ptr<Program> ProgramPtr;
+
+		/*
+		 * Adds inputs and programs to a transaction during coin selection while keeping its
+		 * estimated size up to date, so every step costs O(1) instead of a full EstimateSize().
+		 * Outputs, attributes and payload are measured once at construction and must not be
+		 * changed on the transaction while the builder is in use.
+		 */
+		class TransactionBuilder {
+		public:
+			explicit TransactionBuilder(const TransactionPtr &tx);
+
+			~TransactionBuilder();
+
+			void AddInput(const InputPtr &input);
+
+			bool ContainsProgram(const bytes_t &code) const;
+
+			// returns false and leaves the transaction alone if a program with the same code exists
+			bool AddUniqueProgram(const ProgramPtr &program);
+
+			// same value as Transaction::EstimateSize() on the transaction being built
+			size_t EstimateSize() const;
+
+			const TransactionPtr &GetTransaction() const;
+
+		private:
+			TransactionPtr _tx;
+			size_t _size;
+			std::set<bytes_t> _codes;
+		};
+
+	}
+}
+
+#endif //__ELASTOS_SDK_TRANSACTIONBUILDER_H__
@@ -7,6 +7,7 @@
 #include <Common/Utils.h>
 #include <Common/Log.h>
 #include <WalletCore/Key.h>
+#include <WalletCore/AddressPool.h>
 #include <Plugin/Transaction/Asset.h>
 #include <Plugin/Transaction/Transaction.h>
 #include <Plugin/Transaction/Payload/OutputPayload/PayloadDefault.h>
@@ -22,13 +23,12 @@ namespace Elastos {
 				_fixedIndex(0),
 				_outputLock(0),
 				_outputType(Type::Default) {
-			_addr = AddressPtr(new Address());
+			_addr = AddressPool::Empty();
 			_amount.setUint64(0);
 			_payload = GeneratePayload(_outputType);
 		}
 
 		TransactionOutput::TransactionOutput(const TransactionOutput &output) {
-			_addr = AddressPtr(new Address());
 			this->operator=(output);
 		}
 
@@ -36,7 +36,8 @@ namespace Elastos {
 			_fixedIndex = o._fixedIndex;
 			_amount = o._amount;
 			_assetID = o._assetID;
-			*_addr = *o._addr;
+			// addresses are shared and never modified in place
+			_addr = o._addr;
 			_outputLock = o._outputLock;
 			_outputType = o._outputType;
 			_payload = GeneratePayload(o._outputType);
@@ -78,14 +79,13 @@ namespace Elastos {
 
 		size_t TransactionOutput::EstimateSize() const {
 			size_t size = 0;
-			ByteStream stream;
 
 			size += _assetID.size();
 			if (_assetID == Asset::GetELAAssetID()) {
 				size += sizeof(uint64_t);
 			} else {
 				bytes_t amountBytes = _amount.getHexBytes();
-				size += stream.WriteVarUint(amountBytes.size());
+				size += ByteStream::VarUintSize(amountBytes.size());
 				size += amountBytes.size();
 			}
 
@@ -95,6 +95,20 @@ namespace Elastos {
 			return size;
 		}
 
+		size_t TransactionOutput::SerializedSize(uint8_t txVersion, bool extend) const {
+			size_t size = EstimateSize();
+
+			if (txVersion >= Transaction::TxVersion::V09) {
+				size += sizeof(uint8_t);
+				size += _payload->EstimateSize();
+			}
+
+			if (extend)
+				size += sizeof(_fixedIndex);
+
+			return size;
+		}
+
 		void TransactionOutput::Serialize(ByteStream &ostream, uint8_t txVersion, bool extend) const {
 			ostream.WriteBytes(_assetID);
 
@@ -152,7 +166,7 @@ namespace Elastos {
 				Log::error("deserialize output program hash error");
 				return false;
 			}
-			_addr->SetProgramHash(programHash);
+			_addr = AddressPool::Get(programHash);
 
 			if (txVersion >= Transaction::TxVersion::V09) {
 				uint8_t outputType = 0;
@@ -222,9 +236,12 @@ namespace Elastos {
 			OutputPayloadPtr payload;
 
 			switch (type) {
-				case Default:
-					payload = OutputPayloadPtr(new PayloadDefault());
+				case Default: {
+					// PayloadDefault carries no data, one instance is shared by every default output
+					static const OutputPayloadPtr defaultPayload(new PayloadDefault());
+					payload = defaultPayload;
 					break;
+				}
 				case VoteOutput:
 					payload = OutputPayloadPtr(new PayloadVote());
 					break;
@@ -263,7 +280,7 @@ namespace Elastos {
 			_outputLock = j["OutputLock"].get<uint32_t>();
 			uint168 programHash;
 			programHash.SetHex(j["ProgramHash"].get<std::string>());
-			_addr->SetProgramHash(programHash);
+			_addr = AddressPool::Get(programHash);
 
 			_outputType = Type(j["OutputType"].get<uint8_t>());
 			_payload = GeneratePayload(_outputType);
@@ -38,6 +38,9 @@ namespace Elastos {
 
 			size_t EstimateSize() const;
 
+			// exact number of bytes Serialize(ostream, txVersion, extend) writes
+			size_t SerializedSize(uint8_t txVersion, bool extend = false) const;
+
 			void Serialize(ByteStream &ostream, uint8_t txVersion, bool extend = false) const;
 
 			bool Deserialize(const ByteStream &istream, uint8_t txVersion, bool extend = false);
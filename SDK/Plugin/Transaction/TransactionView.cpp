@@ -0,0 +1,368 @@
+// Copyright (c) 2012-2019 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "TransactionView.h"
+
+#include <Common/Log.h>
+#include <Plugin/Transaction/Asset.h>
+#include <Plugin/Transaction/Transaction.h>
+#include <Plugin/Transaction/TransactionOutput.h>
+#include <Plugin/Transaction/Payload/OutputPayload/PayloadVote.h>
+#include <Plugin/Transaction/Payload/RechargeToSideChain.h>
+#include <WalletCore/AddressPool.h>
+#include <Wallet/Wallet.h>
+
+namespace Elastos {
+	namespace ElaWallet {
+
+		static bool SkipBytes(const ByteStream &istream, uint64_t len) {
+			if (istream.Position() + len > istream.size())
+				return false;
+
+			istream.Skip(len);
+			return true;
+		}
+
+		static bool SkipVarBytes(const ByteStream &istream) {
+			uint64_t len = 0;
+			return istream.ReadVarUint(len) && SkipBytes(istream, len);
+		}
+
+		// walks the payloads of the types a wallet mostly holds without decoding them, the layouts follow the
+		// Deserialize() of each payload class. Returns false with handled unset for every other type.
+		static bool SkipPayload(const ByteStream &istream, uint8_t type, uint8_t version, bool &handled) {
+			handled = true;
+			switch (type) {
+				case Transaction::transferAsset:
+				case Transaction::returnDepositCoin:
+					return true;
+
+				case Transaction::coinBase:
+					return SkipVarBytes(istream);
+
+				case Transaction::record:
+					return SkipVarBytes(istream) && SkipVarBytes(istream);
+
+				case Transaction::sideChainPow:
+					return SkipBytes(istream, 2 * sizeof(uint256) + sizeof(uint32_t)) && SkipVarBytes(istream);
+
+				case Transaction::rechargeToSideChain:
+					if (version == RechargeToSideChain::V0)
+						return SkipVarBytes(istream) && SkipVarBytes(istream);
+					return version == RechargeToSideChain::V1 && SkipBytes(istream, sizeof(uint256));
+
+				case Transaction::withdrawFromSideChain: {
+					uint64_t count = 0;
+					return SkipBytes(istream, sizeof(uint32_t)) && SkipVarBytes(istream) &&
+						   istream.ReadVarUint(count) && count <= istream.size() &&
+						   SkipBytes(istream, count * sizeof(uint256));
+				}
+
+				case Transaction::transferCrossChainAsset: {
+					uint64_t count = 0, index = 0;
+					if (!istream.ReadVarUint(count))
+						return false;
+					for (uint64_t i = 0; i < count; ++i) {
+						if (!SkipVarBytes(istream) || !istream.ReadVarUint(index) ||
+							!SkipBytes(istream, sizeof(uint64_t)))
+							return false;
+					}
+					return true;
+				}
+
+				default:
+					handled = false;
+					return false;
+			}
+		}
+
+		TransactionView::TransactionView(const TransactionPtr &tx) :
+			_extend(false),
+			_version(0),
+			_type(0),
+			_blockHeight(TX_UNCONFIRMED),
+			_timestamp(0),
+			_tx(tx),
+			_materialized(false) {
+		}
+
+		TransactionView::~TransactionView() {
+		}
+
+		bool TransactionView::Deserialize(const void *data, size_t len, bool extend) {
+			_stream = ByteStream(data, len);
+			_extend = extend;
+			_materialized = false;
+			_inputs.clear();
+			_outputs.clear();
+
+			if (!_tx->DeserializeType(_stream))
+				return false;
+
+			_version = _tx->GetVersion();
+			_type = _tx->GetTransactionType();
+
+			uint8_t payloadVersion = 0;
+			if (!_stream.ReadByte(payloadVersion))
+				return false;
+
+			// payload has no length prefix, so it has to be walked to reach the inputs. Only the rare dpos, cr and
+			// did payloads are decoded for that
+			bool handled;
+			if (!SkipPayload(_stream, _type, payloadVersion, handled)) {
+				if (handled) {
+					Log::error("view: skip payload error");
+					return false;
+				}
+
+				PayloadPtr payload = _tx->InitPayload(_type);
+				if (payload == nullptr) {
+					Log::error("view: unknown payload type {}", _type);
+					return false;
+				}
+				if (!payload->Deserialize(_stream, payloadVersion)) {
+					Log::error("view: skip payload error");
+					return false;
+				}
+			}
+
+			uint64_t attributeLength = 0;
+			if (!_stream.ReadVarUint(attributeLength))
+				return false;
+
+			for (size_t i = 0; i < attributeLength; ++i) {
+				uint8_t usage;
+				uint64_t dataLength = 0;
+				if (!_stream.ReadUint8(usage) || !_stream.ReadVarUint(dataLength) || !SkipBytes(_stream, dataLength)) {
+					Log::error("view: skip attribute[{}] error", i);
+					return false;
+				}
+			}
+
+			uint64_t inCount = 0;
+			if (!_stream.ReadVarUint(inCount)) {
+				Log::error("view: inCount error");
+				return false;
+			}
+
+			_inputs.resize(inCount);
+			for (size_t i = 0; i < inCount; ++i) {
+				if (!_stream.ReadBytes(_inputs[i].txHash) || !_stream.ReadUint16(_inputs[i].index) ||
+					!SkipBytes(_stream, sizeof(uint32_t))) {
+					Log::error("view: input[{}] error", i);
+					return false;
+				}
+			}
+
+			uint64_t outputLength = 0;
+			if (!_stream.ReadVarUint(outputLength)) {
+				Log::error("view: output len error");
+				return false;
+			}
+
+			if (outputLength > UINT16_MAX) {
+				Log::error("view: too much outputs: {}", outputLength);
+				return false;
+			}
+
+			_outputs.resize(outputLength);
+			for (size_t i = 0; i < outputLength; ++i) {
+				OutputRef &o = _outputs[i];
+				o.offset = _stream.Position();
+				o.type = TransactionOutput::Default;
+
+				if (!_stream.ReadBytes(o.assetID)) {
+					Log::error("view: output[{}] asset id error", i);
+					return false;
+				}
+
+				uint64_t amountLength = sizeof(uint64_t);
+				if (o.assetID != Asset::GetELAAssetID() && !_stream.ReadVarUint(amountLength)) {
+					Log::error("view: output[{}] amount error", i);
+					return false;
+				}
+
+				if (!SkipBytes(_stream, amountLength + sizeof(uint32_t)) || !_stream.ReadBytes(o.programHash)) {
+					Log::error("view: output[{}] program hash error", i);
+					return false;
+				}
+
+				if (_version >= Transaction::TxVersion::V09) {
+					if (!_stream.ReadUint8(o.type)) {
+						Log::error("view: output[{}] type error", i);
+						return false;
+					}
+
+					if (o.type == TransactionOutput::VoteOutput) {
+						PayloadVote vote;
+						if (!vote.Deserialize(_stream)) {
+							Log::error("view: output[{}] payload error", i);
+							return false;
+						}
+					}
+				}
+
+				if (!extend) {
+					o.fixedIndex = (uint16_t) i;
+				} else if (!_stream.ReadUint16(o.fixedIndex)) {
+					Log::error("view: output[{}] index error", i);
+					return false;
+				}
+			}
+
+			// lock time and programs are never needed by a view
+			return true;
+		}
+
+		const uint256 &TransactionView::GetHash() const {
+			return _txHash;
+		}
+
+		void TransactionView::SetHash(const uint256 &hash) {
+			_txHash = hash;
+		}
+
+		uint8_t TransactionView::GetTransactionType() const {
+			return _type;
+		}
+
+		bool TransactionView::IsCoinBase() const {
+			return _type == Transaction::coinBase;
+		}
+
+		uint32_t TransactionView::GetBlockHeight() const {
+			return _blockHeight;
+		}
+
+		void TransactionView::SetBlockHeight(uint32_t height) {
+			_blockHeight = height;
+		}
+
+		time_t TransactionView::GetTimestamp() const {
+			return _timestamp;
+		}
+
+		void TransactionView::SetTimestamp(time_t timestamp) {
+			_timestamp = timestamp;
+		}
+
+		uint32_t TransactionView::GetConfirms(uint32_t walletBlockHeight) const {
+			if (_blockHeight == TX_UNCONFIRMED)
+				return 0;
+
+			return walletBlockHeight >= _blockHeight ? walletBlockHeight - _blockHeight + 1 : 0;
+		}
+
+		std::string TransactionView::GetConfirmStatus(uint32_t walletBlockHeight) const {
+			uint32_t confirm = GetConfirms(walletBlockHeight);
+
+			if (IsCoinBase())
+				return confirm <= 100 ? "Pending" : "Confirmed";
+
+			return confirm < 2 ? "Pending" : "Confirmed";
+		}
+
+		const std::vector<TransactionView::InputRef> &TransactionView::GetInputs() const {
+			return _inputs;
+		}
+
+		const std::vector<TransactionView::OutputRef> &TransactionView::GetOutputs() const {
+			return _outputs;
+		}
+
+		BigInt TransactionView::OutputAmount(size_t i) const {
+			BigInt amount(0);
+			const OutputRef &o = _outputs[i];
+
+			_stream.SetPosition(o.offset + o.assetID.size());
+			if (o.assetID == Asset::GetELAAssetID()) {
+				uint64_t value;
+				if (_stream.ReadUint64(value))
+					amount.setHexBytes(bytes_t(&value, sizeof(value)), true);
+			} else {
+				bytes_t bytes;
+				if (_stream.ReadVarBytes(bytes))
+					amount.setHexBytes(bytes);
+			}
+
+			return amount;
+		}
+
+		OutputPtr TransactionView::OutputOfIndex(uint16_t fixedIndex) const {
+			for (std::vector<OutputRef>::const_iterator it = _outputs.cbegin(); it != _outputs.cend(); ++it) {
+				if (it->fixedIndex != fixedIndex)
+					continue;
+
+				OutputPtr output(new TransactionOutput());
+				_stream.SetPosition(it->offset);
+				if (!output->Deserialize(_stream, _version, _extend)) {
+					Log::error("view: deserialize output {} of tx {} error", fixedIndex, _txHash.GetHex());
+					return nullptr;
+				}
+
+				if (!_extend)
+					output->SetFixedIndex(fixedIndex);
+
+				return output;
+			}
+
+			return nullptr;
+		}
+
+		nlohmann::json TransactionView::GetSummary(const WalletPtr &wallet, const std::map<std::string, std::string> &genesisAddresses, uint32_t confirms) const {
+			bool sent = false;
+			BigInt outputAmount(0), changeAmount(0);
+			std::string topUpSidechain;
+			std::map<uint256, TransactionViewPtr> txInput = wallet->TransactionViewsForInputs(_inputs);
+
+			for (std::vector<InputRef>::const_iterator in = _inputs.cbegin(); in != _inputs.cend() && in->txHash != 0; ++in) {
+				std::map<uint256, TransactionViewPtr>::iterator it = txInput.find(in->txHash);
+				if (it == txInput.end())
+					continue;
+
+				const OutputPtr o = it->second->OutputOfIndex(in->index);
+				if (o && wallet->ContainsAddress(o->Addr()) && !wallet->IsDepositAddress(o->Addr())) {
+					// sent or moved
+					sent = true;
+					break;
+				}
+			}
+
+			for (size_t i = 0; i < _outputs.size(); ++i) {
+				BigInt oAmount = OutputAmount(i);
+				AddressPtr addr = AddressPool::Get(_outputs[i].programHash);
+				std::string chainID = Transaction::TopUpSidechainOf(addr->String(), genesisAddresses);
+				if (!chainID.empty())
+					topUpSidechain = chainID;
+
+				if (wallet->ContainsAddress(addr) && !wallet->IsDepositAddress(addr)) {
+					changeAmount += oAmount;
+				} else {
+					outputAmount += oAmount;
+				}
+			}
+
+			return Transaction::SummaryOf(_txHash, GetConfirmStatus(wallet->LastBlockHeight()), confirms, _timestamp,
+										  _type, _blockHeight, sent, outputAmount, changeAmount, topUpSidechain);
+		}
+
+		const TransactionPtr &TransactionView::GetTransaction() const {
+			if (!_materialized) {
+				ByteStream stream(_stream.GetBytes());
+				if (!_tx->Deserialize(stream, _extend)) {
+					Log::error("view: full deserialize tx {} error", _txHash.GetHex());
+				}
+
+				if (_extend)
+					_tx->SetHash(_txHash);
+				_tx->SetBlockHeight(_blockHeight);
+				_tx->SetTimestamp(_timestamp);
+				_materialized = true;
+			}
+
+			return _tx;
+		}
+
+	}
+}
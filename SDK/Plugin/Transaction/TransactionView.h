@@ -0,0 +1,108 @@
+// Copyright (c) 2012-2019 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef __ELASTOS_SDK_TRANSACTIONVIEW_H__
+#define __ELASTOS_SDK_TRANSACTIONVIEW_H__
+
+#include <Common/ByteStream.h>
+#include <Common/BigInt.h>
+#include <Common/uint256.h>
+
+#include <nlohmann/json.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <map>
+#include <vector>
+
+namespace Elastos {
+	namespace ElaWallet {
+
+		class Wallet;
+		class Transaction;
+		class TransactionOutput;
+		typedef boost::shared_ptr<Wallet> WalletPtr;
+		typedef boost::shared_ptr<Transaction> TransactionPtr;
+		typedef boost::shared_ptr<TransactionOutput> OutputPtr;
+
+		/*
+		 * Read-only view over a stored transaction. Only the fields needed by listing paths
+		 * (type, inputs, output asset/amount/program hash) are decoded; payload, attributes and programs
+		 * are skipped. Full deserialization happens on the first call to GetTransaction().
+		 */
+		class TransactionView {
+		public:
+			struct InputRef {
+				uint256 txHash;
+				uint16_t index;
+			};
+
+			struct OutputRef {
+				uint256 assetID;
+				uint168 programHash;
+				uint16_t fixedIndex;
+				uint8_t type;
+				size_t offset;
+			};
+
+		public:
+			// tx is an empty instance of the chain's transaction class, used for type dispatch
+			explicit TransactionView(const TransactionPtr &tx);
+
+			~TransactionView();
+
+			bool Deserialize(const void *data, size_t len, bool extend = false);
+
+			const uint256 &GetHash() const;
+
+			void SetHash(const uint256 &hash);
+
+			uint8_t GetTransactionType() const;
+
+			bool IsCoinBase() const;
+
+			uint32_t GetBlockHeight() const;
+
+			void SetBlockHeight(uint32_t height);
+
+			time_t GetTimestamp() const;
+
+			void SetTimestamp(time_t timestamp);
+
+			uint32_t GetConfirms(uint32_t walletBlockHeight) const;
+
+			std::string GetConfirmStatus(uint32_t walletBlockHeight) const;
+
+			const std::vector<InputRef> &GetInputs() const;
+
+			const std::vector<OutputRef> &GetOutputs() const;
+
+			BigInt OutputAmount(size_t i) const;
+
+			OutputPtr OutputOfIndex(uint16_t fixedIndex) const;
+
+			nlohmann::json GetSummary(const WalletPtr &wallet, const std::map<std::string, std::string> &genesisAddresses, uint32_t confirms) const;
+
+			const TransactionPtr &GetTransaction() const;
+
+		private:
+			ByteStream _stream;
+			bool _extend;
+			uint8_t _version;
+			uint8_t _type;
+			uint256 _txHash;
+			uint32_t _blockHeight;
+			time_t _timestamp;
+			std::vector<InputRef> _inputs;
+			std::vector<OutputRef> _outputs;
+
+			TransactionPtr _tx;
+			mutable bool _materialized;
+		};
+
+		typedef boost::shared_ptr<TransactionView> TransactionViewPtr;
+
+	}
+}
+
+#endif //__ELASTOS_SDK_TRANSACTIONVIEW_H__
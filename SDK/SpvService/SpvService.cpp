@@ -56,6 +56,15 @@ namespace Elastos {
 			GetPeerManager()->PublishTransaction(tx);
 		}
 
+		void SpvService::PublishTransactions(const std::vector<TransactionPtr> &txns) {
+			if (GetPeerManager()->GetConnectStatus() != Peer::Connected) {
+				GetPeerManager()->CancelTimer();
+				GetPeerManager()->ConnectLaster(0);
+			}
+
+			GetPeerManager()->PublishTransactions(txns);
+		}
+
 		void SpvService::DatabaseFlush() {
 			_databaseManager->flush();
 		}
@@ -178,6 +187,9 @@ namespace Elastos {
 				peerEntity.address = peers[i].Address;
 				peerEntity.port = peers[i].Port;
 				peerEntity.timeStamp = peers[i].Timestamp;
+				peerEntity.lastSuccess = peers[i].LastSuccess;
+				peerEntity.latency = peers[i].Latency;
+				peerEntity.failures = peers[i].Failures;
 				peerEntityList.push_back(peerEntity);
 			}
 			_databaseManager->PutPeers(peerEntityList);
@@ -251,6 +263,41 @@ namespace Elastos {
 			return {};
 		}
 
+		std::vector<TransactionViewPtr> SpvService::LoadTxnViewDesc(const std::string &chainID, TxnType type,
+																	size_t offset, size_t limit) const {
+			if (type == TXN_NORMAL) {
+				return _databaseManager->GetNormalTxnViews(chainID, offset, limit);
+			} else if (type == TXN_COINBASE) {
+				return _databaseManager->GetCoinbaseTxnViews(chainID, offset, limit);
+			}
+
+			return {};
+		}
+
+		std::vector<TransactionPtr> SpvService::LoadTxnDescBefore(const std::string &chainID, TxnType type,
+																  uint64_t height, const uint256 &hash,
+																  size_t limit) const {
+			if (type == TXN_NORMAL) {
+				return _databaseManager->GetNormalTxnsBefore(chainID, height, hash.GetHex(), limit);
+			} else if (type == TXN_COINBASE) {
+				return _databaseManager->GetCoinbaseTxnsBefore(chainID, height, hash.GetHex(), limit);
+			}
+
+			return {};
+		}
+
+		std::vector<TransactionViewPtr> SpvService::LoadTxnViewDescBefore(const std::string &chainID, TxnType type,
+																		  uint64_t height, const uint256 &hash,
+																		  size_t limit) const {
+			if (type == TXN_NORMAL) {
+				return _databaseManager->GetNormalTxnViewsBefore(chainID, height, hash.GetHex(), limit);
+			} else if (type == TXN_COINBASE) {
+				return _databaseManager->GetCoinbaseTxnViewsBefore(chainID, height, hash.GetHex(), limit);
+			}
+
+			return {};
+		}
+
 		void SpvService::DeleteTxn(const uint256 &hash) {
 			_databaseManager->DeleteNormalTxn(hash);
 			_databaseManager->DeletePendingTxn(hash);
@@ -280,7 +327,11 @@ namespace Elastos {
 			std::vector<PeerEntity> peersEntity = _databaseManager->GetAllPeers();
 
 			for (size_t i = 0; i < peersEntity.size(); ++i) {
-				peers.push_back(PeerInfo(peersEntity[i].address, peersEntity[i].port, peersEntity[i].timeStamp));
+				PeerInfo info(peersEntity[i].address, peersEntity[i].port, peersEntity[i].timeStamp);
+				info.LastSuccess = peersEntity[i].lastSuccess;
+				info.Latency = peersEntity[i].latency;
+				info.Failures = peersEntity[i].failures;
+				peers.push_back(info);
 			}
 
 			return peers;
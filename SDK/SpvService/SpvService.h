@@ -50,12 +50,24 @@ namespace Elastos {
 
 			std::vector<TransactionPtr> LoadTxnDesc(const std::string &chainID, TxnType type, size_t offset, size_t limit) const;
 
+			std::vector<TransactionViewPtr> LoadTxnViewDesc(const std::string &chainID, TxnType type, size_t offset,
+															size_t limit) const;
+
+			std::vector<TransactionPtr> LoadTxnDescBefore(const std::string &chainID, TxnType type, uint64_t height,
+														  const uint256 &hash, size_t limit) const;
+
+			std::vector<TransactionViewPtr> LoadTxnViewDescBefore(const std::string &chainID, TxnType type,
+																  uint64_t height, const uint256 &hash,
+																  size_t limit) const;
+
 			void RegisterWalletListener(Wallet::Listener *listener);
 
 			void RegisterPeerManagerListener(PeerManager::Listener *listener);
 
 			void PublishTransaction(const TransactionPtr &tx);
 
+			void PublishTransactions(const std::vector<TransactionPtr> &txns);
+
 			void DatabaseFlush();
 
 		public:
@@ -0,0 +1,206 @@
+// Copyright (c) 2012-2019 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "CoinSelector.h"
+
+#include <Plugin/Transaction/TransactionOutput.h>
+
+namespace Elastos {
+	namespace ElaWallet {
+
+		CoinSelector::Params::Params() :
+			amount(0),
+			fixedFee(0),
+			feePerKB(0),
+			baseSize(0),
+			inputSize(1),
+			maxSize(0),
+			changeCost(0) {
+		}
+
+		size_t CoinSelector::Params::Size(size_t inputs) const {
+			// input and program counts grow from 1 to 3 byte varints
+			return baseSize + inputs * inputSize + (inputs >= 0xFD ? 4 : 0);
+		}
+
+		size_t CoinSelector::Params::MaxInputs() const {
+			if (maxSize <= baseSize + 4)
+				return 0;
+
+			return (maxSize - baseSize - 4 - 1) / inputSize;
+		}
+
+		BigInt CoinSelector::Params::Fee(size_t inputs) const {
+			if (feePerKB == 0)
+				return fixedFee;
+
+			return BigInt((Size(inputs) + 999) / 1000 * feePerKB);
+		}
+
+		BigInt CoinSelector::Params::Target(size_t inputs) const {
+			return amount + Fee(inputs);
+		}
+
+		CoinSelector::~CoinSelector() {
+		}
+
+		std::string LargestFirstCoinSelector::Name() const {
+			return "LargestFirst";
+		}
+
+		bool LargestFirstCoinSelector::Select(const UTXOArray &candidates, const Params &params, Result &result) const {
+			size_t maxInputs = params.MaxInputs();
+			BigInt total(0);
+
+			result.utxos.clear();
+			result.changeless = false;
+
+			for (UTXOArray::const_iterator u = candidates.cbegin(); u != candidates.cend(); ++u) {
+				size_t n = result.utxos.size();
+				if (total >= params.Target(n) && params.Size(n) >= 2000)
+					return true;
+
+				if (n >= maxInputs)
+					return total >= params.Target(n);
+
+				result.utxos.push_back(*u);
+				total += (*u)->Output()->Amount();
+			}
+
+			return total >= params.Target(result.utxos.size());
+		}
+
+		BranchAndBoundCoinSelector::BranchAndBoundCoinSelector(size_t maxTries) :
+			_maxTries(maxTries) {
+		}
+
+		std::string BranchAndBoundCoinSelector::Name() const {
+			return "BranchAndBound";
+		}
+
+		bool BranchAndBoundCoinSelector::Select(const UTXOArray &candidates, const Params &params, Result &result) const {
+			// works on uint64 effective values, anything that might not fit goes the simple way
+			BigInt sum = params.amount + params.fixedFee + params.changeCost;
+			for (UTXOArray::const_iterator u = candidates.cbegin(); u != candidates.cend(); ++u)
+				sum += (*u)->Output()->Amount();
+			if (sum > BigInt(INT64_MAX))
+				return LargestFirstCoinSelector().Select(candidates, params, result);
+
+			// Fee(n) <= ceil(base * rate) + n * ceil(inputSize * rate) + feePerKB, which keeps the target
+			// independent of the number of inputs
+			uint64_t inputFee = 0, target = params.amount.getUint64(), changeCost = params.changeCost.getUint64();
+			if (params.feePerKB != 0) {
+				inputFee = (params.inputSize * params.feePerKB + 999) / 1000;
+				target += ((params.baseSize + 4) * params.feePerKB + 999) / 1000 + params.feePerKB;
+			} else {
+				target += params.fixedFee.getUint64();
+			}
+
+			std::vector<size_t> pool;
+			std::vector<uint64_t> value;
+			uint64_t available = 0;
+			for (size_t i = 0; i < candidates.size(); ++i) {
+				uint64_t amount = candidates[i]->Output()->Amount().getUint64();
+				if (amount <= inputFee)
+					continue;
+
+				pool.push_back(i);
+				value.push_back(amount - inputFee);
+				available += amount - inputFee;
+			}
+
+			size_t maxInputs = params.MaxInputs();
+			std::vector<size_t> selection, best;
+			uint64_t current = 0, bestExcess = UINT64_MAX;
+
+			if (available >= target) {
+				size_t index = 0;
+				for (size_t tries = 0; tries < _maxTries; ++tries, ++index) {
+					bool backtrack = false;
+					if (current + available < target || current > target + changeCost || selection.size() > maxInputs) {
+						backtrack = true;
+					} else if (current >= target) {
+						if (current - target < bestExcess) {
+							best = selection;
+							bestExcess = current - target;
+							if (bestExcess == 0)
+								break;
+						}
+						backtrack = true;
+					}
+
+					if (backtrack) {
+						if (selection.empty())
+							break;
+
+						// give back the skipped values, then try the branch without the last included one
+						for (--index; index > selection.back(); --index)
+							available += value[index];
+						current -= value[index];
+						selection.pop_back();
+					} else {
+						available -= value[index];
+						// excluding a value and then including an equal one is a branch already searched
+						if (selection.empty() || selection.back() == index - 1 || value[index] != value[index - 1]) {
+							selection.push_back(index);
+							current += value[index];
+						}
+					}
+				}
+			}
+
+			if (best.empty())
+				return LargestFirstCoinSelector().Select(candidates, params, result);
+
+			result.utxos.clear();
+			for (size_t i = 0; i < best.size(); ++i)
+				result.utxos.push_back(candidates[pool[best[i]]]);
+			result.changeless = true;
+
+			return true;
+		}
+
+		std::string MinInputCoinSelector::Name() const {
+			return "MinInput";
+		}
+
+		bool MinInputCoinSelector::Select(const UTXOArray &candidates, const Params &params, Result &result) const {
+			size_t maxInputs = std::min(params.MaxInputs(), candidates.size());
+			BigInt total(0);
+			size_t k;
+
+			result.utxos.clear();
+			result.changeless = false;
+
+			// the k largest coins give the largest sum any k coins can give
+			for (k = 1; k <= maxInputs; ++k) {
+				total += candidates[k - 1]->Output()->Amount();
+				if (total >= params.Target(k))
+					break;
+			}
+
+			if (k > maxInputs) {
+				result.utxos.assign(candidates.begin(), candidates.begin() + maxInputs);
+				return false;
+			}
+
+			// replace the k-th coin with the smallest one that still covers the rest
+			BigInt need = params.Target(k) - (total - candidates[k - 1]->Output()->Amount());
+			size_t lo = k - 1, hi = candidates.size();
+			while (hi - lo > 1) {
+				size_t mid = lo + (hi - lo) / 2;
+				if (candidates[mid]->Output()->Amount() >= need)
+					lo = mid;
+				else
+					hi = mid;
+			}
+
+			result.utxos.assign(candidates.begin(), candidates.begin() + k - 1);
+			result.utxos.push_back(candidates[lo]);
+
+			return true;
+		}
+
+	}
+}
@@ -0,0 +1,101 @@
+// Copyright (c) 2012-2019 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef __ELASTOS_SDK_COINSELECTOR_H__
+#define __ELASTOS_SDK_COINSELECTOR_H__
+
+#include "UTXO.h"
+
+#include <Common/BigInt.h>
+
+#include <boost/shared_ptr.hpp>
+
+#include <string>
+
+namespace Elastos {
+	namespace ElaWallet {
+
+		class CoinSelector {
+		public:
+			struct Params {
+				Params();
+
+				// sum of all outputs
+				BigInt amount;
+				// fee of the tx when feePerKB is 0 (fixed fee or non-ELA asset)
+				BigInt fixedFee;
+				uint64_t feePerKB;
+				// estimated tx size without inputs and programs
+				size_t baseSize;
+				// upper bound of the bytes one input adds, its program included
+				size_t inputSize;
+				size_t maxSize;
+				// fee a change output would add; an exact match may give up to this much to the fee instead
+				BigInt changeCost;
+
+				size_t Size(size_t inputs) const;
+
+				size_t MaxInputs() const;
+
+				BigInt Fee(size_t inputs) const;
+
+				BigInt Target(size_t inputs) const;
+			};
+
+			struct Result {
+				Result() : changeless(false) {}
+
+				UTXOArray utxos;
+				// the whole surplus goes to the fee, no change output should be added
+				bool changeless;
+			};
+
+		public:
+			virtual ~CoinSelector();
+
+			virtual std::string Name() const = 0;
+
+			/*
+			 * candidates are spendable and ordered by amount, largest first. Returns false if no
+			 * selection covers amount plus fee within maxSize; result then holds the largest
+			 * selection that fits, so the caller can report what is available.
+			 */
+			virtual bool Select(const UTXOArray &candidates, const Params &params, Result &result) const = 0;
+		};
+
+		typedef boost::shared_ptr<CoinSelector> CoinSelectorPtr;
+
+		// the wallet's historic policy: largest coins first, keep picking until the tx is at least 2000 bytes
+		class LargestFirstCoinSelector : public CoinSelector {
+		public:
+			virtual std::string Name() const;
+
+			virtual bool Select(const UTXOArray &candidates, const Params &params, Result &result) const;
+		};
+
+		// depth first search for an input set whose surplus is below changeCost; falls back to largest first
+		class BranchAndBoundCoinSelector : public CoinSelector {
+		public:
+			explicit BranchAndBoundCoinSelector(size_t maxTries = 100000);
+
+			virtual std::string Name() const;
+
+			virtual bool Select(const UTXOArray &candidates, const Params &params, Result &result) const;
+
+		private:
+			size_t _maxTries;
+		};
+
+		// fewest possible inputs, the last one being the smallest coin that still covers the target
+		class MinInputCoinSelector : public CoinSelector {
+		public:
+			virtual std::string Name() const;
+
+			virtual bool Select(const UTXOArray &candidates, const Params &params, Result &result) const;
+		};
+
+	}
+}
+
+#endif //__ELASTOS_SDK_COINSELECTOR_H__
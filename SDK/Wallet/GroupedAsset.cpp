@@ -5,19 +5,27 @@
 #include "Wallet.h"
 #include "GroupedAsset.h"
 #include "UTXO.h"
+#include "CoinSelector.h"
 
 #include <Common/ErrorChecker.h>
 #include <Common/Utils.h>
 #include <Common/Log.h>
+#include <Common/BlockAllocator.h>
 #include <Plugin/Transaction/Payload/RegisterAsset.h>
 #include <Plugin/Transaction/Transaction.h>
 #include <Plugin/Transaction/Asset.h>
 #include <Plugin/Transaction/TransactionOutput.h>
 #include <Plugin/Transaction/TransactionInput.h>
+#include <Plugin/Transaction/TransactionBuilder.h>
 #include <Plugin/Transaction/Attribute.h>
 #include <Plugin/Transaction/Program.h>
 #include <Plugin/Transaction/Payload/OutputPayload/PayloadVote.h>
 
+#include <algorithm>
+#include <set>
+
+#define INPUT_BLOCK_CAPACITY 3000
+
 namespace Elastos {
 	namespace ElaWallet {
 
@@ -46,6 +54,9 @@ namespace Elastos {
 			_utxosCoinbase = proto._utxosCoinbase;
 			_utxosDeposit = proto._utxosDeposit;
 			_utxosLocked = proto._utxosLocked;
+			_utxosByHeight = proto._utxosByHeight;
+			_utxosByAmount = proto._utxosByAmount;
+			_utxosByAddress = proto._utxosByAddress;
 			*_asset = *proto._asset;
 			_parent = proto._parent;
 			return *this;
@@ -61,6 +72,9 @@ namespace Elastos {
 			_utxosCoinbase.clear();
 			_utxosDeposit.clear();
 			_utxosLocked.clear();
+			_utxosByHeight.clear();
+			_utxosByAmount.clear();
+			_utxosByAddress.clear();
 		}
 
 		UTXOArray GroupedAsset::GetUTXOs(const std::string &addr) const {
@@ -84,6 +98,18 @@ namespace Elastos {
 			return result;
 		}
 
+		UTXOArray GroupedAsset::GetUTXOsAfter(const UTXOPtr &cursor, size_t count, const std::string &addr) const {
+			UTXOArray result;
+			UTXOHeightSet::const_iterator it = cursor ? _utxosByHeight.upper_bound(cursor) : _utxosByHeight.cbegin();
+
+			for (; it != _utxosByHeight.cend() && result.size() < count; ++it) {
+				if (addr.empty() || addr == (*it)->Output()->Addr()->String())
+					result.push_back(*it);
+			}
+
+			return result;
+		}
+
 		const UTXOSet &GroupedAsset::GetVoteUTXO() const {
 			return _utxosVote;
 		}
@@ -253,6 +279,7 @@ namespace Elastos {
 
 			{
 				_parent->GetLock().lock();
+				TransactionBuilder builder(tx);
 				for (UTXOSet::const_iterator u = _utxosVote.cbegin(); u != _utxosVote.cend(); ++u) {
 					if ((*u)->GetConfirms(_parent->_blockHeight) < 2 || _parent->IsUTXOSpending(*u)) {
 						_parent->GetLock().unlock();
@@ -315,19 +342,17 @@ namespace Elastos {
 					totalInputAmount += (*u)->Output()->Amount();
 
 					firstInput = *u;
-					tx->AddInput(InputPtr(new TransactionInput((*u)->Hash(), (*u)->Index())));
+					builder.AddInput(InputPtr(new TransactionInput((*u)->Hash(), (*u)->Index())));
 					if (!_parent->_subAccount->GetCodeAndPath((*u)->Output()->Addr(), code, path)) {
 						_parent->GetLock().unlock();
 						ErrorChecker::ThrowParamException(Error::Address, "Can't found code and path for input");
 					}
-					tx->AddUniqueProgram(ProgramPtr(new Program(path, code, bytes_t())));
+					if (!builder.ContainsProgram(code))
+						builder.AddUniqueProgram(ProgramPtr(new Program(path, code, bytes_t())));
 				}
-				feeAmount = CalculateFee(_parent->_feePerKb, tx->EstimateSize());
+				feeAmount = CalculateFee(_parent->_feePerKb, builder.EstimateSize());
 
-				UTXOArray utxo2Pick(_utxos.begin(), _utxos.end());
-				std::sort(utxo2Pick.begin(), utxo2Pick.end(), [](const UTXOPtr &a, const UTXOPtr &b) {
-					return a->Output()->Amount() > b->Output()->Amount();
-				});
+				UTXOArray utxo2Pick(_utxosByAmount.begin(), _utxosByAmount.end());
 
 				utxo2Pick.insert(utxo2Pick.end(), _utxosCoinbase.begin(), _utxosCoinbase.end());
 
@@ -342,14 +367,15 @@ namespace Elastos {
 
 					if ((*u)->GetConfirms(_parent->_blockHeight) < 2)
 						continue;
-					tx->AddInput(InputPtr(new TransactionInput((*u)->Hash(), (*u)->Index())));
+					builder.AddInput(InputPtr(new TransactionInput((*u)->Hash(), (*u)->Index())));
 					if (!_parent->_subAccount->GetCodeAndPath((*u)->Output()->Addr(), code, path)) {
 						_parent->GetLock().unlock();
 						ErrorChecker::ThrowParamException(Error::Address, "Can't found code and path for input");
 					}
-					tx->AddUniqueProgram(ProgramPtr(new Program(path, code, bytes_t())));
+					if (!builder.ContainsProgram(code))
+						builder.AddUniqueProgram(ProgramPtr(new Program(path, code, bytes_t())));
 
-					txSize = tx->EstimateSize();
+					txSize = builder.EstimateSize();
 
 					totalInputAmount += (*u)->Output()->Amount();
 					feeAmount = CalculateFee(_parent->_feePerKb, txSize);
@@ -446,13 +472,13 @@ namespace Elastos {
 
 			{
 				_parent->GetLock().lock();
-				UTXOArray utxo2Pick(_utxos.begin(), _utxos.end());
-				std::sort(utxo2Pick.begin(), utxo2Pick.end(), [](const UTXOPtr &a, const UTXOPtr &b) {
-					return a->Output()->Amount() > b->Output()->Amount();
-				});
+				TransactionBuilder builder(tx);
+				UTXOArray utxo2Pick(_utxosByAmount.begin(), _utxosByAmount.end());
 
 				utxo2Pick.insert(utxo2Pick.end(), _utxosCoinbase.begin(), _utxosCoinbase.end());
 
+				// every confirmed candidate is spent up to the input limit
+				BlockAllocator<TransactionInput> inputBlock(std::min<size_t>(utxo2Pick.size(), INPUT_BLOCK_CAPACITY));
 				for (UTXOArray::iterator u = utxo2Pick.begin(); u != utxo2Pick.end(); ++u) {
 					if (txSize >= TX_MAX_SIZE || tx->GetInputs().size() >= 3000)
 						break;
@@ -465,18 +491,19 @@ namespace Elastos {
 					if ((*u)->GetConfirms(_parent->_blockHeight) < 2)
 						continue;
 
-					tx->AddInput(InputPtr(new TransactionInput((*u)->Hash(), (*u)->Index())));
+					builder.AddInput(inputBlock.New((*u)->Hash(), (*u)->Index()));
 					bytes_t code;
 					std::string path;
 					if (!_parent->_subAccount->GetCodeAndPath((*u)->Output()->Addr(), code, path)) {
 						_parent->GetLock().unlock();
 						ErrorChecker::ThrowParamException(Error::Address, "Can't found code and path for input");
 					}
-					tx->AddUniqueProgram(ProgramPtr(new Program(path, code, bytes_t())));
+					if (!builder.ContainsProgram(code))
+						builder.AddUniqueProgram(ProgramPtr(new Program(path, code, bytes_t())));
 
 					totalInputAmount += (*u)->Output()->Amount();
 
-					txSize = tx->EstimateSize();
+					txSize = builder.EstimateSize();
 					if (_asset->GetName() == "ELA")
 						feeAmount = CalculateFee(_parent->_feePerKb, txSize);
 				}
@@ -506,6 +533,89 @@ namespace Elastos {
 			return tx;
 		}
 
+		std::vector<TransactionPtr> GroupedAsset::ConsolidateInBatches(const std::string &memo, size_t maxTxCount) {
+			std::vector<TransactionPtr> txns;
+			bool isELA = _asset->GetName() == "ELA";
+			bool lastUTXOPending = false;
+
+			AddressArray addr;
+			_parent->GetAllAddresses(addr, 0, 1, false);
+			ErrorChecker::CheckCondition(addr.empty(), Error::GetUnusedAddress, "get unused address fail");
+
+			_parent->GetLock().lock();
+			UTXOArray utxo2Pick;
+			utxo2Pick.reserve(_utxosByAmount.size() + _utxosCoinbase.size());
+			for (UTXOAmountSet::const_iterator u = _utxosByAmount.cbegin(); u != _utxosByAmount.cend(); ++u) {
+				if (IsSpendable(*u, lastUTXOPending))
+					utxo2Pick.push_back(*u);
+			}
+			for (UTXOSet::const_iterator u = _utxosCoinbase.cbegin(); u != _utxosCoinbase.cend(); ++u) {
+				if (IsSpendable(*u, lastUTXOPending))
+					utxo2Pick.push_back(*u);
+			}
+
+			// one pass over the candidates, every chunk becomes an independent tx paying to the same address
+			UTXOArray::iterator u = utxo2Pick.begin();
+			while (u != utxo2Pick.end() && (maxTxCount == 0 || txns.size() < maxTxCount)) {
+				TransactionPtr tx(new Transaction());
+				BigInt totalInputAmount(0);
+				uint64_t txSize = 0, feeAmount = 0;
+
+				tx->AddAttribute(AttributePtr(new Attribute(Attribute::Nonce,
+															bytes_t(std::to_string((std::rand() & 0xFFFFFFFF))))));
+				if (!memo.empty())
+					tx->AddAttribute(AttributePtr(new Attribute(Attribute::Memo, bytes_t(memo.c_str(), memo.size()))));
+
+				BlockAllocator<TransactionInput> inputBlock(std::min<size_t>(utxo2Pick.end() - u, INPUT_BLOCK_CAPACITY));
+				TransactionBuilder builder(tx);
+				for (; u != utxo2Pick.end(); ++u) {
+					if (txSize >= TX_MAX_SIZE || tx->GetInputs().size() >= 3000)
+						break;
+
+					builder.AddInput(inputBlock.New((*u)->Hash(), (*u)->Index()));
+					bytes_t code;
+					std::string path;
+					if (!_parent->_subAccount->GetCodeAndPath((*u)->Output()->Addr(), code, path)) {
+						_parent->GetLock().unlock();
+						ErrorChecker::ThrowParamException(Error::Address, "Can't found code and path for input");
+					}
+					if (!builder.ContainsProgram(code))
+						builder.AddUniqueProgram(ProgramPtr(new Program(path, code, bytes_t())));
+
+					totalInputAmount += (*u)->Output()->Amount();
+					txSize = builder.EstimateSize();
+				}
+
+				if (isELA)
+					feeAmount = CalculateFee(_parent->_feePerKb, txSize);
+
+				if (totalInputAmount <= feeAmount) {
+					// candidates are largest first, the remaining chunks can't pay their fee either
+					Log::warn("{} consolidate stop at tx {}, input {} <= fee {}", _parent->_walletID, txns.size(),
+							  totalInputAmount.getDec(), feeAmount);
+					break;
+				}
+
+				SPVLOG_DEBUG("batch {}: inputs: {}, amount: {}, fee: {}", txns.size(), tx->GetInputs().size(),
+							 totalInputAmount.getDec(), feeAmount);
+				tx->AddOutput(OutputPtr(new TransactionOutput(totalInputAmount - feeAmount, *addr[0], _asset->GetHash())));
+				tx->SetFee(feeAmount);
+				txns.push_back(tx);
+			}
+			_parent->GetLock().unlock();
+
+			if (txns.empty()) {
+				if (lastUTXOPending) {
+					ErrorChecker::ThrowLogicException(Error::TxPending, "merge utxo fail, last tx is pending");
+				} else {
+					ErrorChecker::ThrowLogicException(Error::BalanceNotEnough,
+													  "merge utxo fail, available balance is not enough");
+				}
+			}
+
+			return txns;
+		}
+
 		TransactionPtr GroupedAsset::CreateTxForOutputs(uint8_t type,
 														const PayloadPtr &payload,
 														const std::vector<OutputPtr> &outputs,
@@ -537,9 +647,10 @@ namespace Elastos {
 
 			{
 				_parent->GetLock().lock();
+				TransactionBuilder builder(txn);
 				if (_asset->GetName() == "ELA") {
 				    if (fee <= 0) {
-					    feeAmount.setUint64(CalculateFee(_parent->_feePerKb, txn->EstimateSize()));
+					    feeAmount.setUint64(CalculateFee(_parent->_feePerKb, builder.EstimateSize()));
 				    } else {
 				        feeAmount = fee;
 				    }
@@ -556,71 +667,126 @@ namespace Elastos {
 						if ((*u)->GetConfirms(_parent->_blockHeight) < 2)
 							continue;
 
-						txn->AddInput(InputPtr(new TransactionInput((*u)->Hash(), (*u)->Index())));
+						builder.AddInput(InputPtr(new TransactionInput((*u)->Hash(), (*u)->Index())));
 						if (!_parent->_subAccount->GetCodeAndPath((*u)->Output()->Addr(), code, path)) {
 							_parent->GetLock().unlock();
 							ErrorChecker::ThrowParamException(Error::Address, "Can't found code and path for input");
 						}
-						txn->AddUniqueProgram(ProgramPtr(new Program(path, code, bytes_t())));
+						if (!builder.ContainsProgram(code))
+							builder.AddUniqueProgram(ProgramPtr(new Program(path, code, bytes_t())));
 						totalInputAmount += (*u)->Output()->Amount();
 
-						txSize = txn->EstimateSize();
+						txSize = builder.EstimateSize();
 						if (_asset->GetName() == "ELA") {
                             if (fee <= 0) {
-                                feeAmount.setUint64(CalculateFee(_parent->_feePerKb, txn->EstimateSize()));
+                                feeAmount.setUint64(CalculateFee(_parent->_feePerKb, builder.EstimateSize()));
                             }
                         }
 					}
 				}
 
-				UTXOArray utxo2Pick(_utxos.begin(), _utxos.end());
-				std::sort(utxo2Pick.begin(), utxo2Pick.end(), [](const UTXOPtr &a, const UTXOPtr &b) {
-					return a->Output()->Amount() > b->Output()->Amount();
-				});
+				// amount ordered already, and partitioned by address for fromAddress
+				const UTXOAmountSet *spendable = &_utxosByAmount;
+				bool byAddress = fromAddress && fromAddress->Valid();
+				if (byAddress) {
+					std::map<uint168, UTXOAmountSet>::const_iterator it = _utxosByAddress.find(fromAddress->ProgramHash());
+					spendable = it != _utxosByAddress.cend() ? &it->second : nullptr;
+				}
 
-				utxo2Pick.insert(utxo2Pick.end(), _utxosCoinbase.begin(), _utxosCoinbase.end());
+				UTXOArray candidates;
+				candidates.reserve((spendable ? spendable->size() : 0) + _utxosCoinbase.size());
+				if (spendable) {
+					for (UTXOAmountSet::const_iterator u = spendable->cbegin(); u != spendable->cend(); ++u) {
+						if (IsSpendable(*u, lastUTXOPending))
+							candidates.push_back(*u);
+					}
+				}
+				size_t ordered = candidates.size();
+				for (UTXOSet::const_iterator u = _utxosCoinbase.cbegin(); u != _utxosCoinbase.cend(); ++u) {
+					if (byAddress && *fromAddress != *(*u)->Output()->Addr())
+						continue;
 
-				for (UTXOArray::iterator u = utxo2Pick.begin(); u != utxo2Pick.end(); ++u) {
-					if (!max && totalInputAmount >= totalOutputAmount + feeAmount && txSize >= 2000)
-						break;
+					if (IsSpendable(*u, lastUTXOPending))
+						candidates.push_back(*u);
+				}
 
-					if (_parent->IsUTXOSpending(*u)) {
-						lastUTXOPending = true;
-						continue;
-					}
+				// the selectors expect every candidate ordered by amount, only the coinbase part needs sorting
+				std::sort(candidates.begin() + ordered, candidates.end(), UTXOAmountCompare());
+				std::inplace_merge(candidates.begin(), candidates.begin() + ordered, candidates.end(),
+								   UTXOAmountCompare());
 
-					if (fromAddress && fromAddress->Valid() && *fromAddress != *(*u)->Output()->Addr())
+				CoinSelector::Params params;
+				params.amount = totalInputAmount < totalOutputAmount ? totalOutputAmount - totalInputAmount : BigInt(0);
+				if (_asset->GetName() == "ELA") {
+					if (fee <= 0)
+						params.feePerKB = _parent->_feePerKb;
+					else
+						params.fixedFee = fee;
+				}
+				params.baseSize = builder.EstimateSize();
+				params.maxSize = TX_MAX_SIZE;
+				// an input costs the most expensive program among the candidates' addresses
+				std::set<uint168> programHashes;
+				size_t programSize = 0;
+				for (UTXOArray::const_iterator u = candidates.cbegin(); u != candidates.cend(); ++u) {
+					if (!programHashes.insert((*u)->Output()->Addr()->ProgramHash()).second)
 						continue;
 
-					if ((*u)->GetConfirms(_parent->_blockHeight) < 2)
-						continue;
-					txn->AddInput(InputPtr(new TransactionInput((*u)->Hash(), (*u)->Index())));
 					if (!_parent->_subAccount->GetCodeAndPath((*u)->Output()->Addr(), code, path)) {
 						_parent->GetLock().unlock();
 						ErrorChecker::ThrowParamException(Error::Address, "Can't found code and path for input");
 					}
-					txn->AddUniqueProgram(ProgramPtr(new Program(path, code, bytes_t())));
+					programSize = std::max(programSize, Program(path, code, bytes_t()).EstimateSize());
+				}
+				if (!candidates.empty())
+					params.inputSize = TransactionInput().EstimateSize() + programSize;
+				if (params.feePerKB != 0)
+					params.changeCost = ((outputs.front()->EstimateSize() + params.inputSize) * params.feePerKB + 999) / 1000;
+
+				CoinSelector::Result selection;
+				bool selected;
+				if (max) {
+					size_t n = std::min(candidates.size(), params.MaxInputs());
+					selection.utxos.assign(candidates.begin(), candidates.begin() + n);
+					selected = n == candidates.size();
+				} else {
+					selected = _parent->_coinSelector->Select(candidates, params, selection);
+				}
+				SPVLOG_DEBUG("{} selected {}/{} utxos", _parent->_coinSelector->Name(), selection.utxos.size(), candidates.size());
 
-					txSize = txn->EstimateSize();
-					if (txSize >= TX_MAX_SIZE) { // transaction size-in-bytes too large
+				BlockAllocator<TransactionInput> inputBlock(selection.utxos.size());
+				for (UTXOArray::const_iterator u = selection.utxos.cbegin(); u != selection.utxos.cend(); ++u) {
+					builder.AddInput(inputBlock.New((*u)->Hash(), (*u)->Index()));
+					if (!_parent->_subAccount->GetCodeAndPath((*u)->Output()->Addr(), code, path)) {
 						_parent->GetLock().unlock();
-						if (!pickVoteFirst && !_utxosVote.empty()) {
-							return CreateTxForOutputs(type, payload, outputs, fromAddress, memo, max, !pickVoteFirst);
-						}
-
-						BigInt maxAmount = totalInputAmount - feeAmount;
-						ErrorChecker::ThrowParamException(Error::CreateTransactionExceedSize,
-													 "Tx size too large, max available amount: " + maxAmount.getDec() +
-													 " sela");
-						return nullptr;
+						ErrorChecker::ThrowParamException(Error::Address, "Can't found code and path for input");
 					}
-
+					if (!builder.ContainsProgram(code))
+						builder.AddUniqueProgram(ProgramPtr(new Program(path, code, bytes_t())));
 					totalInputAmount += (*u)->Output()->Amount();
-					if (_asset->GetName() == "ELA") {
-                        if (fee <= 0) {
-                            feeAmount.setUint64(CalculateFee(_parent->_feePerKb, txn->EstimateSize()));
-                        }
+				}
+
+				txSize = builder.EstimateSize();
+				if (_asset->GetName() == "ELA" && fee <= 0)
+					feeAmount.setUint64(CalculateFee(_parent->_feePerKb, txSize));
+
+				// an exact match spends the surplus as fee rather than creating a change output
+				if (selection.changeless && totalInputAmount >= totalOutputAmount + feeAmount)
+					feeAmount = totalInputAmount - totalOutputAmount;
+
+				bool sizeLimited = !selected && selection.utxos.size() < candidates.size() &&
+								   selection.utxos.size() >= params.MaxInputs();
+				if (txSize >= TX_MAX_SIZE || sizeLimited) { // transaction size-in-bytes too large
+					_parent->GetLock().unlock();
+					if (!pickVoteFirst && !_utxosVote.empty()) {
+						return CreateTxForOutputs(type, payload, outputs, fromAddress, memo, max, fee, !pickVoteFirst);
 					}
+
+					BigInt maxAmount = totalInputAmount - feeAmount;
+					ErrorChecker::ThrowParamException(Error::CreateTransactionExceedSize,
+												 "Tx size too large, max available amount: " + maxAmount.getDec() +
+												 " sela");
+					return nullptr;
 				}
 
 				if (!pickVoteFirst && (max || totalInputAmount < totalOutputAmount + feeAmount)) {
@@ -634,18 +800,19 @@ namespace Elastos {
 						if ((*u)->GetConfirms(_parent->_blockHeight) < 2)
 							continue;
 
-						txn->AddInput(InputPtr(new TransactionInput((*u)->Hash(), (*u)->Index())));
+						builder.AddInput(InputPtr(new TransactionInput((*u)->Hash(), (*u)->Index())));
 						if (!_parent->_subAccount->GetCodeAndPath((*u)->Output()->Addr(), code, path)) {
 							_parent->GetLock().unlock();
 							ErrorChecker::ThrowParamException(Error::Address, "Can't found code and path for input");
 						}
-						txn->AddUniqueProgram(ProgramPtr(new Program(path, code, bytes_t())));
+						if (!builder.ContainsProgram(code))
+							builder.AddUniqueProgram(ProgramPtr(new Program(path, code, bytes_t())));
 						totalInputAmount += (*u)->Output()->Amount();
 
-						txSize = txn->EstimateSize();
+						txSize = builder.EstimateSize();
 						if (_asset->GetName() == "ELA") {
                             if (fee <= 0) {
-                                feeAmount.setUint64(CalculateFee(_parent->_feePerKb, txn->EstimateSize()));
+                                feeAmount.setUint64(CalculateFee(_parent->_feePerKb, builder.EstimateSize()));
                             }
 						}
 					}
@@ -656,6 +823,7 @@ namespace Elastos {
 			if (max) {
 				totalOutputAmount = totalInputAmount - feeAmount;
 				txn->GetOutputs().front()->SetAmount(totalOutputAmount);
+				txn->ResetHash();
 			}
 
 			if (txn) {
@@ -707,16 +875,18 @@ namespace Elastos {
 
 			{
 				_parent->GetLock().lock();
+				TransactionBuilder builder(tx);
 
-				txSize = tx->EstimateSize();
+				txSize = builder.EstimateSize();
 				feeAmount = CalculateFee(_parent->_feePerKb, txSize);
 
-				UTXOArray utxo2Pick(_utxos.begin(), _utxos.end());
+				UTXOArray utxo2Pick(_utxosByAmount.begin(), _utxosByAmount.end());
 				utxo2Pick.insert(utxo2Pick.end(), _utxosCoinbase.begin(), _utxosCoinbase.end());
 
-				std::sort(utxo2Pick.begin(), utxo2Pick.end(), [](const UTXOPtr &a, const UTXOPtr &b) {
-					return a->Output()->Amount() > b->Output()->Amount();
-				});
+				// only the coinbase part needs sorting before the merge
+				std::sort(utxo2Pick.begin() + _utxosByAmount.size(), utxo2Pick.end(), UTXOAmountCompare());
+				std::inplace_merge(utxo2Pick.begin(), utxo2Pick.begin() + _utxosByAmount.size(), utxo2Pick.end(),
+								   UTXOAmountCompare());
 
 				for (UTXOArray::iterator u = utxo2Pick.begin(); u != utxo2Pick.end(); ++u) {
 					if (totalInputAmount >= feeAmount && txSize >= 2000)
@@ -729,14 +899,15 @@ namespace Elastos {
 
 					if ((*u)->GetConfirms(_parent->_blockHeight) < 2)
 						continue;
-					tx->AddInput(InputPtr(new TransactionInput((*u)->Hash(), (*u)->Index())));
+					builder.AddInput(InputPtr(new TransactionInput((*u)->Hash(), (*u)->Index())));
 					if (!_parent->_subAccount->GetCodeAndPath((*u)->Output()->Addr(), code, path)) {
 						_parent->GetLock().unlock();
 						ErrorChecker::ThrowParamException(Error::Address, "Can't found code and path for input");
 					}
-					tx->AddUniqueProgram(ProgramPtr(new Program(path, code, bytes_t())));
+					if (!builder.ContainsProgram(code))
+						builder.AddUniqueProgram(ProgramPtr(new Program(path, code, bytes_t())));
 
-					txSize = tx->EstimateSize();
+					txSize = builder.EstimateSize();
 					if (txSize > TX_MAX_SIZE) { // transaction size-in-bytes too large
 						_parent->GetLock().unlock();
 						ErrorChecker::ThrowParamException(Error::CreateTransactionExceedSize,
@@ -759,15 +930,16 @@ namespace Elastos {
 						if ((*u)->GetConfirms(_parent->_blockHeight) < 2)
 							continue;
 
-						tx->AddInput(InputPtr(new TransactionInput((*u)->Hash(), (*u)->Index())));
+						builder.AddInput(InputPtr(new TransactionInput((*u)->Hash(), (*u)->Index())));
 						if (!_parent->_subAccount->GetCodeAndPath((*u)->Output()->Addr(), code, path)) {
 							_parent->GetLock().unlock();
 							ErrorChecker::ThrowParamException(Error::Address, "Can't found code and path for input");
 						}
-						tx->AddUniqueProgram(ProgramPtr(new Program(path, code, bytes_t())));
+						if (!builder.ContainsProgram(code))
+							builder.AddUniqueProgram(ProgramPtr(new Program(path, code, bytes_t())));
 
 						totalInputAmount += (*u)->Output()->Amount();
-						txSize = tx->EstimateSize();
+						txSize = builder.EstimateSize();
 						if (_asset->GetName() == "ELA")
 							feeAmount = CalculateFee(_parent->_feePerKb, txSize);
 					}
@@ -801,72 +973,108 @@ namespace Elastos {
 		}
 
 		bool GroupedAsset::AddUTXO(const UTXOPtr &o) {
+			UTXOSet *set = InsertUTXO(o);
+			if (set == nullptr)
+				return false;
+
+			_utxosByHeight.insert(o);
+			if (set == &_utxos) {
+				_utxosByAmount.insert(o);
+				_utxosByAddress[o->Output()->Addr()->ProgramHash()].insert(o);
+			}
+			return true;
+		}
+
+		bool GroupedAsset::AddCoinBaseUTXO(const UTXOPtr &o) {
+			if (InsertCoinBaseUTXO(o) == nullptr)
+				return false;
+
+			_utxosByHeight.insert(o);
+			return true;
+		}
+
+		void GroupedAsset::AddUTXOs(const UTXOArray &utxos, bool coinbase) {
+			// sorted by outpoint, every insert below is an append; the other indexes are built in one pass each
+			UTXOArray sorted(utxos), added, spendable;
+			std::map<uint168, UTXOArray> spendableByAddress;
+			std::sort(sorted.begin(), sorted.end(), UTXOCompare());
+			added.reserve(sorted.size());
+
+			for (UTXOArray::const_iterator u = sorted.cbegin(); u != sorted.cend(); ++u) {
+				UTXOSet *set = coinbase ? InsertCoinBaseUTXO(*u) : InsertUTXO(*u);
+				if (set == nullptr)
+					continue;
+
+				added.push_back(*u);
+				if (set == &_utxos) {
+					spendable.push_back(*u);
+					spendableByAddress[(*u)->Output()->Addr()->ProgramHash()].push_back(*u);
+				}
+			}
+
+			_utxosByHeight.insert(added.begin(), added.end());
+			_utxosByAmount.insert(spendable.begin(), spendable.end());
+			for (std::map<uint168, UTXOArray>::iterator it = spendableByAddress.begin(); it != spendableByAddress.end(); ++it)
+				_utxosByAddress[it->first].insert(it->second.begin(), it->second.end());
+		}
+
+		UTXOSet *GroupedAsset::InsertUTXO(const UTXOPtr &o) {
 			if (_parent->_subAccount->IsProducerDepositAddress(o->Output()->Addr()) ||
 				_parent->_subAccount->IsCRDepositAddress(o->Output()->Addr())) {
 				if (!_utxosDeposit.insert(o).second)
-					return false;
+					return nullptr;
 
 				_balanceDeposit += o->Output()->Amount();
 				SPVLOG_DEBUG("{} +++ deposit utxo {}:{}:{}:{} -> deposit {}", _parent->_walletID,
 							 o->Hash().GetHex(), o->Index(), o->Output()->Addr()->String(),
 							 o->Output()->Amount().getDec(), _balanceDeposit.getDec());
+				return &_utxosDeposit;
 			} else {
 				if (o->Output()->GetType() == TransactionOutput::Type::VoteOutput) {
 					if (!_utxosVote.insert(o).second)
-						return false;
+						return nullptr;
 
 					_balanceVote += o->Output()->Amount();
 					_balance += o->Output()->Amount();
 					SPVLOG_DEBUG("{} +++ vote utxo {}:{}:{}:{} -> vote {} balance {}", _parent->_walletID,
 								 o->Hash().GetHex(), o->Index(), o->Output()->Addr()->String(),
 								 o->Output()->Amount().getDec(), _balanceVote.getDec(), _balance.getDec());
+					return &_utxosVote;
 				} else {
 					if (!_utxos.insert(o).second)
-						return false;
+						return nullptr;
 
 					_balance += o->Output()->Amount();
 					SPVLOG_DEBUG("{} +++ utxo {}:{}:{}:{} -> balance {}, size: {}", _parent->_walletID,
 								 o->Hash().GetHex(), o->Index(), o->Output()->Addr()->String(),
 								 o->Output()->Amount().getDec(), _balance.getDec(), _utxos.size());
+					return &_utxos;
 				}
 			}
-
-			return true;
 		}
 
-		bool GroupedAsset::AddCoinBaseUTXO(const UTXOPtr &o) {
+		UTXOSet *GroupedAsset::InsertCoinBaseUTXO(const UTXOPtr &o) {
 			if (o->GetConfirms(_parent->_blockHeight) <= 100) {
 				if (!_utxosLocked.insert(o).second)
-					return false;
+					return nullptr;
 				_balanceLocked += o->Output()->Amount();
 				SPVLOG_DEBUG("{} +++ coinbase locked utxo {}:{}:{}:{} -> locked {}", _parent->_walletID,
 							 o->Hash().GetHex(), o->Index(), o->Output()->Addr()->String(),
 							 o->Output()->Amount().getDec(), _balanceLocked.getDec());
+				return &_utxosLocked;
 			} else {
 				if (!_utxosCoinbase.insert(o).second)
-					return false;
+					return nullptr;
 				_balance += o->Output()->Amount();
 				SPVLOG_DEBUG("{} +++ coinbase utxo {}:{}:{}:{} -> balance {}", _parent->_walletID, o->Hash().GetHex(),
 							 o->Index(), o->Output()->Addr()->String(), o->Output()->Amount().getDec(),
 							 _balance.getDec());
+				return &_utxosCoinbase;
 			}
-
-			return true;
 		}
 
-		UTXOArray GroupedAsset::RemoveUTXO(const std::vector<InputPtr> &inputs) {
-			UTXOArray deleted;
-
-			for (InputArray::const_iterator in = inputs.cbegin(); in != inputs.cend(); ++in) {
-				UTXOPtr u = RemoveUTXO(UTXOPtr(new UTXO(*in)));
-				if (u)
-					deleted.push_back(u);
-			}
-
-			return deleted;
-		}
-
-		UTXOPtr GroupedAsset::RemoveUTXO(const UTXOPtr &u) {
+		template<class K>
+		UTXOPtr GroupedAsset::EraseUTXO(const K &u) {
 			UTXOPtr deleted;
 			UTXOSet::iterator it;
 
@@ -876,6 +1084,7 @@ namespace Elastos {
 				SPVLOG_DEBUG("{} --- coinbase utxo {}:{}:{}:{} -> balance {}", _parent->_walletID,
 							 (*it)->Hash().GetHex(), (*it)->Index(), (*it)->Output()->Addr()->String(),
 							 (*it)->Output()->Amount().getDec(), _balance.getDec());
+				_utxosByHeight.erase(*it);
 				_utxosCoinbase.erase(it);
 				return deleted;
 			}
@@ -887,6 +1096,7 @@ namespace Elastos {
 				SPVLOG_DEBUG("{} --- vote utxo {}:{}:{}:{} -> vote balance {} balance {}", _parent->_walletID,
 							 (*it)->Hash().GetHex(), (*it)->Index(), (*it)->Output()->Addr()->String(),
 							 (*it)->Output()->Amount().getDec(), _balanceVote.getDec(), _balance.getDec());
+				_utxosByHeight.erase(*it);
 				_utxosVote.erase(it);
 				return deleted;
 			}
@@ -897,6 +1107,14 @@ namespace Elastos {
 				SPVLOG_DEBUG("{} --- utxo {}:{}:{}:{} -> balance {}", _parent->_walletID, (*it)->Hash().GetHex(),
 							 (*it)->Index(), (*it)->Output()->Addr()->String(), (*it)->Output()->Amount().getDec(),
 							 _balance.getDec());
+				_utxosByHeight.erase(*it);
+				_utxosByAmount.erase(*it);
+				std::map<uint168, UTXOAmountSet>::iterator addr = _utxosByAddress.find((*it)->Output()->Addr()->ProgramHash());
+				if (addr != _utxosByAddress.end()) {
+					addr->second.erase(*it);
+					if (addr->second.empty())
+						_utxosByAddress.erase(addr);
+				}
 				_utxos.erase(it);
 				return deleted;
 			}
@@ -907,6 +1125,7 @@ namespace Elastos {
 				SPVLOG_DEBUG("{} --- deposit utxo {}:{}:{}:{} -> deposit balance {}", _parent->_walletID,
 							 (*it)->Hash().GetHex(), (*it)->Index(), (*it)->Output()->Addr()->String(),
 							 (*it)->Output()->Amount().getDec(), _balanceDeposit.getDec());
+				_utxosByHeight.erase(*it);
 				_utxosDeposit.erase(it);
 				return deleted;
 			}
@@ -914,6 +1133,7 @@ namespace Elastos {
 			if ((it = _utxosLocked.find(u)) != _utxosLocked.end()) {
 				deleted = *it;
 				_balanceLocked -= (*it)->Output()->Amount();
+				_utxosByHeight.erase(*it);
 				_utxosLocked.erase(it);
 				return deleted;
 			}
@@ -921,6 +1141,22 @@ namespace Elastos {
 			return nullptr;
 		}
 
+		UTXOArray GroupedAsset::RemoveUTXO(const std::vector<InputPtr> &inputs) {
+			UTXOArray deleted;
+
+			for (InputArray::const_iterator in = inputs.cbegin(); in != inputs.cend(); ++in) {
+				UTXOPtr u = EraseUTXO(*in);
+				if (u)
+					deleted.push_back(u);
+			}
+
+			return deleted;
+		}
+
+		UTXOPtr GroupedAsset::RemoveUTXO(const UTXOPtr &u) {
+			return EraseUTXO(u);
+		}
+
 		bool GroupedAsset::UpdateLockedBalance() {
 			bool changed = false;
 
@@ -950,6 +1186,15 @@ namespace Elastos {
 				   _utxosLocked.find(o) != _utxosLocked.end();
 		}
 
+		bool GroupedAsset::IsSpendable(const UTXOPtr &u, bool &pending) const {
+			if (_parent->IsUTXOSpending(u)) {
+				pending = true;
+				return false;
+			}
+
+			return u->GetConfirms(_parent->_blockHeight) >= 2;
+		}
+
 		uint64_t GroupedAsset::CalculateFee(uint64_t feePerKB, size_t size) const {
 			return (size + 999) / 1000 * feePerKB;
 		}
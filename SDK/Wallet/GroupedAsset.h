@@ -44,6 +44,9 @@ namespace Elastos {
 
 			UTXOArray GetUTXOs(const std::string &addr) const;
 
+			// utxos ordered by (height, hash, index), strictly after cursor (from the beginning if cursor is null)
+			UTXOArray GetUTXOsAfter(const UTXOPtr &cursor, size_t count, const std::string &addr) const;
+
 			const UTXOSet &GetVoteUTXO() const;
 
 			const UTXOSet &GetCoinBaseUTXOs() const;
@@ -60,6 +63,9 @@ namespace Elastos {
 
 			TransactionPtr Consolidate(const std::string &memo);
 
+			// split all spendable utxos into independent consolidate txs, at most maxTxCount of them (0: no limit)
+			std::vector<TransactionPtr> ConsolidateInBatches(const std::string &memo, size_t maxTxCount);
+
 			TransactionPtr CreateTxForOutputs(uint8_t type,
 											  const PayloadPtr &payload,
 											  const OutputArray &outputs,
@@ -77,6 +83,9 @@ namespace Elastos {
 
 			bool AddCoinBaseUTXO(const UTXOPtr &o);
 
+			// bulk variant of AddUTXO/AddCoinBaseUTXO for loading a wallet
+			void AddUTXOs(const UTXOArray &utxos, bool coinbase);
+
 			UTXOArray RemoveUTXO(const std::vector<InputPtr> &inputs);
 
 			UTXOPtr RemoveUTXO(const UTXOPtr &u);
@@ -86,11 +95,28 @@ namespace Elastos {
 			bool ContainUTXO(const UTXOPtr &o) const;
 
 		private:
+			// return the set the utxo was added to, nullptr if it was already there
+			UTXOSet *InsertUTXO(const UTXOPtr &o);
+
+			UTXOSet *InsertCoinBaseUTXO(const UTXOPtr &o);
+
+			// key is a UTXOPtr or an InputPtr, see UTXOCompare
+			template<class K>
+			UTXOPtr EraseUTXO(const K &u);
+
 			uint64_t CalculateFee(uint64_t feePerKB, size_t size) const;
 
+			// confirmed and not spent by a pending tx; sets pending when it is
+			bool IsSpendable(const UTXOPtr &u, bool &pending) const;
+
 		private:
 			BigInt _balance, _balanceVote, _balanceDeposit, _balanceLocked;
+			// flat sorted arrays of handles; each utxo is still a heap UTXO with its decoded output attached
 			UTXOSet _utxos, _utxosVote, _utxosCoinbase, _utxosDeposit, _utxosLocked;
+			UTXOHeightSet _utxosByHeight;
+			// same coins as _utxos, as a whole and per address, largest amount first for coin selection
+			UTXOAmountSet _utxosByAmount;
+			std::map<uint168, UTXOAmountSet> _utxosByAddress;
 
 			AssetPtr _asset;
 
@@ -6,15 +6,15 @@
 #define __ELASTOS_SDK_UTXO_H__
 
 #include <Common/uint256.h>
+#include <Common/FlatSet.h>
+#include <Common/BigInt.h>
 #include <Plugin/Transaction/TransactionOutput.h>
+#include <Plugin/Transaction/TransactionInput.h>
 #include <vector>
 
 namespace Elastos {
 	namespace ElaWallet {
 
-		class TransactionInput;
-		class BigInt;
-		typedef boost::shared_ptr<TransactionInput> InputPtr;
 
 		class UTXO {
 		public:
@@ -77,9 +77,56 @@ namespace Elastos {
 					return x->Hash() < y->Hash();
 				}
 			}
+
+			// lookup by outpoint without building a UTXO
+			bool operator() (const UTXOPtr &x, const InputPtr &y) const {
+				if (x->Hash() == y->TxHash()) {
+					return x->Index() < y->Index();
+				} else {
+					return x->Hash() < y->TxHash();
+				}
+			}
+
+			bool operator() (const InputPtr &x, const UTXOPtr &y) const {
+				if (x->TxHash() == y->Hash()) {
+					return x->Index() < y->Index();
+				} else {
+					return x->TxHash() < y->Hash();
+				}
+			}
 		} UTXOCompare;
 
-		typedef std::set<UTXOPtr, UTXOCompare> UTXOSet;
+		typedef FlatSet<UTXOPtr, UTXOCompare> UTXOSet;
+
+		typedef struct {
+			bool operator() (const UTXOPtr &x, const UTXOPtr &y) const {
+				if (x->BlockHeight() != y->BlockHeight()) {
+					return x->BlockHeight() < y->BlockHeight();
+				} else if (x->Hash() == y->Hash()) {
+					return x->Index() < y->Index();
+				} else {
+					return x->Hash() < y->Hash();
+				}
+			}
+		} UTXOHeightCompare;
+
+		typedef FlatSet<UTXOPtr, UTXOHeightCompare> UTXOHeightSet;
+
+		// largest amount first, the order coin selection wants its candidates in
+		typedef struct {
+			bool operator() (const UTXOPtr &x, const UTXOPtr &y) const {
+				const BigInt &a = x->Output()->Amount(), &b = y->Output()->Amount();
+				if (a != b) {
+					return a > b;
+				} else if (x->Hash() == y->Hash()) {
+					return x->Index() < y->Index();
+				} else {
+					return x->Hash() < y->Hash();
+				}
+			}
+		} UTXOAmountCompare;
+
+		typedef FlatSet<UTXOPtr, UTXOAmountCompare> UTXOAmountSet;
 
 	}
 }
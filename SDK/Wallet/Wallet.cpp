@@ -38,6 +38,7 @@ namespace Elastos {
 			_chainID(chainID),
 			_blockHeight(lastBlockHeight),
 			_feePerKb(DEFAULT_FEE_PER_KB),
+			_coinSelector(new LargestFirstCoinSelector()),
 			_subAccount(subAccount),
 			_database(database) {
 
@@ -60,14 +61,13 @@ namespace Elastos {
 				_subAccount->UnusedAddresses(SEQUENCE_GAP_LIMIT_EXTERNAL + 100, 0);
 				_subAccount->UnusedAddresses(SEQUENCE_GAP_LIMIT_INTERNAL + 100, 1);
 
-				std::map<uint256, TransactionPtr> txnMap;
+				std::map<uint256, TransactionViewPtr> txnMap;
 				bool saveTxHash = false;
 
 				if (!database->ExistTxHashTable() || (_chainID == CHAINID_IDCHAIN && !database->GetTxHashDPoS().empty())) {
 					saveTxHash = true;
 					std::vector<TransactionPtr> txns = LoadTxn(TxnType(TXN_NORMAL | TXN_COINBASE));
 					for (TransactionPtr &tx : txns) {
-						txnMap[tx->GetHash()] = tx;
 						if (tx->IsIDTransaction())
 							txHashDID.push_back(tx->GetHash().GetHex());
 						else if (tx->IsDPoSTransaction())
@@ -77,26 +77,31 @@ namespace Elastos {
 						else if (tx->IsProposalTransaction())
 							txHashProposal.push_back(tx->GetHash().GetHex());
 					}
-				} else {
-					std::vector<TransactionPtr> utxoTxns = LoadUTXOTxn();
-					for (TransactionPtr &tx : utxoTxns)
-						txnMap[tx->GetHash()] = tx;
 				}
 
+				// only the referenced outputs are materialized, the rest of each utxo txn stays as raw bytes
+				std::vector<TransactionViewPtr> utxoTxns = LoadUTXOTxn();
+				for (TransactionViewPtr &view : utxoTxns)
+					txnMap[view->GetHash()] = view;
+
+				std::map<uint256, UTXOArray> assetUTXOs, assetCoinbaseUTXOs;
 				for (const UTXOPtr &u : utxo) {
-					std::map<uint256, TransactionPtr>::iterator it = txnMap.find(u->Hash());
+					std::map<uint256, TransactionViewPtr>::iterator it = txnMap.find(u->Hash());
 					if (it != txnMap.end()) {
-						TransactionPtr tx = it->second;
+						TransactionViewPtr tx = it->second;
 						OutputPtr o = tx->OutputOfIndex(u->Index());
-						GroupedAssetPtr groupedAsset = GetGroupedAsset(o->AssetID());
-						if (groupedAsset) {
+						if (o == nullptr) {
+							Log::error("utxo {}:{} output not found", u->Hash().GetHex(), u->Index());
+							continue;
+						}
+						if (ContainsAsset(o->AssetID())) {
 							u->SetOutput(o);
 							u->SetBlockHeight(tx->GetBlockHeight());
 							u->SetTimestamp(tx->GetTimestamp());
 							if (tx->IsCoinBase()) {
-								groupedAsset->AddCoinBaseUTXO(u);
+								assetCoinbaseUTXOs[o->AssetID()].push_back(u);
 							} else {
-								groupedAsset->AddUTXO(u);
+								assetUTXOs[o->AssetID()].push_back(u);
 							}
 						} else {
 							Log::error("asset {} not found", o->AssetID().GetHex());
@@ -105,6 +110,11 @@ namespace Elastos {
 						Log::error("utxo hash {} not found", u->Hash().GetHex());
 					}
 				}
+
+				for (std::map<uint256, UTXOArray>::iterator it = assetUTXOs.begin(); it != assetUTXOs.end(); ++it)
+					GetGroupedAsset(it->first)->AddUTXOs(it->second, false);
+				for (std::map<uint256, UTXOArray>::iterator it = assetCoinbaseUTXOs.begin(); it != assetCoinbaseUTXOs.end(); ++it)
+					GetGroupedAsset(it->first)->AddUTXOs(it->second, true);
 				if (saveTxHash)
 					SaveSpecialTxHash(txHashDPoS, txHashCRC, txHashProposal, txHashDID, _chainID == CHAINID_IDCHAIN);
 			} else {
@@ -207,6 +217,24 @@ namespace Elastos {
 			return result;
 		}
 
+		UTXOArray Wallet::GetUTXOsAfter(const UTXOPtr &cursor, size_t count, const std::string &address) const {
+			boost::mutex::scoped_lock scopedLock(lock);
+			UTXOArray result;
+
+			for (GroupedAssetMap::iterator it = _groupedAssets.begin(); it != _groupedAssets.end(); ++it) {
+				UTXOArray utxos = it->second->GetUTXOsAfter(cursor, count, address);
+				result.insert(result.end(), utxos.begin(), utxos.end());
+			}
+
+			if (_groupedAssets.size() > 1) {
+				std::sort(result.begin(), result.end(), UTXOHeightCompare());
+				if (result.size() > count)
+					result.resize(count);
+			}
+
+			return result;
+		}
+
 		UTXOArray Wallet::GetVoteUTXO() const {
 			boost::mutex::scoped_lock scopedLock(lock);
 			UTXOArray result;
@@ -266,6 +294,16 @@ namespace Elastos {
 			_feePerKb = fee;
 		}
 
+		CoinSelectorPtr Wallet::GetCoinSelector() const {
+			boost::mutex::scoped_lock scoped_lock(lock);
+			return _coinSelector;
+		}
+
+		void Wallet::SetCoinSelector(const CoinSelectorPtr &selector) {
+			boost::mutex::scoped_lock scoped_lock(lock);
+			_coinSelector = selector ? selector : CoinSelectorPtr(new LargestFirstCoinSelector());
+		}
+
 		// only support asset of ELA
 		TransactionPtr Wallet::Vote(const VoteContent &voteContent, const std::string &memo, bool max,
 		                            VoteContentArray &dropedVotes) {
@@ -289,6 +327,23 @@ namespace Elastos {
 			return tx;
 		}
 
+		std::vector<TransactionPtr> Wallet::ConsolidateInBatches(const std::string &memo, const uint256 &assetID,
+																 size_t maxTxCount) {
+			bool containAsset;
+			{
+				boost::mutex::scoped_lock scoped_lock(lock);
+				containAsset = ContainsAsset(assetID);
+			}
+
+			ErrorChecker::CheckParam(!containAsset, Error::InvalidAsset, "asset not found: " + assetID.GetHex());
+
+			// fee of other assets is paid from ELA utxos, which can't be shared by unpublished txs
+			if (assetID != Asset::GetELAAssetID())
+				return std::vector<TransactionPtr>(1, Consolidate(memo, assetID));
+
+			return _groupedAssets[assetID]->ConsolidateInBatches(memo, maxTxCount);
+		}
+
 		TransactionPtr Wallet::CreateRetrieveTransaction(uint8_t type, const PayloadPtr &payload, const BigInt &amount,
 														 const AddressPtr &fromAddress, const std::string &memo) {
 			std::string memoFixed;
@@ -770,6 +825,11 @@ namespace Elastos {
 			_subAccount->SignTransaction(tx, payPassword);
 		}
 
+		void Wallet::SignTransactions(const std::vector<TransactionPtr> &txns, const std::string &payPassword) const {
+			boost::mutex::scoped_lock scopedLock(lock);
+			_subAccount->SignTransactions(txns, payPassword);
+		}
+
 		std::string
 		Wallet::SignWithDID(const AddressPtr &did, const std::string &msg, const std::string &payPasswd) const {
 			boost::mutex::scoped_lock scopedLock(lock);
@@ -909,6 +969,30 @@ namespace Elastos {
 			return txnsInputs;
 		}
 
+		std::map<uint256, TransactionViewPtr> Wallet::TransactionViewsForInputs(const std::vector<TransactionView::InputRef> &inputs) const {
+			std::map<uint256, TransactionViewPtr> viewsInputs;
+			if (_database.expired() || inputs.empty())
+				return viewsInputs;
+
+			std::set<std::string> hashes;
+			for (const TransactionView::InputRef &in : inputs)
+				hashes.insert(in.txHash.GetHex());
+
+			DatabaseManagerPtr db = _database.lock();
+			std::vector<TransactionViewPtr> views = db->GetCoinbaseUniqueTxnViews(_chainID, hashes);
+
+			std::vector<TransactionViewPtr> tmp = db->GetNormalUniqueTxnViews(_chainID, hashes);
+			views.insert(views.end(), tmp.begin(), tmp.end());
+
+			tmp = db->GetPendingUniqueTxnViews(_chainID, hashes);
+			views.insert(views.end(), tmp.begin(), tmp.end());
+
+			for (TransactionViewPtr &view : views)
+				viewsInputs[view->GetHash()] = view;
+
+			return viewsInputs;
+		}
+
 		AssetPtr Wallet::GetAsset(const uint256 &assetID) const {
 			boost::mutex::scoped_lock scopedLock(lock);
 			if (!ContainsAsset(assetID)) {
@@ -1106,10 +1190,7 @@ namespace Elastos {
 
 		void Wallet::RemoveSpendingUTXO(const InputArray &inputs) {
 			for (InputArray::const_iterator input = inputs.cbegin(); input != inputs.cend(); ++input) {
-				UTXOSet::iterator it;
-				if ((it = _spendingOutputs.find(UTXOPtr(new UTXO(*input)))) != _spendingOutputs.end()) {
-					_spendingOutputs.erase(it);
-				}
+				_spendingOutputs.erase(*input);
 			}
 		}
 
@@ -1293,11 +1374,11 @@ namespace Elastos {
 			}
 		}
 
-		std::vector<TransactionPtr> Wallet::LoadUTXOTxn() const {
+		std::vector<TransactionViewPtr> Wallet::LoadUTXOTxn() const {
 			if (!_database.expired()) {
 				DatabaseManagerPtr db = _database.lock();
-				std::vector<TransactionPtr> txns = db->GetCoinbaseUTXOTxn(_chainID);
-				std::vector<TransactionPtr> tmp = db->GetNormalUTXOTxn(_chainID);
+				std::vector<TransactionViewPtr> txns = db->GetCoinbaseUTXOTxnViews(_chainID);
+				std::vector<TransactionViewPtr> tmp = db->GetNormalUTXOTxnViews(_chainID);
 
 				txns.insert(txns.end(), tmp.begin(), tmp.end());
 
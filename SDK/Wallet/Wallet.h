@@ -9,7 +9,9 @@
 #include <Common/ElementSet.h>
 #include <Account/SubAccount.h>
 #include <Wallet/GroupedAsset.h>
+#include <Wallet/CoinSelector.h>
 #include <Plugin/Transaction/TransactionInput.h>
+#include <Plugin/Transaction/TransactionView.h>
 
 #include <boost/weak_ptr.hpp>
 #include <boost/function.hpp>
@@ -130,11 +132,19 @@ namespace Elastos {
 
 			void SetFeePerKb(uint64_t fee);
 
+			CoinSelectorPtr GetCoinSelector() const;
+
+			// nullptr restores the default largest-first selection
+			void SetCoinSelector(const CoinSelectorPtr &selector);
+
 			TransactionPtr Vote(const VoteContent &voteContent, const std::string &memo, bool max,
 			                    VoteContentArray &dropedVotes);
 
 			TransactionPtr Consolidate(const std::string &memo, const uint256 &asset);
 
+			std::vector<TransactionPtr> ConsolidateInBatches(const std::string &memo, const uint256 &asset,
+															 size_t maxTxCount);
+
 			TransactionPtr CreateRetrieveTransaction(uint8_t type, const PayloadPtr &payload, const BigInt &amount,
 													 const AddressPtr &fromAddress, const std::string &memo);
 
@@ -164,6 +174,8 @@ namespace Elastos {
 
 			std::map<uint256, TransactionPtr> TransactionsForInputs(const InputArray &inputs) const;
 
+			std::map<uint256, TransactionViewPtr> TransactionViewsForInputs(const std::vector<TransactionView::InputRef> &inputs) const;
+
 			bool TransactionIsValid(const TransactionPtr &transaction);
 
 #if 0
@@ -180,6 +192,8 @@ namespace Elastos {
 
 			void SignTransaction(const TransactionPtr &tx, const std::string &payPassword) const;
 
+			void SignTransactions(const std::vector<TransactionPtr> &txns, const std::string &payPassword) const;
+
 			std::string SignWithDID(const AddressPtr &did, const std::string &msg, const std::string &payPasswd) const;
 
 			std::string SignDigestWithDID(const AddressPtr &did, const uint256 &digest,
@@ -191,6 +205,8 @@ namespace Elastos {
 
 			UTXOArray GetAllUTXO(const std::string &address) const;
 
+			UTXOArray GetUTXOsAfter(const UTXOPtr &cursor, size_t count, const std::string &address) const;
+
 			UTXOArray GetVoteUTXO() const;
 
 			std::vector<TransactionPtr> TxUnconfirmedBefore(uint32_t blockHeight);
@@ -255,7 +271,7 @@ namespace Elastos {
 
 			bool containTxn(const uint256 &hash) const;
 
-			std::vector<TransactionPtr> LoadUTXOTxn() const;
+			std::vector<TransactionViewPtr> LoadUTXOTxn() const;
 
 			std::vector<UTXOPtr> LoadUTXOs() const;
 
@@ -292,6 +308,7 @@ namespace Elastos {
 			UTXOSet _spendingOutputs;
 
 			uint64_t _feePerKb;
+			CoinSelectorPtr _coinSelector;
 
 			uint32_t _blockHeight;
 			boost::weak_ptr<Listener> _listener;
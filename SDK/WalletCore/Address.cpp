@@ -13,15 +13,22 @@
 #include <WalletCore/secp256k1_openssl.h>
 
 #include <boost/bind.hpp>
+#include <boost/thread/mutex.hpp>
 
 namespace Elastos {
 	namespace ElaWallet {
 
-		Address::Address() {
+		// guards the first Base58 encoding of addresses shared between threads
+		static boost::mutex &EncodeLock() {
+			static boost::mutex lock;
+			return lock;
+		}
+
+		Address::Address() : _strReady(false) {
 			_isValid = false;
 		}
 
-		Address::Address(const std::string &address) {
+		Address::Address(const std::string &address) : _strReady(true) {
 			_str = address;
 			if (address.empty()) {
 				_isValid = false;
@@ -41,24 +48,22 @@ namespace Elastos {
 			Address(prefix, {pubKey}, 1, did) {
 		}
 
-		Address::Address(Prefix prefix, const std::vector<bytes_t> &pubkeys, uint8_t m, bool did) {
+		Address::Address(Prefix prefix, const std::vector<bytes_t> &pubkeys, uint8_t m, bool did) : _strReady(false) {
 			if (pubkeys.size() == 0) {
 				_isValid = false;
 			} else {
 				GenerateCode(prefix, pubkeys, m, did);
 				GenerateProgramHash(prefix);
-				if (CheckValid())
-					_str = Base58::CheckEncode(_programHash.bytes());
+				CheckValid();
 			}
 		}
 
-		Address::Address(const uint168 &programHash) {
+		Address::Address(const uint168 &programHash) : _strReady(false) {
 			_programHash = programHash;
-			if (CheckValid())
-				_str = Base58::CheckEncode(_programHash.bytes());
+			CheckValid();
 		}
 
-		Address::Address(const Address &address) {
+		Address::Address(const Address &address) : _strReady(false) {
 			operator=(address);
 		}
 
@@ -75,6 +80,16 @@ namespace Elastos {
 		}
 
 		std::string Address::String() const {
+			// Base58 is only needed for display, so it is encoded on first use
+			if (!_strReady.load(std::memory_order_acquire)) {
+				boost::mutex::scoped_lock scopedLock(EncodeLock());
+				if (!_strReady.load(std::memory_order_relaxed)) {
+					if (_isValid)
+						_str = Base58::CheckEncode(_programHash.bytes());
+					_strReady.store(true, std::memory_order_release);
+				}
+			}
+
 			return _str;
 		}
 
@@ -84,8 +99,8 @@ namespace Elastos {
 
 		void Address::SetProgramHash(const uint168 &programHash) {
 			_programHash = programHash;
-			if (CheckValid())
-				_str = Base58::CheckEncode(_programHash.bytes());
+			CheckValid();
+			ResetString();
 		}
 
 		SignType Address::PrefixToSignType(Prefix prefix) const {
@@ -118,8 +133,8 @@ namespace Elastos {
 		void Address::SetRedeemScript(Prefix prefix, const bytes_t &code) {
 			_code = code;
 			GenerateProgramHash(prefix);
-			if (CheckValid())
-				_str = Base58::CheckEncode(_programHash.bytes());
+			CheckValid();
+			ResetString();
 			ErrorChecker::CheckCondition(!_isValid, Error::InvalidArgument, "redeemscript is invalid");
 		}
 
@@ -130,7 +145,7 @@ namespace Elastos {
 				ErrorChecker::ThrowLogicException(Error::Address, "can't change to or from multi-sign prefix");
 
 			GenerateProgramHash(prefix);
-			_str = Base58::CheckEncode(_programHash.bytes());
+			ResetString();
 			return true;
 		}
 
@@ -138,7 +153,7 @@ namespace Elastos {
 			if (!_code.empty() && _programHash.prefix() == PrefixIDChain) {
 				_code.back() = SignTypeDID;
 				GenerateProgramHash(PrefixIDChain);
-				_str = Base58::CheckEncode(_programHash.bytes());
+				ResetString();
 			}
 		}
 
@@ -155,7 +170,12 @@ namespace Elastos {
 			_programHash = address._programHash;
 			_code = address._code;
 			_isValid = address._isValid;
-			_str = address._str;
+			if (address._strReady.load(std::memory_order_acquire)) {
+				_str = address._str;
+				_strReady.store(true, std::memory_order_release);
+			} else {
+				ResetString();
+			}
 			return *this;
 		}
 
@@ -223,6 +243,11 @@ namespace Elastos {
 			}
 		}
 
+		void Address::ResetString() {
+			_str.clear();
+			_strReady.store(false, std::memory_order_release);
+		}
+
 		void Address::GenerateProgramHash(Prefix prefix) {
 			bytes_t hash = hash160(_code);
 			_programHash = uint168(prefix, hash);
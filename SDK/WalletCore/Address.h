@@ -8,6 +8,8 @@
 #include <Common/typedefs.h>
 #include <Common/uint256.h>
 
+#include <atomic>
+
 namespace Elastos {
 	namespace ElaWallet {
 
@@ -102,10 +104,13 @@ namespace Elastos {
 
 			bool CheckValid();
 
+			void ResetString();
+
 		private:
 			uint168 _programHash;
 			bytes_t _code;
-			std::string _str;
+			mutable std::string _str;
+			mutable std::atomic<bool> _strReady;
 			bool _isValid;
 		};
 
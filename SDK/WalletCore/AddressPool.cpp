@@ -0,0 +1,65 @@
+// Copyright (c) 2012-2019 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include "AddressPool.h"
+
+#include <boost/weak_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <map>
+
+#define ADDRESS_POOL_MIN_PRUNE 1024
+
+namespace Elastos {
+	namespace ElaWallet {
+
+		typedef std::map<uint168, boost::weak_ptr<Address> > AddressMap;
+
+		static boost::mutex _lock;
+		static AddressMap _pool;
+		static size_t _pruneThreshold = ADDRESS_POOL_MIN_PRUNE;
+
+		AddressPtr AddressPool::Get(const uint168 &programHash) {
+			boost::mutex::scoped_lock scopedLock(_lock);
+
+			AddressMap::iterator it = _pool.find(programHash);
+			if (it != _pool.end()) {
+				AddressPtr addr = it->second.lock();
+				if (addr)
+					return addr;
+			}
+
+			AddressPtr addr(new Address(programHash));
+			if (it != _pool.end()) {
+				it->second = addr;
+				return addr;
+			}
+
+			if (_pool.size() >= _pruneThreshold) {
+				// entries of addresses no output refers to any more
+				for (it = _pool.begin(); it != _pool.end();) {
+					if (it->second.expired())
+						_pool.erase(it++);
+					else
+						++it;
+				}
+				_pruneThreshold = _pool.size() * 2 > ADDRESS_POOL_MIN_PRUNE ? _pool.size() * 2 : ADDRESS_POOL_MIN_PRUNE;
+			}
+
+			_pool[programHash] = addr;
+			return addr;
+		}
+
+		const AddressPtr &AddressPool::Empty() {
+			static const AddressPtr empty(new Address());
+			return empty;
+		}
+
+		size_t AddressPool::Size() {
+			boost::mutex::scoped_lock scopedLock(_lock);
+			return _pool.size();
+		}
+
+	}
+}
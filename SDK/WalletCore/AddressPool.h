@@ -0,0 +1,31 @@
+// Copyright (c) 2012-2019 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef __ELASTOS_SDK_ADDRESSPOOL_H__
+#define __ELASTOS_SDK_ADDRESSPOOL_H__
+
+#include "Address.h"
+
+namespace Elastos {
+	namespace ElaWallet {
+
+		/*
+		 * Intern table of addresses keyed by program hash. Deserialized outputs share one Address per
+		 * distinct program hash instead of each owning a copy. Handles must be treated as immutable:
+		 * replace the pointer, never modify the pointee.
+		 */
+		class AddressPool {
+		public:
+			static AddressPtr Get(const uint168 &programHash);
+
+			// shared invalid address used by default-constructed outputs
+			static const AddressPtr &Empty();
+
+			static size_t Size();
+		};
+
+	}
+}
+
+#endif //__ELASTOS_SDK_ADDRESSPOOL_H__
@@ -54,10 +54,8 @@ namespace Elastos {
 				return false;
 			}
 
-			if (!istream.ReadByte(_flags)) {
-				Log::error("Bloom filter deserialize flags fail");
-				return false;
-			}
+			// Serialize() does not write the flags, a filterload without them keeps the flags we were constructed with
+			istream.ReadByte(_flags);
 
 			return true;
 		}
@@ -6,6 +6,7 @@
 
 #include <catch.hpp>
 #include <WalletCore/Address.h>
+#include <WalletCore/AddressPool.h>
 #include <WalletCore/HDKeychain.h>
 #include <WalletCore/BIP39.h>
 #include <Common/Log.h>
@@ -26,4 +27,24 @@ TEST_CASE("Address test", "[Address]") {
 
 		REQUIRE("Ed8ZSxSB98roeyuRZwwekrnRqcgnfiUDeQ" == Address(PrefixStandard, child.pubkey()).String());
 	}
+
+	SECTION("Address pool") {
+		Address addr("Ed8ZSxSB98roeyuRZwwekrnRqcgnfiUDeQ");
+		REQUIRE(addr.Valid());
+
+		AddressPtr a = AddressPool::Get(addr.ProgramHash());
+		AddressPtr b = AddressPool::Get(addr.ProgramHash());
+		REQUIRE(a.get() == b.get());
+		REQUIRE(*a == addr);
+		REQUIRE(a->String() == "Ed8ZSxSB98roeyuRZwwekrnRqcgnfiUDeQ");
+
+		Address copy(*a);
+		REQUIRE(copy.String() == addr.String());
+		copy.ChangePrefix(PrefixDeposit);
+		REQUIRE(copy.String() != addr.String());
+		REQUIRE(a->String() == addr.String());
+
+		REQUIRE(!AddressPool::Empty()->Valid());
+		REQUIRE(AddressPool::Empty()->String().empty());
+	}
 }
\ No newline at end of file
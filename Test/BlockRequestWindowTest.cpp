@@ -0,0 +1,117 @@
+// Copyright (c) 2012-2019 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#define CATCH_CONFIG_MAIN
+
+#include <catch.hpp>
+#include "TestHelper.h"
+
+#include <Common/Log.h>
+#include <P2P/BlockRequestWindow.h>
+
+#include <cfloat>
+
+using namespace Elastos::ElaWallet;
+
+static std::vector<uint256> makeInventory(size_t count) {
+	std::vector<uint256> hashes;
+	for (size_t i = 0; i < count; ++i)
+		hashes.push_back(getRanduint256());
+	return hashes;
+}
+
+TEST_CASE("Block request window test", "[BlockRequestWindow]") {
+	Log::registerMultiLogger();
+
+	SECTION("window and deferral") {
+		BlockRequestWindow window;
+		std::vector<std::vector<uint256> > invs;
+		for (int i = 0; i < 4; ++i)
+			invs.push_back(makeInventory(3));
+
+		REQUIRE(window.Window() == 2);
+		REQUIRE(window.Request(invs[0]));
+		window.BatchSent(invs[0].back(), 0);
+		REQUIRE(window.Request(invs[1]));
+		window.BatchSent(invs[1].back(), 0);
+		REQUIRE(!window.Request(invs[2]));
+		REQUIRE(!window.Request(invs[3]));
+		REQUIRE(window.Batches() == 2);
+		REQUIRE(window.Deferred() == 2);
+
+		// a block that is not the last of the batch completes nothing
+		std::vector<std::vector<uint256> > released;
+		REQUIRE(!window.Received(invs[0][0], 100, 1.0, 0.5, released));
+		REQUIRE(released.empty());
+
+		// streamed in 1s with a 0.5s round trip, a window of two covers it
+		REQUIRE(window.Received(invs[0].back(), 100, 2.0, 0.5, released));
+		REQUIRE(window.Window() == 2);
+		REQUIRE(released.size() == 1);
+		REQUIRE(released[0] == invs[2]);
+		REQUIRE(window.Deferred() == 1);
+
+		// deferred inventories keep their order, a new one queues behind them
+		std::vector<uint256> late = makeInventory(1);
+		window.BatchSent(invs[2].back(), 2.0);
+		REQUIRE(!window.Request(late));
+		released.clear();
+		REQUIRE(!window.Received(invs[1][0], 100, 3.0, 0.5, released));
+		REQUIRE(window.Received(invs[1].back(), 100, 3.1, 0.5, released));
+		REQUIRE(window.Window() == MAX_SYNC_WINDOW);
+		REQUIRE(released.size() == 2);
+		REQUIRE(released[0] == invs[3]);
+		REQUIRE(released[1] == late);
+		REQUIRE(window.Deferred() == 0);
+	}
+
+	SECTION("window follows the round trip") {
+		BlockRequestWindow window;
+		std::vector<uint256> inv = makeInventory(2);
+		std::vector<std::vector<uint256> > released;
+
+		REQUIRE(window.LastRate() == 0);
+		window.BatchSent(inv.back(), 0);
+		REQUIRE(!window.Received(inv[0], 100, 1.0, 10.0, released));
+		REQUIRE(window.Received(inv.back(), 100, 1.1, 10.0, released));
+		REQUIRE(window.Window() == MAX_SYNC_WINDOW);
+		REQUIRE(window.LastRate() == Approx(2000));
+
+		// unknown ping time, the first block's delay stands in for the round trip
+		window.BatchSent(inv.back(), 2.0);
+		REQUIRE(!window.Received(inv[0], 100, 2.5, DBL_MAX, released));
+		REQUIRE(window.Received(inv.back(), 100, 3.5, DBL_MAX, released));
+		REQUIRE(window.Window() == 2);
+		REQUIRE(!window.Waiting());
+	}
+
+	SECTION("stalled batch times out") {
+		BlockRequestWindow window;
+		std::vector<uint256> inv = makeInventory(2);
+		std::vector<std::vector<uint256> > released;
+		double now = 0;
+
+		REQUIRE(window.Check(now) == BlockRequestWindow::Progressing);
+		window.BatchSent(inv.back(), now);
+		REQUIRE(window.Check(now + STALL_TIMEOUT / 2) == BlockRequestWindow::Progressing);
+
+		for (int i = 1; i < MAX_BATCH_STALLS; ++i) {
+			now += STALL_TIMEOUT;
+			REQUIRE(window.Check(now) == BlockRequestWindow::Stalled);
+		}
+
+		// progress starts the count over
+		REQUIRE(!window.Received(inv[0], 100, now, 0.1, released));
+		for (int i = 1; i < MAX_BATCH_STALLS; ++i) {
+			now += STALL_TIMEOUT;
+			REQUIRE(window.Check(now) == BlockRequestWindow::Stalled);
+		}
+		now += STALL_TIMEOUT;
+		REQUIRE(window.Check(now) == BlockRequestWindow::TimedOut);
+
+		window.Clear();
+		REQUIRE(!window.Waiting());
+		REQUIRE(window.Check(now + STALL_TIMEOUT) == BlockRequestWindow::Progressing);
+	}
+}
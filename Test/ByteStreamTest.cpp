@@ -0,0 +1,75 @@
+// Copyright (c) 2012-2019 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#define CATCH_CONFIG_MAIN
+
+#include <catch.hpp>
+#include "TestHelper.h"
+
+#include <Common/ByteStream.h>
+#include <Common/Log.h>
+#include <Plugin/Transaction/Transaction.h>
+
+using namespace Elastos::ElaWallet;
+
+TEST_CASE("ByteStream test", "[ByteStream]") {
+	Log::registerMultiLogger();
+
+	SECTION("varuint size") {
+		uint64_t values[] = {0, 0xFC, 0xFD, 0xFFFF, 0x10000, 0xFFFFFFFF, 0x100000000};
+
+		for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); ++i) {
+			ByteStream stream;
+			REQUIRE(stream.WriteVarUint(values[i]) == ByteStream::VarUintSize(values[i]));
+			REQUIRE(stream.size() == ByteStream::VarUintSize(values[i]));
+
+			uint64_t v = 0;
+			REQUIRE(stream.ReadVarUint(v));
+			REQUIRE(v == values[i]);
+		}
+	}
+
+	SECTION("view reads the caller's memory") {
+		ByteStream stream;
+		stream.WriteUint32(0x12345678);
+		stream.WriteVarString("view");
+		stream.WriteBytes(getRanduint256());
+		const bytes_t &bytes = stream.GetBytes();
+
+		ByteStream view = ByteStream::View(bytes.data(), bytes.size());
+		REQUIRE(view.size() == bytes.size());
+		REQUIRE(view.Data() == bytes.data());
+
+		uint32_t u32 = 0;
+		std::string str;
+		uint256 hash;
+		REQUIRE(view.ReadUint32(u32));
+		REQUIRE(view.ReadVarString(str));
+		REQUIRE(view.ReadBytes(hash));
+		REQUIRE(u32 == 0x12345678);
+		REQUIRE(str == "view");
+		uint8_t byte = 0;
+		REQUIRE(!view.ReadByte(byte));
+
+		REQUIRE(bytes_t(view.Data(), view.Data() + view.size()) == bytes);
+		REQUIRE_THROWS(view.GetBytes());
+	}
+
+	SECTION("transaction from view") {
+		for (int extend = 0; extend < 2; ++extend) {
+			Transaction tx1, tx2;
+			initTransaction(tx1, Transaction::TxVersion::V09);
+
+			ByteStream stream;
+			tx1.Serialize(stream, extend != 0);
+			const bytes_t &bytes = stream.GetBytes();
+
+			ByteStream view = ByteStream::View(bytes.data(), bytes.size());
+			REQUIRE(tx2.Deserialize(view, extend != 0));
+			REQUIRE(view.Position() == bytes.size());
+			REQUIRE(tx2.GetHash() == tx1.GetHash());
+			verifyTransaction(tx1, tx2, false);
+		}
+	}
+}
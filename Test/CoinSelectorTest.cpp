@@ -0,0 +1,102 @@
+// Copyright (c) 2012-2019 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#define CATCH_CONFIG_MAIN
+
+#include <catch.hpp>
+#include "TestHelper.h"
+
+#include <Common/Log.h>
+#include <Wallet/CoinSelector.h>
+#include <WalletCore/Address.h>
+
+using namespace Elastos::ElaWallet;
+
+static UTXOArray makeCandidates(const std::vector<uint64_t> &amounts) {
+	UTXOArray utxos;
+	Address addr(uint168(getRandBytes(21)));
+
+	for (size_t i = 0; i < amounts.size(); ++i) {
+		OutputPtr o(new TransactionOutput(BigInt(amounts[i]), addr));
+		utxos.push_back(UTXOPtr(new UTXO(getRanduint256(), (uint16_t) i, 0, 0, o)));
+	}
+
+	std::sort(utxos.begin(), utxos.end(), UTXOAmountCompare());
+	return utxos;
+}
+
+static BigInt sum(const UTXOArray &utxos) {
+	BigInt total(0);
+	for (size_t i = 0; i < utxos.size(); ++i)
+		total += utxos[i]->Output()->Amount();
+	return total;
+}
+
+static CoinSelector::Params makeParams(uint64_t amount, uint64_t feePerKB) {
+	CoinSelector::Params params;
+	params.amount = amount;
+	params.feePerKB = feePerKB;
+	params.baseSize = 200;
+	params.inputSize = 140;
+	params.maxSize = 1000 * 1000;
+	if (feePerKB != 0)
+		params.changeCost = (200 * feePerKB + 999) / 1000;
+	return params;
+}
+
+TEST_CASE("Coin selector test", "[CoinSelector]") {
+	Log::registerMultiLogger();
+
+	SECTION("largest first") {
+		UTXOArray candidates = makeCandidates({100, 50000, 3000, 70000, 20, 900000});
+		CoinSelector::Params params = makeParams(100000, 0);
+		CoinSelector::Result result;
+
+		REQUIRE(LargestFirstCoinSelector().Select(candidates, params, result));
+		REQUIRE(result.utxos.front()->Output()->Amount() == BigInt(900000));
+		REQUIRE(sum(result.utxos) >= params.Target(result.utxos.size()));
+		REQUIRE(!result.changeless);
+
+		params.amount = 2000000;
+		REQUIRE(!LargestFirstCoinSelector().Select(candidates, params, result));
+		REQUIRE(result.utxos.size() == candidates.size());
+	}
+
+	SECTION("min input") {
+		UTXOArray candidates = makeCandidates({900000, 600000, 500000, 300000, 120000, 110000, 5000});
+		CoinSelector::Params params = makeParams(1000000, 0);
+		CoinSelector::Result result;
+
+		// two coins are needed; the second one is the smallest that still covers the target
+		REQUIRE(MinInputCoinSelector().Select(candidates, params, result));
+		REQUIRE(result.utxos.size() == 2);
+		REQUIRE(result.utxos[0]->Output()->Amount() == BigInt(900000));
+		REQUIRE(result.utxos[1]->Output()->Amount() == BigInt(110000));
+
+		params.amount = 10000000;
+		REQUIRE(!MinInputCoinSelector().Select(candidates, params, result));
+	}
+
+	SECTION("branch and bound") {
+		UTXOArray candidates = makeCandidates({700000, 500000, 400000, 300000, 200000, 100000});
+		CoinSelector::Params params = makeParams(600000, 0);
+		CoinSelector::Result result;
+
+		REQUIRE(BranchAndBoundCoinSelector().Select(candidates, params, result));
+		REQUIRE(result.changeless);
+		REQUIRE(sum(result.utxos) == BigInt(600000));
+
+		// with a fee rate the conservative target still covers the real fee
+		params = makeParams(600000, 10000);
+		REQUIRE(BranchAndBoundCoinSelector().Select(candidates, params, result));
+		REQUIRE(sum(result.utxos) >= params.Target(result.utxos.size()));
+
+		// no exact match, falls back to largest first
+		candidates = makeCandidates({1000000, 1000000});
+		params = makeParams(600000, 0);
+		REQUIRE(BranchAndBoundCoinSelector().Select(candidates, params, result));
+		REQUIRE(!result.changeless);
+		REQUIRE(sum(result.utxos) >= params.Target(result.utxos.size()));
+	}
+}
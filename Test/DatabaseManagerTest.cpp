@@ -197,6 +197,9 @@ TEST_CASE("DatabaseManager test", "[DatabaseManager]") {
 				peer.address = getRandUInt128();
 				peer.port = (uint16_t) rand();
 				peer.timeStamp = (uint64_t) rand();
+				peer.lastSuccess = (uint64_t) rand();
+				peer.latency = (uint32_t) rand() % 5000;
+				peer.failures = (uint32_t) rand() % 10;
 				peerToSave.push_back(peer);
 			}
 
@@ -216,7 +219,18 @@ TEST_CASE("DatabaseManager test", "[DatabaseManager]") {
 				REQUIRE(peers[i].address == peerToSave[i].address);
 				REQUIRE(peers[i].port == peerToSave[i].port);
 				REQUIRE(peers[i].timeStamp == peerToSave[i].timeStamp);
+				REQUIRE(peers[i].lastSuccess == peerToSave[i].lastSuccess);
+				REQUIRE(peers[i].latency == peerToSave[i].latency);
+				REQUIRE(peers[i].failures == peerToSave[i].failures);
 			}
+
+			peers[0].failures++;
+			REQUIRE(dbm.PutPeer(peers[0]));
+			std::vector<PeerEntity> updated = dbm.GetAllPeers();
+			REQUIRE(updated.size() == peers.size());
+			REQUIRE(updated[0].failures == peers[0].failures);
+			peers[0].failures--;
+			REQUIRE(dbm.PutPeer(peers[0]));
 		}
 
 		SECTION("Peer delete test") {
@@ -420,6 +434,29 @@ TEST_CASE("DatabaseManager test", "[DatabaseManager]") {
 			}
 		}
 
+		SECTION("Transaction keyset page test") {
+			DatabaseManager dbm(DBFILE);
+			std::vector<TransactionPtr> pages;
+			uint64_t height = UINT32_MAX;
+			uint256 hash;
+
+			for (;;) {
+				std::vector<TransactionPtr> page = dbm.GetNormalTxnsBefore(CHAINID_MAINCHAIN, height, hash.GetHex(), 7);
+				REQUIRE(page.size() <= 7);
+				if (page.empty())
+					break;
+				pages.insert(pages.end(), page.begin(), page.end());
+				height = page.back()->GetBlockHeight();
+				hash = page.back()->GetHash();
+			}
+
+			REQUIRE(TEST_TX_RECORD_CNT == pages.size());
+			for (int i = 1; i < pages.size(); ++i) {
+				REQUIRE(pages[i]->GetBlockHeight() == pages[i - 1]->GetBlockHeight());
+				REQUIRE(pages[i]->GetHash() < pages[i - 1]->GetHash());
+			}
+		}
+
 		SECTION("Transaction delete by txHash test") {
 			DatabaseManager dbm(DBFILE);
 
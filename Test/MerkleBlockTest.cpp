@@ -45,4 +45,29 @@ TEST_CASE("MerkleBlock construct test", "[MerkleBlock]") {
 
 		verifyELAMerkleBlock(static_cast<const MerkleBlock &>(*merkleBlock), mb);
 	}
+
+	SECTION("discard aux pow") {
+		MerkleBlockPtr merkleBlock = Registry::Instance()->CreateMerkleBlock("ELA");
+		setMerkleBlockValues(static_cast<MerkleBlock *>(merkleBlock.get()));
+		uint256 hash = merkleBlock->GetHash();
+		std::vector<uint256> txHashes;
+		merkleBlock->MerkleBlockTxHashes(txHashes);
+		size_t size = merkleBlock->SerializedSize(MERKLEBLOCK_VERSION_1);
+
+		merkleBlock->DiscardAuxPow();
+		REQUIRE(merkleBlock->SerializedSize(MERKLEBLOCK_VERSION_1) < size);
+
+		ByteStream stream;
+		merkleBlock->Serialize(stream, MERKLEBLOCK_VERSION_1);
+		REQUIRE(stream.size() == merkleBlock->SerializedSize(MERKLEBLOCK_VERSION_1));
+
+		MerkleBlock mb;
+		REQUIRE(mb.Deserialize(stream, MERKLEBLOCK_VERSION_1));
+		REQUIRE(mb.GetHash() == hash);
+		REQUIRE(mb.GetHeight() == merkleBlock->GetHeight());
+
+		std::vector<uint256> compactTxHashes;
+		mb.MerkleBlockTxHashes(compactTxHashes);
+		REQUIRE(compactTxHashes == txHashes);
+	}
 }
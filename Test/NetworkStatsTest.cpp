@@ -0,0 +1,80 @@
+// Copyright (c) 2012-2019 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#define CATCH_CONFIG_MAIN
+
+#include <catch.hpp>
+
+#include <Common/Log.h>
+#include <P2P/NetworkStats.h>
+
+using namespace Elastos::ElaWallet;
+
+TEST_CASE("Network stats test", "[NetworkStats]") {
+	Log::registerMultiLogger();
+
+	SECTION("counters and histogram") {
+		NetworkStats stats;
+
+		stats.Record(NetworkStats::Inbound, "tx", 100, 0.0005);
+		stats.Record(NetworkStats::Inbound, "tx", 200, 0.02);
+		stats.Record(NetworkStats::Inbound, "tx", 300, 60);
+		stats.Record(NetworkStats::Outbound, "inv", 50, 0);
+
+		NetworkStats::CounterMap in = stats.GetCounters(NetworkStats::Inbound);
+		REQUIRE(in.size() == 1);
+		REQUIRE(in["tx"].count == 3);
+		REQUIRE(in["tx"].bytes == 600);
+		REQUIRE(in["tx"].buckets[0] == 1);
+		REQUIRE(in["tx"].buckets[3] == 1);
+		REQUIRE(in["tx"].buckets[NETWORK_STATS_BUCKETS - 1] == 1);
+
+		NetworkStats::CounterMap out = stats.GetCounters(NetworkStats::Outbound);
+		REQUIRE(out.size() == 1);
+		REQUIRE(out["inv"].count == 1);
+		REQUIRE(out["inv"].buckets[0] == 1);
+
+		NetworkStats total;
+		total.Merge(stats);
+		total.Merge(stats);
+		REQUIRE(total.GetCounters(NetworkStats::Inbound)["tx"].count == 6);
+		REQUIRE(total.GetCounters(NetworkStats::Outbound)["inv"].bytes == 100);
+
+		nlohmann::json j = stats.ToJson();
+		REQUIRE(j["Inbound"]["tx"]["Count"] == 3);
+		REQUIRE(j["Inbound"]["tx"]["Buckets"].size() == NETWORK_STATS_BUCKETS);
+		REQUIRE(j["Outbound"]["inv"]["Bytes"] == 50);
+
+		stats.Clear();
+		REQUIRE(stats.GetCounters(NetworkStats::Inbound).empty());
+	}
+
+	SECTION("text exposition") {
+		NetworkStats stats;
+		stats.Record(NetworkStats::Inbound, "merkleblock", 300, 0.002);
+		stats.Record(NetworkStats::Inbound, "merkleblock", 300, 0.2);
+
+		nlohmann::json j;
+		j["ConnectedPeers"] = 2;
+		j["SecondsSinceLastBlock"] = nlohmann::json();
+		j["Orphans"]["Count"] = 4;
+		j["Peers"] = nlohmann::json::array();
+		j["Peers"].push_back({{"Host", "127.0.0.1"}, {"Port", 20866}, {"DownloadPeer", true}, {"SendQueueBytes", 0}});
+		j["Messages"] = stats.ToJson();
+
+		std::string text = NetworkStats::ToText(j, "chain=\"ELA\"");
+		REQUIRE(text.find("spv_connected_peers{chain=\"ELA\"} 2\n") != std::string::npos);
+		REQUIRE(text.find("spv_seconds_since_last_block") == std::string::npos);
+		REQUIRE(text.find("spv_orphan_blocks{chain=\"ELA\"} 4\n") != std::string::npos);
+		REQUIRE(text.find("spv_peer_download_peer{chain=\"ELA\",peer=\"127.0.0.1:20866\"} 1\n") != std::string::npos);
+		REQUIRE(text.find("spv_messages_total{chain=\"ELA\",direction=\"in\",type=\"merkleblock\"} 2\n") != std::string::npos);
+		REQUIRE(text.find("spv_message_latency_seconds_bucket{chain=\"ELA\",direction=\"in\",type=\"merkleblock\",le=\"0.001\"} 0\n") != std::string::npos);
+		REQUIRE(text.find("spv_message_latency_seconds_bucket{chain=\"ELA\",direction=\"in\",type=\"merkleblock\",le=\"0.005\"} 1\n") != std::string::npos);
+		REQUIRE(text.find("spv_message_latency_seconds_bucket{chain=\"ELA\",direction=\"in\",type=\"merkleblock\",le=\"+Inf\"} 2\n") != std::string::npos);
+
+		text = NetworkStats::ToText(j, "");
+		REQUIRE(text.find("spv_connected_peers{} 2\n") != std::string::npos);
+		REQUIRE(text.find("spv_messages_total{direction=\"in\",type=\"merkleblock\"} 2\n") != std::string::npos);
+	}
+}
@@ -0,0 +1,132 @@
+// Copyright (c) 2012-2019 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#define CATCH_CONFIG_MAIN
+
+#include <catch.hpp>
+#include "TestHelper.h"
+
+#include <Common/Log.h>
+#include <P2P/OrphanPool.h>
+#include <Plugin/Block/MerkleBlock.h>
+
+using namespace Elastos::ElaWallet;
+
+static MerkleBlockPtr makeBlock(const uint256 &prevHash) {
+	MerkleBlockPtr block(new MerkleBlock());
+	setMerkleBlockValues(static_cast<MerkleBlock *>(block.get()));
+	block->SetPrevBlockHash(prevHash);
+	return block;
+}
+
+TEST_CASE("Orphan pool test", "[OrphanPool]") {
+	Log::registerMultiLogger();
+
+	SECTION("index by prev hash") {
+		OrphanPool pool;
+		std::vector<MerkleBlockPtr> chain;
+		uint256 prevHash = getRanduint256();
+		for (int i = 0; i < 10; ++i) {
+			chain.push_back(makeBlock(prevHash));
+			prevHash = chain.back()->GetHash();
+		}
+
+		for (size_t i = chain.size(); i > 0; --i)
+			REQUIRE(pool.Insert(chain[i - 1]));
+		REQUIRE(!pool.Insert(chain[0]));
+		REQUIRE(pool.Size() == chain.size());
+
+		MerkleBlockPtr next = pool.GetMatchPrevHash(chain[0]->GetPrevBlockHash());
+		for (size_t i = 0; i < chain.size(); ++i) {
+			REQUIRE(next == chain[i]);
+			REQUIRE(pool.Remove(next));
+			REQUIRE(!pool.Contains(next));
+			next = pool.GetMatchPrevHash(next->GetHash());
+		}
+		REQUIRE(next == nullptr);
+		REQUIRE(pool.Size() == 0);
+		REQUIRE(pool.Bytes() == 0);
+		REQUIRE(pool.Evictions() == 0);
+	}
+
+	SECTION("byte budget") {
+		MerkleBlockPtr first = makeBlock(getRanduint256());
+		size_t bytes = first->SerializedSize(MERKLEBLOCK_VERSION_1);
+		OrphanPool pool(bytes * 4, 0);
+
+		REQUIRE(pool.Insert(first));
+		for (int i = 0; i < 20; ++i) {
+			pool.Insert(makeBlock(getRanduint256()));
+			REQUIRE(pool.Bytes() <= bytes * 4);
+		}
+		REQUIRE(!pool.Contains(first));
+		REQUIRE(pool.Evictions() > 0);
+		REQUIRE(pool.GetStats().count == pool.Size());
+	}
+
+	SECTION("per peer quota") {
+		OrphanPool pool(ORPHAN_POOL_MAX_BYTES, 3);
+		const Peer *a = reinterpret_cast<const Peer *>(0x1), *b = reinterpret_cast<const Peer *>(0x2);
+
+		MerkleBlockPtr fromB = makeBlock(getRanduint256());
+		REQUIRE(pool.Insert(fromB, b));
+
+		std::vector<MerkleBlockPtr> fromA;
+		for (int i = 0; i < 5; ++i) {
+			fromA.push_back(makeBlock(getRanduint256()));
+			REQUIRE(pool.Insert(fromA.back(), a));
+		}
+
+		// a only evicts its own oldest orphans
+		REQUIRE(pool.Size() == 4);
+		REQUIRE(pool.Evictions() == 2);
+		REQUIRE(pool.Contains(fromB));
+		REQUIRE(!pool.Contains(fromA[0]));
+		REQUIRE(!pool.Contains(fromA[1]));
+		REQUIRE(pool.Contains(fromA[4]));
+
+		pool.Clear();
+		REQUIRE(pool.Size() == 0);
+		REQUIRE(pool.Bytes() == 0);
+	}
+
+	SECTION("quota of one") {
+		OrphanPool pool(ORPHAN_POOL_MAX_BYTES, 1);
+		const Peer *a = reinterpret_cast<const Peer *>(0x1);
+
+		MerkleBlockPtr last;
+		for (int i = 0; i < 5; ++i) {
+			last = makeBlock(getRanduint256());
+			REQUIRE(pool.Insert(last, a));
+			REQUIRE(pool.Size() == 1);
+		}
+		REQUIRE(pool.Contains(last));
+		REQUIRE(pool.Evictions() == 4);
+	}
+
+	SECTION("disconnected peer") {
+		OrphanPool pool(ORPHAN_POOL_MAX_BYTES, 2);
+		const Peer *a = reinterpret_cast<const Peer *>(0x1);
+
+		std::vector<MerkleBlockPtr> blocks;
+		for (int i = 0; i < 2; ++i) {
+			blocks.push_back(makeBlock(getRanduint256()));
+			REQUIRE(pool.Insert(blocks.back(), a));
+		}
+
+		// a new peer at the same address starts with a fresh quota, the old orphans stay
+		pool.RemoveSource(a);
+		for (int i = 0; i < 2; ++i) {
+			blocks.push_back(makeBlock(getRanduint256()));
+			REQUIRE(pool.Insert(blocks.back(), a));
+		}
+		REQUIRE(pool.Size() == 4);
+		REQUIRE(pool.Evictions() == 0);
+
+		for (size_t i = 0; i < blocks.size(); ++i)
+			REQUIRE(pool.Remove(blocks[i]));
+		REQUIRE(pool.Size() == 0);
+		REQUIRE(pool.Bytes() == 0);
+	}
+}
@@ -0,0 +1,82 @@
+// Copyright (c) 2012-2019 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#define CATCH_CONFIG_MAIN
+
+#include <catch.hpp>
+
+#include <Common/Log.h>
+#include <P2P/PeerCapture.h>
+
+#include <boost/filesystem.hpp>
+
+using namespace Elastos::ElaWallet;
+
+TEST_CASE("Peer capture test", "[PeerCapture]") {
+	Log::registerMultiLogger();
+	std::string path = "PeerCaptureTest.cap";
+
+	SECTION("record and read back") {
+		PeerCapture capture;
+		REQUIRE(capture.Create(path, 0x1234abcd));
+
+		uint32_t p1 = capture.AddPeer();
+		uint32_t p2 = capture.AddPeer();
+		REQUIRE(p1 != p2);
+
+		capture.Record(p1, "version", bytes_t("0102"));
+		capture.Record(p2, "merkleblock", bytes_t("aabbcc"));
+		capture.Record(p2, "tx", bytes_t());
+		capture.Record(p2, "merkleblock", bytes_t("ddeeff"));
+		capture.Record(p1, "merkleblock", bytes_t("00"));
+		REQUIRE(capture.FramesRecorded() == 5);
+		capture.Close();
+
+		PeerCapture replay;
+		REQUIRE(replay.Open(path));
+		REQUIRE(replay.GetMagicNumber() == 0x1234abcd);
+
+		std::map<uint32_t, size_t> blocks = replay.CountFrames("merkleblock");
+		REQUIRE(blocks[p1] == 1);
+		REQUIRE(blocks[p2] == 2);
+		REQUIRE(replay.BusiestPeer("merkleblock") == p2);
+
+		PeerCapture::Frame frame;
+		double lastTime = 0;
+		REQUIRE(replay.Read(p2, frame));
+		REQUIRE(frame.type == "merkleblock");
+		REQUIRE(frame.payload == bytes_t("aabbcc"));
+		REQUIRE(frame.time >= lastTime);
+		lastTime = frame.time;
+
+		REQUIRE(replay.Read(p2, frame));
+		REQUIRE(frame.type == "tx");
+		REQUIRE(frame.payload.empty());
+		REQUIRE(frame.time >= lastTime);
+
+		REQUIRE(replay.Read(p2, frame));
+		REQUIRE(frame.payload == bytes_t("ddeeff"));
+		REQUIRE(!replay.Read(p2, frame));
+		replay.Close();
+
+		REQUIRE(replay.Open(path));
+		size_t count = 0;
+		while (replay.Read(frame))
+			count++;
+		REQUIRE(count == 5);
+		replay.Close();
+	}
+
+	SECTION("reject other files") {
+		PeerCapture capture;
+		REQUIRE(!capture.Open("PeerCaptureTest.missing"));
+
+		std::ofstream bad(path.c_str(), std::ios::binary | std::ios::trunc);
+		bad << "not a capture";
+		bad.close();
+		REQUIRE(!capture.Open(path));
+	}
+
+	boost::filesystem::remove(path);
+}
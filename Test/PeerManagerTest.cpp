@@ -0,0 +1,131 @@
+// Copyright (c) 2012-2019 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#define CATCH_CONFIG_MAIN
+
+#include <catch.hpp>
+#include "TestHelper.h"
+
+#include <Common/Log.h>
+#include <P2P/PeerManager.h>
+#include <Implement/SubWallet.h>
+#include <SpvService/SpvService.h>
+#include <MasterWalletManager.h>
+#include <IMasterWallet.h>
+
+#include <unistd.h>
+#include <boost/filesystem.hpp>
+
+using namespace Elastos::ElaWallet;
+
+static const std::string __rootPath = "./";
+static const std::string __masterWalletID = "PeerManagerTest";
+
+class TestMasterWalletManager : public MasterWalletManager {
+public:
+	TestMasterWalletManager() :
+		MasterWalletManager(MasterWalletMap(), __rootPath, __rootPath) {
+		_p2pEnable = false;
+	}
+};
+
+static Peer::Stats makeStats(uint32_t lastBlock, double pingTime, double downloadRate, uint32_t stalls = 0) {
+	Peer::Stats stats;
+	stats.port = 0;
+	stats.lastBlock = lastBlock;
+	stats.pingTime = pingTime;
+	stats.downloadRate = downloadRate;
+	stats.downloadBytes = 0;
+	stats.stalls = stalls;
+	stats.misbehavior = 0;
+	stats.sendQueueBytes = 0;
+	stats.downloadPeer = false;
+	return stats;
+}
+
+TEST_CASE("Download peer swap", "[PeerManager]") {
+	Log::registerMultiLogger();
+
+	SECTION("stalls") {
+		Peer::Stats download = makeStats(1000, 0.1, 0, 3);
+		REQUIRE(PeerManager::JudgeDownloadPeer(download, {}) == PeerManager::DownloadPeerStalled);
+	}
+
+	SECTION("unmeasured download peer is kept") {
+		Peer::Stats download = makeStats(1000, 0.1, 0);
+		REQUIRE(PeerManager::JudgeDownloadPeer(download, {makeStats(1000, 0.01, 1e7)}) ==
+				PeerManager::KeepDownloadPeer);
+	}
+
+	SECTION("unmeasured peers are not compared") {
+		// far below the default rate assumed for peers never measured
+		Peer::Stats download = makeStats(1000, 0.1, 1024);
+		REQUIRE(PeerManager::JudgeDownloadPeer(download, {makeStats(1000, 0.01, 0), makeStats(1000, 0.01, 0)}) ==
+				PeerManager::KeepDownloadPeer);
+	}
+
+	SECTION("measured faster peer") {
+		Peer::Stats download = makeStats(1000, 0.1, 1024);
+		REQUIRE(PeerManager::JudgeDownloadPeer(download, {makeStats(1000, 0.1, 1e6)}) ==
+				PeerManager::DownloadPeerSlow);
+
+		// behind the download peer's chain
+		REQUIRE(PeerManager::JudgeDownloadPeer(download, {makeStats(999, 0.1, 1e6)}) ==
+				PeerManager::KeepDownloadPeer);
+
+		// within the hysteresis
+		REQUIRE(PeerManager::JudgeDownloadPeer(download, {makeStats(1000, 0.1, 1536)}) ==
+				PeerManager::KeepDownloadPeer);
+	}
+}
+
+TEST_CASE("Download peer probe", "[PeerManager]") {
+	boost::filesystem::remove_all(boost::filesystem::path(__rootPath + __masterWalletID));
+	TestMasterWalletManager manager;
+	IMasterWallet *masterWallet = manager.ImportWalletWithMnemonic(__masterWalletID,
+		"abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon about",
+		"", "payPassword", false);
+	SubWallet *subWallet = dynamic_cast<SubWallet *>(masterWallet->CreateSubWallet(CHAINID_MAINCHAIN));
+	REQUIRE(subWallet != nullptr);
+
+	PeerManager *peerManager = subWallet->GetWalletManager()->GetPeerManager().get();
+	PeerPtr download(new Peer(peerManager, peerManager->GetMagicNumber()));
+	PeerPtr candidate(new Peer(peerManager, peerManager->GetMagicNumber()));
+	download->InitDefaultMessages();
+	candidate->InitDefaultMessages();
+
+	// the download peer streams a batch at a few kB/s
+	std::vector<uint256> inv;
+	for (size_t i = 0; i < 2; ++i)
+		inv.push_back(getRanduint256());
+	download->RequestBlocks(inv);
+	REQUIRE(download->WaitingBlocks());
+	REQUIRE(!download->BlockReceived(inv[0], 500));
+	usleep(200000);
+	REQUIRE(!download->BlockReceived(inv[1], 500));
+	REQUIRE(!download->WaitingBlocks());
+	REQUIRE(download->GetStats().downloadRate > 0);
+
+	// a peer that never downloaded can't show it is slow
+	REQUIRE(PeerManager::JudgeDownloadPeer(download->GetStats(), {candidate->GetStats()}) ==
+			PeerManager::KeepDownloadPeer);
+
+	std::vector<uint256> probe;
+	for (size_t i = 0; i < 3; ++i)
+		probe.push_back(getRanduint256());
+	candidate->ProbeDownload(probe);
+	REQUIRE(candidate->WaitingBlocks());
+	for (size_t i = 0; i < probe.size(); ++i)
+		REQUIRE(candidate->BlockReceived(probe[i], 500));
+	REQUIRE(!candidate->WaitingBlocks());
+	REQUIRE(candidate->GetStats().downloadRate > download->GetStats().downloadRate);
+
+	REQUIRE(PeerManager::JudgeDownloadPeer(download->GetStats(), {candidate->GetStats()}) ==
+			PeerManager::DownloadPeerSlow);
+
+	// a probe block counts once, later copies of it are blocks like any other
+	REQUIRE(!candidate->BlockReceived(probe[0], 500));
+
+	manager.DestroyWallet(__masterWalletID);
+}
@@ -0,0 +1,105 @@
+// Copyright (c) 2012-2019 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#define CATCH_CONFIG_MAIN
+
+#include <catch.hpp>
+#include "TestHelper.h"
+
+#include <Common/Log.h>
+#include <Implement/PublishProgress.h>
+
+using namespace Elastos::ElaWallet;
+
+static nlohmann::json makeResult(int code) {
+	nlohmann::json result;
+	result["Code"] = code;
+	result["Reason"] = code == 0 ? "" : "rejected";
+	return result;
+}
+
+TEST_CASE("Publish progress test", "[PublishProgress]") {
+	Log::registerMultiLogger();
+
+	SECTION("a burst is reported in batches") {
+		PublishProgress progress;
+		std::vector<std::string> hashes;
+		size_t total = 2 * PUBLISH_REPORT_COUNT + 10;
+		time_t now = 1000;
+
+		for (size_t i = 0; i < total; ++i) {
+			hashes.push_back(getRanduint256().GetHex());
+			progress.Add(hashes.back(), now);
+		}
+		REQUIRE(progress.Pending() == total);
+
+		std::vector<nlohmann::json> reports;
+		nlohmann::json report;
+		for (size_t i = 0; i < total; ++i) {
+			REQUIRE(progress.Result(hashes[i], makeResult(i == 5 ? 1 : 0), now, report));
+			if (!report.is_null())
+				reports.push_back(report);
+		}
+
+		REQUIRE(reports.size() == 3);
+		REQUIRE(reports[0]["Results"].size() == PUBLISH_REPORT_COUNT);
+		REQUIRE(reports[0]["Results"][5]["TxHash"] == hashes[5]);
+		REQUIRE(reports[0]["Results"][5]["Result"]["Code"] == 1);
+		REQUIRE(reports[0]["Done"] == PUBLISH_REPORT_COUNT);
+		REQUIRE(reports[0]["Failed"] == 1);
+		REQUIRE(!reports[0].contains("FailedTxHashes"));
+		REQUIRE(reports[1]["Done"] == 2 * PUBLISH_REPORT_COUNT);
+
+		// the last result closes the batch with a summary
+		REQUIRE(reports[2]["Results"].size() == 10);
+		REQUIRE(reports[2]["Done"] == total);
+		REQUIRE(reports[2]["Total"] == total);
+		REQUIRE(reports[2]["FailedTxHashes"].size() == 1);
+		REQUIRE(reports[2]["FailedTxHashes"][0] == hashes[5]);
+		REQUIRE(progress.Pending() == 0);
+
+		// txs of no batch are left to the caller
+		REQUIRE(!progress.Result(hashes[0], makeResult(0), now, report));
+		REQUIRE(report.is_null());
+	}
+
+	SECTION("slow results are reported per interval") {
+		PublishProgress progress;
+		std::vector<std::string> hashes;
+		nlohmann::json report;
+		time_t now = 1000;
+
+		for (size_t i = 0; i < 4; ++i) {
+			hashes.push_back(getRanduint256().GetHex());
+			progress.Add(hashes.back(), now);
+		}
+
+		REQUIRE(progress.Result(hashes[0], makeResult(0), now, report));
+		REQUIRE(report.is_null());
+		REQUIRE(progress.Result(hashes[1], makeResult(0), now + PUBLISH_REPORT_INTERVAL, report));
+		REQUIRE(report["Results"].size() == 2);
+		REQUIRE(report["Done"] == 2);
+		REQUIRE(report["Total"] == 4);
+
+		REQUIRE(progress.Result(hashes[2], makeResult(0), now + PUBLISH_REPORT_INTERVAL, report));
+		REQUIRE(report.is_null());
+
+		// a batch added while one is still pending joins it
+		hashes.push_back(getRanduint256().GetHex());
+		progress.Add(hashes.back(), now + PUBLISH_REPORT_INTERVAL);
+		REQUIRE(progress.Result(hashes[3], makeResult(0), now + PUBLISH_REPORT_INTERVAL, report));
+		REQUIRE(report.is_null());
+		REQUIRE(progress.Result(hashes[4], makeResult(0), now + PUBLISH_REPORT_INTERVAL, report));
+		REQUIRE(report["Results"].size() == 3);
+		REQUIRE(report["Done"] == 5);
+		REQUIRE(report["Total"] == 5);
+		REQUIRE(report["FailedTxHashes"].empty());
+
+		// the next batch starts over
+		progress.Add(hashes[0], now + 10);
+		REQUIRE(progress.Result(hashes[0], makeResult(0), now + 10, report));
+		REQUIRE(report["Done"] == 1);
+		REQUIRE(report["Total"] == 1);
+	}
+}
@@ -0,0 +1,112 @@
+// Copyright (c) 2012-2019 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#define CATCH_CONFIG_MAIN
+
+#include <catch.hpp>
+#include "TestHelper.h"
+
+#include <Common/Log.h>
+#include <P2P/PublishQueue.h>
+#include <P2P/TransactionPeerList.h>
+
+#include <boost/bind.hpp>
+
+using namespace Elastos::ElaWallet;
+
+static TransactionPtr makeTx() {
+	TransactionPtr tx(new Transaction());
+	tx->SetLockTime(getRandUInt32());
+	return tx;
+}
+
+static void publishCallback(int &fired, const uint256 &, int, const std::string &) {
+	fired++;
+}
+
+TEST_CASE("Publish queue test", "[PublishQueue]") {
+	Log::registerMultiLogger();
+
+	SECTION("insertion order and pending callbacks") {
+		PublishQueue queue;
+		int fired = 0;
+		std::vector<TransactionPtr> txns;
+
+		for (int i = 0; i < 10; ++i) {
+			txns.push_back(makeTx());
+			if (i % 2)
+				REQUIRE(queue.Insert(PublishedTransaction(txns.back(), boost::bind(&publishCallback, boost::ref(fired), _1, _2, _3))));
+			else
+				REQUIRE(queue.Insert(PublishedTransaction(txns.back())));
+		}
+		REQUIRE(!queue.Insert(PublishedTransaction(txns[3])));
+		REQUIRE(queue.Size() == txns.size());
+		REQUIRE(queue.PendingCallbacks() == 5);
+
+		std::vector<uint256> hashes = queue.GetHashes();
+		REQUIRE(hashes.size() == txns.size());
+		for (size_t i = 0; i < txns.size(); ++i) {
+			REQUIRE(hashes[i] == txns[i]->GetHash());
+			REQUIRE(queue.Contains(txns[i]->GetHash()));
+		}
+
+		txns[5]->SetBlockHeight(100);
+		std::vector<uint256> pending = queue.GetPendingHashes();
+		REQUIRE(pending.size() == 4);
+		REQUIRE(pending[0] == txns[1]->GetHash());
+		REQUIRE(pending[1] == txns[3]->GetHash());
+		REQUIRE(pending[2] == txns[7]->GetHash());
+		REQUIRE(pending[3] == txns[9]->GetHash());
+
+		PublishedTransaction pubTx = queue.ResetCallback(txns[1]->GetHash());
+		REQUIRE(pubTx.HasCallback());
+		pubTx.FireCallback(0, "success");
+		REQUIRE(fired == 1);
+		REQUIRE(!queue.Get(txns[1]->GetHash()).HasCallback());
+		REQUIRE(!queue.ResetCallback(txns[1]->GetHash()).HasCallback());
+		REQUIRE(queue.PendingCallbacks() == 4);
+
+		pubTx = queue.Remove(txns[3]->GetHash());
+		REQUIRE(pubTx.GetTransaction() == txns[3]);
+		REQUIRE(!queue.Contains(txns[3]->GetHash()));
+		REQUIRE(queue.Remove(txns[3]->GetHash()).GetTransaction() == nullptr);
+		REQUIRE(queue.PendingCallbacks() == 3);
+		REQUIRE(queue.Size() == txns.size() - 1);
+
+		queue.ResetCallback(txns[5]->GetHash());
+		queue.ResetCallback(txns[7]->GetHash());
+		queue.ResetCallback(txns[9]->GetHash());
+		REQUIRE(!queue.HasPendingCallbacks());
+		REQUIRE(queue.GetPendingHashes().empty());
+
+		queue.Clear();
+		REQUIRE(queue.Size() == 0);
+		REQUIRE(queue.Get(txns[0]->GetHash()).GetTransaction() == nullptr);
+	}
+
+	SECTION("transaction peer list") {
+		TransactionPeerList list;
+		PeerInfo p1(getRandUInt128(), 20866, 0), p2(getRandUInt128(), 20866, 0);
+		uint256 h1 = getRanduint256(), h2 = getRanduint256();
+
+		REQUIRE(list.AddPeer(h1, p1) == 1);
+		REQUIRE(list.AddPeer(h1, p1) == 1);
+		REQUIRE(list.AddPeer(h1, p2) == 2);
+		REQUIRE(list.AddPeer(h2, p1) == 1);
+		REQUIRE(list.Size() == 2);
+		REQUIRE(list.HasPeer(h1, p2));
+		REQUIRE(!list.HasPeer(h2, p2));
+		REQUIRE(list.Count(getRanduint256()) == 0);
+
+		REQUIRE(list.RemovePeer(h1, p2));
+		REQUIRE(!list.RemovePeer(h1, p2));
+		REQUIRE(list.Count(h1) == 1);
+
+		REQUIRE(list.RemovePeer(p1) == 2);
+		REQUIRE(list.Count(h1) == 0);
+		REQUIRE(list.Count(h2) == 0);
+		REQUIRE(list.Size() == 0);
+		REQUIRE(list.RemovePeer(p1) == 0);
+	}
+}
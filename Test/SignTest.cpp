@@ -10,6 +10,7 @@
 #include <Account/SubAccount.h>
 #include <Common/Utils.h>
 #include <Common/Log.h>
+#include <Plugin/Transaction/Attribute.h>
 #include <Plugin/Transaction/Program.h>
 #include <Plugin/Transaction/Transaction.h>
 #include <WalletCore/BIP39.h>
@@ -117,6 +118,32 @@ TEST_CASE("Sign transaction test", "[SignTransaction]") {
 				REQUIRE(tx->IsSigned());
 			}
 
+			SECTION("Standard address batch sign test") {
+				AddressArray addresses;
+				subAccount1->GetAllAddresses(addresses, 0, 100, false);
+				REQUIRE(addresses.size() > 1);
+
+				std::vector<TransactionPtr> txns;
+				for (size_t i = 0; i < 4; ++i) {
+					bytes_t redeemScript;
+					std::string path;
+					REQUIRE(subAccount1->GetCodeAndPath(addresses[i % 2], redeemScript, path));
+
+					TransactionPtr tx(new Transaction);
+					tx->FromJson(content);
+					tx->AddAttribute(AttributePtr(new Attribute(Attribute::Nonce, bytes_t(std::to_string(i)))));
+					tx->AddProgram(ProgramPtr(new Program(path, redeemScript, bytes_t())));
+					txns.push_back(tx);
+				}
+
+				REQUIRE_THROWS(subAccount3->SignTransactions(txns, payPasswd));
+				REQUIRE_NOTHROW(subAccount1->SignTransactions(txns, payPasswd));
+				for (size_t i = 0; i < txns.size(); ++i)
+					REQUIRE(txns[i]->IsSigned());
+
+				REQUIRE_THROWS(subAccount1->SignTransactions(txns, payPasswd));
+			}
+
 			SECTION("Owner standard address sign test") {
 				AddressPtr addr(new Address(PrefixStandard, ownerPubKey1));
 				bytes_t redeemScript;
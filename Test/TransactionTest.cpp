@@ -10,11 +10,21 @@
 #include <Plugin/Transaction/Transaction.h>
 #include <Plugin/Transaction/Attribute.h>
 #include <Plugin/Transaction/IDTransaction.h>
+#include <Plugin/Transaction/TransactionView.h>
+#include <Plugin/Transaction/TransactionBuilder.h>
 #include <Plugin/Transaction/Payload/DIDInfo.h>
+#include <Plugin/Transaction/Payload/CoinBase.h>
+#include <Plugin/Transaction/Payload/Record.h>
+#include <Plugin/Transaction/Payload/SideChainPow.h>
+#include <Plugin/Transaction/Payload/RechargeToSideChain.h>
+#include <Plugin/Transaction/Payload/WithdrawFromSideChain.h>
+#include <Plugin/Transaction/Payload/TransferCrossChainAsset.h>
 #include <Common/Utils.h>
 #include <Common/Log.h>
 #include <Common/ElementSet.h>
 
+#include <boost/thread.hpp>
+
 using namespace Elastos::ElaWallet;
 
 
@@ -60,6 +70,194 @@ TEST_CASE("Transaction Serialize and Deserialize", "[Transaction]") {
 		}
 	}
 
+	SECTION("transaction view test") {
+		for (int extend = 0; extend < 2; ++extend) {
+			Transaction tx1;
+			initTransaction(tx1, extend ? Transaction::TxVersion::V09 : Transaction::TxVersion::Default);
+
+			ByteStream stream;
+			tx1.Serialize(stream, extend != 0);
+
+			TransactionView view(TransactionPtr(new Transaction()));
+			REQUIRE(view.Deserialize(stream.GetBytes().data(), stream.GetBytes().size(), extend != 0));
+			view.SetHash(tx1.GetHash());
+
+			REQUIRE(view.GetTransactionType() == tx1.GetTransactionType());
+			REQUIRE(view.GetInputs().size() == tx1.GetInputs().size());
+			for (size_t i = 0; i < tx1.GetInputs().size(); ++i) {
+				REQUIRE(view.GetInputs()[i].txHash == tx1.GetInputs()[i]->TxHash());
+				REQUIRE(view.GetInputs()[i].index == tx1.GetInputs()[i]->Index());
+			}
+
+			REQUIRE(view.GetOutputs().size() == tx1.GetOutputs().size());
+			for (size_t i = 0; i < tx1.GetOutputs().size(); ++i) {
+				const OutputPtr &o = tx1.GetOutputs()[i];
+				REQUIRE(view.GetOutputs()[i].assetID == o->AssetID());
+				REQUIRE(view.GetOutputs()[i].programHash == o->Addr()->ProgramHash());
+				REQUIRE(view.OutputAmount(i) == o->Amount());
+
+				OutputPtr vo = view.OutputOfIndex(view.GetOutputs()[i].fixedIndex);
+				REQUIRE(vo != nullptr);
+				REQUIRE(vo->Amount() == o->Amount());
+				REQUIRE(vo->OutputLock() == o->OutputLock());
+				REQUIRE(vo->GetType() == o->GetType());
+			}
+
+			const TransactionPtr &tx2 = view.GetTransaction();
+			REQUIRE(tx2->GetHash() == tx1.GetHash());
+			verifyTransaction(tx1, *tx2, false);
+		}
+	}
+
+	SECTION("transaction view skips payload") {
+		std::vector<std::pair<uint8_t, PayloadPtr>> payloads = {
+			{Transaction::coinBase, PayloadPtr(new CoinBase(getRandBytes(40)))},
+			{Transaction::record, PayloadPtr(new Record("record", getRandBytes(40)))},
+			{Transaction::sideChainPow, PayloadPtr(new SideChainPow(getRanduint256(), getRanduint256(),
+																	getRandUInt32(), getRandBytes(64)))},
+			{Transaction::rechargeToSideChain, PayloadPtr(new RechargeToSideChain(getRandBytes(80), getRandBytes(120)))},
+			{Transaction::withdrawFromSideChain, PayloadPtr(new WithdrawFromSideChain(
+				getRandUInt32(), "genesis", {getRanduint256(), getRanduint256()}))},
+			{Transaction::transferCrossChainAsset, PayloadPtr(new TransferCrossChainAsset(
+				{TransferInfo("cross chain address", 0, getRandBigInt()), TransferInfo("other", 1, getRandBigInt())}))},
+		};
+
+		for (size_t i = 0; i < payloads.size(); ++i) {
+			Transaction tx1(payloads[i].first, payloads[i].second);
+			initTransaction(tx1, Transaction::TxVersion::Default);
+			tx1.SetPayloadVersion(0);
+
+			ByteStream stream;
+			tx1.Serialize(stream);
+
+			TransactionView view(TransactionPtr(new Transaction()));
+			REQUIRE(view.Deserialize(stream.GetBytes().data(), stream.GetBytes().size()));
+			view.SetHash(tx1.GetHash());
+
+			REQUIRE(view.GetTransactionType() == tx1.GetTransactionType());
+			REQUIRE(view.GetInputs().size() == tx1.GetInputs().size());
+			REQUIRE(view.GetOutputs().size() == tx1.GetOutputs().size());
+			for (size_t j = 0; j < tx1.GetOutputs().size(); ++j)
+				REQUIRE(view.OutputAmount(j) == tx1.GetOutputs()[j]->Amount());
+
+			verifyTransaction(tx1, *view.GetTransaction(), false);
+		}
+	}
+
+	SECTION("transaction builder size") {
+		TransactionPtr tx(new Transaction());
+		initTransaction(*tx, Transaction::TxVersion::V09);
+
+		TransactionBuilder builder(tx);
+		REQUIRE(builder.EstimateSize() == tx->EstimateSize());
+
+		std::vector<bytes_t> codes;
+		for (size_t i = 0; i < 10; ++i)
+			codes.push_back(getRandBytes(35));
+
+		for (size_t i = 0; i < 300; ++i) {
+			builder.AddInput(InputPtr(new TransactionInput(getRanduint256(), (uint16_t) i)));
+			const bytes_t &code = codes[i % codes.size()];
+			REQUIRE(builder.AddUniqueProgram(ProgramPtr(new Program("", code, getRandBytes(65)))) == (i < codes.size()));
+			REQUIRE(builder.ContainsProgram(code));
+			REQUIRE(builder.EstimateSize() == tx->EstimateSize());
+		}
+
+		ByteStream stream;
+		tx->Serialize(stream);
+		REQUIRE(builder.EstimateSize() == stream.GetBytes().size());
+	}
+
+	SECTION("serialized size") {
+		for (int version = 0; version < 2; ++version) {
+			for (int extend = 0; extend < 2; ++extend) {
+				Transaction tx;
+				initTransaction(tx, version ? Transaction::TxVersion::V09 : Transaction::TxVersion::Default);
+				tx.AddProgram(ProgramPtr(new Program("m/44'/0'/0'/0/0", getRandBytes(35), bytes_t())));
+
+				size_t size = tx.SerializedSize(extend != 0);
+				ByteStream stream;
+				tx.Serialize(stream, extend != 0);
+				REQUIRE(size == stream.GetBytes().size());
+				REQUIRE(tx.SerializedSize(extend != 0) == size);
+			}
+		}
+	}
+
+	SECTION("cached serialization") {
+		Transaction tx1;
+		initTransaction(tx1, Transaction::TxVersion::V09);
+
+		uint256 hash = tx1.GetHash(), md = tx1.GetShaData();
+		ByteStream stream1, stream2;
+		tx1.Serialize(stream1, true);
+		tx1.Serialize(stream2, true);
+		REQUIRE(stream1.GetBytes() == stream2.GetBytes());
+
+		// a deserialized tx hashes the bytes it was read from
+		Transaction tx2;
+		REQUIRE(tx2.Deserialize(stream1, true));
+		REQUIRE(tx2.GetHash() == hash);
+		REQUIRE(tx2.GetShaData() == md);
+
+		// programs are not part of the digest
+		tx1.AddProgram(ProgramPtr(new Program("", getRandBytes(35), getRandBytes(65))));
+		REQUIRE(tx1.GetShaData() == md);
+		stream2.Reset();
+		tx1.Serialize(stream2, true);
+		REQUIRE(stream2.GetBytes() != stream1.GetBytes());
+
+		// mutators drop the cache
+		tx1.AddOutput(OutputPtr(new TransactionOutput(BigInt(100), Address(uint168(getRandBytes(21))))));
+		REQUIRE(tx1.GetHash() != hash);
+		REQUIRE(tx1.GetShaData() != md);
+
+		hash = tx1.GetHash();
+		tx1.SetLockTime(tx1.GetLockTime() + 1);
+		REQUIRE(tx1.GetHash() != hash);
+
+		hash = tx1.GetHash();
+		tx1.GetOutputs().front()->SetAmount(tx1.GetOutputs().front()->Amount() + 1);
+		REQUIRE(tx1.GetHash() == hash);
+		tx1.ResetHash();
+		REQUIRE(tx1.GetHash() != hash);
+
+		Transaction tx3;
+		stream1.Reset();
+		tx1.Serialize(stream1);
+		REQUIRE(tx3.Deserialize(stream1));
+		REQUIRE(tx3.GetHash() == tx1.GetHash());
+	}
+
+	SECTION("concurrent readers fill the cache once") {
+		Transaction tx;
+		initTransaction(tx, Transaction::TxVersion::V09);
+		Transaction expected(tx);
+		ByteStream expectedStream;
+		expected.Serialize(expectedStream, true);
+		tx.ResetHash();
+
+		std::vector<uint256> hashes(8), digests(8);
+		std::vector<bytes_t> serialized(8);
+		boost::thread_group threads;
+		for (size_t i = 0; i < hashes.size(); ++i) {
+			threads.create_thread([&tx, &hashes, &digests, &serialized, i]() {
+				ByteStream stream;
+				tx.Serialize(stream, true);
+				serialized[i] = stream.GetBytes();
+				hashes[i] = tx.GetHash();
+				digests[i] = tx.GetShaData();
+			});
+		}
+		threads.join_all();
+
+		for (size_t i = 0; i < hashes.size(); ++i) {
+			REQUIRE(hashes[i] == expected.GetHash());
+			REQUIRE(digests[i] == expected.GetShaData());
+			REQUIRE(serialized[i] == expectedStream.GetBytes());
+		}
+	}
+
 }
 
 TEST_CASE("Convert to and from json", "[Transaction]") {
@@ -0,0 +1,73 @@
+// Copyright (c) 2012-2019 The Elastos Open Source Project
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#define CATCH_CONFIG_MAIN
+
+#include <catch.hpp>
+#include "TestHelper.h"
+
+#include <Common/Log.h>
+#include <Wallet/UTXO.h>
+
+using namespace Elastos::ElaWallet;
+
+TEST_CASE("UTXO set test", "[UTXOSet]") {
+	Log::registerMultiLogger();
+
+	UTXOArray utxos;
+	for (int i = 0; i < 200; ++i)
+		utxos.push_back(UTXOPtr(new UTXO(getRanduint256(), (uint16_t) (i % 5), 0, (uint32_t) (rand() % 50))));
+
+	SECTION("insert one by one and in bulk") {
+		UTXOSet single, bulk;
+		for (size_t i = 0; i < utxos.size(); ++i)
+			REQUIRE(single.insert(utxos[i]).second);
+		REQUIRE(!single.insert(utxos[0]).second);
+		REQUIRE(!single.insert(UTXOPtr(new UTXO(utxos[1]->Hash(), utxos[1]->Index()))).second);
+
+		bulk.insert(utxos.begin(), utxos.end());
+		bulk.insert(utxos.begin(), utxos.begin() + 10);
+		REQUIRE(single.size() == utxos.size());
+		REQUIRE(bulk.size() == utxos.size());
+
+		UTXOSet::const_iterator a = single.cbegin(), b = bulk.cbegin();
+		for (; a != single.cend(); ++a, ++b) {
+			REQUIRE((*a)->Equal((*b)->Hash(), (*b)->Index()));
+			if (a != single.cbegin())
+				REQUIRE(UTXOCompare()(*(a - 1), *a));
+		}
+	}
+
+	SECTION("find and erase by input") {
+		UTXOSet set;
+		set.insert(utxos.begin(), utxos.end());
+
+		for (size_t i = 0; i < utxos.size(); i += 2) {
+			InputPtr input(new TransactionInput(utxos[i]->Hash(), utxos[i]->Index()));
+			REQUIRE(set.find(input) != set.end());
+			REQUIRE(*set.find(input) == utxos[i]);
+			REQUIRE(set.erase(input) == 1);
+			REQUIRE(set.erase(input) == 0);
+		}
+
+		REQUIRE(set.size() == utxos.size() / 2);
+		for (size_t i = 1; i < utxos.size(); i += 2)
+			REQUIRE(set.find(utxos[i]) != set.end());
+	}
+
+	SECTION("height order") {
+		UTXOHeightSet set;
+		set.insert(utxos.begin(), utxos.end());
+		REQUIRE(set.size() == utxos.size());
+
+		for (UTXOHeightSet::const_iterator it = set.cbegin(); it != set.cend(); ++it) {
+			if (it != set.cbegin())
+				REQUIRE((*(it - 1))->BlockHeight() <= (*it)->BlockHeight());
+		}
+
+		UTXOPtr cursor = *(set.cbegin() + set.size() / 2);
+		UTXOHeightSet::const_iterator next = set.upper_bound(cursor);
+		REQUIRE(next - set.cbegin() == (long) set.size() / 2 + 1);
+	}
+}
@@ -195,6 +195,12 @@ public:
 					  << hash << std::endl;
 	}
 
+	virtual void OnPublishProgress(const nlohmann::json &progress) {
+		if (verboseMode)
+			std::cout << "*** Wallet " << _chainID << " publish progress: "
+					  << progress.dump() << std::endl;
+	}
+
 	virtual void OnAssetRegistered(const std::string &asset, const nlohmann::json &info) {
 	}
 
@@ -1709,6 +1715,30 @@ static int loglevel(int argc, char *argv[]) {
 	return 0;
 }
 
+// netstats [text]
+static int netstats(int argc, char *argv[]) {
+	if (argc != 1 && argc != 2) {
+		invalidCmdError();
+		return ERRNO_CMD;
+	}
+	if (manager == nullptr) {
+		std::cerr << "wallet manager is null" << std::endl;
+		return ERRNO_APP;
+	}
+
+	try {
+		if (argc == 2 && std::string(argv[1]) == "text") {
+			std::cout << manager->GetNetworkStatsText();
+		} else {
+			std::cout << manager->GetNetworkStats().dump(4) << std::endl;
+		}
+	} catch (const std::exception &e) {
+		exceptionError(e);
+		return ERRNO_APP;
+	}
+	return 0;
+}
+
 // vote (cr | dpos)
 static int vote(int argc, char *argv[]) {
 	checkParam(2);
@@ -2522,6 +2552,7 @@ struct command {
 	{"verbose",    verbose,        "(on | off)                                       Set verbose mode."},
 	{"tracking",   tracking,       "                                                 Create proposal tracking tx."},
 	{"loglevel",   loglevel,       "(trace | debug | info | warning | error | critical | off"},
+	{"netstats",   netstats,       "[text]                                           Show network stats of all wallets in json or text format."},
 	{"exit", NULL,               "                                                 Quit wallet."},
 	{"quit", NULL,               "                                                 Quit wallet."},
 	{NULL,   NULL, NULL}